@@ -1,8 +1,11 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
+#include <mutex>
 #include <stdexcept>
 #include "AMPLModel.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
@@ -17,9 +20,20 @@
 #include "Uno.hpp"
 
 namespace uno {
+   // the reader and the writer of the ASL use global state (current ASL instance, error handling): they are serialized, so that
+   // several models can be read and solved in concurrent threads
+   std::mutex asl_io_mutex;
+
    ASL* generate_asl(std::string file_name) {
+      std::lock_guard<std::mutex> lock(asl_io_mutex);
       ASL* asl = ASL_alloc(ASL_read_pfgh);
+      // a missing file is reported with an exception instead of terminating the process
+      asl->i.return_nofile_ = 1;
       FILE* nl = jac0dim_ASL(asl, file_name.data(), static_cast<int>(file_name.size()));
+      if (nl == nullptr) {
+         ASL_free(&asl);
+         throw std::runtime_error("The file " + file_name + " could not be opened");
+      }
       // indices start at 0
       asl->i.Fortran_ = 0;
 
@@ -81,12 +95,44 @@ namespace uno {
 
       // compute number of nonzeros in the Lagrangian Hessian
       this->set_number_hessian_nonzeros();
+
+      // parallel evaluations: one ASL instance per additional thread
+      const size_t number_threads = ThreadPool::number_threads_from_option(options.get_unsigned_int("AMPL_evaluation_threads"));
+      if (1 < number_threads) {
+         this->thread_pool = std::make_unique<ThreadPool>(number_threads);
+         for (size_t thread_index = 1; thread_index < number_threads; thread_index++) {
+            ASL* asl_clone = generate_asl(file_name);
+            asl_clone->i.congrd_mode = 1;
+            // same Hessian sparsity pattern as the main instance
+            (*(asl_clone)->p.Sphset)(asl_clone, nullptr, -1, 1, 1, 1);
+            this->asl_clones.emplace_back(asl_clone);
+         }
+         this->thread_gradients.resize(number_threads, std::vector<double>(this->number_variables));
+         this->thread_hessians.resize(number_threads, std::vector<double>(this->number_asl_hessian_nonzeros));
+         this->thread_multipliers.resize(number_threads, std::vector<double>(this->number_constraints));
+         DEBUG << "The AMPL model is evaluated with " << number_threads << " threads\n";
+      }
    }
 
    AMPLModel::~AMPLModel() {
+      // stop the threads before releasing their ASL instances
+      this->thread_pool.reset();
+      std::lock_guard<std::mutex> lock(asl_io_mutex);
+      for (ASL*& asl_clone: this->asl_clones) {
+         ASL_free(&asl_clone);
+      }
       ASL_free(&this->asl);
    }
 
+   ASL* AMPLModel::asl_of_thread(size_t thread_index) const {
+      return (thread_index == 0) ? this->asl : this->asl_clones[thread_index - 1];
+   }
+
+   // blocks of consecutive rows: a few blocks per thread balance the load
+   size_t AMPLModel::number_evaluation_tasks(size_t number_rows) const {
+      return std::min(number_rows, 4 * this->thread_pool->size());
+   }
+
    void AMPLModel::generate_variables() {
       for (size_t variable_index: Range(this->number_variables)) {
          this->variable_lower_bounds[variable_index] = (this->asl->i.LUv_ != nullptr) ? this->asl->i.LUv_[2*variable_index] : -INF<double>;
@@ -163,6 +209,10 @@ namespace uno {
    */
 
    void AMPLModel::evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const {
+      if (this->thread_pool != nullptr) {
+         this->evaluate_constraints_in_parallel(x, constraints);
+         return;
+      }
       fint error_flag = 0;
       (*(this->asl)->p.Conval)(this->asl, const_cast<double*>(x.data()), constraints.data(), &error_flag);
       if (0 < error_flag) {
@@ -193,10 +243,125 @@ namespace uno {
    }
 
    void AMPLModel::evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      // the rows are written concurrently in the fixed pattern of the Jacobian
+      if (this->thread_pool != nullptr && constraint_jacobian.has_fixed_pattern() &&
+            this->evaluate_constraint_jacobian_in_parallel(x, constraint_jacobian)) {
+         return;
+      }
       for (size_t constraint_index: Range(this->number_constraints)) {
-         constraint_jacobian[constraint_index].clear();
-         this->evaluate_constraint_gradient(x, constraint_index, constraint_jacobian[constraint_index]);
+         // compute the AMPL sparse gradient
+         fint error_flag = 0;
+         (*(this->asl)->p.Congrd)(this->asl, static_cast<int>(constraint_index), const_cast<double*>(x.data()),
+               const_cast<double*>(this->asl_gradient.data()), &error_flag);
+         if (0 < error_flag) {
+            throw GradientEvaluationError();
+         }
+
+         // the pattern of each row is fixed: the values are written in place after the first evaluation
+         cgrad* asl_variables_tmp = this->asl->i.Cgrad_[constraint_index];
+         size_t sparse_asl_index = 0;
+         while (asl_variables_tmp != nullptr) {
+            const size_t variable_index = static_cast<size_t>(asl_variables_tmp->varno);
+            constraint_jacobian.insert(this->asl_gradient[sparse_asl_index], constraint_index, variable_index);
+            asl_variables_tmp = asl_variables_tmp->next;
+            sparse_asl_index++;
+         }
+      }
+   }
+
+   void AMPLModel::evaluate_constraints_in_parallel(const Vector<double>& x, std::vector<double>& constraints) const {
+      const size_t number_tasks = this->number_evaluation_tasks(this->number_constraints);
+      this->thread_pool->parallel_for(number_tasks, [&](size_t task_index, size_t thread_index) {
+         ASL* thread_asl = this->asl_of_thread(thread_index);
+         for (size_t constraint_index: Range(task_index * this->number_constraints / number_tasks,
+               (task_index + 1) * this->number_constraints / number_tasks)) {
+            fint error_flag = 0;
+            constraints[constraint_index] = (*(thread_asl)->p.Conival)(thread_asl, static_cast<int>(constraint_index), const_cast<double*>(x.data()),
+                  &error_flag);
+            if (0 < error_flag) {
+               throw FunctionEvaluationError();
+            }
+         }
+      });
+   }
+
+   bool AMPLModel::evaluate_constraint_jacobian_in_parallel(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const {
+      const size_t number_tasks = this->number_evaluation_tasks(this->number_constraints);
+      const auto rows_of_task = [&](size_t task_index) {
+         return Range(task_index * this->number_constraints / number_tasks, (task_index + 1) * this->number_constraints / number_tasks);
+      };
+      // check that the fixed pattern starts with the ASL pattern of each row (the reformulations may append entries)
+      std::atomic<bool> pattern_matches{true};
+      this->thread_pool->parallel_for(number_tasks, [&](size_t task_index, size_t /*thread_index*/) {
+         for (size_t constraint_index: rows_of_task(task_index)) {
+            const size_t pattern_size = constraint_jacobian.pattern_size(constraint_index);
+            const size_t* pattern_indices = constraint_jacobian.pattern_indices(constraint_index);
+            size_t position = 0;
+            for (const cgrad* asl_variables_tmp = this->asl->i.Cgrad_[constraint_index]; asl_variables_tmp != nullptr;
+                  asl_variables_tmp = asl_variables_tmp->next) {
+               if (pattern_size <= position || pattern_indices[position] != static_cast<size_t>(asl_variables_tmp->varno)) {
+                  pattern_matches = false;
+                  return;
+               }
+               position++;
+            }
+         }
+      });
+      if (not pattern_matches) {
+         return false;
       }
+
+      this->thread_pool->parallel_for(number_tasks, [&](size_t task_index, size_t thread_index) {
+         ASL* thread_asl = this->asl_of_thread(thread_index);
+         std::vector<double>& gradient = this->thread_gradients[thread_index];
+         for (size_t constraint_index: rows_of_task(task_index)) {
+            fint error_flag = 0;
+            (*(thread_asl)->p.Congrd)(thread_asl, static_cast<int>(constraint_index), const_cast<double*>(x.data()), gradient.data(), &error_flag);
+            if (0 < error_flag) {
+               throw GradientEvaluationError();
+            }
+            size_t number_entries = 0;
+            for (const cgrad* asl_variables_tmp = thread_asl->i.Cgrad_[constraint_index]; asl_variables_tmp != nullptr;
+                  asl_variables_tmp = asl_variables_tmp->next) {
+               number_entries++;
+            }
+            double* row_values = constraint_jacobian.overwrite_row(constraint_index, number_entries);
+            std::copy(gradient.begin(), gradient.begin() + static_cast<std::ptrdiff_t>(number_entries), row_values);
+         }
+      });
+      return true;
+   }
+
+   // the terms of the Lagrangian are split among the threads (the objective and blocks of constraints), then the partial Hessians
+   // are summed by blocks of entries
+   void AMPLModel::evaluate_lagrangian_hessian_in_parallel(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers) const {
+      const size_t number_threads = this->thread_pool->size();
+      this->thread_pool->parallel_for(number_threads, [&](size_t task_index, size_t thread_index) {
+         ASL* thread_asl = this->asl_of_thread(thread_index);
+         // flip the signs of the multipliers: in AMPL, the Lagrangian is f + lambda.g, while Uno uses f - lambda.g
+         std::vector<double>& task_multipliers = this->thread_multipliers[task_index];
+         std::fill(task_multipliers.begin(), task_multipliers.end(), 0.);
+         for (size_t constraint_index: Range(task_index * this->number_constraints / number_threads,
+               (task_index + 1) * this->number_constraints / number_threads)) {
+            task_multipliers[constraint_index] = -multipliers[constraint_index];
+         }
+         double task_objective_multiplier = (task_index == 0) ? objective_multiplier : 0.;
+         (*(thread_asl)->p.Xknown)(thread_asl, const_cast<double*>(x.data()), nullptr);
+         (*(thread_asl)->p.Sphes)(thread_asl, nullptr, this->thread_hessians[task_index].data(), -1, &task_objective_multiplier,
+               task_multipliers.data());
+         thread_asl->i.x_known = 0;
+      });
+      const size_t number_nonzeros = this->number_asl_hessian_nonzeros;
+      this->thread_pool->parallel_for(number_threads, [&](size_t task_index, size_t /*thread_index*/) {
+         for (size_t position: Range(task_index * number_nonzeros / number_threads, (task_index + 1) * number_nonzeros / number_threads)) {
+            double entry = 0.;
+            for (const std::vector<double>& thread_hessian: this->thread_hessians) {
+               entry += thread_hessian[position];
+            }
+            this->asl_hessian[position] = entry;
+         }
+      });
    }
 
    void AMPLModel::set_number_hessian_nonzeros() {
@@ -205,7 +370,7 @@ namespace uno {
       const int objective_number = -1;
       const int upper_triangular = 1;
       this->number_asl_hessian_nonzeros = static_cast<size_t>((*(this->asl)->p.Sphset)(this->asl, nullptr, objective_number, 1, 1, upper_triangular));
-      this->asl_hessian.reserve(this->number_asl_hessian_nonzeros);
+      this->asl_hessian.resize(this->number_asl_hessian_nonzeros);
    }
 
    size_t AMPLModel::number_objective_gradient_nonzeros() const {
@@ -285,7 +450,10 @@ namespace uno {
       const int objective_number = -1;
       // flip the signs of the multipliers: in AMPL, the Lagrangian is f + lambda.g, while Uno uses f - lambda.g
       this->multipliers_with_flipped_sign = -multipliers;
-      if (this->fixed_hessian_sparsity) {
+      if (this->fixed_hessian_sparsity && this->thread_pool != nullptr) {
+         this->evaluate_lagrangian_hessian_in_parallel(x, objective_multiplier, multipliers);
+      }
+      else if (this->fixed_hessian_sparsity) {
          (*(this->asl)->p.Sphes)(this->asl, nullptr, const_cast<double*>(this->asl_hessian.data()), objective_number, &objective_multiplier,
                const_cast<double*>(this->multipliers_with_flipped_sign.data()));
       }
@@ -317,6 +485,75 @@ namespace uno {
       this->asl->i.x_known = 0;
    }
 
+   void AMPLModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+         const Vector<double>& vector, Vector<double>& result) const {
+      // register the vector of variables
+      (*(this->asl)->p.Xknown)(this->asl, const_cast<double*>(x.data()), nullptr);
+
+      // scale by the objective sign
+      objective_multiplier *= this->objective_sign;
+
+      // compute the product with ASL hvcomp (the Hessian is not formed)
+      const int objective_number = -1;
+      // flip the signs of the multipliers: in AMPL, the Lagrangian is f + lambda.g, while Uno uses f - lambda.g
+      this->multipliers_with_flipped_sign = -multipliers;
+      (*(this->asl)->p.Hvcomp)(this->asl, result.data(), const_cast<double*>(vector.data()), objective_number, &objective_multiplier,
+            const_cast<double*>(this->multipliers_with_flipped_sign.data()));
+
+      // unregister the vector of variables
+      this->asl->i.x_known = 0;
+   }
+
+   // variables of the linear arguments of a range of a partially separable element
+   void add_range_variables(const range* U, std::vector<size_t>& variables) {
+      for (int argument_index = 0; argument_index < U->n; argument_index++) {
+         for (const ograd* term = U->lap[argument_index]->nz; term != nullptr; term = term->next) {
+            variables.emplace_back(static_cast<size_t>(term->varno));
+         }
+      }
+   }
+
+   void add_element_function(size_t constraint_index, std::vector<size_t>& variables, std::vector<ElementFunction>& elements) {
+      std::sort(variables.begin(), variables.end());
+      variables.erase(std::unique(variables.begin(), variables.end()), variables.end());
+      if (not variables.empty()) {
+         elements.push_back({constraint_index, std::move(variables)});
+      }
+   }
+
+   // elements of a function read with ASL_findgroups: the basic elements, then one element per group (the nonlinear outer function
+   // of a group couples all the variables of the group)
+   void add_element_functions(const ps_func& function, size_t constraint_index, std::vector<ElementFunction>& elements) {
+      for (int element_index = 0; element_index < function.nb; element_index++) {
+         std::vector<size_t> variables{};
+         add_range_variables(function.b[element_index].U, variables);
+         add_element_function(constraint_index, variables, elements);
+      }
+      for (int group_index = 0; group_index < function.ng; group_index++) {
+         const psg_elem& group = function.g[group_index];
+         std::vector<size_t> variables{};
+         for (int element_index = 0; element_index < group.ns; element_index++) {
+            add_range_variables(group.E[element_index].U, variables);
+         }
+         for (const ograd* term = group.og; term != nullptr; term = term->next) {
+            variables.emplace_back(static_cast<size_t>(term->varno));
+         }
+         add_element_function(constraint_index, variables, elements);
+      }
+   }
+
+   void AMPLModel::compute_element_functions(std::vector<ElementFunction>& elements) const {
+      elements.clear();
+      const ASL_pfgh* asl_pfgh = reinterpret_cast<const ASL_pfgh*>(this->asl);
+      // the nonlinear objective and constraints come first in ASL
+      if (0 < this->asl->i.nlo_) {
+         add_element_functions(asl_pfgh->P.ops[0], ElementFunction::OBJECTIVE, elements);
+      }
+      for (size_t constraint_index: Range(static_cast<size_t>(this->asl->i.nlc_))) {
+         add_element_functions(asl_pfgh->P.cps[constraint_index], constraint_index, elements);
+      }
+   }
+
    double AMPLModel::variable_lower_bound(size_t variable_index) const {
       return this->variable_lower_bounds[variable_index];
    }
@@ -395,6 +632,7 @@ namespace uno {
          option_info.wantsol = 9; // write the solution without printing the message to stdout
          std::string message = "Uno ";
          message.append(Uno::current_version()).append(": ").append(status_to_message(termination_status));
+         std::lock_guard<std::mutex> lock(asl_io_mutex);
          write_sol_ASL(this->asl, message.data(), iterate.primals.data(), iterate.multipliers.constraints.data(), &option_info);
       }
    }
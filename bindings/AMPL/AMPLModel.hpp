@@ -4,12 +4,14 @@
 #ifndef UNO_AMPLMODEL_H
 #define UNO_AMPLMODEL_H
 
+#include <memory>
 #include <vector>
 #include "model/Model.hpp"
 #include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "optimization/Multipliers.hpp"
 #include "symbolic/CollectionAdapter.hpp"
+#include "tools/ThreadPool.hpp"
 
 // include AMPL Solver Library (ASL)
 extern "C" {
@@ -38,6 +40,9 @@ namespace uno {
       void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override;
       void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const override;
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override;
+      void compute_element_functions(std::vector<ElementFunction>& elements) const override;
 
       [[nodiscard]] double variable_lower_bound(size_t variable_index) const override;
       [[nodiscard]] double variable_upper_bound(size_t variable_index) const override;
@@ -71,6 +76,12 @@ namespace uno {
 
       // mutable: can be modified by const methods (internal state not seen by user)
       mutable ASL* asl; /*!< Instance of the AMPL Solver Library class */
+      // parallel evaluations: ASL is not reentrant, each additional thread evaluates the functions with its own ASL instance
+      std::unique_ptr<ThreadPool> thread_pool{};
+      std::vector<ASL*> asl_clones{}; /*!< ASL instance of the thread of index i+1 */
+      mutable std::vector<std::vector<double>> thread_gradients{};
+      mutable std::vector<std::vector<double>> thread_hessians{};
+      mutable std::vector<std::vector<double>> thread_multipliers{};
       const bool write_solution_to_file;
       mutable std::vector<double> asl_gradient{};
       mutable std::vector<double> asl_hessian{};
@@ -108,6 +119,11 @@ namespace uno {
       void generate_constraints();
 
       void set_number_hessian_nonzeros();
+      [[nodiscard]] ASL* asl_of_thread(size_t thread_index) const;
+      [[nodiscard]] size_t number_evaluation_tasks(size_t number_rows) const;
+      void evaluate_constraints_in_parallel(const Vector<double>& x, std::vector<double>& constraints) const;
+      [[nodiscard]] bool evaluate_constraint_jacobian_in_parallel(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const;
+      void evaluate_lagrangian_hessian_in_parallel(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers) const;
       [[nodiscard]] size_t compute_hessian_number_nonzeros(double objective_multiplier, const Vector<double>& multipliers) const;
       static void determine_bounds_types(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds, std::vector<BoundType>& status);
    };
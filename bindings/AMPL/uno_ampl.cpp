@@ -1,18 +1,25 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
+#include <fstream>
 #include <string>
 #include <stdexcept>
+#include <vector>
 #include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
 #include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
 #include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
 #include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
 #include "AMPLModel.hpp"
+#include "Batch.hpp"
+#include "Multistart.hpp"
+#include "Portfolio.hpp"
 #include "Uno.hpp"
 #include "model/ModelFactory.hpp"
 #include "options/Options.hpp"
 #include "options/DefaultOptions.hpp"
 #include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+#include "tools/Timer.hpp"
 
 /*
 size_t memory_allocation_amount = 0;
@@ -25,42 +32,100 @@ void* operator new(size_t size) {
 */
 
 namespace uno {
+   Result solve_ampl_model(const std::string& model_name, const Options& options) {
+      // AMPL model
+      std::unique_ptr<Model> ampl_model = std::make_unique<AMPLModel>(model_name, options);
+      DISCRETE << "Original model " << ampl_model->name << '\n' << ampl_model->number_variables << " variables, " <<
+         ampl_model->number_constraints << " constraints\n";
+
+      // reformulate (scale, add slacks, relax the bounds, ...) if necessary
+      std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(ampl_model), options);
+      DISCRETE << "Reformulated model " << model->name << '\n' << model->number_variables << " variables, " <<
+               model->number_constraints << " constraints\n";
+
+      // initialize initial primal and dual points
+      Iterate initial_iterate(model->number_variables, model->number_constraints);
+      model->initial_primal_point(initial_iterate.primals);
+      model->project_onto_variable_bounds(initial_iterate.primals);
+      model->initial_dual_point(initial_iterate.multipliers.constraints);
+      initial_iterate.feasibility_multipliers.reset();
+
+      // create the constraint relaxation strategy, the globalization mechanism and the Uno solver
+      auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model, options);
+      auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+      Uno uno = Uno(*globalization_mechanism, options);
+
+      // solve the instance
+      return uno.solve(*model, initial_iterate, options);
+      // std::cout << "memory_allocation_amount = " << memory_allocation_amount << '\n';
+   }
+
+   // concurrent runs from several starting points: the solution of the best run is written to the .sol file
+   Result solve_ampl_model_multistart(const std::string& model_name, const Options& options) {
+      Options run_options(options);
+      run_options["AMPL_write_solution_to_file"] = "no";
+      Multistart multistart(options);
+      Result result = multistart.solve([&]() {
+         return ModelFactory::reformulate(std::make_unique<AMPLModel>(model_name, run_options), run_options);
+      }, options);
+      // the runs postprocessed the solution with the reformulated models: only the AMPL model writes it
+      const AMPLModel ampl_model(model_name, options);
+      ampl_model.postprocess_solution(result.solution, result.solution.status);
+      result.print(options.get_bool("print_solution"));
+      return result;
+   }
+
+   // strategy combinations that race in parallel: the solution of the winner is written to the .sol file
+   Result solve_ampl_model_portfolio(const std::string& model_name, const Options& options) {
+      Portfolio portfolio(options.get_string("portfolio"));
+      Result result = portfolio.solve([&](const Options& combination_options) {
+         Options run_options(combination_options);
+         run_options["AMPL_write_solution_to_file"] = "no";
+         return ModelFactory::reformulate(std::make_unique<AMPLModel>(model_name, run_options), run_options);
+      }, options);
+      const AMPLModel ampl_model(model_name, options);
+      ampl_model.postprocess_solution(result.solution, result.solution.status);
+      DISCRETE << "\nUno " << Uno::current_version() << " (portfolio: " << portfolio.winning_combination << ")\n";
+      result.print(options.get_bool("print_solution"));
+      return result;
+   }
+
    void run_uno_ampl(const std::string& model_name, const Options& options) {
       try {
-         // AMPL model
-         std::unique_ptr<Model> ampl_model = std::make_unique<AMPLModel>(model_name, options);
-         DISCRETE << "Original model " << ampl_model->name << '\n' << ampl_model->number_variables << " variables, " <<
-            ampl_model->number_constraints << " constraints\n";
-
-         // reformulate (scale, add slacks, relax the bounds, ...) if necessary
-         std::unique_ptr<Model> model = ModelFactory::reformulate(std::move(ampl_model), options);
-         DISCRETE << "Reformulated model " << model->name << '\n' << model->number_variables << " variables, " <<
-                  model->number_constraints << " constraints\n";
-
-         // initialize initial primal and dual points
-         Iterate initial_iterate(model->number_variables, model->number_constraints);
-         model->initial_primal_point(initial_iterate.primals);
-         model->project_onto_variable_bounds(initial_iterate.primals);
-         model->initial_dual_point(initial_iterate.multipliers.constraints);
-         initial_iterate.feasibility_multipliers.reset();
-
-         // create the constraint relaxation strategy, the globalization mechanism and the Uno solver
-         auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model, options);
-         auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
-         Uno uno = Uno(*globalization_mechanism, options);
-
-         // solve the instance
-         uno.solve(*model, initial_iterate, options);
-         // std::cout << "memory_allocation_amount = " << memory_allocation_amount << '\n';
+         if (not options.get_string("portfolio").empty()) {
+            solve_ampl_model_portfolio(model_name, options);
+         }
+         else if (1 < options.get_unsigned_int("multistart_points")) {
+            solve_ampl_model_multistart(model_name, options);
+         }
+         else {
+            solve_ampl_model(model_name, options);
+         }
       }
       catch (std::exception& exception) {
          DISCRETE << exception.what() << '\n';
       }
    }
 
+   // solve the instances of a batch file concurrently (one instance per thread) and write one result record per instance
+   void run_uno_ampl_batch(const std::string& batch_file_name, const Options& options) {
+      const std::vector<BatchInstance> instances = Batch::read_instances(batch_file_name);
+      const std::string& results_file_name = options.get_string("AMPL_batch_results_file");
+      std::ofstream results_file(results_file_name);
+      if (not results_file) {
+         throw std::invalid_argument("The results file " + results_file_name + " could not be opened");
+      }
+      const Timer timer{};
+      const Batch batch(ThreadPool::number_threads_from_option(options.get_unsigned_int("AMPL_batch_threads")));
+      batch.solve(instances, solve_ampl_model, options, results_file);
+      DISCRETE << "The results were written to " << results_file_name << " (" << timer.get_duration() << "s)\n";
+   }
+
    void print_uno_instructions() {
       std::cout << "Welcome in Uno " << Uno::current_version() << '\n';
       std::cout << "To solve an AMPL model, type ./uno_ampl model.nl -AMPL [option_name=option_value ...]\n";
+      std::cout << "To solve a batch of AMPL models (one model.nl [time_limit] per line), type ./uno_ampl --batch batch.txt -AMPL "
+                   "[option_name=option_value ...]\n";
       std::cout << "To choose a constraint relaxation strategy, use the argument constraint_relaxation_strategy="
                    "[feasibility_restoration|l1_relaxation]\n";
       std::cout << "To choose a subproblem method, use the argument subproblem=[QP|LP|primal_dual_interior_point]\n";
@@ -94,6 +159,16 @@ int main(int argc, char* argv[]) {
          Options options = DefaultOptions::load();
 
          // AMPL expects: ./uno_ampl model.nl -AMPL [option_name=option_value, ...]
+         // batch mode: ./uno_ampl --batch batch.txt -AMPL [option_name=option_value, ...]
+         const bool batch_mode = (std::string(argv[1]) == "--batch");
+         // shift the arguments so that argv[1] is the model name (or the batch file)
+         if (batch_mode) {
+            argc--;
+            argv++;
+            if (argc < 3) {
+               throw std::runtime_error("The batch mode expects: --batch batch.txt -AMPL");
+            }
+         }
          // model name
          std::string model_name = std::string(argv[1]);
 
@@ -112,7 +187,12 @@ int main(int argc, char* argv[]) {
 
          // solve the model
          Logger::set_logger(options.get_string("logger"));
-         run_uno_ampl(model_name, options);
+         if (batch_mode) {
+            run_uno_ampl_batch(model_name, options);
+         }
+         else {
+            run_uno_ampl(model_name, options);
+         }
       }
    }
    catch (std::exception& exception) {
@@ -0,0 +1,118 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include "Batch.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+
+namespace uno {
+   Batch::Batch(size_t number_threads): number_threads(number_threads) {
+   }
+
+   void Batch::solve(const std::vector<BatchInstance>& instances, const InstanceSolver& solve_instance, const Options& options,
+         std::ostream& results) const {
+      const std::vector<size_t> schedule = Batch::schedule(instances);
+      results << Batch::results_header() << std::flush;
+      std::mutex results_mutex;
+
+      ThreadPool thread_pool(this->number_threads);
+      DISCRETE << "Solving " << instances.size() << " instances with " << thread_pool.size() << " threads\n";
+      // the threads pick the next instance of the schedule when they become idle
+      thread_pool.parallel_for(schedule.size(), [&](size_t task_index, size_t /*thread_index*/) {
+         const BatchInstance& instance = instances[schedule[task_index]];
+         // the instances are solved silently: the records are the output of the batch
+         Options instance_options(options);
+         instance_options["logger"] = "SILENT";
+         if (not instance.time_limit.empty()) {
+            instance_options["time_limit"] = instance.time_limit;
+         }
+         const ScopedLoggerLevel logger_level(instance_options.get_string("logger"));
+
+         std::string record;
+         try {
+            record = Batch::result_record(instance.model_name, solve_instance(instance.model_name, instance_options));
+         }
+         catch (const std::exception& exception) {
+            record = Batch::error_record(instance.model_name, exception.what());
+         }
+         // the records are written as the instances complete
+         std::lock_guard<std::mutex> lock(results_mutex);
+         results << record << std::flush;
+      });
+   }
+
+   std::vector<BatchInstance> Batch::read_instances(std::istream& batch) {
+      std::vector<BatchInstance> instances{};
+      std::string line;
+      while (std::getline(batch, line)) {
+         std::istringstream line_stream(line);
+         BatchInstance instance{"", "", 0};
+         if (not (line_stream >> instance.model_name) || instance.model_name[0] == '#') {
+            continue;
+         }
+         line_stream >> instance.time_limit;
+         // the size of the .nl file estimates the solve time (ASL appends the .nl extension if needed)
+         for (const std::string& file_name: {instance.model_name, instance.model_name + ".nl"}) {
+            std::ifstream model_file(file_name, std::ios::binary | std::ios::ate);
+            if (model_file) {
+               instance.file_size = static_cast<std::streamoff>(model_file.tellg());
+               break;
+            }
+         }
+         instances.emplace_back(std::move(instance));
+      }
+      return instances;
+   }
+
+   std::vector<BatchInstance> Batch::read_instances(const std::string& batch_file_name) {
+      std::ifstream batch_file(batch_file_name);
+      if (not batch_file) {
+         throw std::invalid_argument("The batch file " + batch_file_name + " was not found");
+      }
+      return Batch::read_instances(batch_file);
+   }
+
+   std::vector<size_t> Batch::schedule(const std::vector<BatchInstance>& instances) {
+      std::vector<size_t> schedule(instances.size());
+      std::iota(schedule.begin(), schedule.end(), 0);
+      std::stable_sort(schedule.begin(), schedule.end(), [&](size_t index1, size_t index2) {
+         return instances[index1].file_size > instances[index2].file_size;
+      });
+      return schedule;
+   }
+
+   std::string Batch::results_header() {
+      return "instance,status,objective,primal feasibility,iterations,objective evaluations,constraint evaluations,"
+         "objective gradient evaluations,Jacobian evaluations,Hessian evaluations,solve time\n";
+   }
+
+   std::string Batch::result_record(const std::string& model_name, const Result& result) {
+      std::ostringstream record;
+      record << Batch::csv_field(model_name) << ',' << Batch::csv_field(status_to_message(result.solution.status)) << ',' <<
+         std::setprecision(17) << result.solution.evaluations.objective << ',' << result.solution.primal_feasibility << ',' <<
+         result.iteration << ',' << result.objective_evaluations << ',' << result.constraint_evaluations << ',' <<
+         result.objective_gradient_evaluations << ',' << result.jacobian_evaluations << ',' << result.hessian_evaluations << ',' <<
+         result.solve_time << '\n';
+      return record.str();
+   }
+
+   std::string Batch::error_record(const std::string& model_name, const std::string& error) {
+      return Batch::csv_field(model_name) + ',' + Batch::csv_field("Error: " + error) + ",,,,,,,,,\n";
+   }
+
+   std::string Batch::csv_field(const std::string& value) {
+      std::string field = "\"";
+      for (char character: value) {
+         field += (character == '"') ? std::string("\"\"") : std::string(1, character);
+      }
+      return field + "\"";
+   }
+} // namespace
@@ -0,0 +1,50 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BATCH_H
+#define UNO_BATCH_H
+
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "optimization/Result.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   // instance of a batch: model file and time limit (empty: time_limit option)
+   struct BatchInstance {
+      std::string model_name;
+      std::string time_limit;
+      std::streamoff file_size;
+   };
+
+   // batch of instances solved concurrently (one instance per thread). The largest model files are solved first and one CSV result
+   // record per instance is written as the instances complete
+   class Batch {
+   public:
+      // solves the model of an instance (e.g. an AMPL model) with the options of the instance
+      using InstanceSolver = std::function<Result(const std::string& model_name, const Options& options)>;
+
+      explicit Batch(size_t number_threads);
+
+      void solve(const std::vector<BatchInstance>& instances, const InstanceSolver& solve_instance, const Options& options,
+            std::ostream& results) const;
+
+      // one instance per line: model.nl [time_limit]. Empty lines and lines starting with # are ignored
+      [[nodiscard]] static std::vector<BatchInstance> read_instances(std::istream& batch);
+      [[nodiscard]] static std::vector<BatchInstance> read_instances(const std::string& batch_file_name);
+      // indices of the instances, largest files first: the small instances fill the idle threads at the end of the batch
+      [[nodiscard]] static std::vector<size_t> schedule(const std::vector<BatchInstance>& instances);
+      [[nodiscard]] static std::string results_header();
+      [[nodiscard]] static std::string result_record(const std::string& model_name, const Result& result);
+      [[nodiscard]] static std::string error_record(const std::string& model_name, const std::string& error);
+      [[nodiscard]] static std::string csv_field(const std::string& value);
+
+      const size_t number_threads;
+   };
+} // namespace
+
+#endif // UNO_BATCH_H
@@ -0,0 +1,240 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include "Multistart.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+
+namespace uno {
+   MultistartSampling multistart_sampling_from_string(const std::string& sampling) {
+      if (sampling == "latin_hypercube") {
+         return MultistartSampling::LATIN_HYPERCUBE;
+      }
+      else if (sampling == "perturbation") {
+         return MultistartSampling::PERTURBATION;
+      }
+      throw std::invalid_argument("The multistart sampling " + sampling + " is not known");
+   }
+
+   Multistart::Multistart(const Options& options) :
+         number_points(std::max(size_t(1), options.get_unsigned_int("multistart_points"))),
+         number_threads(ThreadPool::number_threads_from_option(options.get_unsigned_int("multistart_threads"))),
+         sampling(multistart_sampling_from_string(options.get_string("multistart_sampling"))),
+         radius(options.get_double("multistart_radius")),
+         seed(static_cast<unsigned int>(options.get_unsigned_int("multistart_seed"))),
+         cutoff_distance(options.get_double("multistart_cutoff_distance")),
+         cutoff_iteration(options.get_unsigned_int("multistart_cutoff_iteration")) {
+   }
+
+   namespace {
+      // outcome of the run from a starting point
+      struct MultistartRun {
+         std::optional<Result> result{};
+         double objective{INF<double>}; // objective of the model at the final point (minimization)
+         bool is_cut_off{false};
+         bool is_duplicate{false}; // converged to a local solution that was already found
+         std::string error{};
+      };
+
+      // the converged feasible points come first and are ranked by objective, the other points by infeasibility
+      bool is_better_run(const MultistartRun& run, const MultistartRun& other_run) {
+         if (not run.result.has_value()) {
+            return false;
+         }
+         if (not other_run.result.has_value()) {
+            return true;
+         }
+         const bool is_feasible = is_feasible_status(run.result->solution.status);
+         if (is_feasible != is_feasible_status(other_run.result->solution.status)) {
+            return is_feasible;
+         }
+         if (is_feasible) {
+            return run.objective < other_run.objective;
+         }
+         return run.result->solution.primal_feasibility < other_run.result->solution.primal_feasibility;
+      }
+
+      // ||x - y||_inf / max(1, ||y||_inf)
+      double relative_distance(const Vector<double>& x, const Vector<double>& y, size_t number_variables) {
+         double distance = 0.;
+         double norm = 1.;
+         for (size_t variable_index: Range(number_variables)) {
+            distance = std::max(distance, std::abs(x[variable_index] - y[variable_index]));
+            norm = std::max(norm, std::abs(y[variable_index]));
+         }
+         return distance / norm;
+      }
+   } // namespace
+
+   Result Multistart::solve(const ModelGenerator& generate_model, const Options& options) {
+      ThreadPool thread_pool(std::min(this->number_threads, this->number_points));
+      // one model per thread, generated at its first run
+      std::vector<std::unique_ptr<Model>> models(thread_pool.size());
+      models[0] = generate_model();
+      const Model& model = *models[0];
+      const size_t number_variables = model.number_variables;
+
+      // starting points
+      std::vector<double> lower_bounds(number_variables), upper_bounds(number_variables);
+      for (size_t variable_index: Range(number_variables)) {
+         lower_bounds[variable_index] = model.variable_lower_bound(variable_index);
+         upper_bounds[variable_index] = model.variable_upper_bound(variable_index);
+      }
+      Vector<double> initial_point(number_variables);
+      model.initial_primal_point(initial_point);
+      model.project_onto_variable_bounds(initial_point);
+      const std::vector<Vector<double>> starting_points = Multistart::generate_starting_points(lower_bounds, upper_bounds, initial_point,
+            this->number_points, this->sampling, this->radius, this->seed);
+
+      // the runs are silent: the summary is printed at the end
+      Options run_options(options);
+      run_options["logger"] = "SILENT";
+      const Level logger_level = Logger::level;
+
+      std::vector<MultistartRun> runs(this->number_points);
+      std::vector<Vector<double>> local_solutions{};
+      std::mutex local_solutions_mutex;
+      thread_pool.parallel_for(this->number_points, [&](size_t run_index, size_t thread_index) {
+         MultistartRun& run = runs[run_index];
+         try {
+            if (models[thread_index] == nullptr) {
+               models[thread_index] = generate_model();
+            }
+            const Model& run_model = *models[thread_index];
+            Iterate initial_iterate(run_model.number_variables, run_model.number_constraints);
+            for (size_t variable_index: Range(number_variables)) {
+               initial_iterate.primals[variable_index] = starting_points[run_index][variable_index];
+            }
+            run_model.initial_dual_point(initial_iterate.multipliers.constraints);
+            initial_iterate.feasibility_multipliers.reset();
+
+            // the strategies hold the state of a run: they are created for each run
+            auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(run_model, run_options);
+            auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, run_options);
+            Uno uno(*globalization_mechanism, run_options);
+            // cut off the run when it approaches a local solution that was already found
+            uno.set_iteration_callback([&](const Iterate& iterate, size_t iteration) {
+               if (iteration < this->cutoff_iteration) {
+                  return false;
+               }
+               std::lock_guard<std::mutex> lock(local_solutions_mutex);
+               run.is_cut_off = std::any_of(local_solutions.cbegin(), local_solutions.cend(), [&](const Vector<double>& local_solution) {
+                  return relative_distance(iterate.primals, local_solution, number_variables) <= this->cutoff_distance;
+               });
+               return run.is_cut_off;
+            });
+            run.result.emplace(uno.solve(run_model, initial_iterate, run_options));
+
+            const Iterate& solution = run.result->solution;
+            try {
+               run.objective = run_model.evaluate_objective(solution.primals);
+            }
+            catch (const std::exception&) {
+               run.objective = INF<double>;
+            }
+            if (not run.is_cut_off && is_feasible_status(solution.status)) {
+               std::lock_guard<std::mutex> lock(local_solutions_mutex);
+               run.is_duplicate = std::any_of(local_solutions.cbegin(), local_solutions.cend(), [&](const Vector<double>& local_solution) {
+                  return relative_distance(solution.primals, local_solution, number_variables) <= this->cutoff_distance;
+               });
+               if (not run.is_duplicate) {
+                  local_solutions.push_back(solution.primals);
+               }
+            }
+         }
+         catch (const std::exception& exception) {
+            run.error = exception.what();
+         }
+      });
+      Logger::level = logger_level;
+
+      // summary
+      this->number_local_solutions = local_solutions.size();
+      this->number_duplicate_runs = 0;
+      size_t best_index = 0;
+      for (size_t run_index: Range(this->number_points)) {
+         const MultistartRun& run = runs[run_index];
+         if (run.is_cut_off || run.is_duplicate) {
+            this->number_duplicate_runs++;
+         }
+         DISCRETE << "Multistart run " << run_index << ": ";
+         if (not run.result.has_value()) {
+            DISCRETE << "error (" << run.error << ")\n";
+         }
+         else if (run.is_cut_off) {
+            DISCRETE << "cut off after " << run.result->iteration << " iterations\n";
+         }
+         else if (run.is_duplicate) {
+            DISCRETE << "duplicate local solution, objective " << run.objective << ", " << run.result->iteration << " iterations\n";
+         }
+         else {
+            DISCRETE << status_to_message(run.result->solution.status) << ", objective " << run.objective << ", " <<
+               run.result->iteration << " iterations\n";
+         }
+         if (is_better_run(run, runs[best_index])) {
+            best_index = run_index;
+         }
+      }
+      if (not runs[best_index].result.has_value()) {
+         throw std::runtime_error("All the multistart runs failed");
+      }
+      DISCRETE << "Best multistart run: " << best_index << " (" << local_solutions.size() << " local solutions found)\n";
+      return std::move(*runs[best_index].result);
+   }
+
+   std::vector<Vector<double>> Multistart::generate_starting_points(const std::vector<double>& lower_bounds, const std::vector<double>& upper_bounds,
+         const Vector<double>& initial_point, size_t number_points, MultistartSampling sampling, double radius, unsigned int seed) {
+      const size_t number_variables = initial_point.size();
+      std::vector<Vector<double>> starting_points(number_points, initial_point);
+      if (number_points <= 1) {
+         return starting_points;
+      }
+      std::mt19937 generator(seed);
+      std::uniform_real_distribution<double> uniform(0., 1.);
+      // the first point is the initial point
+      const size_t number_samples = number_points - 1;
+      std::vector<size_t> strata(number_samples);
+      for (size_t variable_index: Range(number_variables)) {
+         const double x0 = initial_point[variable_index];
+         const double lower_bound = lower_bounds[variable_index];
+         const double upper_bound = upper_bounds[variable_index];
+         // half-width of the box around the initial point
+         const double half_width = radius * std::max(1., std::abs(x0));
+         if (sampling == MultistartSampling::LATIN_HYPERCUBE) {
+            // box: the bounds when finite, the initial point +/- half-width otherwise
+            const double box_lower = is_finite(lower_bound) ? lower_bound : x0 - half_width;
+            const double box_upper = is_finite(upper_bound) ? upper_bound : x0 + half_width;
+            // one sample per stratum of each variable
+            std::iota(strata.begin(), strata.end(), 0);
+            std::shuffle(strata.begin(), strata.end(), generator);
+            for (size_t sample_index: Range(number_samples)) {
+               const double position = (static_cast<double>(strata[sample_index]) + uniform(generator)) / static_cast<double>(number_samples);
+               starting_points[sample_index + 1][variable_index] = box_lower + position * (box_upper - box_lower);
+            }
+         }
+         else {
+            for (size_t sample_index: Range(number_samples)) {
+               const double perturbed_value = x0 + half_width * (2. * uniform(generator) - 1.);
+               starting_points[sample_index + 1][variable_index] = std::min(std::max(perturbed_value, lower_bound), upper_bound);
+            }
+         }
+      }
+      return starting_points;
+   }
+} // namespace
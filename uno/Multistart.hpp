@@ -0,0 +1,57 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MULTISTART_H
+#define UNO_MULTISTART_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "linear_algebra/Vector.hpp"
+#include "optimization/Result.hpp"
+
+namespace uno {
+   // forward declarations
+   class Model;
+   class Options;
+
+   enum class MultistartSampling {LATIN_HYPERCUBE, PERTURBATION};
+
+   // multistart driver around Uno::solve: the runs from several starting points are solved concurrently and the best point is returned.
+   // The first starting point is the initial point of the model; the others sample a box around it, restricted to the variable bounds.
+   // A run is cut off when its iterate comes close to a local solution found by another run; a run that converges to a local solution
+   // that was already found is also a duplicate.
+   // Each thread generates its own model (the evaluations of a model are not thread-safe) and reuses it for all its runs; the
+   // symbolic analyses of the linear solvers are shared through the cache of fill-reducing orderings.
+   class Multistart {
+   public:
+      // generates a (reformulated) model
+      using ModelGenerator = std::function<std::unique_ptr<Model>()>;
+
+      explicit Multistart(const Options& options);
+
+      [[nodiscard]] Result solve(const ModelGenerator& generate_model, const Options& options);
+
+      [[nodiscard]] static std::vector<Vector<double>> generate_starting_points(const std::vector<double>& lower_bounds,
+            const std::vector<double>& upper_bounds, const Vector<double>& initial_point, size_t number_points, MultistartSampling sampling,
+            double radius, unsigned int seed);
+
+      // outcome of the last solve
+      size_t number_local_solutions{0}; // distinct local solutions
+      size_t number_duplicate_runs{0}; // runs that were cut off or converged to a local solution that was already found
+
+   protected:
+      const size_t number_points;
+      const size_t number_threads;
+      const MultistartSampling sampling;
+      const double radius;
+      const unsigned int seed;
+      const double cutoff_distance;
+      const size_t cutoff_iteration;
+   };
+
+   MultistartSampling multistart_sampling_from_string(const std::string& sampling);
+} // namespace
+
+#endif // UNO_MULTISTART_H
@@ -0,0 +1,167 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <atomic>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include "Portfolio.hpp"
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+#include "tools/Timer.hpp"
+
+namespace uno {
+   Portfolio::Portfolio(const std::string& combinations): combinations(Portfolio::split(combinations, ',')) {
+      if (this->combinations.empty()) {
+         throw std::invalid_argument("The portfolio does not contain any combination");
+      }
+   }
+
+   namespace {
+      // outcome of the run of a combination
+      struct PortfolioRun {
+         std::optional<Result> result{};
+         bool is_cancelled{false};
+         double time{0.};
+         std::string error{};
+      };
+
+      // feasible points first, then the least infeasible point
+      bool is_better_portfolio_run(const PortfolioRun& run, const PortfolioRun& other_run) {
+         if (not run.result.has_value()) {
+            return false;
+         }
+         if (not other_run.result.has_value()) {
+            return true;
+         }
+         const bool is_feasible = is_feasible_status(run.result->solution.status);
+         if (is_feasible != is_feasible_status(other_run.result->solution.status)) {
+            return is_feasible;
+         }
+         if (is_feasible) {
+            return run.result->solution.evaluations.objective < other_run.result->solution.evaluations.objective;
+         }
+         return run.result->solution.primal_feasibility < other_run.result->solution.primal_feasibility;
+      }
+   } // namespace
+
+   Result Portfolio::solve(const ModelGenerator& generate_model, const Options& options) {
+      const size_t number_combinations = this->combinations.size();
+      std::vector<Options> options_of_combination{};
+      options_of_combination.reserve(number_combinations);
+      for (const std::string& combination: this->combinations) {
+         options_of_combination.emplace_back(Portfolio::combination_options(combination, options));
+      }
+
+      // the combinations race in concurrent threads
+      constexpr size_t no_winner = std::numeric_limits<size_t>::max();
+      std::atomic<size_t> winner{no_winner};
+      std::vector<PortfolioRun> runs(number_combinations);
+      const Level logger_level = Logger::level;
+      const Timer timer{};
+      ThreadPool thread_pool(number_combinations);
+      thread_pool.parallel_for(number_combinations, [&](size_t combination_index, size_t /*thread_index*/) {
+         PortfolioRun& run = runs[combination_index];
+         try {
+            const Options& run_options = options_of_combination[combination_index];
+            const std::unique_ptr<Model> model = generate_model(run_options);
+            Iterate initial_iterate(model->number_variables, model->number_constraints);
+            model->initial_primal_point(initial_iterate.primals);
+            model->project_onto_variable_bounds(initial_iterate.primals);
+            model->initial_dual_point(initial_iterate.multipliers.constraints);
+            initial_iterate.feasibility_multipliers.reset();
+
+            auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model, run_options);
+            auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, run_options);
+            Uno uno(*globalization_mechanism, run_options);
+            // cooperative cancellation: the run stops at its next iteration once another combination won
+            uno.set_iteration_callback([&](const Iterate& /*iterate*/, size_t /*iteration*/) {
+               run.is_cancelled = (winner.load() != no_winner);
+               return run.is_cancelled;
+            });
+            run.result.emplace(uno.solve(*model, initial_iterate, run_options));
+            run.time = timer.get_duration();
+            if (run.result->solution.status == TerminationStatus::FEASIBLE_KKT_POINT) {
+               size_t expected_winner = no_winner;
+               winner.compare_exchange_strong(expected_winner, combination_index);
+            }
+         }
+         catch (const std::exception& exception) {
+            run.error = exception.what();
+         }
+      });
+      Logger::level = logger_level;
+
+      // summary
+      this->cancelled_combinations.clear();
+      for (size_t combination_index: Range(number_combinations)) {
+         const PortfolioRun& run = runs[combination_index];
+         DISCRETE << "Portfolio combination " << this->combinations[combination_index] << ": ";
+         if (not run.result.has_value()) {
+            DISCRETE << "error (" << run.error << ")\n";
+         }
+         else if (run.is_cancelled) {
+            this->cancelled_combinations.push_back(this->combinations[combination_index]);
+            DISCRETE << "cancelled after " << run.result->iteration << " iterations\n";
+         }
+         else {
+            DISCRETE << status_to_message(run.result->solution.status) << " after " << run.result->iteration << " iterations in " <<
+               run.time << "s\n";
+         }
+      }
+      size_t best_index = winner.load();
+      if (best_index == no_winner) {
+         best_index = 0;
+         for (size_t combination_index: Range(1, number_combinations)) {
+            if (is_better_portfolio_run(runs[combination_index], runs[best_index])) {
+               best_index = combination_index;
+            }
+         }
+      }
+      if (not runs[best_index].result.has_value()) {
+         throw std::runtime_error("All the portfolio combinations failed");
+      }
+      this->winning_combination = this->combinations[best_index];
+      DISCRETE << (winner.load() == no_winner ? "Best" : "Winning") << " portfolio combination: " << this->winning_combination << '\n';
+      return std::move(*runs[best_index].result);
+   }
+
+   std::vector<std::string> Portfolio::split(const std::string& string, char delimiter) {
+      std::vector<std::string> tokens{};
+      std::istringstream stream(string);
+      std::string token;
+      while (std::getline(stream, token, delimiter)) {
+         // trim the spaces
+         const size_t first = token.find_first_not_of(' ');
+         if (first != std::string::npos) {
+            tokens.emplace_back(token.substr(first, token.find_last_not_of(' ') - first + 1));
+         }
+      }
+      return tokens;
+   }
+
+   // the settings of the combination overwrite the options. The runs are silent
+   Options Portfolio::combination_options(const std::string& combination, const Options& options) {
+      Options combination_options(options);
+      for (const std::string& setting: Portfolio::split(combination, '+')) {
+         const size_t position = setting.find('=');
+         if (position == std::string::npos) {
+            Options::set_preset(combination_options, setting);
+         }
+         else {
+            combination_options[setting.substr(0, position)] = setting.substr(position + 1);
+         }
+      }
+      combination_options["logger"] = "SILENT";
+      return combination_options;
+   }
+} // namespace
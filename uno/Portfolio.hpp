@@ -0,0 +1,45 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PORTFOLIO_H
+#define UNO_PORTFOLIO_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "optimization/Result.hpp"
+
+namespace uno {
+   // forward declarations
+   class Model;
+   class Options;
+
+   // portfolio of strategy combinations that race on the same problem, each in its own thread. The first combination that
+   // converges to a feasible KKT point wins and the other ones are cancelled at their next iteration. Without a winner, the
+   // best point (feasible first, then least infeasible) is returned.
+   // The combinations are separated by commas; the settings of a combination are separated by '+' and are either a preset
+   // name or an option_name=option_value pair (e.g. "ipopt,filtersqp,filtersqp+globalization_mechanism=LS")
+   class Portfolio {
+   public:
+      // generates a (reformulated) model for the options of a combination
+      using ModelGenerator = std::function<std::unique_ptr<Model>(const Options&)>;
+
+      explicit Portfolio(const std::string& combinations);
+
+      [[nodiscard]] Result solve(const ModelGenerator& generate_model, const Options& options);
+      [[nodiscard]] static Options combination_options(const std::string& combination, const Options& options);
+
+      // combination of the returned point
+      std::string winning_combination{};
+      // combinations that were stopped because another one won
+      std::vector<std::string> cancelled_combinations{};
+
+   protected:
+      const std::vector<std::string> combinations;
+
+      [[nodiscard]] static std::vector<std::string> split(const std::string& string, char delimiter);
+   };
+} // namespace
+
+#endif // UNO_PORTFOLIO_H
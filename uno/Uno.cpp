@@ -27,10 +27,13 @@ namespace uno {
          print_solution(options.get_bool("print_solution")),
          strategy_combination(Uno::get_strategy_combination(options)) { }
    
-   Level Logger::level = INFO;
+   thread_local Level Logger::level = INFO;
 
-   void Uno::solve(const Model& model, Iterate& current_iterate, const Options& options) {
+   Result Uno::solve(const Model& model, Iterate& current_iterate, const Options& options) {
       Timer timer{};
+      // the state of a solve is local to the calling thread. The logger level of the caller is restored on exit
+      const ScopedLoggerLevel logger_level(options.get_string("logger"));
+      Iterate::reset_evaluation_counters();
       Statistics statistics = Uno::create_statistics(model, options);
 
       try {
@@ -53,6 +56,10 @@ namespace uno {
                // compute an acceptable iterate by solving a subproblem at the current point
                this->globalization_mechanism.compute_next_iterate(statistics, model, current_iterate, trial_iterate);
                termination = this->termination_criteria(trial_iterate.status, major_iterations, timer.get_duration());
+               if (not termination && this->iteration_callback && this->iteration_callback(trial_iterate, major_iterations)) {
+                  DEBUG << "The solve was interrupted by the iteration callback\n";
+                  termination = true;
+               }
                // the trial iterate becomes the current iterate for the next iteration
                std::swap(current_iterate, trial_iterate);
             }
@@ -68,12 +75,18 @@ namespace uno {
          Uno::postprocess_iterate(model, current_iterate, current_iterate.status);
          Result result = this->create_result(model, current_iterate, major_iterations, timer);
          this->print_optimization_summary(result);
+         return result;
       }
       catch (const std::exception& e) {
          DISCRETE  << "An error occurred at the initial iterate: " << e.what()  << '\n';
+         return this->create_result(model, current_iterate, 0, timer);
       }
    }
 
+   void Uno::set_iteration_callback(std::function<bool(const Iterate&, size_t)> callback) {
+      this->iteration_callback = std::move(callback);
+   }
+
    void Uno::initialize(Statistics& statistics, Iterate& current_iterate, const Options& options) {
       statistics.start_new_line();
       statistics.set("iter", 0);
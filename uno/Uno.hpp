@@ -4,6 +4,7 @@
 #ifndef UNO_H
 #define UNO_H
 
+#include <functional>
 #include "optimization/Result.hpp"
 #include "optimization/TerminationStatus.hpp"
 
@@ -19,7 +20,9 @@ namespace uno {
    public:
       Uno(GlobalizationMechanism& globalization_mechanism, const Options& options);
 
-      void solve(const Model& model, Iterate& initial_iterate, const Options& options);
+      Result solve(const Model& model, Iterate& initial_iterate, const Options& options);
+      // the callback is called with the new iterate and the iteration number after each iteration. The solve stops when it returns true
+      void set_iteration_callback(std::function<bool(const Iterate&, size_t)> callback);
 
       static std::string current_version();
       static void print_available_strategies();
@@ -29,9 +32,10 @@ namespace uno {
    private:
       GlobalizationMechanism& globalization_mechanism; /*!< Globalization mechanism */
       const size_t max_iterations; /*!< Maximum number of iterations */
-      const double time_limit; /*!< CPU time limit (can be inf) */
+      const double time_limit; /*!< Wall-clock time limit (can be inf) */
       const bool print_solution;
       const std::string strategy_combination;
+      std::function<bool(const Iterate&, size_t)> iteration_callback{};
 
       void initialize(Statistics& statistics, Iterate& current_iterate, const Options& options);
       [[nodiscard]] static Statistics create_statistics(const Model& model, const Options& options);
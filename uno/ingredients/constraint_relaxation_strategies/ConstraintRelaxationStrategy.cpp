@@ -7,6 +7,7 @@
 #include "optimization/Direction.hpp"
 #include "ingredients/subproblems/Subproblem.hpp"
 #include "ingredients/subproblems/SubproblemFactory.hpp"
+#include "linear_algebra/SparseKernels.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "model/Model.hpp"
 #include "optimization/Iterate.hpp"
@@ -62,20 +63,29 @@ namespace uno {
       };
    }
 
+   // linearized constraint violation "‖c(x) + ∇c(x)^T (αd)‖", computed without forming the linearized constraints
+   double ConstraintRelaxationStrategy::compute_linearized_constraint_violation(const Iterate& current_iterate, const Vector<double>& primal_direction,
+         double step_length, Norm norm) const {
+      return linearized_residual_norm(norm, current_iterate.evaluations.constraints, step_length, current_iterate.evaluations.constraint_jacobian,
+            primal_direction, [&](double constraint_value, size_t constraint_index) {
+         return this->model.constraint_violation(constraint_value, constraint_index);
+      });
+   }
+
    double ConstraintRelaxationStrategy::compute_predicted_infeasibility_reduction_model(const Iterate& current_iterate,
          const Vector<double>& primal_direction, double step_length) const {
       // predicted infeasibility reduction: "‖c(x)‖ - ‖c(x) + ∇c(x)^T (αd)‖"
       const double current_constraint_violation = this->model.constraint_violation(current_iterate.evaluations.constraints, this->progress_norm);
-      const double trial_linearized_constraint_violation = this->model.constraint_violation(current_iterate.evaluations.constraints + step_length *
-                                                                                                                                      (current_iterate.evaluations.constraint_jacobian * primal_direction), this->progress_norm);
+      const double trial_linearized_constraint_violation = this->compute_linearized_constraint_violation(current_iterate, primal_direction,
+            step_length, this->progress_norm);
       return current_constraint_violation - trial_linearized_constraint_violation;
    }
 
    std::function<double(double)> ConstraintRelaxationStrategy::compute_predicted_objective_reduction_model(const Iterate& current_iterate,
-         const Vector<double>& primal_direction, double step_length, const SymmetricMatrix<size_t, double>& hessian) const {
-      // predicted objective reduction: "-∇f(x)^T (αd) - α^2/2 d^T H d"
+         const Vector<double>& primal_direction, double step_length, const HessianModel& hessian_model) {
+      // predicted objective reduction: "-∇f(x)^T (αd) - α^2/2 d^T H d" (H includes the low-rank correction of the quasi-Newton models)
       const double directional_derivative = dot(primal_direction, current_iterate.evaluations.objective_gradient);
-      const double quadratic_term = hessian.quadratic_product(primal_direction, primal_direction);
+      const double quadratic_term = hessian_model.quadratic_product(primal_direction);
       return [=](double objective_multiplier) {
          return step_length * (-objective_multiplier*directional_derivative) - step_length*step_length/2. * quadratic_term;
       };
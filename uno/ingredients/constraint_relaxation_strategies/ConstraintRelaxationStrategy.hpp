@@ -5,6 +5,7 @@
 #define UNO_CONSTRAINTRELAXATIONSTRATEGY_H
 
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include "linear_algebra/Norm.hpp"
 #include "optimization/TerminationStatus.hpp"
@@ -13,6 +14,7 @@ namespace uno {
    // forward declarations
    class Direction;
    class GlobalizationStrategy;
+   class HessianModel;
    class Iterate;
    template <typename ElementType>
    class LagrangianGradient;
@@ -22,8 +24,6 @@ namespace uno {
    class Options;
    class Statistics;
    class Subproblem;
-   template <typename IndexType, typename ElementType>
-   class SymmetricMatrix;
    template <typename ElementType>
    class Vector;
    struct WarmstartInformation;
@@ -60,6 +60,10 @@ namespace uno {
       [[nodiscard]] size_t get_hessian_evaluation_count() const;
       [[nodiscard]] size_t get_number_subproblems_solved() const;
 
+      // second-order predicted objective reduction as a function of the objective multiplier
+      [[nodiscard]] static std::function<double(double)> compute_predicted_objective_reduction_model(const Iterate& current_iterate,
+            const Vector<double>& primal_direction, double step_length, const HessianModel& hessian_model);
+
    protected:
       const Model& model;
       const std::unique_ptr<GlobalizationStrategy> globalization_strategy;
@@ -77,10 +81,10 @@ namespace uno {
 
       void set_objective_measure(Iterate& iterate) const;
       void set_infeasibility_measure(Iterate& iterate) const;
+      [[nodiscard]] double compute_linearized_constraint_violation(const Iterate& current_iterate, const Vector<double>& primal_direction,
+            double step_length, Norm norm) const;
       [[nodiscard]] double compute_predicted_infeasibility_reduction_model(const Iterate& current_iterate, const Vector<double>& primal_direction,
             double step_length) const;
-      [[nodiscard]] std::function<double(double)> compute_predicted_objective_reduction_model(const Iterate& current_iterate,
-            const Vector<double>& primal_direction, double step_length, const SymmetricMatrix<size_t, double>& hessian) const;
       [[nodiscard]] std::function<double(double)> compute_predicted_objective_reduction_model(const Iterate& current_iterate,
             const Vector<double>& primal_direction, double step_length) const;
       void compute_progress_measures(Iterate& current_iterate, Iterate& trial_iterate);
@@ -134,8 +134,8 @@ namespace uno {
          double step_length) {
       return this->globalization_strategy->is_infeasibility_sufficiently_reduced(this->reference_optimality_progress, trial_iterate.progress) &&
          (not this->switch_to_optimality_requires_linearized_feasibility ||
-         this->model.constraint_violation(current_iterate.evaluations.constraints + step_length*(current_iterate.evaluations.constraint_jacobian *
-         direction.primals), this->residual_norm) <= this->linear_feasibility_tolerance);
+         this->compute_linearized_constraint_violation(current_iterate, direction.primals, step_length, this->residual_norm) <=
+         this->linear_feasibility_tolerance);
    }
 
    void FeasibilityRestoration::switch_to_optimality_phase(Iterate& current_iterate, Iterate& trial_iterate) {
@@ -205,7 +205,7 @@ namespace uno {
       return {
          this->compute_predicted_infeasibility_reduction_model(current_iterate, direction.primals, step_length),
          this->first_order_predicted_reduction ? this->compute_predicted_objective_reduction_model(current_iterate, direction.primals, step_length) :
-            this->compute_predicted_objective_reduction_model(current_iterate, direction.primals, step_length, this->subproblem->get_lagrangian_hessian()),
+            this->compute_predicted_objective_reduction_model(current_iterate, direction.primals, step_length, this->subproblem->get_hessian_model()),
          this->subproblem->compute_predicted_auxiliary_reduction_model(this->model, current_iterate, direction.primals, step_length)
       };
    }
@@ -93,8 +93,7 @@ namespace uno {
 
       // penalty update: if penalty parameter is already 0 or fixed by the user, no need to decrease it
       if (0. < this->penalty_parameter && not this->parameters.fixed_parameter) {
-         double linearized_residual = this->model.constraint_violation(current_iterate.evaluations.constraints +
-               current_iterate.evaluations.constraint_jacobian * direction.primals, Norm::L1);
+         double linearized_residual = this->compute_linearized_constraint_violation(current_iterate, direction.primals, 1., Norm::L1);
          DEBUG << "Linearized infeasibility mk(dk): " << linearized_residual << "\n\n";
 
          // if the current direction is already feasible, terminate
@@ -108,8 +107,8 @@ namespace uno {
             this->solve_subproblem(statistics, this->feasibility_problem, current_iterate, current_iterate.feasibility_multipliers, feasibility_direction,
                   warmstart_information);
             std::swap(direction.multipliers, direction.feasibility_multipliers);
-            const double residual_lowest_violation = this->model.constraint_violation(current_iterate.evaluations.constraints +
-                  current_iterate.evaluations.constraint_jacobian * feasibility_direction.primals, Norm::L1);
+            const double residual_lowest_violation = this->compute_linearized_constraint_violation(current_iterate, feasibility_direction.primals, 1.,
+                  Norm::L1);
             DEBUG << "Lowest linearized infeasibility mk(dk): " << residual_lowest_violation << '\n';
             this->subproblem->exit_feasibility_problem(this->feasibility_problem, current_iterate);
 
@@ -117,8 +116,7 @@ namespace uno {
             this->decrease_parameter_aggressively(current_iterate, feasibility_direction);
             if (this->penalty_parameter < current_penalty_parameter) {
                this->solve_l1_relaxed_problem(statistics, current_iterate, direction, this->penalty_parameter, warmstart_information);
-               linearized_residual = this->model.constraint_violation(current_iterate.evaluations.constraints +
-                     current_iterate.evaluations.constraint_jacobian * direction.primals, Norm::L1);
+               linearized_residual = this->compute_linearized_constraint_violation(current_iterate, direction.primals, 1., Norm::L1);
             }
 
             // stage d: further decrease penalty parameter to reach a fraction of the ideal decrease
@@ -193,8 +191,7 @@ namespace uno {
          this->solve_l1_relaxed_problem(statistics, current_iterate, direction, this->penalty_parameter, warmstart_information);
 
          // recompute the linearized residual
-         linearized_residual = this->model.constraint_violation(current_iterate.evaluations.constraints +
-               current_iterate.evaluations.constraint_jacobian * direction.primals, Norm::L1);
+         linearized_residual = this->compute_linearized_constraint_violation(current_iterate, direction.primals, 1., Norm::L1);
          DEBUG << "Linearized infeasibility mk(dk): " << linearized_residual << "\n\n";
       }
       DEBUG << "Condition enforce_linearized_residual_sufficient_decrease is true\n";
@@ -272,7 +269,7 @@ namespace uno {
       return {
          this->compute_predicted_infeasibility_reduction_model(current_iterate, direction.primals, step_length),
          this->first_order_predicted_reduction ? this->compute_predicted_objective_reduction_model(current_iterate, direction.primals, step_length) :
-            this->compute_predicted_objective_reduction_model(current_iterate, direction.primals, step_length, this->subproblem->get_lagrangian_hessian()),
+            this->compute_predicted_objective_reduction_model(current_iterate, direction.primals, step_length, this->subproblem->get_hessian_model()),
          this->subproblem->compute_predicted_auxiliary_reduction_model(this->model, current_iterate, direction.primals, step_length)
       };
    }
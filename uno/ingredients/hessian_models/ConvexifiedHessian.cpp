@@ -20,6 +20,9 @@ namespace uno {
          regularization_initial_value(options.get_double("regularization_initial_value")),
          regularization_increase_factor(options.get_double("regularization_increase_factor")),
          regularization_failure_threshold(options.get_double("regularization_failure_threshold")) {
+      if (not this->linear_solver->provides_inertia()) {
+         throw std::invalid_argument("The convexified Hessian model requires a linear solver that provides the inertia");
+      }
    }
 
    void ConvexifiedHessian::evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
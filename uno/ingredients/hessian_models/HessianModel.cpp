@@ -2,6 +2,9 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include "HessianModel.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/Iterate.hpp"
 
 namespace uno {
    HessianModel::HessianModel(size_t dimension, size_t maximum_number_nonzeros, const std::string& sparse_format, bool use_regularization) :
@@ -9,4 +12,17 @@ namespace uno {
    }
 
    HessianModel::~HessianModel() { }
+
+   void HessianModel::evaluate(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Vector<double>& constraint_multipliers) {
+      this->evaluate(statistics, problem, current_iterate.primals, constraint_multipliers);
+   }
+
+   double HessianModel::quadratic_product(const Vector<double>& x) const {
+      double result = this->hessian.quadratic_product(x, x);
+      if (const LowRankCorrection<double>* hessian_correction = this->low_rank_correction(); hessian_correction != nullptr) {
+         result += hessian_correction->quadratic_product(x);
+      }
+      return result;
+   }
 } // namespace
\ No newline at end of file
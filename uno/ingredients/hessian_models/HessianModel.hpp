@@ -10,10 +10,13 @@
 
 namespace uno {
    // forward declarations
+   class Iterate;
    class OptimizationProblem;
    class Statistics;
    template <typename ElementType>
    class Vector;
+   template <typename ElementType>
+   class LowRankCorrection;
 
    class HessianModel {
    public:
@@ -25,6 +28,15 @@ namespace uno {
 
       virtual void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
             const Vector<double>& constraint_multipliers) = 0;
+      // evaluation at an iterate: the models that need first-order information take the derivatives cached in the iterate
+      virtual void evaluate(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+            const Vector<double>& constraint_multipliers);
+      // quasi-Newton models in compact form: the Hessian is "hessian" plus a low-rank correction (nullptr if none)
+      [[nodiscard]] virtual const LowRankCorrection<double>* low_rank_correction() const { return nullptr; }
+      // x^T B x, including the low-rank correction
+      [[nodiscard]] double quadratic_product(const Vector<double>& x) const;
+      // the subproblem signals each primal direction it computed (used by the models that monitor the acceptance of the steps)
+      virtual void notify_primal_direction(const Vector<double>& /*primal_direction*/, size_t /*number_variables*/) { }
    };
 } // namespace
 
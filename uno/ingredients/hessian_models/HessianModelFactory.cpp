@@ -5,19 +5,37 @@
 #include "HessianModel.hpp"
 #include "ConvexifiedHessian.hpp"
 #include "ExactHessian.hpp"
+#include "LBFGSHessian.hpp"
+#include "PartitionedQuasiNewtonHessian.hpp"
+#include "ReusedHessian.hpp"
 #include "ZeroHessian.hpp"
+#include "options/Options.hpp"
 #include "solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 
 namespace uno {
    std::unique_ptr<HessianModel> HessianModelFactory::create(const std::string& hessian_model, size_t dimension, size_t maximum_number_nonzeros,
          bool convexify, const Options& options) {
       if (hessian_model == "exact") {
+         std::unique_ptr<HessianModel> exact_hessian;
          if (convexify) {
-            return std::make_unique<ConvexifiedHessian>(dimension, maximum_number_nonzeros + dimension, options);
+            exact_hessian = std::make_unique<ConvexifiedHessian>(dimension, maximum_number_nonzeros + dimension, options);
          }
          else {
-            return std::make_unique<ExactHessian>(dimension, maximum_number_nonzeros, options);
+            exact_hessian = std::make_unique<ExactHessian>(dimension, maximum_number_nonzeros, options);
          }
+         // reuse the Hessian (and its convexification) over several iterations
+         if (options.get_bool("hessian_reuse")) {
+            return std::make_unique<ReusedHessian>(std::move(exact_hessian), options);
+         }
+         return exact_hessian;
+      }
+      else if (hessian_model == "LBFGS") {
+         // the approximation is positive definite: no convexification is needed
+         return std::make_unique<LBFGSHessian>(dimension, options);
+      }
+      else if (hessian_model == "partitioned") {
+         // the element matrices may be indefinite: the inertia is corrected by the subproblem
+         return std::make_unique<PartitionedQuasiNewtonHessian>(dimension, maximum_number_nonzeros, options);
       }
       else if (hessian_model == "zero") {
          return std::make_unique<ZeroHessian>(dimension, options);
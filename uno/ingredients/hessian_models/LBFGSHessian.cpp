@@ -0,0 +1,219 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+#include "LBFGSHessian.hpp"
+#include "linear_algebra/SparseKernels.hpp"
+#include "model/Model.hpp"
+#include "optimization/Iterate.hpp"
+#include "reformulation/OptimizationProblem.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   LBFGSHessian::LBFGSHessian(size_t dimension, const Options& options) :
+         // diagonal δI and diagonal terms added by the subproblem (e.g. barrier terms)
+         HessianModel(dimension, 2 * dimension, options.get_string("sparse_format"), /* use_regularization = */false),
+         memory_size(options.get_unsigned_int("quasi_newton_memory_size")),
+         damping_threshold(options.get_double("quasi_newton_damping_threshold")),
+         skip_tolerance(options.get_double("quasi_newton_skip_tolerance")),
+         previous_primals(dimension),
+         previous_objective_gradient(dimension),
+         current_objective_gradient(dimension),
+         s(dimension),
+         y(dimension) {
+      if (this->memory_size == 0) {
+         throw std::invalid_argument("The option quasi_newton_memory_size should be positive");
+      }
+   }
+
+   void LBFGSHessian::evaluate(Statistics& /*statistics*/, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers) {
+      const Model& model = problem.model;
+      if (this->current_constraint_jacobian == nullptr) {
+         this->current_constraint_jacobian = std::make_unique<RectangularMatrix<double>>(model.number_constraints, model.number_variables);
+      }
+      // first-order information at the current point
+      this->current_objective_gradient.clear();
+      model.evaluate_objective_gradient(primal_variables, this->current_objective_gradient);
+      Iterate::number_eval_objective_gradient++;
+      this->current_constraint_jacobian->clear();
+      if (model.is_constrained()) {
+         model.evaluate_constraint_jacobian(primal_variables, *this->current_constraint_jacobian);
+         Iterate::number_eval_jacobian++;
+      }
+      this->update_with_gradients(problem, primal_variables, this->current_objective_gradient, *this->current_constraint_jacobian,
+            constraint_multipliers);
+   }
+
+   void LBFGSHessian::evaluate(Statistics& /*statistics*/, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Vector<double>& constraint_multipliers) {
+      // the derivatives at the current iterate are evaluated once and shared with the subproblem
+      current_iterate.evaluate_objective_gradient(problem.model);
+      current_iterate.evaluate_constraint_jacobian(problem.model);
+      this->update_with_gradients(problem, current_iterate.primals, current_iterate.evaluations.objective_gradient,
+            current_iterate.evaluations.constraint_jacobian, constraint_multipliers);
+   }
+
+   void LBFGSHessian::update_with_gradients(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const SparseVector<double>& objective_gradient, const RectangularMatrix<double>& constraint_jacobian,
+         const Vector<double>& constraint_multipliers) {
+      const Model& model = problem.model;
+      // the additional variables of the reformulations (e.g. elastics) do not enter the Hessian
+      this->number_variables = model.number_variables;
+      if (this->previous_constraint_jacobian == nullptr) {
+         this->previous_constraint_jacobian = std::make_unique<RectangularMatrix<double>>(model.number_constraints, model.number_variables);
+      }
+
+      // y = ∇L(x, λ) - ∇L(x_previous, λ) with the current multipliers
+      if (this->has_previous_point) {
+         for (size_t variable_index: Range(this->number_variables)) {
+            this->s[variable_index] = primal_variables[variable_index] - this->previous_primals[variable_index];
+         }
+         this->y.fill(0.);
+         const double objective_multiplier = problem.get_objective_multiplier();
+         this->compute_lagrangian_gradient(objective_multiplier, objective_gradient, constraint_jacobian, constraint_multipliers, 1., this->y);
+         this->compute_lagrangian_gradient(objective_multiplier, this->previous_objective_gradient, *this->previous_constraint_jacobian,
+               constraint_multipliers, -1., this->y);
+         this->update(this->s, this->y, this->number_variables);
+      }
+      for (size_t variable_index: Range(this->number_variables)) {
+         this->previous_primals[variable_index] = primal_variables[variable_index];
+      }
+      this->previous_objective_gradient.clear();
+      for (const auto [variable_index, derivative]: objective_gradient) {
+         this->previous_objective_gradient.insert(variable_index, derivative);
+      }
+      this->previous_constraint_jacobian->assign(constraint_jacobian);
+      this->has_previous_point = true;
+
+      // sparse part of the Hessian: δI on the original variables
+      this->hessian.set_dimension(problem.number_variables);
+      this->hessian.reset();
+      for (size_t variable_index: Range(problem.number_variables)) {
+         if (variable_index < this->number_variables) {
+            this->hessian.insert(this->delta, variable_index, variable_index);
+         }
+         this->hessian.finalize_column(variable_index);
+      }
+      this->evaluation_count++;
+   }
+
+   bool LBFGSHessian::update(const Vector<double>& s, Vector<double>& y, size_t number_variables) {
+      this->number_variables = number_variables;
+      double s_norm_squared = 0.;
+      for (size_t variable_index: Range(number_variables)) {
+         s_norm_squared += s[variable_index] * s[variable_index];
+      }
+      if (s_norm_squared == 0.) {
+         return false;
+      }
+
+      // Powell damping: y is moved towards B s so that s^T y >= θ s^T B s
+      Vector<double> Bs(number_variables);
+      this->compute_hessian_vector_product(s, Bs);
+      double sBs = 0., sy = 0.;
+      for (size_t variable_index: Range(number_variables)) {
+         sBs += s[variable_index] * Bs[variable_index];
+         sy += s[variable_index] * y[variable_index];
+      }
+      if (sy < this->damping_threshold * sBs) {
+         const double theta = (1. - this->damping_threshold) * sBs / (sBs - sy);
+         DEBUG << "L-BFGS: damping the pair with θ = " << theta << '\n';
+         for (size_t variable_index: Range(number_variables)) {
+            y[variable_index] = theta * y[variable_index] + (1. - theta) * Bs[variable_index];
+         }
+         sy = 0.;
+         for (size_t variable_index: Range(number_variables)) {
+            sy += s[variable_index] * y[variable_index];
+         }
+      }
+      // skip the pair if the curvature is too small
+      double y_norm_squared = 0.;
+      for (size_t variable_index: Range(number_variables)) {
+         y_norm_squared += y[variable_index] * y[variable_index];
+      }
+      if (sy <= this->skip_tolerance * std::sqrt(s_norm_squared * y_norm_squared)) {
+         DEBUG << "L-BFGS: skipping the pair (s^T y = " << sy << ")\n";
+         return false;
+      }
+
+      // store the pair
+      if (this->s_history.size() == this->memory_size) {
+         this->s_history.pop_front();
+         this->y_history.pop_front();
+      }
+      Vector<double> new_s(number_variables), new_y(number_variables);
+      for (size_t variable_index: Range(number_variables)) {
+         new_s[variable_index] = s[variable_index];
+         new_y[variable_index] = y[variable_index];
+      }
+      this->s_history.emplace_back(std::move(new_s));
+      this->y_history.emplace_back(std::move(new_y));
+      this->delta = y_norm_squared / sy;
+      this->compute_compact_representation();
+      return true;
+   }
+
+   // result = δx - Ψ N^{-1} Ψ^T x on the original variables
+   void LBFGSHessian::compute_hessian_vector_product(const Vector<double>& x, Vector<double>& result) const {
+      for (size_t variable_index: Range(this->number_variables)) {
+         result[variable_index] = this->delta * x[variable_index];
+      }
+      this->correction.add_product(x, result);
+   }
+
+   void LBFGSHessian::compute_compact_representation() {
+      const size_t number_pairs = this->s_history.size();
+      const size_t n = this->number_variables;
+      const size_t rank = 2 * number_pairs;
+      // basis Ψ = [δS Y]
+      std::vector<double> basis(n * rank);
+      for (size_t pair_index = 0; pair_index < number_pairs; pair_index++) {
+         double* s_column = basis.data() + pair_index * n;
+         double* y_column = basis.data() + (number_pairs + pair_index) * n;
+         for (size_t variable_index = 0; variable_index < n; variable_index++) {
+            s_column[variable_index] = this->delta * this->s_history[pair_index][variable_index];
+            y_column[variable_index] = this->y_history[pair_index][variable_index];
+         }
+      }
+      // middle matrix N = [δS^T S  L; L^T  -D]
+      std::vector<double> middle_matrix(rank * rank, 0.);
+      const auto entry = [&](size_t row_index, size_t column_index) -> double& {
+         return middle_matrix[column_index * rank + row_index];
+      };
+      for (size_t i = 0; i < number_pairs; i++) {
+         const Vector<double>& s_i = this->s_history[i];
+         for (size_t j = 0; j <= i; j++) {
+            const Vector<double>& s_j = this->s_history[j];
+            const Vector<double>& y_j = this->y_history[j];
+            double ss = 0., sy = 0.;
+            for (size_t variable_index = 0; variable_index < n; variable_index++) {
+               ss += s_i[variable_index] * s_j[variable_index];
+               sy += s_i[variable_index] * y_j[variable_index];
+            }
+            entry(i, j) = entry(j, i) = this->delta * ss;
+            if (j < i) { // L_ij = s_i^T y_j
+               entry(number_pairs + j, i) = entry(i, number_pairs + j) = sy;
+            }
+            else { // -D
+               entry(number_pairs + i, number_pairs + i) = -sy;
+            }
+         }
+      }
+      this->correction.set(n, rank, std::move(basis), std::move(middle_matrix));
+   }
+
+   // result += sign * (σ ∇f - J^T λ)
+   void LBFGSHessian::compute_lagrangian_gradient(double objective_multiplier, const SparseVector<double>& objective_gradient,
+         const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& constraint_multipliers, double sign, Vector<double>& result) const {
+      if (objective_multiplier != 0.) {
+         for (const auto [variable_index, derivative]: objective_gradient) {
+            result[variable_index] += sign * objective_multiplier * derivative;
+         }
+      }
+      transposed_matrix_vector_product(constraint_jacobian, constraint_multipliers, -sign, result);
+   }
+} // namespace
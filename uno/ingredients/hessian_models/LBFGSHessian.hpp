@@ -0,0 +1,73 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_LBFGSHESSIAN_H
+#define UNO_LBFGSHESSIAN_H
+
+#include <deque>
+#include <memory>
+#include "HessianModel.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   // limited-memory BFGS approximation of the Lagrangian Hessian in compact form (Byrd, Nocedal and Schnabel, 1994):
+   //    B = δI - Ψ N^{-1} Ψ^T with Ψ = [δS Y] and N = [δS^T S  L; L^T  -D]
+   // where S and Y store the last pairs (s, y), L is the strictly lower triangular part of S^T Y and D its diagonal.
+   // The sparse matrix "hessian" holds the diagonal δI, the low-rank correction is exposed separately: the memory and the cost
+   // of an update grow with the number of pairs, not with the number of nonzeros of the exact Hessian.
+   // Safeguards: Powell damping of y when s^T y < θ s^T B s, then the pair is skipped if the curvature s^T y is not positive enough
+   class LBFGSHessian : public HessianModel {
+   public:
+      LBFGSHessian(size_t dimension, const Options& options);
+
+      void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers) override;
+      void evaluate(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+            const Vector<double>& constraint_multipliers) override;
+      [[nodiscard]] const LowRankCorrection<double>* low_rank_correction() const override { return &this->correction; }
+
+      // update with the pair (s, y) on the first number_variables variables. Returns false if the pair was skipped
+      bool update(const Vector<double>& s, Vector<double>& y, size_t number_variables);
+      // result = B x
+      void compute_hessian_vector_product(const Vector<double>& x, Vector<double>& result) const;
+      [[nodiscard]] double get_diagonal() const { return this->delta; }
+      [[nodiscard]] size_t number_pairs() const { return this->s_history.size(); }
+
+   protected:
+      const size_t memory_size;
+      const double damping_threshold;
+      const double skip_tolerance;
+      size_t number_variables{0};
+      double delta{1.}; // scaling of the identity
+      std::deque<Vector<double>> s_history{};
+      std::deque<Vector<double>> y_history{};
+      LowRankCorrection<double> correction{};
+
+      // information at the previous point
+      bool has_previous_point{false};
+      Vector<double> previous_primals;
+      SparseVector<double> previous_objective_gradient;
+      // allocated at the first evaluation (the number of constraints is not known before)
+      std::unique_ptr<RectangularMatrix<double>> previous_constraint_jacobian{};
+      // first-order information evaluated by the model when no iterate is available
+      SparseVector<double> current_objective_gradient;
+      std::unique_ptr<RectangularMatrix<double>> current_constraint_jacobian{};
+      Vector<double> s;
+      Vector<double> y;
+
+      void update_with_gradients(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const SparseVector<double>& objective_gradient, const RectangularMatrix<double>& constraint_jacobian,
+            const Vector<double>& constraint_multipliers);
+      void compute_compact_representation();
+      void compute_lagrangian_gradient(double objective_multiplier, const SparseVector<double>& objective_gradient,
+            const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& constraint_multipliers, double sign, Vector<double>& result) const;
+   };
+} // namespace
+
+#endif // UNO_LBFGSHESSIAN_H
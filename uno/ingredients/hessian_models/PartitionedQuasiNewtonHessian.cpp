@@ -0,0 +1,380 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include "PartitionedQuasiNewtonHessian.hpp"
+#include "optimization/Iterate.hpp"
+#include "reformulation/OptimizationProblem.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   ElementUpdate element_update_from_string(const std::string& element_update) {
+      if (element_update == "BFGS") {
+         return ElementUpdate::BFGS;
+      }
+      else if (element_update == "SR1") {
+         return ElementUpdate::SR1;
+      }
+      throw std::invalid_argument("The quasi-Newton element update " + element_update + " is not known");
+   }
+
+   PartitionedQuasiNewtonHessian::PartitionedQuasiNewtonHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options) :
+         HessianModel(dimension, maximum_number_nonzeros, options.get_string("sparse_format"), /* use_regularization = */false),
+         element_update(element_update_from_string(options.get_string("quasi_newton_element_update"))),
+         damping_threshold(options.get_double("quasi_newton_damping_threshold")),
+         skip_tolerance(options.get_double("quasi_newton_skip_tolerance")),
+         previous_primals(dimension),
+         previous_objective_gradient(dimension),
+         current_objective_gradient(dimension),
+         gradient_difference(dimension) {
+   }
+
+   void PartitionedQuasiNewtonHessian::evaluate(Statistics& /*statistics*/, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers) {
+      const bool first_evaluation = not this->is_initialized;
+      if (first_evaluation) {
+         // exact Hessian at the first point: its pattern is kept in the subsequent evaluations
+         this->initialize(problem, primal_variables, constraint_multipliers);
+      }
+      this->evaluate_first_order_information(problem.model, primal_variables);
+      this->update(problem, primal_variables, constraint_multipliers, first_evaluation);
+   }
+
+   void PartitionedQuasiNewtonHessian::evaluate(Statistics& /*statistics*/, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Vector<double>& constraint_multipliers) {
+      const bool first_evaluation = not this->is_initialized;
+      if (first_evaluation) {
+         this->initialize(problem, current_iterate.primals, constraint_multipliers);
+      }
+      // the derivatives at the current iterate are evaluated once and shared with the subproblem
+      current_iterate.evaluate_objective_gradient(problem.model);
+      current_iterate.evaluate_constraint_jacobian(problem.model);
+      this->current_objective_gradient.clear();
+      for (const auto [variable_index, derivative]: current_iterate.evaluations.objective_gradient) {
+         this->current_objective_gradient.insert(variable_index, derivative);
+      }
+      this->current_constraint_jacobian->assign(current_iterate.evaluations.constraint_jacobian);
+      this->update(problem, current_iterate.primals, constraint_multipliers, first_evaluation);
+   }
+
+   void PartitionedQuasiNewtonHessian::update(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers, bool first_evaluation) {
+      if (not first_evaluation) {
+         this->update_elements(primal_variables);
+      }
+      std::swap(this->previous_objective_gradient, this->current_objective_gradient);
+      std::swap(this->previous_constraint_jacobian, this->current_constraint_jacobian);
+      if (not first_evaluation) {
+         this->assemble(problem, constraint_multipliers);
+      }
+      for (size_t variable_index: Range(problem.model.number_variables)) {
+         this->previous_primals[variable_index] = primal_variables[variable_index];
+      }
+      this->evaluation_count++;
+   }
+
+   std::vector<PartitionedQuasiNewtonHessian::Element> PartitionedQuasiNewtonHessian::merge_elements(
+         const std::vector<ElementFunction>& element_functions, size_t number_variables) {
+      // order the elements by function
+      std::vector<size_t> order(element_functions.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(), order.end(), [&](size_t index1, size_t index2) {
+         return element_functions[index1].constraint_index < element_functions[index2].constraint_index;
+      });
+
+      // union-find on the elements of each function: two elements that share a variable are merged
+      std::vector<size_t> parent(element_functions.size());
+      std::iota(parent.begin(), parent.end(), 0);
+      const auto find = [&](size_t index) {
+         while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+         }
+         return index;
+      };
+      constexpr size_t no_owner = std::numeric_limits<size_t>::max();
+      std::vector<size_t> owner(number_variables, no_owner);
+      std::vector<Element> merged_elements{};
+      size_t start = 0;
+      while (start < order.size()) {
+         const size_t constraint_index = element_functions[order[start]].constraint_index;
+         size_t end = start;
+         while (end < order.size() && element_functions[order[end]].constraint_index == constraint_index) {
+            end++;
+         }
+         for (size_t position: Range(start, end)) {
+            const size_t element_index = order[position];
+            for (size_t variable_index: element_functions[element_index].variables) {
+               if (owner[variable_index] == no_owner) {
+                  owner[variable_index] = element_index;
+               }
+               else {
+                  parent[find(element_index)] = find(owner[variable_index]);
+               }
+            }
+         }
+         // gather the variables of each merged element
+         std::unordered_map<size_t, size_t> merged_element_of_root{};
+         for (size_t position: Range(start, end)) {
+            const size_t element_index = order[position];
+            const size_t root = find(element_index);
+            auto [iterator, inserted] = merged_element_of_root.try_emplace(root, merged_elements.size());
+            if (inserted) {
+               merged_elements.push_back({constraint_index});
+            }
+            Element& element = merged_elements[iterator->second];
+            const std::vector<size_t>& variables = element_functions[element_index].variables;
+            element.variables.insert(element.variables.end(), variables.begin(), variables.end());
+         }
+         for (size_t position: Range(start, end)) {
+            for (size_t variable_index: element_functions[order[position]].variables) {
+               owner[variable_index] = no_owner;
+            }
+         }
+         start = end;
+      }
+
+      // the element matrices are initialized with the identity
+      for (Element& element: merged_elements) {
+         std::sort(element.variables.begin(), element.variables.end());
+         element.variables.erase(std::unique(element.variables.begin(), element.variables.end()), element.variables.end());
+         const size_t element_size = element.variables.size();
+         element.matrix.assign(element_size * element_size, 0.);
+         for (size_t index: Range(element_size)) {
+            element.matrix[index * element_size + index] = 1.;
+         }
+         element.positions.assign(element_size * element_size, NOT_IN_PATTERN);
+      }
+      return merged_elements;
+   }
+
+   bool PartitionedQuasiNewtonHessian::update_element(Element& element, const std::vector<double>& s, std::vector<double>& y) const {
+      const size_t element_size = element.variables.size();
+      // B s (B is symmetric)
+      std::vector<double> Bs(element_size, 0.);
+      double s_norm_squared = 0.;
+      for (size_t column_index: Range(element_size)) {
+         const double* column = element.matrix.data() + column_index * element_size;
+         for (size_t row_index: Range(element_size)) {
+            Bs[row_index] += column[row_index] * s[column_index];
+         }
+         s_norm_squared += s[column_index] * s[column_index];
+      }
+      if (s_norm_squared == 0.) {
+         return false;
+      }
+
+      if (this->element_update == ElementUpdate::SR1) {
+         // B+ = B + r r^T / r^T s with r = y - B s. The update is skipped when r^T s is small
+         double rs = 0., r_norm_squared = 0.;
+         for (size_t index: Range(element_size)) {
+            y[index] -= Bs[index];
+            rs += y[index] * s[index];
+            r_norm_squared += y[index] * y[index];
+         }
+         if (r_norm_squared == 0. || std::abs(rs) <= this->skip_tolerance * std::sqrt(s_norm_squared * r_norm_squared)) {
+            return false;
+         }
+         for (size_t column_index: Range(element_size)) {
+            double* column = element.matrix.data() + column_index * element_size;
+            for (size_t row_index: Range(element_size)) {
+               column[row_index] += y[row_index] * y[column_index] / rs;
+            }
+         }
+         return true;
+      }
+      else {
+         // B+ = B - B s s^T B / s^T B s + y y^T / s^T y with Powell damping of y
+         double sBs = 0., sy = 0.;
+         for (size_t index: Range(element_size)) {
+            sBs += s[index] * Bs[index];
+            sy += s[index] * y[index];
+         }
+         if (sy < this->damping_threshold * sBs) {
+            const double theta = (1. - this->damping_threshold) * sBs / (sBs - sy);
+            sy = 0.;
+            for (size_t index: Range(element_size)) {
+               y[index] = theta * y[index] + (1. - theta) * Bs[index];
+               sy += s[index] * y[index];
+            }
+         }
+         double y_norm_squared = 0.;
+         for (size_t index: Range(element_size)) {
+            y_norm_squared += y[index] * y[index];
+         }
+         if (sBs <= 0. || sy <= this->skip_tolerance * std::sqrt(s_norm_squared * y_norm_squared)) {
+            return false;
+         }
+         for (size_t column_index: Range(element_size)) {
+            double* column = element.matrix.data() + column_index * element_size;
+            for (size_t row_index: Range(element_size)) {
+               column[row_index] += -Bs[row_index] * Bs[column_index] / sBs + y[row_index] * y[column_index] / sy;
+            }
+         }
+         return true;
+      }
+   }
+
+   void PartitionedQuasiNewtonHessian::initialize(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers) {
+      const Model& model = problem.model;
+      std::vector<ElementFunction> element_functions{};
+      model.compute_element_functions(element_functions);
+      this->elements = PartitionedQuasiNewtonHessian::merge_elements(element_functions, model.number_variables);
+      this->current_constraint_jacobian = std::make_unique<RectangularMatrix<double>>(model.number_constraints, model.number_variables);
+      this->previous_constraint_jacobian = std::make_unique<RectangularMatrix<double>>(model.number_constraints, model.number_variables);
+
+      // exact Hessian (the elastics of the reformulations do not enter the Hessian)
+      this->hessian.set_dimension(problem.number_variables);
+      model.evaluate_lagrangian_hessian(primal_variables, problem.get_objective_multiplier(), constraint_multipliers, this->hessian);
+      for (size_t variable_index: Range(model.number_variables, problem.number_variables)) {
+         this->hessian.finalize_column(variable_index);
+      }
+
+      // pattern of the exact Hessian grouped by column (the order of the entries within a column is kept)
+      std::vector<std::pair<size_t, size_t>> entries{};
+      this->hessian.for_each_nonzero([&](size_t row_index, size_t column_index, double /*element*/) {
+         entries.emplace_back(row_index, column_index);
+      });
+      // the pattern only covers the variables of the model: the columns of the elastics are empty
+      this->pattern_column_starts.assign(model.number_variables + 1, 0);
+      for (const auto& [row_index, column_index]: entries) {
+         this->pattern_column_starts[column_index + 1]++;
+      }
+      std::partial_sum(this->pattern_column_starts.begin(), this->pattern_column_starts.end(), this->pattern_column_starts.begin());
+      std::vector<size_t> next_position(this->pattern_column_starts.begin(), this->pattern_column_starts.end() - 1);
+      this->pattern_row_indices.resize(entries.size());
+      std::unordered_map<size_t, size_t> position_of_entry{};
+      for (const auto& [row_index, column_index]: entries) {
+         const size_t position = next_position[column_index]++;
+         this->pattern_row_indices[position] = row_index;
+         const size_t key = std::min(row_index, column_index) * problem.number_variables + std::max(row_index, column_index);
+         position_of_entry.try_emplace(key, position);
+      }
+      this->pattern_values.resize(entries.size());
+
+      // positions of the element entries: the entries outside the exact pattern are dropped
+      size_t number_dropped_entries = 0;
+      for (Element& element: this->elements) {
+         const size_t element_size = element.variables.size();
+         for (size_t column_index: Range(element_size)) {
+            for (size_t row_index: Range(column_index + 1)) {
+               const size_t key = element.variables[row_index] * problem.number_variables + element.variables[column_index];
+               if (auto iterator = position_of_entry.find(key); iterator != position_of_entry.end()) {
+                  element.positions[column_index * element_size + row_index] = iterator->second;
+               }
+               else {
+                  number_dropped_entries++;
+               }
+            }
+         }
+      }
+      DEBUG << "Partitioned quasi-Newton Hessian: " << this->elements.size() << " elements, " << number_dropped_entries <<
+         " element entries outside the Hessian pattern\n";
+      this->is_initialized = true;
+   }
+
+   void PartitionedQuasiNewtonHessian::evaluate_first_order_information(const Model& model, const Vector<double>& primal_variables) {
+      this->current_objective_gradient.clear();
+      model.evaluate_objective_gradient(primal_variables, this->current_objective_gradient);
+      Iterate::number_eval_objective_gradient++;
+      this->current_constraint_jacobian->clear();
+      if (model.is_constrained()) {
+         model.evaluate_constraint_jacobian(primal_variables, *this->current_constraint_jacobian);
+         Iterate::number_eval_jacobian++;
+      }
+   }
+
+   // the elements of a function are consecutive: the gradient difference of the function is scattered once
+   void PartitionedQuasiNewtonHessian::update_elements(const Vector<double>& primal_variables) {
+      // apply function(variable_index, derivative, sign) to the nonzeros of the current and previous gradients of a function
+      const auto for_each_gradient_nonzero = [&](size_t constraint_index, const auto& function) {
+         if (constraint_index == ElementFunction::OBJECTIVE) {
+            for (const auto [variable_index, derivative]: this->current_objective_gradient) {
+               function(variable_index, derivative, 1.);
+            }
+            for (const auto [variable_index, derivative]: this->previous_objective_gradient) {
+               function(variable_index, derivative, -1.);
+            }
+         }
+         else {
+            for (const auto [variable_index, derivative]: (*this->current_constraint_jacobian)[constraint_index]) {
+               function(variable_index, derivative, 1.);
+            }
+            for (const auto [variable_index, derivative]: (*this->previous_constraint_jacobian)[constraint_index]) {
+               function(variable_index, derivative, -1.);
+            }
+         }
+      };
+
+      size_t number_updates = 0;
+      size_t start = 0;
+      while (start < this->elements.size()) {
+         const size_t constraint_index = this->elements[start].constraint_index;
+         for_each_gradient_nonzero(constraint_index, [&](size_t variable_index, double derivative, double sign) {
+            this->gradient_difference[variable_index] += sign * derivative;
+         });
+         size_t end = start;
+         while (end < this->elements.size() && this->elements[end].constraint_index == constraint_index) {
+            Element& element = this->elements[end];
+            const size_t element_size = element.variables.size();
+            this->element_s.resize(element_size);
+            this->element_y.resize(element_size);
+            for (size_t index: Range(element_size)) {
+               const size_t variable_index = element.variables[index];
+               this->element_s[index] = primal_variables[variable_index] - this->previous_primals[variable_index];
+               this->element_y[index] = this->gradient_difference[variable_index];
+            }
+            if (this->update_element(element, this->element_s, this->element_y)) {
+               number_updates++;
+            }
+            end++;
+         }
+         for_each_gradient_nonzero(constraint_index, [&](size_t variable_index, double /*derivative*/, double /*sign*/) {
+            this->gradient_difference[variable_index] = 0.;
+         });
+         start = end;
+      }
+      DEBUG << "Partitioned quasi-Newton Hessian: " << number_updates << " elements out of " << this->elements.size() << " were updated\n";
+   }
+
+   void PartitionedQuasiNewtonHessian::assemble(const OptimizationProblem& problem, const Vector<double>& constraint_multipliers) {
+      std::fill(this->pattern_values.begin(), this->pattern_values.end(), 0.);
+      const double objective_multiplier = problem.get_objective_multiplier();
+      for (const Element& element: this->elements) {
+         const double weight = (element.constraint_index == ElementFunction::OBJECTIVE) ? objective_multiplier :
+               -constraint_multipliers[element.constraint_index];
+         if (weight != 0.) {
+            const size_t element_size = element.variables.size();
+            for (size_t column_index: Range(element_size)) {
+               for (size_t row_index: Range(column_index + 1)) {
+                  const size_t position = element.positions[column_index * element_size + row_index];
+                  if (position != NOT_IN_PATTERN) {
+                     this->pattern_values[position] += weight * element.matrix[column_index * element_size + row_index];
+                  }
+               }
+            }
+         }
+      }
+
+      // same entries in the same order as the exact Hessian. The problem may have more variables (elastics) than the pattern
+      const size_t pattern_dimension = this->pattern_column_starts.size() - 1;
+      this->hessian.set_dimension(problem.number_variables);
+      this->hessian.reset();
+      for (size_t column_index: Range(problem.number_variables)) {
+         if (column_index < pattern_dimension) {
+            for (size_t position: Range(this->pattern_column_starts[column_index], this->pattern_column_starts[column_index + 1])) {
+               this->hessian.insert(this->pattern_values[position], this->pattern_row_indices[position], column_index);
+            }
+         }
+         this->hessian.finalize_column(column_index);
+      }
+   }
+} // namespace
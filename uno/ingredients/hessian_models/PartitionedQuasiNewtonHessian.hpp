@@ -0,0 +1,85 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_PARTITIONEDQUASINEWTONHESSIAN_H
+#define UNO_PARTITIONEDQUASINEWTONHESSIAN_H
+
+#include <limits>
+#include <memory>
+#include <vector>
+#include "HessianModel.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/Model.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   enum class ElementUpdate {BFGS, SR1};
+
+   // partitioned quasi-Newton approximation of the Lagrangian Hessian (Griewank and Toint, 1982):
+   //    B = σ Σ_{objective elements} B_e - Σ_j λ_j Σ_{elements of c_j} B_e
+   // where each B_e is a small dense matrix on the variables of the element, updated with the pair (s_e, y_e):
+   // s_e is the step restricted to the element and y_e the difference of the gradients of its function.
+   // The elements of a function that share variables are merged, so that y_e only depends on the element.
+   // The approximation is assembled in the sparsity pattern of the exact Hessian (obtained at the first evaluation, where the
+   // exact Hessian is used), which keeps the symbolic analysis of the linear solvers valid.
+   class PartitionedQuasiNewtonHessian : public HessianModel {
+   public:
+      PartitionedQuasiNewtonHessian(size_t dimension, size_t maximum_number_nonzeros, const Options& options);
+
+      void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers) override;
+      void evaluate(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+            const Vector<double>& constraint_multipliers) override;
+
+      struct Element {
+         size_t constraint_index; // index of the constraint, or ElementFunction::OBJECTIVE
+         std::vector<size_t> variables{};
+         std::vector<double> matrix{}; // dense, column-major
+         std::vector<size_t> positions{}; // position of the upper triangular entries in the Hessian pattern (column-major)
+      };
+
+      // merge the overlapping elements of the same function and sort the elements by function
+      static std::vector<Element> merge_elements(const std::vector<ElementFunction>& element_functions, size_t number_variables);
+      // update the element matrix with the pair (s, y). Returns false if the pair was skipped
+      bool update_element(Element& element, const std::vector<double>& s, std::vector<double>& y) const;
+      [[nodiscard]] const std::vector<Element>& get_elements() const { return this->elements; }
+
+   protected:
+      static constexpr size_t NOT_IN_PATTERN{std::numeric_limits<size_t>::max()};
+
+      const ElementUpdate element_update;
+      const double damping_threshold;
+      const double skip_tolerance;
+      std::vector<Element> elements{};
+      bool is_initialized{false};
+
+      // sparsity pattern of the exact Hessian, grouped by column
+      std::vector<size_t> pattern_column_starts{};
+      std::vector<size_t> pattern_row_indices{};
+      std::vector<double> pattern_values{};
+
+      // information at the previous point
+      Vector<double> previous_primals;
+      SparseVector<double> previous_objective_gradient;
+      SparseVector<double> current_objective_gradient;
+      // allocated at the first evaluation (the number of constraints is not known before)
+      std::unique_ptr<RectangularMatrix<double>> previous_constraint_jacobian{};
+      std::unique_ptr<RectangularMatrix<double>> current_constraint_jacobian{};
+      Vector<double> gradient_difference;
+      std::vector<double> element_s{};
+      std::vector<double> element_y{};
+
+      void initialize(const OptimizationProblem& problem, const Vector<double>& primal_variables, const Vector<double>& constraint_multipliers);
+      void evaluate_first_order_information(const Model& model, const Vector<double>& primal_variables);
+      void update(const OptimizationProblem& problem, const Vector<double>& primal_variables, const Vector<double>& constraint_multipliers,
+            bool first_evaluation);
+      void update_elements(const Vector<double>& primal_variables);
+      void assemble(const OptimizationProblem& problem, const Vector<double>& constraint_multipliers);
+   };
+} // namespace
+
+#endif // UNO_PARTITIONEDQUASINEWTONHESSIAN_H
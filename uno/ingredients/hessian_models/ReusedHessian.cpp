@@ -0,0 +1,138 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include "ReusedHessian.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/Iterate.hpp"
+#include "reformulation/OptimizationProblem.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   ReusedHessian::ReusedHessian(std::unique_ptr<HessianModel> hessian_model, const Options& options) :
+         HessianModel(hessian_model->hessian.dimension(), hessian_model->hessian.capacity(), options.get_string("sparse_format"),
+               /* use_regularization = */false),
+         hessian_model(std::move(hessian_model)),
+         maximum_age(options.get_unsigned_int("hessian_reuse_maximum_age")),
+         primal_threshold(options.get_double("hessian_reuse_primal_threshold")),
+         multiplier_threshold(options.get_double("hessian_reuse_multiplier_threshold")),
+         acceptance_threshold(options.get_double("hessian_reuse_acceptance_threshold")) {
+   }
+
+   void ReusedHessian::evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers) {
+      this->evaluate_or_reuse(problem, primal_variables, constraint_multipliers, [&]() {
+         this->hessian_model->evaluate(statistics, problem, primal_variables, constraint_multipliers);
+      });
+   }
+
+   void ReusedHessian::evaluate(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+         const Vector<double>& constraint_multipliers) {
+      this->evaluate_or_reuse(problem, current_iterate.primals, constraint_multipliers, [&]() {
+         this->hessian_model->evaluate(statistics, problem, current_iterate, constraint_multipliers);
+      });
+   }
+
+   void ReusedHessian::evaluate_or_reuse(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers, const std::function<void()>& evaluate_hessian_model) {
+      if (this->must_refresh(problem, primal_variables, constraint_multipliers)) {
+         evaluate_hessian_model();
+         this->evaluation_count = this->hessian_model->evaluation_count;
+         this->is_initialized = true;
+         this->age = 0;
+         this->reference_problem = &problem;
+         this->reference_objective_multiplier = problem.get_objective_multiplier();
+         this->reference_primals.assign(primal_variables.begin(), primal_variables.begin() + static_cast<std::ptrdiff_t>(problem.number_variables));
+         this->reference_multipliers.assign(constraint_multipliers.begin(),
+               constraint_multipliers.begin() + static_cast<std::ptrdiff_t>(problem.number_constraints));
+      }
+      else {
+         this->age++;
+         this->number_reuses++;
+         DEBUG << "The Hessian is reused (age " << this->age << ")\n";
+      }
+      // the subproblem modifies the Hessian (e.g. barrier terms): start from a copy of the Hessian of the underlying model
+      this->copy_hessian();
+      this->previous_primals.assign(primal_variables.begin(), primal_variables.begin() + static_cast<std::ptrdiff_t>(problem.number_variables));
+      this->number_directions = 0;
+   }
+
+   void ReusedHessian::notify_primal_direction(const Vector<double>& primal_direction, size_t number_variables) {
+      this->direction_norm = 0.;
+      for (size_t variable_index: Range(number_variables)) {
+         this->direction_norm = std::max(this->direction_norm, std::abs(primal_direction[variable_index]));
+      }
+      this->number_directions++;
+   }
+
+   // relative distance ||x - x_reference||_inf / max(1, ||x_reference||_inf)
+   template <typename Array>
+   double relative_distance(const Array& x, const std::vector<double>& reference) {
+      double distance = 0.;
+      double reference_norm = 1.;
+      for (size_t index: Range(reference.size())) {
+         distance = std::max(distance, std::abs(x[index] - reference[index]));
+         reference_norm = std::max(reference_norm, std::abs(reference[index]));
+      }
+      return distance / reference_norm;
+   }
+
+   bool ReusedHessian::must_refresh(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+         const Vector<double>& constraint_multipliers) const {
+      if (not this->is_initialized) {
+         return true;
+      }
+      if (&problem != this->reference_problem || problem.get_objective_multiplier() != this->reference_objective_multiplier ||
+            problem.number_variables != this->reference_primals.size() || problem.number_constraints != this->reference_multipliers.size()) {
+         DEBUG << "The Hessian is refreshed: the problem changed\n";
+         return true;
+      }
+      if (this->maximum_age <= this->age) {
+         DEBUG << "The Hessian is refreshed: maximum age reached\n";
+         return true;
+      }
+      const double primal_distance = relative_distance(primal_variables, this->reference_primals);
+      if (this->primal_threshold < primal_distance) {
+         DEBUG << "The Hessian is refreshed: the primals moved by " << primal_distance << '\n';
+         return true;
+      }
+      const double multiplier_distance = relative_distance(constraint_multipliers, this->reference_multipliers);
+      if (this->multiplier_threshold < multiplier_distance) {
+         DEBUG << "The Hessian is refreshed: the multipliers moved by " << multiplier_distance << '\n';
+         return true;
+      }
+      // acceptance of the last step
+      if (0 < this->number_directions && 0. < this->direction_norm) {
+         double step_norm = 0.;
+         for (size_t variable_index: Range(this->previous_primals.size())) {
+            step_norm = std::max(step_norm, std::abs(primal_variables[variable_index] - this->previous_primals[variable_index]));
+         }
+         const double acceptance_ratio = step_norm / (this->direction_norm * static_cast<double>(this->number_directions));
+         if (acceptance_ratio < this->acceptance_threshold) {
+            DEBUG << "The Hessian is refreshed: acceptance ratio " << acceptance_ratio << '\n';
+            return true;
+         }
+      }
+      return false;
+   }
+
+   void ReusedHessian::copy_hessian() {
+      const SymmetricMatrix<size_t, double>& source = this->hessian_model->hessian;
+      this->hessian.set_dimension(source.dimension());
+      this->hessian.reset();
+      size_t current_column = 0;
+      source.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+         while (current_column < column_index) {
+            this->hessian.finalize_column(current_column);
+            current_column++;
+         }
+         this->hessian.insert(element, row_index, column_index);
+      });
+      while (current_column < source.dimension()) {
+         this->hessian.finalize_column(current_column);
+         current_column++;
+      }
+   }
+} // namespace
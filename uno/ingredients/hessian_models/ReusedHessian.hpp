@@ -0,0 +1,63 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_REUSEDHESSIAN_H
+#define UNO_REUSEDHESSIAN_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+#include "HessianModel.hpp"
+
+namespace uno {
+   // forward declaration
+   class Options;
+
+   // wrapper that reuses the Hessian of another model (and the inertia correction it may contain) over several iterations.
+   // The Hessian is refreshed when:
+   // - it is older than the maximum age;
+   // - the primals or the multipliers moved too far (relative infinity norm) from the point where it was evaluated;
+   // - the steps were poorly accepted: the ratio between the accepted step and the last direction, divided by the number of
+   //   directions computed since the last evaluation (trust-region rejections), is below a threshold;
+   // - the problem changed (e.g. the feasibility problem is solved)
+   class ReusedHessian : public HessianModel {
+   public:
+      ReusedHessian(std::unique_ptr<HessianModel> hessian_model, const Options& options);
+
+      void evaluate(Statistics& statistics, const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers) override;
+      void evaluate(Statistics& statistics, const OptimizationProblem& problem, Iterate& current_iterate,
+            const Vector<double>& constraint_multipliers) override;
+      [[nodiscard]] const LowRankCorrection<double>* low_rank_correction() const override { return this->hessian_model->low_rank_correction(); }
+      void notify_primal_direction(const Vector<double>& primal_direction, size_t number_variables) override;
+
+      size_t number_reuses{0};
+
+   protected:
+      const std::unique_ptr<HessianModel> hessian_model;
+      const size_t maximum_age;
+      const double primal_threshold;
+      const double multiplier_threshold;
+      const double acceptance_threshold;
+
+      // state at the last evaluation of the underlying model
+      bool is_initialized{false};
+      size_t age{0};
+      const OptimizationProblem* reference_problem{nullptr};
+      double reference_objective_multiplier{0.};
+      std::vector<double> reference_primals{};
+      std::vector<double> reference_multipliers{};
+      // acceptance of the steps
+      std::vector<double> previous_primals{};
+      double direction_norm{0.};
+      size_t number_directions{0};
+
+      void evaluate_or_reuse(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers, const std::function<void()>& evaluate_hessian_model);
+      [[nodiscard]] bool must_refresh(const OptimizationProblem& problem, const Vector<double>& primal_variables,
+            const Vector<double>& constraint_multipliers) const;
+      void copy_hessian();
+   };
+} // namespace
+
+#endif // UNO_REUSEDHESSIAN_H
@@ -16,8 +16,8 @@ namespace uno {
       this->trust_region_radius = new_trust_region_radius;
    }
 
-   const SymmetricMatrix<size_t, double>& Subproblem::get_lagrangian_hessian() const {
-      return this->hessian_model->hessian;
+   const HessianModel& Subproblem::get_hessian_model() const {
+      return *this->hessian_model;
    }
 
    size_t Subproblem::get_hessian_evaluation_count() const {
@@ -19,8 +19,11 @@ namespace uno {
    QPSubproblem::QPSubproblem(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
          size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options) :
          InequalityConstrainedMethod(options.get_string("hessian_model"), number_variables, number_constraints, number_hessian_nonzeros,
-               options.get_string("globalization_mechanism") == "LS", options),
-         use_regularization(options.get_string("globalization_mechanism") != "TR" || options.get_bool("convexify_QP")),
+               // the Hessian is convexified when the QP solver only solves convex QPs
+               options.get_string("globalization_mechanism") == "LS" || QPSolverFactory::requires_convex_hessian(options),
+               options),
+         use_regularization(options.get_string("globalization_mechanism") != "TR" || options.get_bool("convexify_QP") ||
+               QPSolverFactory::requires_convex_hessian(options)),
          enforce_linear_constraints_at_initial_iterate(options.get_bool("enforce_linear_constraints")),
          // maximum number of Hessian nonzeros = number nonzeros + possible diagonal inertia correction
          solver(QPSolverFactory::create(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros,
@@ -47,7 +50,7 @@ namespace uno {
          const Multipliers& current_multipliers, const WarmstartInformation& warmstart_information) {
       // Lagrangian Hessian
       if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
-         this->hessian_model->evaluate(statistics, problem, current_iterate.primals, current_multipliers.constraints);
+         this->hessian_model->evaluate(statistics, problem, current_iterate, current_multipliers.constraints);
       }
       // objective gradient, constraints and constraint Jacobian
       if (warmstart_information.objective_changed) {
@@ -75,10 +78,12 @@ namespace uno {
       }
 
       // solve the QP
+      this->solver->set_hessian_correction(this->hessian_model->low_rank_correction());
       this->solver->solve_QP(problem.number_variables, problem.number_constraints, this->direction_lower_bounds, this->direction_upper_bounds,
             this->linearized_constraints_lower_bounds, this->linearized_constraints_upper_bounds, this->objective_gradient,
             this->constraint_jacobian, this->hessian_model->hessian, this->initial_point, direction, warmstart_information);
       InequalityConstrainedMethod::compute_dual_displacements(current_multipliers, direction.multipliers);
+      this->hessian_model->notify_primal_direction(direction.primals, problem.number_variables);
       this->number_subproblems_solved++;
       // reset the initial point
       this->initial_point.fill(0.);
@@ -6,6 +6,8 @@
 #include "optimization/Direction.hpp"
 #include "optimization/Iterate.hpp"
 #include "ingredients/hessian_models/HessianModelFactory.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
+#include "linear_algebra/SparseKernels.hpp"
 #include "linear_algebra/SparseStorageFactory.hpp"
 #include "solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
@@ -18,7 +20,7 @@
 namespace uno {
    PrimalDualInteriorPointSubproblem::PrimalDualInteriorPointSubproblem(size_t number_variables, size_t number_constraints,
          size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, const Options& options):
-         Subproblem("exact", number_variables, number_hessian_nonzeros, false, options),
+         Subproblem(options.get_string("hessian_model"), number_variables, number_hessian_nonzeros, false, options),
          objective_gradient(2 * number_variables), // original variables + barrier terms
          constraints(number_constraints),
          constraint_jacobian(number_constraints, number_variables),
@@ -52,6 +54,7 @@ namespace uno {
 
    void PrimalDualInteriorPointSubproblem::initialize_statistics(Statistics& statistics, const Options& options) {
       statistics.add_column("regularization", Statistics::double_width - 1, options.get_int("statistics_regularization_column_order"));
+      statistics.add_column("factorizations", Statistics::int_width + 7, options.get_int("statistics_factorizations_column_order"));
       statistics.add_column("barrier param.", Statistics::double_width - 1, options.get_int("statistics_barrier_parameter_column_order"));
    }
 
@@ -126,7 +129,7 @@ namespace uno {
       // barrier Lagrangian Hessian
       if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
          // original Lagrangian Hessian
-         this->hessian_model->evaluate(statistics, problem, current_iterate.primals, current_multipliers.constraints);
+         this->hessian_model->evaluate(statistics, problem, current_iterate, current_multipliers.constraints);
 
          // diagonal barrier terms (grouped by variable)
          for (size_t variable_index: Range(problem.number_variables)) {
@@ -200,29 +203,37 @@ namespace uno {
 
       // compute the primal-dual solution
       this->assemble_augmented_system(statistics, problem, current_multipliers);
-      this->augmented_system.solve(*this->linear_solver);
+      // quasi-Newton Hessian in compact form: the low-rank correction is handled by the Sherman-Morrison-Woodbury formula
+      const LowRankCorrection<double>* hessian_correction = this->hessian_model->low_rank_correction();
+      if (hessian_correction != nullptr) {
+         this->augmented_system.solve(*this->linear_solver, *hessian_correction);
+      }
+      else {
+         this->augmented_system.solve(*this->linear_solver);
+      }
       assert(direction.status == SubproblemStatus::OPTIMAL && "The primal-dual perturbed subproblem was not solved to optimality");
       this->number_subproblems_solved++;
 
       this->assemble_primal_dual_direction(problem, current_iterate.primals, current_multipliers, direction.primals, direction.multipliers);
       direction.subproblem_objective = this->evaluate_subproblem_objective(direction);
+      this->hessian_model->notify_primal_direction(direction.primals, problem.number_variables);
    }
 
    void PrimalDualInteriorPointSubproblem::assemble_augmented_system(Statistics& statistics, const OptimizationProblem& problem,
          const Multipliers& current_multipliers) {
       // assemble, factorize and regularize the augmented matrix
       this->augmented_system.assemble_matrix(this->hessian_model->hessian, this->constraint_jacobian, problem.number_variables, problem.number_constraints);
-      this->augmented_system.factorize_matrix(problem.model, *this->linear_solver);
+      // rhs (required by the curvature test of the regularization)
+      this->assemble_augmented_rhs(problem, current_multipliers);
       const double dual_regularization_parameter = std::pow(this->barrier_parameter(), this->parameters.regularization_exponent);
-      this->augmented_system.regularize_matrix(statistics, problem.model, *this->linear_solver, problem.number_variables, problem.number_constraints,
+      this->augmented_system.regularize_matrix(statistics, *this->linear_solver, problem.number_variables, problem.number_constraints,
             dual_regularization_parameter);
 
-      // check the inertia
-      [[maybe_unused]] auto [number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues] = this->linear_solver->get_inertia();
-      assert(number_pos_eigenvalues == problem.number_variables && number_neg_eigenvalues == problem.number_constraints && number_zero_eigenvalues == 0);
-
-      // rhs
-      this->assemble_augmented_rhs(problem, current_multipliers);
+      // check the inertia (the curvature test may accept a factorization with a wrong inertia)
+      if (not this->augmented_system.uses_curvature_test(*this->linear_solver)) {
+         [[maybe_unused]] auto [number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues] = this->linear_solver->get_inertia();
+         assert(number_pos_eigenvalues == problem.number_variables && number_neg_eigenvalues == problem.number_constraints && number_zero_eigenvalues == 0);
+      }
    }
 
    void PrimalDualInteriorPointSubproblem::initialize_feasibility_problem(const l1RelaxedProblem& /*problem*/, Iterate& current_iterate) {
@@ -354,7 +365,7 @@ namespace uno {
 
    double PrimalDualInteriorPointSubproblem::evaluate_subproblem_objective(const Direction& direction) const {
       const double linear_term = dot(direction.primals, this->objective_gradient);
-      const double quadratic_term = this->hessian_model->hessian.quadratic_product(direction.primals, direction.primals) / 2.;
+      const double quadratic_term = this->hessian_model->quadratic_product(direction.primals) / 2.;
       return linear_term + quadratic_term;
    }
 
@@ -415,14 +426,8 @@ namespace uno {
       }
 
       // constraint: evaluations and gradients
+      transposed_matrix_vector_product(this->constraint_jacobian, current_multipliers.constraints, 1., this->augmented_system.rhs);
       for (size_t constraint_index: Range(problem.number_constraints)) {
-         // Lagrangian
-         if (current_multipliers.constraints[constraint_index] != 0.) {
-            for (const auto [variable_index, derivative]: this->constraint_jacobian[constraint_index]) {
-               this->augmented_system.rhs[variable_index] += current_multipliers.constraints[constraint_index] * derivative;
-            }
-         }
-         // constraints
          this->augmented_system.rhs[problem.number_variables + constraint_index] = -this->constraints[constraint_index];
       }
       DEBUG2 << "RHS: "; print_vector(DEBUG2, view(this->augmented_system.rhs, 0, problem.number_variables + problem.number_constraints)); DEBUG << '\n';
@@ -477,6 +482,8 @@ namespace uno {
 
    void PrimalDualInteriorPointSubproblem::compute_least_square_multipliers(const OptimizationProblem& problem, Iterate& iterate,
          Vector<double>& constraint_multipliers) {
+      // the augmented matrix is overwritten by the least-square system
+      this->augmented_system.discard_assembly_pattern();
       this->augmented_system.matrix.set_dimension(problem.number_variables + problem.number_constraints);
       this->augmented_system.matrix.reset();
       Preprocessing::compute_least_square_multipliers(problem.model, this->augmented_system.matrix, this->augmented_system.rhs, *this->linear_solver,
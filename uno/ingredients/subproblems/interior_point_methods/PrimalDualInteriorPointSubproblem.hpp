@@ -5,6 +5,7 @@
 #define UNO_INFEASIBLEINTERIORPOINTSUBPROBLEM_H
 
 #include "ingredients/subproblems/Subproblem.hpp"
+#include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
 #include "BarrierParameterUpdateStrategy.hpp"
 
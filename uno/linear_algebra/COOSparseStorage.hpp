@@ -23,11 +23,16 @@ namespace uno {
       void insert(ElementType term, IndexType row_index, IndexType column_index) override;
       void finalize_column(IndexType /*column_index*/) override { /* do nothing */ }
       void set_regularization(const std::function<ElementType(size_t index)>& regularization_function) override;
+      [[nodiscard]] size_t regularization_position(size_t index) const override;
       const ElementType* data_pointer() const noexcept override { return this->entries.data(); }
       ElementType* data_pointer() noexcept override { return this->entries.data(); }
 
       void print(std::ostream& stream) const override;
 
+      // non-virtual traversal: function(row_index, column_index, element) is called for each nonzero in storage order
+      template <typename Function>
+      void for_each_nonzero(Function&& function) const;
+
       const IndexType* row_indices_pointer() const {
          return this->row_indices.data();
       }
@@ -103,11 +108,29 @@ namespace uno {
       }
    }
 
+   template <typename IndexType, typename ElementType>
+   size_t COOSparseStorage<IndexType, ElementType>::regularization_position(size_t index) const {
+      assert(this->use_regularization && "You are trying to regularize a matrix where regularization was not preallocated.");
+      // the regularization terms lie at the start of the entries vector
+      return index;
+   }
+
+   template <typename IndexType, typename ElementType>
+   template <typename Function>
+   inline void COOSparseStorage<IndexType, ElementType>::for_each_nonzero(Function&& function) const {
+      const IndexType* rows = this->row_indices.data();
+      const IndexType* columns = this->column_indices.data();
+      const ElementType* elements = this->entries.data();
+      for (size_t nonzero_index: Range(this->number_nonzeros)) {
+         function(rows[nonzero_index], columns[nonzero_index], elements[nonzero_index]);
+      }
+   }
+
    template <typename IndexType, typename ElementType>
    void COOSparseStorage<IndexType, ElementType>::print(std::ostream& stream) const {
-      for (const auto [row_index, column_index, element]: *this) {
+      this->for_each_nonzero([&](IndexType row_index, IndexType column_index, ElementType element) {
          stream << "m(" << row_index << ", " << column_index << ") = " << element << '\n';
-      }
+      });
    }
 
    template <typename IndexType, typename ElementType>
@@ -9,6 +9,7 @@
 #include "SparseStorage.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "tools/Infinity.hpp"
+#include "symbolic/Range.hpp"
 #include "symbolic/VectorView.hpp"
 
 namespace uno {
@@ -26,11 +27,16 @@ namespace uno {
       void insert(ElementType term, IndexType row_index, IndexType column_index) override;
       void finalize_column(IndexType column_index) override;
       void set_regularization(const std::function<ElementType(IndexType /*index*/)>& regularization_function) override;
+      [[nodiscard]] size_t regularization_position(size_t index) const override;
       const ElementType* data_pointer() const noexcept override { return this->entries.data(); }
       ElementType* data_pointer() noexcept override { return this->entries.data(); }
 
       void print(std::ostream& stream) const override;
 
+      // non-virtual traversal: function(row_index, column_index, element) is called for each nonzero in storage order
+      template <typename Function>
+      void for_each_nonzero(Function&& function) const;
+
    protected:
       std::vector<ElementType> entries;
       // entries and row_indices have nnz elements
@@ -101,6 +107,13 @@ namespace uno {
       }
    }
 
+   template <typename IndexType, typename ElementType>
+   size_t CSCSparseStorage<IndexType, ElementType>::regularization_position(size_t index) const {
+      assert(this->use_regularization && "You are trying to regularize a matrix where regularization was not preallocated.");
+      // the regularization term is located at the end of the column, that is right before the start of the next column
+      return static_cast<size_t>(this->column_starts[index + 1] - 1);
+   }
+
    template <typename IndexType, typename ElementType>
    std::tuple<IndexType, IndexType, ElementType> CSCSparseStorage<IndexType, ElementType>::dereference_iterator(IndexType column_index,
          size_t nonzero_index) const {
@@ -122,6 +135,19 @@ namespace uno {
       }
    }
 
+   template <typename IndexType, typename ElementType>
+   template <typename Function>
+   inline void CSCSparseStorage<IndexType, ElementType>::for_each_nonzero(Function&& function) const {
+      const IndexType* rows = this->row_indices.data();
+      const ElementType* elements = this->entries.data();
+      for (size_t column_index: Range(this->dimension)) {
+         const size_t column_end = static_cast<size_t>(this->column_starts[column_index + 1]);
+         for (size_t nonzero_index = static_cast<size_t>(this->column_starts[column_index]); nonzero_index < column_end; nonzero_index++) {
+            function(rows[nonzero_index], static_cast<IndexType>(column_index), elements[nonzero_index]);
+         }
+      }
+   }
+
    template <typename IndexType, typename ElementType>
    void CSCSparseStorage<IndexType, ElementType>::print(std::ostream& stream) const {
       stream << "W = "; print_vector(stream, view(this->entries, 0, this->number_nonzeros));
@@ -0,0 +1,90 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DENSELUFACTORIZATION_H
+#define UNO_DENSELUFACTORIZATION_H
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace uno {
+   // LU factorization with partial pivoting of a small dense square matrix (column-major storage)
+   template <typename ElementType>
+   class DenseLUFactorization {
+   public:
+      DenseLUFactorization() = default;
+
+      // returns false if the matrix is numerically singular
+      bool factorize(const std::vector<ElementType>& matrix, size_t dimension) {
+         this->dimension = dimension;
+         this->factors.assign(matrix.begin(), matrix.begin() + static_cast<std::ptrdiff_t>(dimension * dimension));
+         this->pivots.resize(dimension);
+         for (size_t column_index = 0; column_index < dimension; column_index++) {
+            // pivot: largest entry of the column on or below the diagonal
+            size_t pivot_index = column_index;
+            for (size_t row_index = column_index + 1; row_index < dimension; row_index++) {
+               if (std::abs(this->entry(pivot_index, column_index)) < std::abs(this->entry(row_index, column_index))) {
+                  pivot_index = row_index;
+               }
+            }
+            this->pivots[column_index] = pivot_index;
+            if (this->entry(pivot_index, column_index) == ElementType(0)) {
+               return false;
+            }
+            if (pivot_index != column_index) {
+               for (size_t index = 0; index < dimension; index++) {
+                  std::swap(this->entry(pivot_index, index), this->entry(column_index, index));
+               }
+            }
+            const ElementType inverse_pivot = ElementType(1) / this->entry(column_index, column_index);
+            for (size_t row_index = column_index + 1; row_index < dimension; row_index++) {
+               this->entry(row_index, column_index) *= inverse_pivot;
+            }
+            for (size_t other_column = column_index + 1; other_column < dimension; other_column++) {
+               const ElementType factor = this->entry(column_index, other_column);
+               if (factor != ElementType(0)) {
+                  for (size_t row_index = column_index + 1; row_index < dimension; row_index++) {
+                     this->entry(row_index, other_column) -= this->entry(row_index, column_index) * factor;
+                  }
+               }
+            }
+         }
+         return true;
+      }
+
+      // overwrites rhs (of size dimension) with the solution
+      template <typename Array>
+      void solve(Array& rhs) const {
+         for (size_t index = 0; index < this->dimension; index++) {
+            std::swap(rhs[index], rhs[this->pivots[index]]);
+         }
+         // forward substitution with the unit lower triangular factor
+         for (size_t column_index = 0; column_index < this->dimension; column_index++) {
+            for (size_t row_index = column_index + 1; row_index < this->dimension; row_index++) {
+               rhs[row_index] -= this->entry(row_index, column_index) * rhs[column_index];
+            }
+         }
+         // backward substitution with the upper triangular factor
+         for (size_t column_index = this->dimension; 0 < column_index--;) {
+            rhs[column_index] /= this->entry(column_index, column_index);
+            for (size_t row_index = 0; row_index < column_index; row_index++) {
+               rhs[row_index] -= this->entry(row_index, column_index) * rhs[column_index];
+            }
+         }
+      }
+
+   protected:
+      size_t dimension{0};
+      std::vector<ElementType> factors{};
+      std::vector<size_t> pivots{};
+
+      [[nodiscard]] ElementType& entry(size_t row_index, size_t column_index) { return this->factors[column_index * this->dimension + row_index]; }
+      [[nodiscard]] const ElementType& entry(size_t row_index, size_t column_index) const {
+         return this->factors[column_index * this->dimension + row_index];
+      }
+   };
+} // namespace
+
+#endif // UNO_DENSELUFACTORIZATION_H
@@ -0,0 +1,98 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_LOWRANKCORRECTION_H
+#define UNO_LOWRANKCORRECTION_H
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "DenseLUFactorization.hpp"
+
+namespace uno {
+   // symmetric low-rank correction -Ψ N^{-1} Ψ^T of a matrix, where the basis Ψ is a dense dimension x rank matrix (column-major)
+   // and the middle matrix N is a symmetric nonsingular rank x rank matrix.
+   // Quasi-Newton matrices in compact form are a diagonal plus such a correction
+   template <typename ElementType>
+   class LowRankCorrection {
+   public:
+      LowRankCorrection() = default;
+
+      [[nodiscard]] size_t get_dimension() const { return this->dimension; }
+      [[nodiscard]] size_t get_rank() const { return this->rank; }
+      [[nodiscard]] const std::vector<ElementType>& get_basis() const { return this->basis; }
+      [[nodiscard]] const std::vector<ElementType>& get_middle_matrix() const { return this->middle_matrix; }
+
+      // the correction is defined by the basis and the middle matrix (both column-major)
+      void set(size_t new_dimension, size_t new_rank, std::vector<ElementType> new_basis, std::vector<ElementType> new_middle_matrix) {
+         assert(new_basis.size() == new_dimension * new_rank && new_middle_matrix.size() == new_rank * new_rank);
+         this->dimension = new_dimension;
+         this->rank = new_rank;
+         this->basis = std::move(new_basis);
+         this->middle_matrix = std::move(new_middle_matrix);
+         if (not this->middle_factorization.factorize(this->middle_matrix, this->rank)) {
+            throw std::runtime_error("LowRankCorrection: the middle matrix is singular");
+         }
+      }
+
+      void clear() { this->rank = 0; }
+
+      // result += -Ψ N^{-1} Ψ^T x
+      template <typename Vector1, typename Vector2>
+      void add_product(const Vector1& x, Vector2& result) const {
+         if (this->rank == 0) {
+            return;
+         }
+         this->compute_projection(x);
+         this->middle_factorization.solve(this->projection);
+         for (size_t column_index = 0; column_index < this->rank; column_index++) {
+            const ElementType* column = this->basis.data() + column_index * this->dimension;
+            const ElementType factor = this->projection[column_index];
+            for (size_t index = 0; index < this->dimension; index++) {
+               result[index] -= factor * column[index];
+            }
+         }
+      }
+
+      // x^T (-Ψ N^{-1} Ψ^T) x
+      template <typename Vector1>
+      [[nodiscard]] ElementType quadratic_product(const Vector1& x) const {
+         if (this->rank == 0) {
+            return ElementType(0);
+         }
+         this->compute_projection(x);
+         std::vector<ElementType> projected_x = this->projection;
+         this->middle_factorization.solve(this->projection);
+         ElementType result = ElementType(0);
+         for (size_t index = 0; index < this->rank; index++) {
+            result -= projected_x[index] * this->projection[index];
+         }
+         return result;
+      }
+
+   protected:
+      size_t dimension{0};
+      size_t rank{0};
+      std::vector<ElementType> basis{};
+      std::vector<ElementType> middle_matrix{};
+      DenseLUFactorization<ElementType> middle_factorization{};
+      mutable std::vector<ElementType> projection{};
+
+      // Ψ^T x
+      template <typename Vector1>
+      void compute_projection(const Vector1& x) const {
+         this->projection.resize(this->rank);
+         for (size_t column_index = 0; column_index < this->rank; column_index++) {
+            const ElementType* column = this->basis.data() + column_index * this->dimension;
+            ElementType dot_product = ElementType(0);
+            for (size_t index = 0; index < this->dimension; index++) {
+               dot_product += column[index] * x[index];
+            }
+            this->projection[column_index] = dot_product;
+         }
+      }
+   };
+} // namespace
+
+#endif // UNO_LOWRANKCORRECTION_H
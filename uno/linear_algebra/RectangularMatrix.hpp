@@ -4,42 +4,395 @@
 #ifndef UNO_RECTANGULARMATRIX_H
 #define UNO_RECTANGULARMATRIX_H
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <ostream>
+#include <utility>
 #include <vector>
-#include "SparseVector.hpp"
+#include "symbolic/Range.hpp"
 
 namespace uno {
-   // TODO use more appropriate sparse representation
-   //template <typename ElementType>
-   //using RectangularMatrix = std::vector<SparseVector<ElementType>>;
+   // read-only view of a sparse row (or column) stored contiguously: iterates over [index, value] pairs
+   template <typename ElementType>
+   class SparseRowView {
+   public:
+      class iterator {
+      public:
+         using value_type = std::pair<size_t, ElementType>;
+
+         iterator(const size_t* indices, const ElementType* values, size_t position): indices(indices), values(values), position(position) { }
+
+         value_type operator*() const {
+            return {this->indices[this->position], this->values[this->position]};
+         }
+
+         iterator& operator++() {
+            this->position++;
+            return *this;
+         }
+
+         friend bool operator!=(const iterator& a, const iterator& b) {
+            return a.position != b.position;
+         }
+
+      protected:
+         const size_t* indices;
+         const ElementType* values;
+         size_t position;
+      };
+
+      using value_type = ElementType;
 
+      SparseRowView(const size_t* indices, const ElementType* values, size_t number_nonzeros):
+            indices(indices), values(values), number_nonzeros(number_nonzeros) { }
+
+      [[nodiscard]] size_t size() const { return this->number_nonzeros; }
+      [[nodiscard]] bool is_empty() const { return (this->number_nonzeros == 0); }
+      [[nodiscard]] const size_t* indices_pointer() const { return this->indices; }
+      [[nodiscard]] const ElementType* values_pointer() const { return this->values; }
+
+      [[nodiscard]] iterator begin() const { return iterator(this->indices, this->values, 0); }
+      [[nodiscard]] iterator end() const { return iterator(this->indices, this->values, this->number_nonzeros); }
+
+   protected:
+      const size_t* indices;
+      const ElementType* values;
+      size_t number_nonzeros;
+   };
+
+   /*
+    * Compressed Sparse Row
+    * https://en.wikipedia.org/wiki/Sparse_matrix#Compressed_sparse_row_(CSR,_CRS_or_Yale_format)
+    *
+    * The matrix is built row by row through insert(). The first time it is cleared, the pattern that was inserted is
+    * compressed into a single array of column indices and a single array of values. From then on, an evaluation that
+    * inserts the same entries in the same order overwrites the values in place (no allocation, no index write).
+    * If an evaluation inserts a different pattern, the matrix falls back to building mode and the new pattern is
+    * compressed at the next clear().
+    */
    template <typename ElementType>
    class RectangularMatrix {
    public:
       using value_type = ElementType;
 
-      RectangularMatrix(size_t number_rows, size_t number_columns): matrix(number_rows) {
-         for (auto& row: this->matrix) {
-            row.reserve(number_columns);
+      // column-major (CSC) pattern of the matrix, with the position of each entry in the row-major array of values
+      struct ColumnMajorView {
+         std::vector<size_t> column_starts{};
+         std::vector<size_t> row_indices{};
+         std::vector<size_t> positions{};
+         size_t pattern_version{0};
+      };
+
+      RectangularMatrix(size_t number_rows, size_t number_columns);
+
+      [[nodiscard]] size_t number_rows() const { return this->row_fill.size(); }
+      [[nodiscard]] size_t number_columns() const { return this->number_of_columns; }
+      [[nodiscard]] size_t number_nonzeros() const;
+      [[nodiscard]] bool has_fixed_pattern() const { return this->pattern_is_fixed; }
+
+      // read access to a row
+      [[nodiscard]] SparseRowView<ElementType> operator[](size_t row_index) const;
+
+      // build the matrix incrementally (the entries of a row need not be inserted consecutively)
+      void insert(ElementType term, size_t row_index, size_t column_index);
+      void scale_row(size_t row_index, ElementType factor);
+      // start a new evaluation: the current pattern becomes the fixed pattern
+      void clear();
+      // clear the matrix and insert the rows of another matrix (the pattern of this matrix is kept if it matches)
+      void assign(const RectangularMatrix<ElementType>& other);
+      // compress the entries inserted so far (if needed) without discarding them
+      void finalize_pattern();
+
+      // concurrent filling of a fixed pattern (after clear()): distinct rows may be overwritten by different threads.
+      // overwrite_row(row_index, number_entries) returns the values of the first number_entries entries of the row pattern,
+      // whose column indices are pattern_indices(row_index), and marks them as inserted
+      [[nodiscard]] size_t pattern_size(size_t row_index) const;
+      [[nodiscard]] const size_t* pattern_indices(size_t row_index) const;
+      ElementType* overwrite_row(size_t row_index, size_t number_entries);
+
+      // on-demand column-major view, recomputed only when the pattern changes. The values of column j are
+      // entries_pointer()[view.positions[k]] for k in [view.column_starts[j], view.column_starts[j+1])
+      const ColumnMajorView& column_major_view();
+      [[nodiscard]] const ElementType* entries_pointer() const { return this->entries.data(); }
+
+      template <typename U>
+      friend std::ostream& operator<<(std::ostream& stream, const RectangularMatrix<U>& matrix);
+
+   protected:
+      size_t number_of_columns;
+      // compressed storage
+      std::vector<size_t> row_starts;
+      std::vector<size_t> column_indices{};
+      std::vector<ElementType> entries{};
+      // number of entries of each row inserted since the last clear()
+      std::vector<size_t> row_fill;
+      bool pattern_is_fixed{false};
+      size_t pattern_version{0};
+
+      // building mode: one growing row per constraint
+      std::vector<std::vector<size_t>> building_indices{};
+      std::vector<std::vector<ElementType>> building_values{};
+
+      ColumnMajorView column_major{};
+
+      void compress_building_rows();
+      void compact_partially_filled_rows();
+      void switch_to_building_mode();
+   };
+
+   template <typename ElementType>
+   RectangularMatrix<ElementType>::RectangularMatrix(size_t number_rows, size_t number_columns):
+         number_of_columns(number_columns), row_starts(number_rows + 1, 0), row_fill(number_rows, 0),
+         building_indices(number_rows), building_values(number_rows) {
+   }
+
+   template <typename ElementType>
+   size_t RectangularMatrix<ElementType>::number_nonzeros() const {
+      size_t number_nonzeros = 0;
+      for (size_t row_index: Range(this->number_rows())) {
+         number_nonzeros += (*this)[row_index].size();
+      }
+      return number_nonzeros;
+   }
+
+   template <typename ElementType>
+   inline SparseRowView<ElementType> RectangularMatrix<ElementType>::operator[](size_t row_index) const {
+      assert(row_index < this->number_rows() && "RectangularMatrix: the row index is out of bounds");
+      if (this->pattern_is_fixed) {
+         const size_t row_start = this->row_starts[row_index];
+         return {this->column_indices.data() + row_start, this->entries.data() + row_start, this->row_fill[row_index]};
+      }
+      else {
+         return {this->building_indices[row_index].data(), this->building_values[row_index].data(), this->building_indices[row_index].size()};
+      }
+   }
+
+   template <typename ElementType>
+   inline void RectangularMatrix<ElementType>::insert(ElementType term, size_t row_index, size_t column_index) {
+      assert(row_index < this->number_rows() && "RectangularMatrix: the row index is out of bounds");
+      if (this->pattern_is_fixed) {
+         const size_t position = this->row_starts[row_index] + this->row_fill[row_index];
+         if (position < this->row_starts[row_index + 1] && this->column_indices[position] == column_index) {
+            // same pattern as the previous evaluation: overwrite the value in place
+            this->entries[position] = term;
+            this->row_fill[row_index]++;
+            return;
+         }
+         // the pattern changed
+         this->switch_to_building_mode();
+      }
+      this->building_indices[row_index].emplace_back(column_index);
+      this->building_values[row_index].emplace_back(term);
+   }
+
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::scale_row(size_t row_index, ElementType factor) {
+      if (this->pattern_is_fixed) {
+         const size_t row_start = this->row_starts[row_index];
+         for (size_t position: Range(row_start, row_start + this->row_fill[row_index])) {
+            this->entries[position] *= factor;
+         }
+      }
+      else {
+         for (ElementType& value: this->building_values[row_index]) {
+            value *= factor;
+         }
+      }
+   }
+
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::clear() {
+      this->finalize_pattern();
+      std::fill(this->row_fill.begin(), this->row_fill.end(), size_t(0));
+   }
+
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::assign(const RectangularMatrix<ElementType>& other) {
+      assert(other.number_rows() <= this->number_rows() && "RectangularMatrix::assign: the other matrix has too many rows");
+      this->clear();
+      for (size_t row_index: Range(other.number_rows())) {
+         for (const auto [column_index, element]: other[row_index]) {
+            this->insert(element, row_index, column_index);
+         }
+      }
+   }
+
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::finalize_pattern() {
+      if (not this->pattern_is_fixed) {
+         // an empty matrix does not define a pattern yet
+         if (0 < this->number_nonzeros()) {
+            this->compress_building_rows();
+         }
+      }
+      else {
+         this->compact_partially_filled_rows();
+      }
+   }
+
+   template <typename ElementType>
+   size_t RectangularMatrix<ElementType>::pattern_size(size_t row_index) const {
+      return this->pattern_is_fixed ? (this->row_starts[row_index + 1] - this->row_starts[row_index]) : 0;
+   }
+
+   template <typename ElementType>
+   const size_t* RectangularMatrix<ElementType>::pattern_indices(size_t row_index) const {
+      assert(this->pattern_is_fixed && "RectangularMatrix::pattern_indices: the pattern is not fixed");
+      return this->column_indices.data() + this->row_starts[row_index];
+   }
+
+   template <typename ElementType>
+   ElementType* RectangularMatrix<ElementType>::overwrite_row(size_t row_index, size_t number_entries) {
+      assert(this->pattern_is_fixed && "RectangularMatrix::overwrite_row: the pattern is not fixed");
+      assert(this->row_fill[row_index] == 0 && "RectangularMatrix::overwrite_row: the row was already filled");
+      assert(number_entries <= this->pattern_size(row_index) && "RectangularMatrix::overwrite_row: the row pattern is too small");
+      this->row_fill[row_index] = number_entries;
+      return this->entries.data() + this->row_starts[row_index];
+   }
+
+   template <typename ElementType>
+   const typename RectangularMatrix<ElementType>::ColumnMajorView& RectangularMatrix<ElementType>::column_major_view() {
+      this->finalize_pattern();
+      if (this->column_major.pattern_version != this->pattern_version) {
+         // count the entries in each column
+         this->column_major.column_starts.assign(this->number_of_columns + 1, 0);
+         for (size_t position: Range(this->row_starts.back())) {
+            this->column_major.column_starts[this->column_indices[position] + 1]++;
          }
+         for (size_t column_index: Range(this->number_of_columns)) {
+            this->column_major.column_starts[column_index + 1] += this->column_major.column_starts[column_index];
+         }
+         // distribute the entries
+         const size_t number_nonzeros = this->row_starts.back();
+         this->column_major.row_indices.resize(number_nonzeros);
+         this->column_major.positions.resize(number_nonzeros);
+         std::vector<size_t> current_positions(this->column_major.column_starts.begin(), this->column_major.column_starts.end() - 1);
+         for (size_t row_index: Range(this->number_rows())) {
+            for (size_t position: Range(this->row_starts[row_index], this->row_starts[row_index + 1])) {
+               const size_t column_position = current_positions[this->column_indices[position]]++;
+               this->column_major.row_indices[column_position] = row_index;
+               this->column_major.positions[column_position] = position;
+            }
+         }
+         this->column_major.pattern_version = this->pattern_version;
+      }
+      return this->column_major;
+   }
+
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::compress_building_rows() {
+      // compute the row starts
+      for (size_t row_index: Range(this->number_rows())) {
+         this->row_starts[row_index + 1] = this->row_starts[row_index] + this->building_indices[row_index].size();
+      }
+      const size_t number_nonzeros = this->row_starts.back();
+      this->column_indices.resize(number_nonzeros);
+      this->entries.resize(number_nonzeros);
+      // move the rows to the contiguous arrays and release the building rows
+      for (size_t row_index: Range(this->number_rows())) {
+         std::copy(this->building_indices[row_index].begin(), this->building_indices[row_index].end(),
+               this->column_indices.begin() + static_cast<std::ptrdiff_t>(this->row_starts[row_index]));
+         std::copy(this->building_values[row_index].begin(), this->building_values[row_index].end(),
+               this->entries.begin() + static_cast<std::ptrdiff_t>(this->row_starts[row_index]));
+         this->row_fill[row_index] = this->building_indices[row_index].size();
+         std::vector<size_t>().swap(this->building_indices[row_index]);
+         std::vector<ElementType>().swap(this->building_values[row_index]);
       }
+      this->pattern_is_fixed = true;
+      this->pattern_version++;
+   }
 
-      SparseVector<ElementType>& operator[](size_t row_index) {
-         return this->matrix[row_index];
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::compact_partially_filled_rows() {
+      // if some rows received fewer entries than their pattern, the pattern shrinks to the inserted entries
+      bool rows_are_complete = true;
+      for (size_t row_index: Range(this->number_rows())) {
+         if (this->row_fill[row_index] != this->row_starts[row_index + 1] - this->row_starts[row_index]) {
+            rows_are_complete = false;
+            break;
+         }
+      }
+      if (not rows_are_complete) {
+         size_t current_position = 0;
+         for (size_t row_index: Range(this->number_rows())) {
+            const size_t row_start = this->row_starts[row_index];
+            for (size_t position: Range(row_start, row_start + this->row_fill[row_index])) {
+               this->column_indices[current_position] = this->column_indices[position];
+               this->entries[current_position] = this->entries[position];
+               current_position++;
+            }
+            this->row_starts[row_index] = current_position - this->row_fill[row_index];
+         }
+         this->row_starts.back() = current_position;
+         this->column_indices.resize(current_position);
+         this->entries.resize(current_position);
+         this->pattern_version++;
       }
+   }
 
-      const SparseVector<ElementType>& operator[](size_t row_index) const {
-         return this->matrix[row_index];
+   template <typename ElementType>
+   void RectangularMatrix<ElementType>::switch_to_building_mode() {
+      // copy the entries inserted since the last clear() into the building rows
+      for (size_t row_index: Range(this->number_rows())) {
+         const size_t row_start = this->row_starts[row_index];
+         const size_t row_end = row_start + this->row_fill[row_index];
+         this->building_indices[row_index].assign(this->column_indices.begin() + static_cast<std::ptrdiff_t>(row_start),
+               this->column_indices.begin() + static_cast<std::ptrdiff_t>(row_end));
+         this->building_values[row_index].assign(this->entries.begin() + static_cast<std::ptrdiff_t>(row_start),
+               this->entries.begin() + static_cast<std::ptrdiff_t>(row_end));
+         this->row_fill[row_index] = 0;
       }
+      this->pattern_is_fixed = false;
+   }
 
-      void clear() {
-         for (auto& row: this->matrix) {
-            row.clear();
+   template <typename ElementType>
+   std::ostream& operator<<(std::ostream& stream, const RectangularMatrix<ElementType>& matrix) {
+      for (size_t row_index: Range(matrix.number_rows())) {
+         stream << "row " << row_index << ":";
+         for (const auto [column_index, element]: matrix[row_index]) {
+            stream << " (" << column_index << ", " << element << ")";
          }
+         stream << '\n';
       }
+      return stream;
+   }
 
-   protected:
-      std::vector<SparseVector<ElementType>> matrix;
-   };
+   // free functions
+
+   template <typename ElementType>
+   std::ostream& operator<<(std::ostream& stream, const SparseRowView<ElementType>& x) {
+      stream << "sparse vector with " << x.size() << " nonzeros\n";
+      for (const auto [index, element]: x) {
+         stream << "index " << index << ", value " << element << '\n';
+      }
+      return stream;
+   }
+
+   template <typename ElementType>
+   ElementType norm_inf(const SparseRowView<ElementType>& x) {
+      const ElementType* values = x.values_pointer();
+      ElementType norm = ElementType(0);
+      for (size_t position: Range(x.size())) {
+         norm = std::max(norm, std::abs(values[position]));
+      }
+      return norm;
+   }
+
+   template <typename Vector, typename ElementType>
+   ElementType dot(const Vector& x, const SparseRowView<ElementType>& y) {
+      static_assert(std::is_same_v<typename Vector::value_type, ElementType>);
+
+      const size_t* indices = y.indices_pointer();
+      const ElementType* values = y.values_pointer();
+      ElementType dot_product = ElementType(0);
+      for (size_t position: Range(y.size())) {
+         assert(indices[position] < x.size() && "dot: the sparse row y is larger than the dense vector x");
+         dot_product += x[indices[position]] * values[position];
+      }
+      return dot_product;
+   }
 } // namespace
 
 #endif // UNO_RECTANGULARMATRIX_H
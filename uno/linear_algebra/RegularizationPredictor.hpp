@@ -0,0 +1,59 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_REGULARIZATIONPREDICTOR_H
+#define UNO_REGULARIZATIONPREDICTOR_H
+
+#include <algorithm>
+#include <cmath>
+
+namespace uno {
+   // predicts the primal regularization of the next inertia correction from the history of the previous ones:
+   // - correction_frequency is an exponential moving average of the indicator "the iteration needed a correction".
+   //   When it exceeds skip_threshold, the unregularized factorization is skipped and the first trial uses the prediction
+   // - after a successful correction δ, the prediction moves down: halfway (in log scale) towards the largest regularization
+   //   that failed during the iteration, or δ/decrease_factor if no regularization failed
+   template <typename ElementType>
+   class RegularizationPredictor {
+   public:
+      RegularizationPredictor(ElementType lower_bound, ElementType decrease_factor, double skip_threshold, double history_weight):
+            lower_bound(lower_bound), decrease_factor(decrease_factor), skip_threshold(skip_threshold), history_weight(history_weight) { }
+
+      [[nodiscard]] bool skip_unregularized_trial() const {
+         return ElementType(0) < this->prediction && this->skip_threshold <= this->correction_frequency;
+      }
+      [[nodiscard]] ElementType predicted_regularization() const { return this->prediction; }
+      [[nodiscard]] double frequency() const { return this->correction_frequency; }
+
+      // a factorization with the regularization failed to produce the correct inertia
+      void record_failure(ElementType regularization) {
+         this->largest_failed_regularization = std::max(this->largest_failed_regularization, regularization);
+      }
+
+      // the iteration terminated with the regularization (possibly 0)
+      void record_success(ElementType regularization) {
+         const bool needed_correction = (ElementType(0) < regularization);
+         this->correction_frequency = this->history_weight * this->correction_frequency + (1. - this->history_weight) * (needed_correction ? 1. : 0.);
+         if (needed_correction) {
+            if (ElementType(0) < this->largest_failed_regularization) {
+               this->prediction = std::max(this->lower_bound, std::sqrt(this->largest_failed_regularization * regularization));
+            }
+            else {
+               this->prediction = std::max(this->lower_bound, regularization / this->decrease_factor);
+            }
+         }
+         this->largest_failed_regularization = ElementType(0);
+      }
+
+   protected:
+      const ElementType lower_bound;
+      const ElementType decrease_factor;
+      const double skip_threshold;
+      const double history_weight;
+      ElementType prediction{0};
+      ElementType largest_failed_regularization{0};
+      double correction_frequency{0.};
+   };
+} // namespace
+
+#endif // UNO_REGULARIZATIONPREDICTOR_H
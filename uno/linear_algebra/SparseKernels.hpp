@@ -0,0 +1,149 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SPARSEKERNELS_H
+#define UNO_SPARSEKERNELS_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include "RectangularMatrix.hpp"
+#include "Norm.hpp"
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace uno {
+   // kernels for products with a row-major sparse matrix (typically the constraint Jacobian):
+   // - matrix_vector_product:                 y = J x
+   // - transposed_matrix_vector_product:      y += α J^T x
+   // - linearized_residual_norm:              ||v(c + α J d)|| where v is a componentwise violation function
+   // The rows are partitioned among threads when compiled with OpenMP and the matrix is large enough.
+
+   // number of rows above which the row loops are parallelized
+   constexpr size_t sparse_kernels_parallel_threshold = 10000;
+
+   // dot product of a sparse row with a dense array
+   template <typename ElementType>
+   inline ElementType sparse_row_dot(const size_t* indices, const ElementType* values, size_t number_nonzeros, const ElementType* x) {
+      size_t position = 0;
+      ElementType result = ElementType(0);
+#ifdef __AVX2__
+      if constexpr (std::is_same_v<ElementType, double> && sizeof(size_t) == sizeof(long long)) {
+         // gather 4 entries of x at a time
+         __m256d accumulator = _mm256_setzero_pd();
+         for (; position + 4 <= number_nonzeros; position += 4) {
+            const __m256i gather_indices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + position));
+            const __m256d x_entries = _mm256_i64gather_pd(x, gather_indices, sizeof(double));
+            accumulator = _mm256_add_pd(accumulator, _mm256_mul_pd(_mm256_loadu_pd(values + position), x_entries));
+         }
+         alignas(32) double partial_sums[4];
+         _mm256_store_pd(partial_sums, accumulator);
+         result = (partial_sums[0] + partial_sums[1]) + (partial_sums[2] + partial_sums[3]);
+      }
+#endif
+      // 4 independent accumulators break the dependency chain of the additions
+      ElementType accumulator0 = ElementType(0), accumulator1 = ElementType(0), accumulator2 = ElementType(0), accumulator3 = ElementType(0);
+      for (; position + 4 <= number_nonzeros; position += 4) {
+         accumulator0 += values[position] * x[indices[position]];
+         accumulator1 += values[position + 1] * x[indices[position + 1]];
+         accumulator2 += values[position + 2] * x[indices[position + 2]];
+         accumulator3 += values[position + 3] * x[indices[position + 3]];
+      }
+      for (; position < number_nonzeros; position++) {
+         accumulator0 += values[position] * x[indices[position]];
+      }
+      return result + ((accumulator0 + accumulator1) + (accumulator2 + accumulator3));
+   }
+
+   template <typename ElementType>
+   inline ElementType sparse_row_dot(const SparseRowView<ElementType>& row, const ElementType* x) {
+      return sparse_row_dot(row.indices_pointer(), row.values_pointer(), row.size(), x);
+   }
+
+   // result[i] = J_i x for all rows i
+   template <typename ElementType, typename DenseVector, typename ResultVector>
+   void matrix_vector_product(const RectangularMatrix<ElementType>& matrix, const DenseVector& x, ResultVector& result) {
+      assert(matrix.number_rows() <= result.size() && "matrix_vector_product: the result vector is too small");
+      const ElementType* x_data = x.data();
+      const auto number_rows = static_cast<std::ptrdiff_t>(matrix.number_rows());
+#ifdef _OPENMP
+      #pragma omp parallel for schedule(static) if(sparse_kernels_parallel_threshold <= matrix.number_rows())
+#endif
+      for (std::ptrdiff_t row_index = 0; row_index < number_rows; row_index++) {
+         result[static_cast<size_t>(row_index)] = sparse_row_dot(matrix[static_cast<size_t>(row_index)], x_data);
+      }
+   }
+
+   // result += α J^T x
+   // the rows scatter into the same entries of the result, therefore this kernel is sequential
+   template <typename ElementType, typename DenseVector, typename ResultVector>
+   void transposed_matrix_vector_product(const RectangularMatrix<ElementType>& matrix, const DenseVector& x, ElementType alpha, ResultVector& result) {
+      assert(matrix.number_rows() <= x.size() && "transposed_matrix_vector_product: the vector x is too small");
+      // plain loops: the virtual iterators of Range are too costly in the innermost loop
+      const size_t number_rows = matrix.number_rows();
+      for (size_t row_index = 0; row_index < number_rows; row_index++) {
+         const ElementType factor = alpha * x[row_index];
+         if (factor != ElementType(0)) {
+            const SparseRowView<ElementType> row = matrix[row_index];
+            const size_t* indices = row.indices_pointer();
+            const ElementType* values = row.values_pointer();
+            const size_t number_nonzeros = row.size();
+            for (size_t position = 0; position < number_nonzeros; position++) {
+               result[indices[position]] += factor * values[position];
+            }
+         }
+      }
+   }
+
+   // ||v(c + α J d)||: the linearized constraints are never formed.
+   // violation_function(value, row_index) returns the violation of row row_index when its value is value
+   template <typename ElementType, typename ConstraintVector, typename DenseVector, typename ViolationFunction>
+   ElementType linearized_residual_norm(Norm residual_norm, const ConstraintVector& constraints, ElementType alpha,
+         const RectangularMatrix<ElementType>& matrix, const DenseVector& direction, const ViolationFunction& violation_function) {
+      assert(matrix.number_rows() <= constraints.size() && "linearized_residual_norm: the constraint vector is too small");
+      const ElementType* direction_data = direction.data();
+      const auto number_rows = static_cast<std::ptrdiff_t>(matrix.number_rows());
+      [[maybe_unused]] const bool parallel = (sparse_kernels_parallel_threshold <= matrix.number_rows());
+      ElementType result = ElementType(0);
+      if (residual_norm == Norm::INF) {
+#ifdef _OPENMP
+         #pragma omp parallel for schedule(static) reduction(max:result) if(parallel)
+#endif
+         for (std::ptrdiff_t row_index = 0; row_index < number_rows; row_index++) {
+            const size_t index = static_cast<size_t>(row_index);
+            const ElementType value = constraints[index] + alpha * sparse_row_dot(matrix[index], direction_data);
+            result = std::max(result, std::abs(violation_function(value, index)));
+         }
+         return result;
+      }
+      else if (residual_norm == Norm::L1) {
+#ifdef _OPENMP
+         #pragma omp parallel for schedule(static) reduction(+:result) if(parallel)
+#endif
+         for (std::ptrdiff_t row_index = 0; row_index < number_rows; row_index++) {
+            const size_t index = static_cast<size_t>(row_index);
+            const ElementType value = constraints[index] + alpha * sparse_row_dot(matrix[index], direction_data);
+            result += std::abs(violation_function(value, index));
+         }
+         return result;
+      }
+      else if (residual_norm == Norm::L2 || residual_norm == Norm::L2_SQUARED) {
+#ifdef _OPENMP
+         #pragma omp parallel for schedule(static) reduction(+:result) if(parallel)
+#endif
+         for (std::ptrdiff_t row_index = 0; row_index < number_rows; row_index++) {
+            const size_t index = static_cast<size_t>(row_index);
+            const ElementType value = constraints[index] + alpha * sparse_row_dot(matrix[index], direction_data);
+            const ElementType violation = violation_function(value, index);
+            result += violation * violation;
+         }
+         return (residual_norm == Norm::L2) ? std::sqrt(result) : result;
+      }
+      throw std::invalid_argument("The norm is not known");
+   }
+} // namespace
+
+#endif // UNO_SPARSEKERNELS_H
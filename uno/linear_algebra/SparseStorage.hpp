@@ -54,6 +54,8 @@ namespace uno {
       // this method will be used by the CSCSparseStorage subclass
       virtual void finalize_column(IndexType column_index) = 0;
       virtual void set_regularization(const std::function<ElementType(size_t /*index*/)>& regularization_function) = 0;
+      // position of the regularization term of a given diagonal entry in the array of entries
+      [[nodiscard]] virtual size_t regularization_position(size_t index) const = 0;
       virtual const ElementType* data_pointer() const noexcept = 0;
       virtual ElementType* data_pointer() noexcept = 0;
 
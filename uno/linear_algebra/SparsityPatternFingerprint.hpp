@@ -0,0 +1,55 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SPARSITYPATTERNFINGERPRINT_H
+#define UNO_SPARSITYPATTERNFINGERPRINT_H
+
+#include <cstddef>
+#include <cstdint>
+#include "SymmetricMatrix.hpp"
+
+namespace uno {
+   // compact signature of the sparsity pattern of a symmetric matrix: dimension, number of nonzeros and
+   // a hash of the (row, column) index arrays in storage order. Two matrices with the same fingerprint can
+   // share the symbolic factorization of a direct linear solver
+   class SparsityPatternFingerprint {
+   public:
+      SparsityPatternFingerprint() = default;
+
+      template <typename IndexType, typename ElementType>
+      static SparsityPatternFingerprint compute(const SymmetricMatrix<IndexType, ElementType>& matrix);
+
+      [[nodiscard]] bool operator==(const SparsityPatternFingerprint& other) const {
+         return this->dimension == other.dimension && this->number_nonzeros == other.number_nonzeros && this->hash == other.hash;
+      }
+      [[nodiscard]] bool operator!=(const SparsityPatternFingerprint& other) const { return not (*this == other); }
+
+   protected:
+      size_t dimension{0};
+      size_t number_nonzeros{0};
+      uint64_t hash{0};
+
+      // 64-bit FNV-1a
+      static constexpr uint64_t offset_basis{14695981039346656037ULL};
+      static constexpr uint64_t prime{1099511628211ULL};
+      static void combine(uint64_t& hash, uint64_t value) {
+         hash ^= value;
+         hash *= SparsityPatternFingerprint::prime;
+      }
+   };
+
+   template <typename IndexType, typename ElementType>
+   SparsityPatternFingerprint SparsityPatternFingerprint::compute(const SymmetricMatrix<IndexType, ElementType>& matrix) {
+      SparsityPatternFingerprint fingerprint;
+      fingerprint.dimension = matrix.dimension();
+      fingerprint.number_nonzeros = matrix.number_nonzeros();
+      fingerprint.hash = SparsityPatternFingerprint::offset_basis;
+      matrix.for_each_nonzero([&](IndexType row_index, IndexType column_index, ElementType /*element*/) {
+         SparsityPatternFingerprint::combine(fingerprint.hash, static_cast<uint64_t>(row_index));
+         SparsityPatternFingerprint::combine(fingerprint.hash, static_cast<uint64_t>(column_index));
+      });
+      return fingerprint;
+   }
+} // namespace
+
+#endif // UNO_SPARSITYPATTERNFINGERPRINT_H
@@ -4,14 +4,21 @@
 #ifndef UNO_SYMMETRICINDEFINITELINEARSYSTEM_H
 #define UNO_SYMMETRICINDEFINITELINEARSYSTEM_H
 
+#include <cmath>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 #include "SymmetricMatrix.hpp"
+#include "DenseLUFactorization.hpp"
+#include "LowRankCorrection.hpp"
 #include "SparseStorageFactory.hpp"
 #include "RectangularMatrix.hpp"
+#include "RegularizationPredictor.hpp"
 #include "ingredients/hessian_models/UnstableRegularization.hpp"
-#include "model/Model.hpp"
 #include "solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "options/Options.hpp"
+#include "tools/Logger.hpp"
 #include "tools/Statistics.hpp"
 
 namespace uno {
@@ -26,10 +33,17 @@ namespace uno {
             const Options& options);
       void assemble_matrix(const SymmetricMatrix<size_t, double>& hessian, const RectangularMatrix<double>& constraint_jacobian,
             size_t number_variables, size_t number_constraints);
-      void factorize_matrix(const Model& model, DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver);
-      void regularize_matrix(Statistics& statistics, const Model& model, DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
+      void factorize_matrix(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver);
+      void regularize_matrix(Statistics& statistics, DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
             size_t size_primal_block, size_t size_dual_block, ElementType dual_regularization_parameter);
+      [[nodiscard]] size_t get_number_factorizations() const;
+      // true if the factorizations are accepted with the inertia-free curvature test
+      [[nodiscard]] bool uses_curvature_test(const DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver) const;
       void solve(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver);
+      // solve the system whose top left block is corrected by a low-rank term (e.g. quasi-Newton Hessian in compact form)
+      void solve(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver, const LowRankCorrection<ElementType>& correction);
+      // must be called when the matrix is modified outside of assemble_matrix
+      void discard_assembly_pattern();
       // [[nodiscard]] T get_primal_regularization() const;
 
    protected:
@@ -45,6 +59,42 @@ namespace uno {
       const ElementType primal_regularization_fast_increase_factor;
       const ElementType primal_regularization_slow_increase_factor;
       const size_t threshold_unsuccessful_attempts;
+      const bool use_predictive_regularization;
+      RegularizationPredictor<ElementType> regularization_predictor;
+      const bool use_curvature_test;
+      const ElementType curvature_test_parameter;
+      // the curvature test solves the system with the rhs during the regularization: the solution is then up to date
+      bool solution_is_up_to_date{false};
+      Vector<ElementType> primal_direction{};
+      // solutions of the system with the columns of the low-rank correction
+      Vector<ElementType> correction_rhs{};
+      Vector<ElementType> correction_solutions{};
+
+      // positions of the Hessian, Jacobian and regularization terms in the array of matrix values, recorded during a full
+      // assembly together with the indices of the Hessian and Jacobian entries. As long as these indices do not change,
+      // the next assemblies only scatter the new values
+      bool assembly_pattern_recorded{false};
+      size_t assembled_number_variables{0};
+      size_t assembled_number_constraints{0};
+      std::vector<size_t> hessian_positions{};
+      std::vector<size_t> hessian_indices{}; // (row, column) pairs in the order of traversal
+      std::vector<size_t> jacobian_positions{};
+      std::vector<size_t> jacobian_column_indices{};
+      std::vector<size_t> jacobian_row_starts{};
+      std::vector<size_t> regularization_positions{};
+
+      [[nodiscard]] bool assembly_pattern_is_compatible(const SymmetricMatrix<size_t, double>& hessian,
+            const RectangularMatrix<double>& constraint_jacobian, size_t number_variables, size_t number_constraints) const;
+      void assemble_and_record_pattern(const SymmetricMatrix<size_t, double>& hessian, const RectangularMatrix<double>& constraint_jacobian,
+            size_t number_variables, size_t number_constraints);
+      void scatter_values(const SymmetricMatrix<size_t, double>& hessian, const RectangularMatrix<double>& constraint_jacobian,
+            size_t number_constraints);
+      void set_regularization(size_t size_primal_block);
+      [[nodiscard]] bool has_correct_inertia(const DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
+            size_t size_dual_block) const;
+      [[nodiscard]] bool passes_curvature_test(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
+            size_t size_primal_block);
+      [[nodiscard]] ElementType initial_primal_regularization() const;
    };
 
    template <typename ElementType>
@@ -60,126 +110,372 @@ namespace uno {
          primal_regularization_decrease_factor(ElementType(options.get_double("primal_regularization_decrease_factor"))),
          primal_regularization_fast_increase_factor(ElementType(options.get_double("primal_regularization_fast_increase_factor"))),
          primal_regularization_slow_increase_factor(ElementType(options.get_double("primal_regularization_slow_increase_factor"))),
-         threshold_unsuccessful_attempts(options.get_unsigned_int("threshold_unsuccessful_attempts")) {
+         threshold_unsuccessful_attempts(options.get_unsigned_int("threshold_unsuccessful_attempts")),
+         use_predictive_regularization(options.get_string("regularization_strategy") == "predictive"),
+         regularization_predictor(this->primal_regularization_lb, this->primal_regularization_decrease_factor,
+               options.get_double("regularization_skip_threshold"), options.get_double("regularization_history_weight")),
+         use_curvature_test(options.get_string("regularization_acceptance_test") == "curvature"),
+         curvature_test_parameter(ElementType(options.get_double("curvature_test_parameter"))),
+         primal_direction(dimension) {
+      const std::string& regularization_strategy = options.get_string("regularization_strategy");
+      if (regularization_strategy != "standard" && regularization_strategy != "predictive") {
+         throw std::invalid_argument("The regularization strategy " + regularization_strategy + " is unknown");
+      }
+      const std::string& acceptance_test = options.get_string("regularization_acceptance_test");
+      if (acceptance_test != "inertia" && acceptance_test != "curvature") {
+         throw std::invalid_argument("The regularization acceptance test " + acceptance_test + " is unknown");
+      }
    }
 
    template <typename ElementType>
    void SymmetricIndefiniteLinearSystem<ElementType>::assemble_matrix(const SymmetricMatrix<size_t, double>& hessian,
          const RectangularMatrix<double>& constraint_jacobian, size_t number_variables, size_t number_constraints) {
-      this->matrix.set_dimension(number_variables + number_constraints);
-      this->matrix.reset();
-      // copy the Lagrangian Hessian in the top left block
-      //size_t current_column = 0;
-      for (const auto [row_index, column_index, element]: hessian) {
-         // finalize all empty columns
-         /*for (size_t column: Range(current_column, column_index)) {
-            this->matrix.finalize_column(column);
-            current_column++;
-         }*/
-         this->matrix.insert(element, row_index, column_index);
+      this->solution_is_up_to_date = false;
+      if (this->assembly_pattern_is_compatible(hessian, constraint_jacobian, number_variables, number_constraints)) {
+         this->scatter_values(hessian, constraint_jacobian, number_constraints);
       }
-
-      // Jacobian of general constraints
-      for (size_t column_index: Range(number_constraints)) {
-         for (const auto [row_index, derivative]: constraint_jacobian[column_index]) {
-            this->matrix.insert(derivative, row_index, number_variables + column_index);
-         }
-         this->matrix.finalize_column(column_index);
+      else {
+         this->assemble_and_record_pattern(hessian, constraint_jacobian, number_variables, number_constraints);
       }
    }
 
    template <typename ElementType>
-   void SymmetricIndefiniteLinearSystem<ElementType>::factorize_matrix(const Model& model,
-         DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver) {
-      // compute the symbolic factorization only when:
-      // the problem has a non-constant augmented system (ie is not an LP or a QP) or it is the first factorization
-      if (true || this->number_factorizations == 0 || not model.fixed_hessian_sparsity) {
-         linear_solver.do_symbolic_factorization(this->matrix);
-      }
+   void SymmetricIndefiniteLinearSystem<ElementType>::factorize_matrix(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver) {
+      // the linear solver reuses its symbolic factorization when the sparsity pattern of the matrix did not change
+      linear_solver.do_symbolic_factorization(this->matrix);
       linear_solver.do_numerical_factorization(this->matrix);
       this->number_factorizations++;
    }
 
+   // factorize the matrix and correct its inertia with primal (and, if singular, dual) regularization.
+   // With the curvature test, the rhs must be assembled beforehand: the system is solved for each trial factorization
    template <typename ElementType>
-   void SymmetricIndefiniteLinearSystem<ElementType>::regularize_matrix(Statistics& statistics, const Model& model,
+   void SymmetricIndefiniteLinearSystem<ElementType>::regularize_matrix(Statistics& statistics,
          DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver, size_t size_primal_block, size_t size_dual_block,
          ElementType dual_regularization_parameter) {
       DEBUG2 << "Original matrix\n" << this->matrix << '\n';
+      const size_t initial_number_factorizations = this->number_factorizations;
       this->primal_regularization = ElementType(0.);
       this->dual_regularization = ElementType(0.);
+      // the predictive strategy skips the unregularized factorization when a correction is very likely
+      if (this->use_predictive_regularization && this->regularization_predictor.skip_unregularized_trial()) {
+         this->primal_regularization = this->regularization_predictor.predicted_regularization();
+         DEBUG << "Skipping the unregularized factorization (correction frequency " << this->regularization_predictor.frequency() << ")\n";
+         this->set_regularization(size_primal_block);
+      }
       size_t number_attempts = 1;
       DEBUG << "Testing factorization with regularization factors (" << this->primal_regularization << ", " << this->dual_regularization << ")\n";
+      this->factorize_matrix(linear_solver);
 
-      if (not linear_solver.matrix_is_singular() && linear_solver.number_negative_eigenvalues() == size_dual_block) {
-         DEBUG << "Inertia is good\n";
-         statistics.set("regularization", this->primal_regularization);
-         return;
-      }
-      auto [number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues] = linear_solver.get_inertia();
-      DEBUG << "Expected inertia (" << size_primal_block << ", " << size_dual_block << ", 0), ";
-      DEBUG << "got (" << number_pos_eigenvalues << ", " << number_neg_eigenvalues << ", " << number_zero_eigenvalues << ")\n";
-      DEBUG << "Number of attempts: " << number_attempts << "\n\n";
-
-      // set the constraint regularization coefficient
-      if (linear_solver.matrix_is_singular()) {
-         DEBUG << "Matrix is singular\n";
-         this->dual_regularization = this->dual_regularization_fraction * dual_regularization_parameter;
-      }
-      // set the Hessian regularization coefficient
-      if (this->previous_primal_regularization == 0.) {
-         this->primal_regularization = this->primal_regularization_initial_factor;
-      }
-      else {
-         this->primal_regularization = std::max(this->primal_regularization_lb,
-               this->previous_primal_regularization / this->primal_regularization_decrease_factor);
-      }
-
-      // regularize the augmented matrix
-      this->matrix.set_regularization([=](size_t row_index) {
-         return (row_index < size_primal_block) ? this->primal_regularization : -this->dual_regularization;
-      });
-
+      const bool curvature_test = this->uses_curvature_test(linear_solver);
       bool good_inertia = false;
       while (not good_inertia) {
-         DEBUG << "Testing factorization with regularization factors (" << this->primal_regularization << ", " << this->dual_regularization << ")\n";
-         DEBUG2 << this->matrix << '\n';
-         this->factorize_matrix(model, linear_solver);
-         number_attempts++;
-
-         if (not linear_solver.matrix_is_singular() && linear_solver.number_negative_eigenvalues() == size_dual_block) {
+         const bool accepted = curvature_test ? this->passes_curvature_test(linear_solver, size_primal_block) :
+               this->has_correct_inertia(linear_solver, size_dual_block);
+         if (accepted) {
             good_inertia = true;
-            DEBUG << "Factorization was a success\n";
-            this->previous_primal_regularization = this->primal_regularization;
+            DEBUG << ((this->primal_regularization == ElementType(0.)) ? "Inertia is good\n" : "Factorization was a success\n");
+            if (ElementType(0.) < this->primal_regularization) {
+               this->previous_primal_regularization = this->primal_regularization;
+            }
          }
          else {
-            std::tie(number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues) = linear_solver.get_inertia();
-            DEBUG << "Expected inertia (" << size_primal_block << ", " << size_dual_block << ", 0), ";
-            DEBUG << "got (" << number_pos_eigenvalues << ", " << number_neg_eigenvalues << ", " << number_zero_eigenvalues << ")\n";
+            if (not curvature_test) {
+               auto [number_pos_eigenvalues, number_neg_eigenvalues, number_zero_eigenvalues] = linear_solver.get_inertia();
+               DEBUG << "Expected inertia (" << size_primal_block << ", " << size_dual_block << ", 0), ";
+               DEBUG << "got (" << number_pos_eigenvalues << ", " << number_neg_eigenvalues << ", " << number_zero_eigenvalues << ")\n";
+            }
             DEBUG << "Number of attempts: " << number_attempts << "\n";
-            if (this->previous_primal_regularization == 0. || this->threshold_unsuccessful_attempts < number_attempts) {
-               this->primal_regularization *= this->primal_regularization_fast_increase_factor;
+
+            // set the constraint regularization coefficient after the first factorization. Without inertia, a singular
+            // matrix shows up as a non-finite solution
+            const bool singular_matrix = linear_solver.provides_inertia() ? linear_solver.matrix_is_singular() :
+                  not this->solution_is_up_to_date;
+            if (number_attempts == 1 && singular_matrix) {
+               DEBUG << "Matrix is singular\n";
+               this->dual_regularization = this->dual_regularization_fraction * dual_regularization_parameter;
+            }
+            // set the Hessian regularization coefficient
+            if (this->primal_regularization == ElementType(0.)) {
+               this->primal_regularization = this->initial_primal_regularization();
             }
             else {
-               this->primal_regularization *= this->primal_regularization_slow_increase_factor;
+               this->regularization_predictor.record_failure(this->primal_regularization);
+               if (this->previous_primal_regularization == 0. || this->threshold_unsuccessful_attempts < number_attempts) {
+                  this->primal_regularization *= this->primal_regularization_fast_increase_factor;
+               }
+               else {
+                  this->primal_regularization *= this->primal_regularization_slow_increase_factor;
+               }
             }
 
             if (this->primal_regularization <= this->regularization_failure_threshold) {
                // regularize the augmented matrix
-               this->matrix.set_regularization([=](size_t row_index) {
-                  return (row_index < size_primal_block) ? this->primal_regularization : -this->dual_regularization;
-               });
+               this->set_regularization(size_primal_block);
             }
             else {
                throw UnstableRegularization();
             }
+            DEBUG << "Testing factorization with regularization factors (" << this->primal_regularization << ", " << this->dual_regularization << ")\n";
+            DEBUG2 << this->matrix << '\n';
+            this->factorize_matrix(linear_solver);
+            number_attempts++;
          }
       }
+      this->regularization_predictor.record_success(this->primal_regularization);
       statistics.set("regularization", this->primal_regularization);
+      statistics.set("factorizations", this->number_factorizations - initial_number_factorizations);
    }
 
+   // first nonzero primal regularization of an inertia correction
    template <typename ElementType>
-   void SymmetricIndefiniteLinearSystem<ElementType>::solve(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver) {
+   ElementType SymmetricIndefiniteLinearSystem<ElementType>::initial_primal_regularization() const {
+      if (this->use_predictive_regularization && ElementType(0.) < this->regularization_predictor.predicted_regularization()) {
+         return this->regularization_predictor.predicted_regularization();
+      }
+      else if (this->previous_primal_regularization == 0.) {
+         return this->primal_regularization_initial_factor;
+      }
+      else {
+         return std::max(this->primal_regularization_lb, this->previous_primal_regularization / this->primal_regularization_decrease_factor);
+      }
+   }
+
+   template <typename ElementType>
+   bool SymmetricIndefiniteLinearSystem<ElementType>::has_correct_inertia(const DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
+         size_t size_dual_block) const {
+      return not linear_solver.matrix_is_singular() && linear_solver.number_negative_eigenvalues() == size_dual_block;
+   }
+
+   // inertia-free test (Chiang and Zavala): the primal step d of the regularized system must have sufficiently positive
+   // curvature d^T (W + δ I) d >= α ||d||^2. The augmented matrix is applied to (d, 0), which leaves out the Jacobian
+   // and the dual regularization. A correct inertia guarantees this, but the test also accepts factorizations with a wrong
+   // inertia whose step is a direction of positive curvature
+   template <typename ElementType>
+   bool SymmetricIndefiniteLinearSystem<ElementType>::passes_curvature_test(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
+         size_t size_primal_block) {
+      this->solution_is_up_to_date = false;
+      if (linear_solver.provides_inertia() && linear_solver.matrix_is_singular()) {
+         DEBUG << "Matrix is singular\n";
+         return false;
+      }
       linear_solver.solve_indefinite_system(this->matrix, this->rhs, this->solution);
+      const size_t dimension = this->matrix.dimension();
+      ElementType squared_norm = ElementType(0.);
+      for (size_t index: Range(dimension)) {
+         if (not std::isfinite(this->solution[index])) {
+            DEBUG << "The solution is not finite\n";
+            return false;
+         }
+         this->primal_direction[index] = (index < size_primal_block) ? this->solution[index] : ElementType(0.);
+         if (index < size_primal_block) {
+            squared_norm += this->solution[index] * this->solution[index];
+         }
+      }
+      this->solution_is_up_to_date = true;
+      const ElementType curvature = this->matrix.quadratic_product(this->primal_direction, this->primal_direction);
+      DEBUG << "Curvature of the step: " << curvature << " (threshold " << this->curvature_test_parameter * squared_norm << ")\n";
+      return this->curvature_test_parameter * squared_norm <= curvature;
+   }
+
+   template <typename ElementType>
+   size_t SymmetricIndefiniteLinearSystem<ElementType>::get_number_factorizations() const {
+      return this->number_factorizations;
+   }
+
+   template <typename ElementType>
+   bool SymmetricIndefiniteLinearSystem<ElementType>::uses_curvature_test(
+         const DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver) const {
+      return this->use_curvature_test || not linear_solver.provides_inertia();
+   }
+
+   template <typename ElementType>
+   void SymmetricIndefiniteLinearSystem<ElementType>::solve(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver) {
+      // the curvature test may have solved the system with the accepted factorization already
+      if (not this->solution_is_up_to_date) {
+         linear_solver.solve_indefinite_system(this->matrix, this->rhs, this->solution);
+      }
+      this->solution_is_up_to_date = false;
+   }
+
+   // Sherman-Morrison-Woodbury formula: with K the factorized matrix and U = [Ψ; 0],
+   // (K - U N^{-1} U^T)^{-1} r = K^{-1} r + K^{-1} U (N - U^T K^{-1} U)^{-1} U^T K^{-1} r.
+   // The factorization of K is reused with rank additional right-hand sides and a dense rank x rank system is solved
+   template <typename ElementType>
+   void SymmetricIndefiniteLinearSystem<ElementType>::solve(DirectSymmetricIndefiniteLinearSolver<size_t, ElementType>& linear_solver,
+         const LowRankCorrection<ElementType>& correction) {
+      // K^{-1} r
+      this->solve(linear_solver);
+      const size_t rank = correction.get_rank();
+      if (rank == 0) {
+         return;
+      }
+      const size_t dimension = this->matrix.dimension();
+      const size_t correction_dimension = correction.get_dimension();
+      assert(correction_dimension <= dimension && "The dimension of the low-rank correction is larger than the dimension of the system");
+
+      // Z = K^{-1} U
+      if (this->correction_rhs.size() < dimension * rank) {
+         this->correction_rhs = Vector<ElementType>(dimension * rank);
+         this->correction_solutions = Vector<ElementType>(dimension * rank);
+      }
+      const std::vector<ElementType>& basis = correction.get_basis();
+      for (size_t column_index: Range(rank)) {
+         for (size_t index: Range(dimension)) {
+            this->correction_rhs[column_index * dimension + index] = (index < correction_dimension) ? basis[column_index * correction_dimension + index] :
+                  ElementType(0);
+         }
+      }
+      linear_solver.solve_indefinite_systems(this->matrix, this->correction_rhs, this->correction_solutions, rank);
+
+      // capacitance matrix N - Ψ^T Z and projected solution Ψ^T K^{-1} r
+      std::vector<ElementType> capacitance = correction.get_middle_matrix();
+      std::vector<ElementType> coefficients(rank, ElementType(0));
+      for (size_t row_index: Range(rank)) {
+         const ElementType* basis_column = basis.data() + row_index * correction_dimension;
+         for (size_t column_index: Range(rank)) {
+            const ElementType* Z_column = this->correction_solutions.data() + column_index * dimension;
+            ElementType dot_product = ElementType(0);
+            for (size_t index = 0; index < correction_dimension; index++) {
+               dot_product += basis_column[index] * Z_column[index];
+            }
+            capacitance[column_index * rank + row_index] -= dot_product;
+         }
+         for (size_t index = 0; index < correction_dimension; index++) {
+            coefficients[row_index] += basis_column[index] * this->solution[index];
+         }
+      }
+      DenseLUFactorization<ElementType> capacitance_factorization;
+      if (not capacitance_factorization.factorize(capacitance, rank)) {
+         throw std::runtime_error("SymmetricIndefiniteLinearSystem: the capacitance matrix of the low-rank correction is singular");
+      }
+      capacitance_factorization.solve(coefficients);
+
+      // K^{-1} r + Z (N - Ψ^T Z)^{-1} Ψ^T K^{-1} r
+      for (size_t column_index: Range(rank)) {
+         const ElementType* Z_column = this->correction_solutions.data() + column_index * dimension;
+         for (size_t index = 0; index < dimension; index++) {
+            this->solution[index] += coefficients[column_index] * Z_column[index];
+         }
+      }
+   }
+
+   template <typename ElementType>
+   void SymmetricIndefiniteLinearSystem<ElementType>::discard_assembly_pattern() {
+      this->assembly_pattern_recorded = false;
+   }
+
+   template <typename ElementType>
+   bool SymmetricIndefiniteLinearSystem<ElementType>::assembly_pattern_is_compatible(const SymmetricMatrix<size_t, double>& hessian,
+         const RectangularMatrix<double>& constraint_jacobian, size_t number_variables, size_t number_constraints) const {
+      if (not this->assembly_pattern_recorded || number_variables != this->assembled_number_variables ||
+            number_constraints != this->assembled_number_constraints || hessian.number_nonzeros() != this->hessian_positions.size()) {
+         return false;
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         const size_t recorded_row_size = this->jacobian_row_starts[constraint_index + 1] - this->jacobian_row_starts[constraint_index];
+         if (constraint_jacobian[constraint_index].size() != recorded_row_size) {
+            return false;
+         }
+      }
+      // same sizes: compare the indices of the entries
+      size_t jacobian_nonzero_index = 0;
+      for (size_t constraint_index: Range(number_constraints)) {
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            if (variable_index != this->jacobian_column_indices[jacobian_nonzero_index]) {
+               return false;
+            }
+            jacobian_nonzero_index++;
+         }
+      }
+      bool same_hessian_pattern = true;
+      size_t hessian_nonzero_index = 0;
+      hessian.for_each_nonzero([&](size_t row_index, size_t column_index, double /*element*/) {
+         if (same_hessian_pattern && (row_index != this->hessian_indices[2 * hessian_nonzero_index] ||
+               column_index != this->hessian_indices[2 * hessian_nonzero_index + 1])) {
+            same_hessian_pattern = false;
+         }
+         hessian_nonzero_index++;
+      });
+      return same_hessian_pattern;
+   }
+
+   template <typename ElementType>
+   void SymmetricIndefiniteLinearSystem<ElementType>::assemble_and_record_pattern(const SymmetricMatrix<size_t, double>& hessian,
+         const RectangularMatrix<double>& constraint_jacobian, size_t number_variables, size_t number_constraints) {
+      this->matrix.set_dimension(number_variables + number_constraints);
+      this->matrix.reset();
+      this->hessian_positions.clear();
+      this->hessian_indices.clear();
+      this->jacobian_positions.clear();
+      this->jacobian_column_indices.clear();
+      this->jacobian_row_starts.clear();
+      this->regularization_positions.clear();
+
+      // copy the Lagrangian Hessian in the top left block
+      //size_t current_column = 0;
+      hessian.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+         // finalize all empty columns
+         /*for (size_t column: Range(current_column, column_index)) {
+            this->matrix.finalize_column(column);
+            current_column++;
+         }*/
+         this->hessian_positions.emplace_back(this->matrix.number_nonzeros());
+         this->hessian_indices.emplace_back(row_index);
+         this->hessian_indices.emplace_back(column_index);
+         this->matrix.insert(element, row_index, column_index);
+      });
+
+      // Jacobian of general constraints
+      this->jacobian_row_starts.emplace_back(0);
+      for (size_t column_index: Range(number_constraints)) {
+         for (const auto [row_index, derivative]: constraint_jacobian[column_index]) {
+            this->jacobian_positions.emplace_back(this->matrix.number_nonzeros());
+            this->jacobian_column_indices.emplace_back(row_index);
+            this->matrix.insert(derivative, row_index, number_variables + column_index);
+         }
+         this->jacobian_row_starts.emplace_back(this->jacobian_positions.size());
+         this->matrix.finalize_column(column_index);
+      }
+
+      // diagonal regularization terms
+      for (size_t row_index: Range(number_variables + number_constraints)) {
+         this->regularization_positions.emplace_back(this->matrix.regularization_position(row_index));
+      }
+      this->assembled_number_variables = number_variables;
+      this->assembled_number_constraints = number_constraints;
+      this->assembly_pattern_recorded = true;
+   }
+
+   template <typename ElementType>
+   void SymmetricIndefiniteLinearSystem<ElementType>::scatter_values(const SymmetricMatrix<size_t, double>& hessian,
+         const RectangularMatrix<double>& constraint_jacobian, size_t number_constraints) {
+      ElementType* values = this->matrix.data_pointer();
+      // Lagrangian Hessian: the values are stored in the order of traversal
+      const double* hessian_values = hessian.data_pointer();
+      for (size_t nonzero_index: Range(this->hessian_positions.size())) {
+         values[this->hessian_positions[nonzero_index]] = hessian_values[nonzero_index];
+      }
+      // Jacobian of general constraints
+      size_t jacobian_nonzero_index = 0;
+      for (size_t constraint_index: Range(number_constraints)) {
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            values[this->jacobian_positions[jacobian_nonzero_index]] = derivative;
+            jacobian_nonzero_index++;
+         }
+      }
+      // reset the regularization terms
+      for (const size_t position: this->regularization_positions) {
+         values[position] = ElementType(0);
+      }
+   }
+
+   template <typename ElementType>
+   void SymmetricIndefiniteLinearSystem<ElementType>::set_regularization(size_t size_primal_block) {
+      ElementType* values = this->matrix.data_pointer();
+      for (size_t row_index: Range(this->regularization_positions.size())) {
+         values[this->regularization_positions[row_index]] = (row_index < size_primal_block) ? this->primal_regularization : -this->dual_regularization;
+      }
    }
 
    /*
@@ -38,11 +38,17 @@ namespace uno {
       void set_regularization(const std::function<ElementType(size_t /*index*/)>& regularization_function) {
          this->sparse_storage->set_regularization(regularization_function);
       }
+      [[nodiscard]] size_t regularization_position(size_t index) const { return this->sparse_storage->regularization_position(index); }
 
       static SymmetricMatrix<IndexType, ElementType> zero(size_t dimension) {
          return {dimension, 0, false, "COO"}; // TODO change
       }
 
+      // non-virtual traversal of the nonzeros in storage order: the concrete storage is resolved once, then
+      // function(row_index, column_index, element) is inlined in the loop over the nonzeros
+      template <typename Function>
+      void for_each_nonzero(Function&& function) const;
+
       typename SparseStorage<IndexType, ElementType>::iterator begin() const { return this->sparse_storage->begin(); }
       typename SparseStorage<IndexType, ElementType>::iterator end() const { return this->sparse_storage->end(); }
 
@@ -64,15 +70,33 @@ namespace uno {
          sparse_storage(SparseStorageFactory<IndexType, ElementType>::create(sparse_format, dimension, capacity, use_regularization)) {
    }
    
+   template <typename IndexType, typename ElementType>
+   template <typename Function>
+   inline void SymmetricMatrix<IndexType, ElementType>::for_each_nonzero(Function&& function) const {
+      const SparseStorage<IndexType, ElementType>* storage = this->sparse_storage.get();
+      if (const auto* COO_storage = dynamic_cast<const COOSparseStorage<IndexType, ElementType>*>(storage)) {
+         COO_storage->for_each_nonzero(std::forward<Function>(function));
+      }
+      else if (const auto* CSC_storage = dynamic_cast<const CSCSparseStorage<IndexType, ElementType>*>(storage)) {
+         CSC_storage->for_each_nonzero(std::forward<Function>(function));
+      }
+      else {
+         // unknown storage: fall back to the virtual iterator
+         for (const auto [row_index, column_index, element]: *storage) {
+            function(row_index, column_index, element);
+         }
+      }
+   }
+
    template <typename IndexType, typename ElementType>
    // TODO fix. We need to scan through all the columns
    inline ElementType SymmetricMatrix<IndexType, ElementType>::smallest_diagonal_entry(size_t max_dimension) const {
       ElementType smallest_entry = INF<ElementType>;
-      for (const auto [row_index, column_index, element]: *this->sparse_storage) {
-         if (row_index == column_index && row_index < max_dimension) {
+      this->for_each_nonzero([&](IndexType row_index, IndexType column_index, ElementType element) {
+         if (row_index == column_index && static_cast<size_t>(row_index) < max_dimension) {
             smallest_entry = std::min(smallest_entry, element);
          }
-      }
+      });
       if (smallest_entry == INF<ElementType>) {
          smallest_entry = ElementType(0);
       }
@@ -87,7 +111,7 @@ namespace uno {
       assert(x.size() == y.size() && "SymmetricMatrix::quadratic_product: the two vectors x and y do not have the same size");
 
       ElementType result = ElementType(0);
-      for (const auto [row_index, column_index, element]: *this) {
+      this->for_each_nonzero([&](IndexType row_index, IndexType column_index, ElementType element) {
          if (row_index == column_index) {
             // diagonal term
             result += element * x[row_index] * y[row_index];
@@ -96,7 +120,7 @@ namespace uno {
             // off-diagonal term
             result += element * (x[row_index] * y[column_index] + x[column_index] * y[row_index]);
          }
-      }
+      });
       return result;
    }
 
@@ -64,7 +64,7 @@ namespace uno {
       // add the fixed variables
       size_t current_constraint = this->model->number_constraints;
       for (size_t fixed_variable_index: this->model->get_fixed_variables()) {
-         constraint_jacobian[current_constraint].insert(fixed_variable_index, 1.);
+         constraint_jacobian.insert(1., current_constraint, fixed_variable_index);
          current_constraint++;
       }
    }
@@ -74,6 +74,17 @@ namespace uno {
       this->model->evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
    }
 
+   void FixedBoundsConstraintsModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      // the bound constraints are linear and do not enter the Hessian
+      this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+   }
+
+   void FixedBoundsConstraintsModel::compute_element_functions(std::vector<ElementFunction>& elements) const {
+      // the bound constraints are linear and have no element
+      this->model->compute_element_functions(elements);
+   }
+
    double FixedBoundsConstraintsModel::variable_lower_bound(size_t variable_index) const {
       if (this->model->variable_lower_bound(variable_index) == this->model->variable_upper_bound(variable_index)) {
       // remove bounds of fixed variables
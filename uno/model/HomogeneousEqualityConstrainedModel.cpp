@@ -88,7 +88,7 @@ namespace uno {
       this->model->evaluate_constraint_jacobian(x, constraint_jacobian);
       // add the slack contributions
       for (const auto [constraint_index, slack_index]: this->get_slacks()) {
-         constraint_jacobian[constraint_index].insert(slack_index, -1.);
+         constraint_jacobian.insert(-1., constraint_index, slack_index);
       }
    }
 
@@ -101,6 +101,20 @@ namespace uno {
       }
    }
 
+   void HomogeneousEqualityConstrainedModel::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier,
+         const Vector<double>& multipliers, const Vector<double>& vector, Vector<double>& result) const {
+      this->model->evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, result);
+      // the slacks do not enter the Hessian
+      for (size_t slack_index: Range(this->model->number_variables, this->number_variables)) {
+         result[slack_index] = 0.;
+      }
+   }
+
+   void HomogeneousEqualityConstrainedModel::compute_element_functions(std::vector<ElementFunction>& elements) const {
+      // the slacks appear linearly in the constraints
+      this->model->compute_element_functions(elements);
+   }
+
    double HomogeneousEqualityConstrainedModel::variable_lower_bound(size_t variable_index) const {
       if (variable_index < this->model->number_variables) { // original variable
          return this->model->variable_lower_bound(variable_index);
@@ -4,6 +4,7 @@
 #ifndef UNO_MODEL_H
 #define UNO_MODEL_H
 
+#include <limits>
 #include <string>
 #include <vector>
 #include "linear_algebra/Norm.hpp"
@@ -29,6 +30,14 @@ namespace uno {
    // forward declaration
    class Iterate;
 
+   // element function of a partially separable function (objective or constraint): its Hessian is nonzero only on its variables
+   struct ElementFunction {
+      static constexpr size_t OBJECTIVE{std::numeric_limits<size_t>::max()};
+
+      size_t constraint_index; /*!< Index of the constraint, or OBJECTIVE */
+      std::vector<size_t> variables; /*!< Variables that appear nonlinearly in the element */
+   };
+
    /*! \class Problem
     * \brief Optimization problem
     *
@@ -54,6 +63,11 @@ namespace uno {
       virtual void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const = 0;
       virtual void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
             SymmetricMatrix<size_t, double>& hessian) const = 0;
+      // result = ∇²L(x, σ, λ) vector: the Hessian is never formed, which is required by matrix-free algorithms
+      virtual void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const = 0;
+      // partially separable structure of the objective and the constraints (the elements of a function may overlap)
+      virtual void compute_element_functions(std::vector<ElementFunction>& elements) const = 0;
 
       // purely virtual functions
       [[nodiscard]] virtual double variable_lower_bound(size_t variable_index) const = 0;
@@ -9,10 +9,10 @@
 #include "tools/Logger.hpp"
 
 namespace uno {
-   size_t Iterate::number_eval_objective = 0;
-   size_t Iterate::number_eval_constraints = 0;
-   size_t Iterate::number_eval_objective_gradient = 0;
-   size_t Iterate::number_eval_jacobian = 0;
+   thread_local size_t Iterate::number_eval_objective = 0;
+   thread_local size_t Iterate::number_eval_constraints = 0;
+   thread_local size_t Iterate::number_eval_objective_gradient = 0;
+   thread_local size_t Iterate::number_eval_jacobian = 0;
 
    Iterate::Iterate(size_t number_variables, size_t number_constraints) :
          number_variables(number_variables), number_constraints(number_constraints),
@@ -79,6 +79,13 @@ namespace uno {
       this->residuals.lagrangian_gradient.resize(new_number_variables);
    }
 
+   void Iterate::reset_evaluation_counters() {
+      Iterate::number_eval_objective = 0;
+      Iterate::number_eval_constraints = 0;
+      Iterate::number_eval_objective_gradient = 0;
+      Iterate::number_eval_jacobian = 0;
+   }
+
    std::ostream& operator<<(std::ostream& stream, const Iterate& iterate) {
       stream << "Primal variables: " << iterate.primals << '\n';
       stream << "            ┌ Constraint: " << iterate.multipliers.constraints << '\n';
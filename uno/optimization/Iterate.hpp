@@ -30,10 +30,11 @@ namespace uno {
 
       // evaluations
       Evaluations evaluations;
-      static size_t number_eval_objective;
-      static size_t number_eval_constraints;
-      static size_t number_eval_objective_gradient;
-      static size_t number_eval_jacobian;
+      // the evaluation counters are per thread and are reset at the beginning of each solve: concurrent solves count their own evaluations
+      static thread_local size_t number_eval_objective;
+      static thread_local size_t number_eval_constraints;
+      static thread_local size_t number_eval_objective_gradient;
+      static thread_local size_t number_eval_jacobian;
       // lazy evaluation flags
       bool is_objective_computed{false};
       bool are_constraints_computed{false};
@@ -57,6 +58,7 @@ namespace uno {
       void evaluate_constraint_jacobian(const Model& model);
 
       void set_number_variables(size_t number_variables);
+      static void reset_evaluation_counters();
 
       friend std::ostream& operator<<(std::ostream& stream, const Iterate& iterate);
    };
@@ -38,7 +38,7 @@ namespace uno {
          DISCRETE << "Objective multiplier:\t\t\t" << this->solution.objective_multiplier << '\n';
       }
 
-      DISCRETE << "CPU time:\t\t\t\t" << this->cpu_time << "s\n";
+      DISCRETE << "Solve time:\t\t\t\t" << this->solve_time << "s\n";
       DISCRETE << "Iterations:\t\t\t\t" << this->iteration << '\n';
       DISCRETE << "Objective evaluations:\t\t\t" << this->objective_evaluations << '\n';
       DISCRETE << "Constraints evaluations:\t\t" << this->constraint_evaluations << '\n';
@@ -14,7 +14,7 @@ namespace uno {
       size_t number_variables;
       size_t number_constraints;
       size_t iteration;
-      double cpu_time;
+      double solve_time;
       size_t objective_evaluations;
       size_t constraint_evaluations;
       size_t objective_gradient_evaluations;
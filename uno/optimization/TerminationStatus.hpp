@@ -15,6 +15,12 @@ namespace uno {
       UNBOUNDED
    };
 
+   // the final point is feasible (with or without convergence to a stationary point)
+   inline bool is_feasible_status(TerminationStatus status) {
+      return status == TerminationStatus::FEASIBLE_KKT_POINT || status == TerminationStatus::FEASIBLE_FJ_POINT ||
+         status == TerminationStatus::FEASIBLE_SMALL_STEP;
+   }
+
    inline std::string status_to_message(TerminationStatus status) {
       if (status == TerminationStatus::FEASIBLE_KKT_POINT) {
          return "Converged with feasible KKT point";
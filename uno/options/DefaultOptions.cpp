@@ -19,7 +19,7 @@ namespace uno {
       options["loose_tolerance_consecutive_iteration_threshold"] = "15";
       // maximum outer iterations
       options["max_iterations"] = "2000";
-      // CPU time limit (in seconds)
+      // time limit (elapsed time in seconds)
       options["time_limit"] = "inf";
       // print optimal solution (yes|no)
       options["print_solution"] = "no";
@@ -39,6 +39,7 @@ namespace uno {
       options["statistics_LS_step_length_column_order"] = "10";
       options["statistics_restoration_phase_column_order"] = "20";
       options["statistics_regularization_column_order"] = "21";
+      options["statistics_factorizations_column_order"] = "22";
       options["statistics_funnel_width_column_order"] = "25";
       options["statistics_step_norm_column_order"] = "31";
       options["statistics_objective_column_order"] = "100";
@@ -51,8 +52,17 @@ namespace uno {
       /** main options **/
       // logging level (SILENT|DISCRETE|WARNING|INFO|DEBUG|DEBUG2|DEBUG3)
       options["logger"] = "INFO";
-      // Hessian model (exact|zero)
+      // Hessian model (exact|LBFGS|partitioned|zero)
       options["hessian_model"] = "exact";
+      // reuse the exact Hessian over several iterations (yes|no)
+      options["hessian_reuse"] = "no";
+      // the Hessian is refreshed after this number of reuses
+      options["hessian_reuse_maximum_age"] = "5";
+      // the Hessian is refreshed when the primals or multipliers moved by more than these relative thresholds
+      options["hessian_reuse_primal_threshold"] = "1e-2";
+      options["hessian_reuse_multiplier_threshold"] = "1e-2";
+      // the Hessian is refreshed when the accepted step is shorter than this fraction of the direction
+      options["hessian_reuse_acceptance_threshold"] = "0.5";
       // sparse matrix format (COO|CSC)
       options["sparse_format"] = "COO";
       // scale the functions (yes|no)
@@ -69,6 +79,9 @@ namespace uno {
       options["residual_scaling_threshold"] = "100.";
       options["protect_actual_reduction_against_roundoff"] = "no";
       options["print_subproblem"] = "no";
+      // fill-reducing ordering of the direct linear solvers (solver|AMD|nested_dissection).
+      // solver: ordering chosen by the linear solver (AMD for native_LDL)
+      options["linear_solver_ordering"] = "solver";
 
       /** globalization strategy options **/
       options["armijo_decrease_fraction"] = "1e-4";
@@ -121,8 +134,30 @@ namespace uno {
       options["primal_regularization_decrease_factor"] = "3.";
       options["primal_regularization_fast_increase_factor"] = "100.";
       options["primal_regularization_slow_increase_factor"] = "8.";
+      // inertia correction of the augmented system (standard|predictive)
+      // predictive: start from a regularization predicted from the previous corrections
+      options["regularization_strategy"] = "standard";
+      // frequency of corrections above which the unregularized factorization is skipped (predictive strategy)
+      options["regularization_skip_threshold"] = "0.5";
+      // weight of the history in the moving average of the frequency of corrections (predictive strategy)
+      options["regularization_history_weight"] = "0.7";
+      // acceptance test of a regularized factorization (inertia|curvature)
+      // curvature: inertia-free test d^T W d >= alpha ||d||^2 on the computed primal step (Chiang and Zavala)
+      options["regularization_acceptance_test"] = "inertia";
+      // constant alpha of the curvature test
+      options["curvature_test_parameter"] = "1e-10";
       options["threshold_unsuccessful_attempts"] = "8";
 
+      /** quasi-Newton options **/
+      // number of pairs (s, y) of the limited-memory model
+      options["quasi_newton_memory_size"] = "6";
+      // Powell damping when s^T y < threshold s^T B s
+      options["quasi_newton_damping_threshold"] = "0.2";
+      // the pair is skipped when s^T y <= tolerance ||s|| ||y||
+      options["quasi_newton_skip_tolerance"] = "1e-8";
+      // update of the element matrices of the partitioned model (SR1|BFGS)
+      options["quasi_newton_element_update"] = "SR1";
+
       /** trust region options **/
       // initial trust region radius
       options["TR_radius"] = "10.";
@@ -180,11 +215,73 @@ namespace uno {
       options["barrier_damping_factor"] = "1e-5";
       options["least_square_multiplier_max_norm"] = "1e3";
 
+      /** native LDL options **/
+      // threshold for the stability test of the pivots, in (0, 0.5]
+      options["native_LDL_pivot_tolerance"] = "0.01";
+      options["native_LDL_zero_pivot_tolerance"] = "1e-20";
+      // number of threads for the tree-level parallelism (0: number of hardware threads)
+      options["native_LDL_threads"] = "1";
+
+      /** MINRES options **/
+      options["MINRES_maximum_iterations"] = "5000";
+      // bounds of the inexact Newton relative tolerance min(maximum, sqrt(||rhs||))
+      options["MINRES_maximum_relative_tolerance"] = "1e-6";
+      options["MINRES_minimum_relative_tolerance"] = "1e-12";
+
       /** BQPD options **/
       options["BQPD_kmax"] = "500";
 
+      /** HiGHS options **/
+      // HiGHS needs the explicit Hessian: the low-rank correction of the LBFGS model is formed densely (O(n^2) memory and O(m n^2)
+      // time for n variables and memory size m). The combination is rejected above this number of variables
+      options["HiGHS_maximum_dense_hessian_dimension"] = "2000";
+
+      /** active-set QP solver options **/
+      // proximal term added to the diagonal of the Hessian, so that LPs and positive semidefinite QPs can be solved
+      options["active_set_QP_regularization"] = "1e-8";
+      // tolerance on the (scaled) constraint violation and on the signs of the multipliers
+      options["active_set_QP_tolerance"] = "1e-9";
+      // number of working set changes handled by the Schur complement before the KKT matrix is refactorized
+      options["active_set_QP_maximum_schur_size"] = "100";
+      options["active_set_QP_maximum_iterations"] = "10000";
+
+      /** interior-point QP solver options **/
+      // tolerance on the scaled primal and dual infeasibilities and on the average complementarity
+      options["interior_point_QP_tolerance"] = "1e-9";
+      options["interior_point_QP_maximum_iterations"] = "200";
+      // minimum fraction of the distance to the bounds covered by a step
+      options["interior_point_QP_fraction_to_boundary"] = "0.995";
+      // start from the approximate active set of the previous subproblem
+      options["interior_point_QP_warm_start"] = "yes";
+      // complementarity products of the warm-started point
+      options["interior_point_QP_warm_start_barrier_parameter"] = "1e-4";
+
+      /** multistart options **/
+      // number of starting points (1: no multistart). The first starting point is the initial point of the model
+      options["multistart_points"] = "1";
+      // number of concurrent runs (0: number of hardware threads)
+      options["multistart_threads"] = "0";
+      // sampling of the starting points (latin_hypercube|perturbation)
+      options["multistart_sampling"] = "latin_hypercube";
+      // half-width of the sampling box around the initial point (relative to max(1, |x0|)) when a bound is infinite
+      options["multistart_radius"] = "1.";
+      options["multistart_seed"] = "0";
+      // a run is cut off when its iterate is within this relative distance of a local solution found by another run
+      options["multistart_cutoff_distance"] = "1e-3";
+      options["multistart_cutoff_iteration"] = "5";
+
+      /** portfolio options **/
+      // strategy combinations that race in parallel, separated by commas (empty: no portfolio). A combination is a list of presets
+      // and option_name=option_value pairs separated by '+', e.g. ipopt,filtersqp,filtersqp+globalization_mechanism=LS
+      options["portfolio"] = "";
+
       /** AMPL options **/
       options["AMPL_write_solution_to_file"] = "yes";
+      // number of threads that evaluate the AMPL model, each with its own ASL instance (0: number of hardware threads)
+      options["AMPL_evaluation_threads"] = "1";
+      // batch mode: number of instances solved simultaneously (0: number of hardware threads) and file of the result records
+      options["AMPL_batch_threads"] = "0";
+      options["AMPL_batch_results_file"] = "uno_batch_results.csv";
 
       return options;
    }
@@ -210,7 +307,9 @@ namespace uno {
       }
 
       /** default preset **/
-      if (not QP_solvers.empty()) {
+      // filtersqp is the default preset only with BQPD, which solves nonconvex QPs. The other QP solvers (HiGHS and the in-tree solvers)
+      // require a convexified Hessian
+      if (not QP_solvers.empty() && QP_solvers[0] == "BQPD") {
          Options::set_preset(options, "filtersqp");
       }
       else if (not linear_solvers.empty()) {
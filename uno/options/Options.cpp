@@ -9,6 +9,13 @@
 namespace uno {
    Options::Options(bool are_default_options): are_default_options(are_default_options) { }
 
+   Options::Options(const Options& other): are_default_options(other.are_default_options) {
+      std::lock_guard<std::mutex> lock(other.mutex);
+      this->options = other.options;
+      this->used = other.used;
+      this->is_default = other.is_default;
+   }
+
    size_t Options::size() const {
       return this->options.size();
    }
@@ -23,6 +30,7 @@ namespace uno {
    const std::string& Options::at(const std::string& option_name) const {
       try {
          const std::string& option_value = this->options.at(option_name);
+         std::lock_guard<std::mutex> lock(this->mutex);
          this->used[option_name] = true;
          return option_value;
       }
@@ -203,6 +211,7 @@ namespace uno {
    }
 
    void Options::overwrite_with(const Options& overwriting_options) {
+      std::lock_guard<std::mutex> lock(overwriting_options.mutex);
       for (const auto& [option_name, option_value]: overwriting_options) {
          (*this)[option_name] = option_value;
          this->is_default[option_name] = overwriting_options.is_default[option_name];
@@ -212,12 +221,14 @@ namespace uno {
    void Options::print_used() const {
       size_t number_used_options = 0;
       std::string option_list{};
+      std::unique_lock<std::mutex> lock(this->mutex);
       for (const auto& [option_name, option_value]: this->options) {
          if (not this->is_default[option_name] && this->used[option_name]) {
             number_used_options++;
             option_list.append("- ").append(option_name).append(" = ").append(option_value).append("\n");
          }
       }
+      lock.unlock();
       // print the overwritten options
       if (number_used_options > 0) {
          DISCRETE << "\nUsed overwritten options:\n" << option_list << '\n';
@@ -5,12 +5,14 @@
 #define UNO_OPTIONS_H
 
 #include <map>
+#include <mutex>
 #include <string>
 
 namespace uno {
    class Options {
    public:
       explicit Options(bool are_default_options);
+      Options(const Options& other);
 
       [[nodiscard]] size_t size() const;
       std::string& operator[](const std::string& option_name);
@@ -34,6 +36,8 @@ namespace uno {
       std::map<std::string, std::string> options{};
       mutable std::map<std::string, bool> used{};
       mutable std::map<std::string, bool> is_default{};
+      // the getters record the used options: concurrent solves may share the options
+      mutable std::mutex mutex;
       const bool are_default_options;
 
       [[nodiscard]] const std::string& at(const std::string& option_name) const;
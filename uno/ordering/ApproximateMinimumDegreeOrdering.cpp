@@ -0,0 +1,198 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include "ApproximateMinimumDegreeOrdering.hpp"
+#include "SymmetricGraph.hpp"
+
+namespace uno {
+   Permutation ApproximateMinimumDegreeOrdering::compute_permutation(const SymmetricGraph& graph) const {
+      // a supervariable is a set of indistinguishable variables represented by its principal variable
+      enum class Status {VARIABLE, NONPRINCIPAL, ELEMENT, ABSORBED};
+
+      const size_t n = graph.number_vertices();
+      // quotient graph: variable i is adjacent to the variables A_i and the elements E_i; element e is adjacent to the variables L_e.
+      // An element is identified with the variable it was created from
+      std::vector<std::vector<size_t>> adjacent_variables(n);
+      std::vector<std::vector<size_t>> adjacent_elements(n);
+      std::vector<std::vector<size_t>> element_variables(n);
+      std::vector<Status> status(n, Status::VARIABLE);
+      std::vector<size_t> weight(n, 1); // number of variables of a supervariable, or of L_e for an element
+      std::vector<std::vector<size_t>> members(n); // nonprincipal variables of a supervariable
+      std::vector<size_t> degree(n);
+      using QueueEntry = std::pair<size_t, size_t>; // (degree, variable), stale entries are skipped
+      std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue{};
+      for (size_t variable = 0; variable < n; variable++) {
+         adjacent_variables[variable].reserve(graph.degree(variable));
+         for (size_t position = graph.neighbors_start(variable); position < graph.neighbors_end(variable); position++) {
+            adjacent_variables[variable].emplace_back(graph.neighbor(position));
+         }
+         degree[variable] = graph.degree(variable);
+         queue.emplace(degree[variable], variable);
+      }
+
+      // marker for the pivot structure L_p and the external degrees |L_e \ L_p| of the elements
+      std::vector<size_t> marker(n, 0);
+      std::vector<size_t> external_degree(n, 0);
+      std::vector<size_t> external_degree_stamp(n, 0);
+      std::vector<size_t> hashes(n, 0);
+      size_t stamp = 0;
+
+      Permutation permutation{};
+      permutation.reserve(n);
+      std::vector<size_t> pivot_structure{};
+      while (not queue.empty()) {
+         const auto [pivot_degree, pivot] = queue.top();
+         queue.pop();
+         if (status[pivot] != Status::VARIABLE || pivot_degree != degree[pivot]) {
+            continue;
+         }
+         // the variables of a supervariable are eliminated consecutively
+         permutation.emplace_back(pivot);
+         permutation.insert(permutation.end(), members[pivot].begin(), members[pivot].end());
+         std::vector<size_t>().swap(members[pivot]);
+         const size_t number_remaining_variables = n - permutation.size();
+
+         // L_p = (A_p U (U_{e in E_p} L_e)) \ {p}. The elements of E_p are absorbed into the new element p
+         stamp++;
+         marker[pivot] = stamp;
+         pivot_structure.clear();
+         size_t pivot_structure_weight = 0;
+         const auto add_to_pivot_structure = [&](size_t variable) {
+            if (status[variable] == Status::VARIABLE && marker[variable] != stamp) {
+               marker[variable] = stamp;
+               pivot_structure.emplace_back(variable);
+               pivot_structure_weight += weight[variable];
+            }
+         };
+         for (size_t variable: adjacent_variables[pivot]) {
+            add_to_pivot_structure(variable);
+         }
+         for (size_t element: adjacent_elements[pivot]) {
+            if (status[element] == Status::ELEMENT) {
+               for (size_t variable: element_variables[element]) {
+                  add_to_pivot_structure(variable);
+               }
+               status[element] = Status::ABSORBED;
+               std::vector<size_t>().swap(element_variables[element]);
+            }
+         }
+         status[pivot] = Status::ELEMENT;
+         weight[pivot] = pivot_structure_weight;
+         std::vector<size_t>().swap(adjacent_variables[pivot]);
+         std::vector<size_t>().swap(adjacent_elements[pivot]);
+
+         // |L_e \ L_p| for the elements adjacent to L_p
+         for (size_t variable: pivot_structure) {
+            for (size_t element: adjacent_elements[variable]) {
+               if (status[element] == Status::ELEMENT) {
+                  if (external_degree_stamp[element] != stamp) {
+                     external_degree_stamp[element] = stamp;
+                     external_degree[element] = weight[element];
+                  }
+                  external_degree[element] -= weight[variable];
+               }
+            }
+         }
+
+         // prune the lists of the variables of L_p
+         for (size_t variable: pivot_structure) {
+            // elements: remove the absorbed ones and the ones included in L_p (aggressive absorption), then add p
+            std::vector<size_t>& elements = adjacent_elements[variable];
+            size_t hash = pivot;
+            size_t new_size = 0;
+            for (size_t element: elements) {
+               if (status[element] == Status::ELEMENT) {
+                  if (external_degree[element] == 0) {
+                     status[element] = Status::ABSORBED;
+                     std::vector<size_t>().swap(element_variables[element]);
+                  }
+                  else {
+                     elements[new_size++] = element;
+                     hash += element;
+                  }
+               }
+            }
+            elements.resize(new_size);
+            elements.emplace_back(pivot);
+            // variables: those of L_p are now reachable through p
+            std::vector<size_t>& variables = adjacent_variables[variable];
+            new_size = 0;
+            for (size_t other_variable: variables) {
+               if (status[other_variable] == Status::VARIABLE && marker[other_variable] != stamp) {
+                  variables[new_size++] = other_variable;
+                  hash += other_variable;
+               }
+            }
+            variables.resize(new_size);
+            hashes[variable] = hash;
+         }
+
+         // supervariable detection: variables of L_p with identical lists are merged
+         std::sort(pivot_structure.begin(), pivot_structure.end(), [&](size_t variable1, size_t variable2) {
+            return std::make_pair(hashes[variable1], variable1) < std::make_pair(hashes[variable2], variable2);
+         });
+         for (size_t first = 0; first < pivot_structure.size(); first++) {
+            const size_t variable = pivot_structure[first];
+            if (status[variable] != Status::VARIABLE) {
+               continue;
+            }
+            bool lists_marked = false;
+            for (size_t second = first + 1; second < pivot_structure.size() && hashes[pivot_structure[second]] == hashes[variable]; second++) {
+               const size_t other_variable = pivot_structure[second];
+               if (status[other_variable] != Status::VARIABLE ||
+                     adjacent_variables[variable].size() != adjacent_variables[other_variable].size() ||
+                     adjacent_elements[variable].size() != adjacent_elements[other_variable].size()) {
+                  continue;
+               }
+               if (not lists_marked) {
+                  stamp++;
+                  for (size_t index: adjacent_variables[variable]) { marker[index] = stamp; }
+                  for (size_t index: adjacent_elements[variable]) { marker[index] = stamp; }
+                  lists_marked = true;
+               }
+               const auto is_marked = [&](size_t index) { return marker[index] == stamp; };
+               if (std::all_of(adjacent_variables[other_variable].begin(), adjacent_variables[other_variable].end(), is_marked) &&
+                     std::all_of(adjacent_elements[other_variable].begin(), adjacent_elements[other_variable].end(), is_marked)) {
+                  weight[variable] += weight[other_variable];
+                  members[variable].emplace_back(other_variable);
+                  members[variable].insert(members[variable].end(), members[other_variable].begin(), members[other_variable].end());
+                  status[other_variable] = Status::NONPRINCIPAL;
+                  std::vector<size_t>().swap(members[other_variable]);
+                  std::vector<size_t>().swap(adjacent_variables[other_variable]);
+                  std::vector<size_t>().swap(adjacent_elements[other_variable]);
+               }
+            }
+         }
+
+         // approximate external degrees of the principal variables of L_p
+         for (size_t variable: pivot_structure) {
+            if (status[variable] == Status::VARIABLE) {
+               size_t approximate_degree = pivot_structure_weight - weight[variable];
+               for (size_t other_variable: adjacent_variables[variable]) {
+                  approximate_degree += weight[other_variable];
+               }
+               for (size_t element: adjacent_elements[variable]) {
+                  if (element != pivot) {
+                     approximate_degree += external_degree[element];
+                  }
+               }
+               degree[variable] = std::min({approximate_degree, number_remaining_variables - weight[variable],
+                  degree[variable] + pivot_structure_weight - weight[variable]});
+               queue.emplace(degree[variable], variable);
+            }
+         }
+         // the new element p: its principal variables
+         std::vector<size_t> new_element_variables{};
+         for (size_t variable: pivot_structure) {
+            if (status[variable] == Status::VARIABLE) {
+               new_element_variables.emplace_back(variable);
+            }
+         }
+         element_variables[pivot] = std::move(new_element_variables);
+      }
+      return permutation;
+   }
+} // namespace
@@ -0,0 +1,24 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_APPROXIMATEMINIMUMDEGREEORDERING_H
+#define UNO_APPROXIMATEMINIMUMDEGREEORDERING_H
+
+#include "FillReducingOrdering.hpp"
+
+namespace uno {
+   /*! \class ApproximateMinimumDegreeOrdering
+    * \brief Approximate minimum degree (AMD) ordering
+    *
+    *  Minimum degree on the quotient graph (eliminated variables are represented by elements) with the approximate
+    *  external degrees of Amestoy, Davis and Duff (1996) and aggressive element absorption. Supervariables are not detected
+    */
+   class ApproximateMinimumDegreeOrdering : public FillReducingOrdering {
+   public:
+      ApproximateMinimumDegreeOrdering(): FillReducingOrdering("AMD") { }
+
+      [[nodiscard]] Permutation compute_permutation(const SymmetricGraph& graph) const override;
+   };
+} // namespace
+
+#endif // UNO_APPROXIMATEMINIMUMDEGREEORDERING_H
@@ -0,0 +1,115 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <stdexcept>
+#include <utility>
+#include "FillReducingOrdering.hpp"
+#include "ApproximateMinimumDegreeOrdering.hpp"
+#include "NestedDissectionOrdering.hpp"
+#include "SymmetricGraph.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   std::shared_ptr<const Permutation> FillReducingOrdering::permutation(const SymmetricMatrix<size_t, double>& matrix,
+         const SparsityPatternFingerprint& fingerprint) const {
+      OrderingCache& cache = OrderingCache::shared();
+      std::shared_ptr<const Permutation> permutation = cache.find(this->name, matrix, fingerprint);
+      if (permutation == nullptr) {
+         permutation = std::make_shared<const Permutation>(this->compute_permutation(SymmetricGraph::from_matrix(matrix)));
+         cache.insert(this->name, matrix, fingerprint, permutation);
+         DEBUG << "Computed the " << this->name << " ordering of a matrix of dimension " << matrix.dimension() << '\n';
+      }
+      else {
+         DEBUG << "Reused the cached " << this->name << " ordering\n";
+      }
+      return permutation;
+   }
+
+   OrderingCache& OrderingCache::shared() {
+      static OrderingCache cache;
+      return cache;
+   }
+
+   std::shared_ptr<const Permutation> OrderingCache::find(const std::string& ordering_name, const SymmetricMatrix<size_t, double>& matrix,
+         const SparsityPatternFingerprint& fingerprint) const {
+      // the candidates are collected under the lock, their indices are compared outside of it
+      std::vector<std::pair<std::shared_ptr<const PatternIndices>, std::shared_ptr<const Permutation>>> candidates{};
+      {
+         std::lock_guard<std::mutex> lock(this->mutex);
+         for (const auto& [name, entry_fingerprint, pattern_indices, permutation]: this->entries) {
+            if (name == ordering_name && entry_fingerprint == fingerprint) {
+               candidates.emplace_back(pattern_indices, permutation);
+            }
+         }
+      }
+      for (const auto& [pattern_indices, permutation]: candidates) {
+         if (OrderingCache::has_pattern_indices(matrix, *pattern_indices)) {
+            return permutation;
+         }
+      }
+      return nullptr;
+   }
+
+   void OrderingCache::insert(const std::string& ordering_name, const SymmetricMatrix<size_t, double>& matrix,
+         const SparsityPatternFingerprint& fingerprint, std::shared_ptr<const Permutation> permutation) {
+      auto pattern_indices = std::make_shared<PatternIndices>();
+      pattern_indices->reserve(2 * matrix.number_nonzeros());
+      matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double /*element*/) {
+         pattern_indices->emplace_back(row_index);
+         pattern_indices->emplace_back(column_index);
+      });
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->entries.emplace_front(ordering_name, fingerprint, std::move(pattern_indices), std::move(permutation));
+      if (OrderingCache::capacity < this->entries.size()) {
+         this->entries.pop_back();
+      }
+   }
+
+   void OrderingCache::clear() {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      this->entries.clear();
+   }
+
+   bool OrderingCache::has_pattern_indices(const SymmetricMatrix<size_t, double>& matrix, const PatternIndices& pattern_indices) {
+      if (pattern_indices.size() != 2 * matrix.number_nonzeros()) {
+         return false;
+      }
+      bool same_indices = true;
+      size_t position = 0;
+      matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double /*element*/) {
+         if (same_indices && (position + 1 >= pattern_indices.size() || pattern_indices[position] != row_index ||
+               pattern_indices[position + 1] != column_index)) {
+            same_indices = false;
+         }
+         position += 2;
+      });
+      return same_indices && position == pattern_indices.size();
+   }
+
+   std::unique_ptr<FillReducingOrdering> FillReducingOrderingFactory::create(const std::string& ordering_name) {
+      if (ordering_name == "AMD") {
+         return std::make_unique<ApproximateMinimumDegreeOrdering>();
+      }
+      else if (ordering_name == "nested_dissection") {
+         return std::make_unique<NestedDissectionOrdering>();
+      }
+      std::string message = "The ordering ";
+      message.append(ordering_name).append(" is unknown").append("\n").append("The following values are available: ")
+            .append(join(FillReducingOrderingFactory::available_orderings(), ", "));
+      throw std::invalid_argument(message);
+   }
+
+   std::vector<std::string> FillReducingOrderingFactory::available_orderings() {
+      return {"AMD", "nested_dissection"};
+   }
+
+   Permutation invert_permutation(const Permutation& permutation) {
+      Permutation inverse_permutation(permutation.size());
+      for (size_t index = 0; index < permutation.size(); index++) {
+         inverse_permutation[permutation[index]] = index;
+      }
+      return inverse_permutation;
+   }
+} // namespace
@@ -0,0 +1,78 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_FILLREDUCINGORDERING_H
+#define UNO_FILLREDUCINGORDERING_H
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "linear_algebra/SparsityPatternFingerprint.hpp"
+
+namespace uno {
+   // forward declarations
+   class SymmetricGraph;
+   template <typename IndexType, typename ElementType>
+   class SymmetricMatrix;
+
+   // a permutation is stored as permutation[new index] = original index: the i-th pivot is the variable permutation[i]
+   using Permutation = std::vector<size_t>;
+
+   /*! \class FillReducingOrdering
+    * \brief Symmetric fill-reducing ordering of a sparse matrix
+    *
+    *  Orderings are cached per sparsity pattern and per ordering method, and shared by all the linear solvers of the process:
+    *  the permutation of a KKT pattern is computed once, then reused across factorizations and solver instances
+    */
+   class FillReducingOrdering {
+   public:
+      explicit FillReducingOrdering(std::string name): name(std::move(name)) { }
+      virtual ~FillReducingOrdering() = default;
+
+      // fingerprint is the fingerprint of the pattern of matrix (already computed by the linear solvers)
+      [[nodiscard]] std::shared_ptr<const Permutation> permutation(const SymmetricMatrix<size_t, double>& matrix,
+            const SparsityPatternFingerprint& fingerprint) const;
+      [[nodiscard]] virtual Permutation compute_permutation(const SymmetricGraph& graph) const = 0;
+
+      const std::string name;
+   };
+
+   // thread-safe cache of the most recently computed orderings. An entry is found by its fingerprint, then the (row, column)
+   // indices of its pattern are compared with those of the matrix to rule out a hash collision
+   class OrderingCache {
+   public:
+      static OrderingCache& shared();
+
+      [[nodiscard]] std::shared_ptr<const Permutation> find(const std::string& ordering_name, const SymmetricMatrix<size_t, double>& matrix,
+            const SparsityPatternFingerprint& fingerprint) const;
+      void insert(const std::string& ordering_name, const SymmetricMatrix<size_t, double>& matrix, const SparsityPatternFingerprint& fingerprint,
+            std::shared_ptr<const Permutation> permutation);
+      void clear();
+
+   protected:
+      // (row, column) indices of a pattern in storage order
+      using PatternIndices = std::vector<size_t>;
+
+      static constexpr size_t capacity{16};
+      mutable std::mutex mutex;
+      // most recent entries at the front
+      std::deque<std::tuple<std::string, SparsityPatternFingerprint, std::shared_ptr<const PatternIndices>, std::shared_ptr<const Permutation>>>
+            entries{};
+
+      [[nodiscard]] static bool has_pattern_indices(const SymmetricMatrix<size_t, double>& matrix, const PatternIndices& pattern_indices);
+   };
+
+   class FillReducingOrderingFactory {
+   public:
+      static std::unique_ptr<FillReducingOrdering> create(const std::string& ordering_name);
+      static std::vector<std::string> available_orderings();
+   };
+
+   // inverse_permutation[original index] = new index
+   Permutation invert_permutation(const Permutation& permutation);
+} // namespace
+
+#endif // UNO_FILLREDUCINGORDERING_H
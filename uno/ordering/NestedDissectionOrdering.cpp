@@ -0,0 +1,168 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <string>
+#include "NestedDissectionOrdering.hpp"
+#include "ApproximateMinimumDegreeOrdering.hpp"
+#include "SymmetricGraph.hpp"
+#ifdef HAS_METIS
+#include "metis.h"
+#endif
+
+namespace uno {
+   Permutation NestedDissectionOrdering::compute_permutation(const SymmetricGraph& graph) const {
+      const size_t n = graph.number_vertices();
+      Permutation permutation{};
+      permutation.reserve(n);
+      if (n == 0) {
+         return permutation;
+      }
+#ifdef HAS_METIS
+      idx_t number_vertices = static_cast<idx_t>(n);
+      std::vector<idx_t> vertex_starts(n + 1);
+      std::vector<idx_t> adjacency(graph.neighbors_end(n - 1));
+      for (size_t vertex = 0; vertex <= n; vertex++) {
+         vertex_starts[vertex] = static_cast<idx_t>(vertex < n ? graph.neighbors_start(vertex) : graph.neighbors_end(n - 1));
+      }
+      for (size_t position = 0; position < adjacency.size(); position++) {
+         adjacency[position] = static_cast<idx_t>(graph.neighbor(position));
+      }
+      std::array<idx_t, METIS_NOPTIONS> options{};
+      METIS_SetDefaultOptions(options.data());
+      options[METIS_OPTION_NUMBERING] = 0;
+      // perm[new index] = original index, like Permutation
+      std::vector<idx_t> perm(n), iperm(n);
+      const int status = METIS_NodeND(&number_vertices, vertex_starts.data(), adjacency.data(), nullptr, options.data(), perm.data(), iperm.data());
+      if (status != METIS_OK) {
+         throw std::runtime_error("METIS_NodeND failed with status " + std::to_string(status));
+      }
+      for (idx_t vertex: perm) {
+         permutation.emplace_back(static_cast<size_t>(vertex));
+      }
+#else
+      std::vector<size_t> vertices(n);
+      for (size_t vertex = 0; vertex < n; vertex++) {
+         vertices[vertex] = vertex;
+      }
+      // workspace of size n filled with n
+      std::vector<size_t> workspace(n, n);
+      this->dissect(graph, vertices, permutation, workspace);
+#endif
+      return permutation;
+   }
+
+   // order the subgraph induced by vertices (the content of vertices is destroyed)
+   void NestedDissectionOrdering::dissect(const SymmetricGraph& graph, std::vector<size_t>& vertices, Permutation& permutation,
+         std::vector<size_t>& workspace) const {
+      if (vertices.empty()) {
+         return;
+      }
+      const SymmetricGraph subgraph = graph.induced_subgraph(vertices, workspace);
+      const size_t n = subgraph.number_vertices();
+      const auto order_with_AMD = [&]() {
+         const ApproximateMinimumDegreeOrdering minimum_degree;
+         for (size_t local_vertex: minimum_degree.compute_permutation(subgraph)) {
+            permutation.emplace_back(vertices[local_vertex]);
+         }
+      };
+      if (n <= NestedDissectionOrdering::leaf_size) {
+         order_with_AMD();
+         return;
+      }
+
+      // level structure of a breadth-first search from root (levels[v] = n for unreached vertices)
+      std::vector<size_t> levels(n);
+      std::vector<size_t> visit_order{};
+      visit_order.reserve(n);
+      const auto breadth_first_search = [&](size_t root) {
+         std::fill(levels.begin(), levels.end(), n);
+         visit_order.clear();
+         levels[root] = 0;
+         visit_order.emplace_back(root);
+         for (size_t visited = 0; visited < visit_order.size(); visited++) {
+            const size_t vertex = visit_order[visited];
+            for (size_t position = subgraph.neighbors_start(vertex); position < subgraph.neighbors_end(vertex); position++) {
+               const size_t neighbor = subgraph.neighbor(position);
+               if (levels[neighbor] == n) {
+                  levels[neighbor] = levels[vertex] + 1;
+                  visit_order.emplace_back(neighbor);
+               }
+            }
+         }
+         return levels[visit_order.back()];
+      };
+
+      // pseudo-peripheral root: restart from a vertex of minimum degree in the last level while the depth increases
+      size_t root = 0;
+      size_t depth = breadth_first_search(root);
+      for (size_t iteration = 0; iteration < 5; iteration++) {
+         size_t candidate = visit_order.back();
+         for (auto iterator = visit_order.rbegin(); iterator != visit_order.rend() && levels[*iterator] == depth; ++iterator) {
+            if (subgraph.degree(*iterator) < subgraph.degree(candidate)) {
+               candidate = *iterator;
+            }
+         }
+         const size_t candidate_depth = breadth_first_search(candidate);
+         if (candidate_depth <= depth) {
+            breadth_first_search(root);
+            break;
+         }
+         root = candidate;
+         depth = candidate_depth;
+      }
+
+      // the graph is disconnected: order the component of the root, then the rest
+      if (visit_order.size() < n) {
+         std::vector<size_t> component{}, rest{};
+         for (size_t local_vertex = 0; local_vertex < n; local_vertex++) {
+            (levels[local_vertex] < n ? component : rest).emplace_back(vertices[local_vertex]);
+         }
+         this->dissect(graph, component, permutation, workspace);
+         this->dissect(graph, rest, permutation, workspace);
+         return;
+      }
+      if (depth < 2) {
+         // no separator level with vertices on both sides
+         order_with_AMD();
+         return;
+      }
+
+      // separator: the level that splits the vertices in halves
+      size_t separator_level = 1;
+      size_t number_vertices_below = 0;
+      std::vector<size_t> level_sizes(depth + 1, 0);
+      for (size_t local_vertex = 0; local_vertex < n; local_vertex++) {
+         level_sizes[levels[local_vertex]]++;
+      }
+      for (size_t level = 0; level < depth; level++) {
+         if (0 < level && n <= 2 * (number_vertices_below + level_sizes[level])) {
+            separator_level = level;
+            break;
+         }
+         number_vertices_below += level_sizes[level];
+         separator_level = level + 1;
+      }
+      separator_level = std::min(separator_level, depth - 1);
+
+      std::vector<size_t> first_part{}, second_part{}, separator{};
+      for (size_t local_vertex = 0; local_vertex < n; local_vertex++) {
+         const size_t level = levels[local_vertex];
+         if (level < separator_level) {
+            first_part.emplace_back(vertices[local_vertex]);
+         }
+         else if (level == separator_level) {
+            separator.emplace_back(vertices[local_vertex]);
+         }
+         else {
+            second_part.emplace_back(vertices[local_vertex]);
+         }
+      }
+      std::vector<size_t>().swap(vertices);
+      this->dissect(graph, first_part, permutation, workspace);
+      this->dissect(graph, second_part, permutation, workspace);
+      permutation.insert(permutation.end(), separator.begin(), separator.end());
+   }
+} // namespace
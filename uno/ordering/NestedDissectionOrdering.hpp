@@ -0,0 +1,31 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NESTEDDISSECTIONORDERING_H
+#define UNO_NESTEDDISSECTIONORDERING_H
+
+#include "FillReducingOrdering.hpp"
+
+namespace uno {
+   /*! \class NestedDissectionOrdering
+    * \brief Nested dissection ordering
+    *
+    *  Uses METIS_NodeND when METIS is available. Otherwise, the graph is recursively split by level-set separators
+    *  (middle level of a breadth-first search from a pseudo-peripheral vertex); the separators are ordered last
+    *  and the small subgraphs are ordered with AMD
+    */
+   class NestedDissectionOrdering : public FillReducingOrdering {
+   public:
+      NestedDissectionOrdering(): FillReducingOrdering("nested_dissection") { }
+
+      [[nodiscard]] Permutation compute_permutation(const SymmetricGraph& graph) const override;
+
+   protected:
+      // subgraphs below this size are not dissected further
+      static constexpr size_t leaf_size{64};
+
+      void dissect(const SymmetricGraph& graph, std::vector<size_t>& vertices, Permutation& permutation, std::vector<size_t>& workspace) const;
+   };
+} // namespace
+
+#endif // UNO_NESTEDDISSECTIONORDERING_H
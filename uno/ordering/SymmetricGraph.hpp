@@ -0,0 +1,104 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_SYMMETRICGRAPH_H
+#define UNO_SYMMETRICGRAPH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include "linear_algebra/SymmetricMatrix.hpp"
+
+namespace uno {
+   // adjacency graph of a symmetric sparsity pattern, stored in compressed form:
+   // the neighbors of vertex v are adjacency[vertex_starts[v]:vertex_starts[v+1]] (sorted, no self loops, no duplicates)
+   class SymmetricGraph {
+   public:
+      SymmetricGraph(std::vector<size_t> vertex_starts, std::vector<size_t> adjacency):
+            vertex_starts(std::move(vertex_starts)), adjacency(std::move(adjacency)) { }
+
+      template <typename IndexType, typename ElementType>
+      static SymmetricGraph from_matrix(const SymmetricMatrix<IndexType, ElementType>& matrix);
+
+      [[nodiscard]] size_t number_vertices() const { return this->vertex_starts.size() - 1; }
+      [[nodiscard]] size_t degree(size_t vertex) const { return this->vertex_starts[vertex + 1] - this->vertex_starts[vertex]; }
+      [[nodiscard]] size_t neighbors_start(size_t vertex) const { return this->vertex_starts[vertex]; }
+      [[nodiscard]] size_t neighbors_end(size_t vertex) const { return this->vertex_starts[vertex + 1]; }
+      [[nodiscard]] size_t neighbor(size_t position) const { return this->adjacency[position]; }
+
+      // subgraph induced by a subset of vertices, numbered in the order of the subset.
+      // local_indices must have size number_vertices() and be filled with number_vertices(); it is restored on exit
+      [[nodiscard]] SymmetricGraph induced_subgraph(const std::vector<size_t>& vertices, std::vector<size_t>& local_indices) const;
+
+   protected:
+      std::vector<size_t> vertex_starts;
+      std::vector<size_t> adjacency;
+   };
+
+   template <typename IndexType, typename ElementType>
+   SymmetricGraph SymmetricGraph::from_matrix(const SymmetricMatrix<IndexType, ElementType>& matrix) {
+      const size_t number_vertices = matrix.dimension();
+      // count the off-diagonal entries (each one is an edge in both directions)
+      std::vector<size_t> vertex_starts(number_vertices + 1, 0);
+      matrix.for_each_nonzero([&](IndexType row_index, IndexType column_index, ElementType /*element*/) {
+         if (row_index != column_index) {
+            vertex_starts[static_cast<size_t>(row_index) + 1]++;
+            vertex_starts[static_cast<size_t>(column_index) + 1]++;
+         }
+      });
+      for (size_t vertex = 0; vertex < number_vertices; vertex++) {
+         vertex_starts[vertex + 1] += vertex_starts[vertex];
+      }
+      std::vector<size_t> adjacency(vertex_starts.back());
+      std::vector<size_t> current_positions(vertex_starts.begin(), vertex_starts.end() - 1);
+      matrix.for_each_nonzero([&](IndexType row_index, IndexType column_index, ElementType /*element*/) {
+         if (row_index != column_index) {
+            adjacency[current_positions[static_cast<size_t>(row_index)]++] = static_cast<size_t>(column_index);
+            adjacency[current_positions[static_cast<size_t>(column_index)]++] = static_cast<size_t>(row_index);
+         }
+      });
+      // sort and remove the duplicates (entries that appear several times in the storage) in place
+      size_t new_position = 0;
+      for (size_t vertex = 0; vertex < number_vertices; vertex++) {
+         const auto begin = adjacency.begin() + static_cast<std::ptrdiff_t>(vertex_starts[vertex]);
+         const auto end = adjacency.begin() + static_cast<std::ptrdiff_t>(vertex_starts[vertex + 1]);
+         std::sort(begin, end);
+         vertex_starts[vertex] = new_position;
+         for (auto iterator = begin; iterator != end; ++iterator) {
+            if (iterator == begin || *iterator != *(iterator - 1)) {
+               adjacency[new_position++] = *iterator;
+            }
+         }
+      }
+      vertex_starts[number_vertices] = new_position;
+      adjacency.resize(new_position);
+      return {std::move(vertex_starts), std::move(adjacency)};
+   }
+
+   inline SymmetricGraph SymmetricGraph::induced_subgraph(const std::vector<size_t>& vertices, std::vector<size_t>& local_indices) const {
+      const size_t undefined = this->number_vertices();
+      for (size_t local_index = 0; local_index < vertices.size(); local_index++) {
+         local_indices[vertices[local_index]] = local_index;
+      }
+      std::vector<size_t> subgraph_starts(vertices.size() + 1, 0);
+      std::vector<size_t> subgraph_adjacency{};
+      for (size_t local_index = 0; local_index < vertices.size(); local_index++) {
+         const size_t vertex = vertices[local_index];
+         for (size_t position = this->neighbors_start(vertex); position < this->neighbors_end(vertex); position++) {
+            const size_t neighbor_local_index = local_indices[this->adjacency[position]];
+            if (neighbor_local_index != undefined) {
+               subgraph_adjacency.emplace_back(neighbor_local_index);
+            }
+         }
+         // the neighbors are sorted in the numbering of the subgraph
+         std::sort(subgraph_adjacency.begin() + static_cast<std::ptrdiff_t>(subgraph_starts[local_index]), subgraph_adjacency.end());
+         subgraph_starts[local_index + 1] = subgraph_adjacency.size();
+      }
+      for (size_t vertex: vertices) {
+         local_indices[vertex] = undefined;
+      }
+      return {std::move(subgraph_starts), std::move(subgraph_adjacency)};
+   }
+} // namespace
+
+#endif // UNO_SYMMETRICGRAPH_H
@@ -104,9 +104,14 @@ namespace uno {
             }
             // constraint Jacobian
             RectangularMatrix<double> constraint_jacobian(linear_constraints.size(), model.number_variables);
+            SparseVector<double> constraint_gradient(model.number_variables);
             size_t linear_constraint_index = 0;
             for (size_t constraint_index: linear_constraints) {
-               model.evaluate_constraint_gradient(x, constraint_index, constraint_jacobian[linear_constraint_index]);
+               constraint_gradient.clear();
+               model.evaluate_constraint_gradient(x, constraint_index, constraint_gradient);
+               for (const auto [variable_index, derivative]: constraint_gradient) {
+                  constraint_jacobian.insert(derivative, linear_constraint_index, variable_index);
+               }
                linear_constraint_index++;
             }
             // variable bounds
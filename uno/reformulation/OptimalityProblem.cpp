@@ -3,6 +3,7 @@
 
 #include "OptimalityProblem.hpp"
 #include "optimization/Iterate.hpp"
+#include "linear_algebra/SparseKernels.hpp"
 #include "optimization/LagrangianGradient.hpp"
 #include "symbolic/Expression.hpp"
 
@@ -24,7 +25,7 @@ namespace uno {
    void OptimalityProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const {
       iterate.evaluate_constraint_jacobian(this->model);
       // TODO change this
-      constraint_jacobian = iterate.evaluations.constraint_jacobian;
+      constraint_jacobian.assign(iterate.evaluations.constraint_jacobian);
    }
 
    void OptimalityProblem::evaluate_lagrangian_hessian(const Vector<double>& x, const Vector<double>& multipliers,
@@ -32,6 +33,11 @@ namespace uno {
       this->model.evaluate_lagrangian_hessian(x, this->get_objective_multiplier(), multipliers, hessian);
    }
 
+   void OptimalityProblem::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers,
+         const Vector<double>& vector, Vector<double>& result) const {
+      this->model.evaluate_lagrangian_hessian_vector_product(x, this->get_objective_multiplier(), multipliers, vector, result);
+   }
+
    // Lagrangian gradient split in two parts: objective contribution and constraints' contribution
    void OptimalityProblem::evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate,
          const Multipliers& multipliers) const {
@@ -44,13 +50,8 @@ namespace uno {
       }
 
       // constraints
-      for (size_t constraint_index: Range(this->number_constraints)) {
-         if (multipliers.constraints[constraint_index] != 0.) {
-            for (auto [variable_index, derivative]: iterate.evaluations.constraint_jacobian[constraint_index]) {
-               lagrangian_gradient.constraints_contribution[variable_index] -= multipliers.constraints[constraint_index] * derivative;
-            }
-         }
-      }
+      transposed_matrix_vector_product(iterate.evaluations.constraint_jacobian, multipliers.constraints, -1.,
+            lagrangian_gradient.constraints_contribution);
 
       // bound constraints of original variables
       for (size_t variable_index: Range(this->number_variables)) {
@@ -2,6 +2,7 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include "l1RelaxedProblem.hpp"
+#include "linear_algebra/SparseKernels.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "model/Model.hpp"
 #include "optimization/Iterate.hpp"
@@ -84,13 +85,13 @@ namespace uno {
    void l1RelaxedProblem::evaluate_constraint_jacobian(Iterate& iterate, RectangularMatrix<double>& constraint_jacobian) const {
       iterate.evaluate_constraint_jacobian(this->model);
       // TODO change this
-      constraint_jacobian = iterate.evaluations.constraint_jacobian;
+      constraint_jacobian.assign(iterate.evaluations.constraint_jacobian);
       // add the contribution of the elastics
       for (const auto [constraint_index, elastic_index]: this->elastic_variables.positive) {
-         constraint_jacobian[constraint_index].insert(elastic_index, -1.);
+         constraint_jacobian.insert(-1., constraint_index, elastic_index);
       }
       for (const auto [constraint_index, elastic_index]: this->elastic_variables.negative) {
-         constraint_jacobian[constraint_index].insert(elastic_index, 1.);
+         constraint_jacobian.insert(1., constraint_index, elastic_index);
       }
    }
 
@@ -113,6 +114,25 @@ namespace uno {
       }
    }
 
+   void l1RelaxedProblem::evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, const Vector<double>& multipliers,
+         const Vector<double>& vector, Vector<double>& result) const {
+      this->model.evaluate_lagrangian_hessian_vector_product(x, this->objective_multiplier, multipliers, vector, result);
+
+      // proximal contribution
+      if (this->proximal_center != nullptr && this->proximal_coefficient != 0.) {
+         for (size_t variable_index: Range(this->model.number_variables)) {
+            const double scaling = std::min(1., 1./std::abs(this->proximal_center[variable_index]));
+            const double proximal_term = this->proximal_coefficient * scaling * scaling;
+            result[variable_index] += proximal_term * vector[variable_index];
+         }
+      }
+
+      // the elastics do not enter the Hessian
+      for (size_t elastic_index: Range(this->model.number_variables, this->number_variables)) {
+         result[elastic_index] = 0.;
+      }
+   }
+
    // Lagrangian gradient split in two parts: objective contribution and constraints' contribution
    void l1RelaxedProblem::evaluate_lagrangian_gradient(LagrangianGradient<double>& lagrangian_gradient, Iterate& iterate,
          const Multipliers& multipliers) const {
@@ -125,13 +145,8 @@ namespace uno {
       }
 
       // constraints
-      for (size_t constraint_index: Range(this->number_constraints)) {
-         if (multipliers.constraints[constraint_index] != 0.) {
-            for (auto [variable_index, derivative]: iterate.evaluations.constraint_jacobian[constraint_index]) {
-               lagrangian_gradient.constraints_contribution[variable_index] -= multipliers.constraints[constraint_index] * derivative;
-            }
-         }
-      }
+      transposed_matrix_vector_product(iterate.evaluations.constraint_jacobian, multipliers.constraints, -1.,
+            lagrangian_gradient.constraints_contribution);
 
       // bound constraints of original variables
       for (size_t variable_index: Range(this->model.number_variables)) {
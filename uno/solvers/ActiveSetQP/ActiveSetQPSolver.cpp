@@ -0,0 +1,710 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include "ActiveSetQPSolver.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseKernels.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   // relative size of a primal step below which the entering constraint is considered linearly dependent on the working set
+   constexpr double dependency_tolerance = 1e-12;
+
+   ActiveSetQPSolver::ActiveSetQPSolver(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros,
+         size_t number_hessian_nonzeros, const Options& options):
+         QPSolver(), options(options),
+         regularization(options.get_double("active_set_QP_regularization")),
+         tolerance(options.get_double("active_set_QP_tolerance")),
+         maximum_schur_size(options.get_unsigned_int("active_set_QP_maximum_schur_size")),
+         maximum_iterations(options.get_unsigned_int("active_set_QP_maximum_iterations")),
+         print_subproblem(options.get_bool("print_subproblem")),
+         in_working_set(number_variables + number_constraints, false),
+         working_multipliers(number_variables + number_constraints, 0.),
+         // Hessian + regularization + working set (at most one row per variable)
+         kkt_matrix(2 * number_variables, number_hessian_nonzeros + number_variables + number_jacobian_nonzeros + 2 * number_variables, false, "COO"),
+         factorized_position(number_variables + number_constraints, not_factorized),
+         primals(number_variables),
+         constraint_norms(number_variables + number_constraints),
+         primal_step(number_variables),
+         multiplier_step(number_variables + number_constraints) {
+      this->working_set.reserve(number_variables);
+   }
+
+   ActiveSetQPSolver::~ActiveSetQPSolver() = default;
+
+   void ActiveSetQPSolver::solve_LP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+         const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+         const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+         const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& /*initial_point*/, Direction& direction,
+         const WarmstartInformation& warmstart_information) {
+      const QuadraticProgram problem{number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+            constraints_upper_bounds, linear_objective, constraint_jacobian, nullptr};
+      this->solve_subproblem(problem, direction, warmstart_information);
+   }
+
+   void ActiveSetQPSolver::solve_QP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+         const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+         const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+         const RectangularMatrix<double>& constraint_jacobian, const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& /*initial_point*/,
+         Direction& direction, const WarmstartInformation& warmstart_information) {
+      const QuadraticProgram problem{number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+            constraints_upper_bounds, linear_objective, constraint_jacobian, &hessian};
+      this->solve_subproblem(problem, direction, warmstart_information);
+   }
+
+   double lower_bound(const std::vector<double>& variables_lower_bounds, const std::vector<double>& constraints_lower_bounds,
+         size_t number_variables, size_t constraint_index) {
+      return (constraint_index < number_variables) ? variables_lower_bounds[constraint_index] :
+         constraints_lower_bounds[constraint_index - number_variables];
+   }
+
+   double upper_bound(const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_upper_bounds,
+         size_t number_variables, size_t constraint_index) {
+      return (constraint_index < number_variables) ? variables_upper_bounds[constraint_index] :
+         constraints_upper_bounds[constraint_index - number_variables];
+   }
+
+   // side of a working constraint after its bounds changed (none if the constraint must leave the working set)
+   std::optional<WorkingBound> updated_working_bound(double lower_bound, double upper_bound, WorkingBound bound) {
+      if (lower_bound == upper_bound) {
+         return WorkingBound::EQUALITY;
+      }
+      else if (bound == WorkingBound::LOWER && is_finite(lower_bound)) {
+         return WorkingBound::LOWER;
+      }
+      else if (bound == WorkingBound::UPPER && is_finite(upper_bound)) {
+         return WorkingBound::UPPER;
+      }
+      return std::nullopt;
+   }
+
+   void ActiveSetQPSolver::solve_subproblem(const QuadraticProgram& problem, Direction& direction, const WarmstartInformation& warmstart_information) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+      const bool same_dimensions = (number_variables == this->number_variables && number_constraints == this->number_constraints);
+      if (not same_dimensions || warmstart_information.problem_changed) {
+         // cold start
+         for (const WorkingConstraint& working_constraint: this->working_set) {
+            this->in_working_set[working_constraint.index] = false;
+         }
+         this->working_set.clear();
+         this->is_factorization_valid = false;
+      }
+      // the KKT matrix depends on the Hessian (for QPs) and on the constraint Jacobian
+      if (warmstart_information.constraints_changed || (problem.hessian != nullptr && warmstart_information.objective_changed) ||
+            this->is_factorization_with_hessian != (problem.hessian != nullptr)) {
+         this->is_factorization_valid = false;
+      }
+      this->number_variables = number_variables;
+      this->number_constraints = number_constraints;
+      this->number_iterations = 0;
+
+      // resize the workspace if the subproblem is larger than the preallocated size
+      const size_t number_constraints_total = number_variables + number_constraints;
+      if (this->in_working_set.size() < number_constraints_total) {
+         this->in_working_set.resize(number_constraints_total, false);
+         this->working_multipliers.resize(number_constraints_total, 0.);
+         this->factorized_position.resize(number_constraints_total, not_factorized);
+         this->constraint_norms.resize(number_constraints_total);
+         this->multiplier_step.resize(number_constraints_total);
+      }
+      this->primals.resize(number_variables);
+      this->primal_step.resize(number_variables);
+
+      // norms of the constraint gradients, used to scale the violations
+      for (size_t variable_index: Range(number_variables)) {
+         this->constraint_norms[variable_index] = 1.;
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         double norm = 0.;
+         for (const auto [variable_index, derivative]: problem.constraint_jacobian[constraint_index]) {
+            norm = std::max(norm, std::abs(derivative));
+         }
+         this->constraint_norms[number_variables + constraint_index] = std::max(1., norm);
+      }
+
+      if (this->print_subproblem) {
+         DEBUG << "objective gradient: " << problem.linear_objective;
+         for (size_t constraint_index: Range(number_constraints)) {
+            DEBUG << "gradient c" << constraint_index << ": " << problem.constraint_jacobian[constraint_index];
+         }
+         for (size_t variable_index: Range(number_variables)) {
+            DEBUG << "d" << variable_index << " in [" << problem.variables_lower_bounds[variable_index] << ", " <<
+               problem.variables_upper_bounds[variable_index] << "]\n";
+         }
+         for (size_t constraint_index: Range(number_constraints)) {
+            DEBUG << "linearized c" << constraint_index << " in [" << problem.constraints_lower_bounds[constraint_index] << ", " <<
+               problem.constraints_upper_bounds[constraint_index] << "]\n";
+         }
+      }
+
+      const size_t number_factorizations_before = this->number_factorizations;
+      if (this->initialize_working_set(problem, same_dimensions && not warmstart_information.problem_changed) &&
+            this->restore_dual_feasibility(problem)) {
+         direction.status = this->run_dual_active_set_method(problem);
+      }
+      else {
+         direction.status = SubproblemStatus::ERROR;
+      }
+      DEBUG << "Active-set QP solver: " << this->number_iterations << " iterations, " <<
+         (this->number_factorizations - number_factorizations_before) << " factorizations, working set of size " << this->working_set.size() << '\n';
+      this->set_direction(problem, direction);
+
+      if (direction.status == SubproblemStatus::ERROR) {
+         // the next subproblem starts from scratch
+         for (const WorkingConstraint& working_constraint: this->working_set) {
+            this->in_working_set[working_constraint.index] = false;
+         }
+         this->working_set.clear();
+         this->is_factorization_valid = false;
+      }
+   }
+
+   bool ActiveSetQPSolver::initialize_working_set(const QuadraticProgram& problem, bool is_hot_start) {
+      const size_t number_constraints_total = problem.number_variables + problem.number_constraints;
+      const auto lower = [&](size_t constraint_index) {
+         return lower_bound(problem.variables_lower_bounds, problem.constraints_lower_bounds, problem.number_variables, constraint_index);
+      };
+      const auto upper = [&](size_t constraint_index) {
+         return upper_bound(problem.variables_upper_bounds, problem.constraints_upper_bounds, problem.number_variables, constraint_index);
+      };
+
+      if (is_hot_start && this->is_factorization_valid) {
+         // the factorization and the working set of the previous subproblem are reused: only the bounds changed
+         for (size_t working_index = this->working_set.size(); 0 < working_index; working_index--) {
+            WorkingConstraint& working_constraint = this->working_set[working_index - 1];
+            const std::optional<WorkingBound> bound = updated_working_bound(lower(working_constraint.index), upper(working_constraint.index),
+                  working_constraint.bound);
+            if (bound.has_value()) {
+               working_constraint.bound = *bound;
+            }
+            else if (not this->remove_from_working_set(problem, working_index - 1)) {
+               return false;
+            }
+         }
+         return true;
+      }
+
+      // new factorization: the working set contains the previous working set (hot start) and the equality constraints
+      std::vector<WorkingConstraint> initial_working_set{};
+      if (is_hot_start) {
+         for (const WorkingConstraint& working_constraint: this->working_set) {
+            const std::optional<WorkingBound> bound = updated_working_bound(lower(working_constraint.index), upper(working_constraint.index),
+                  working_constraint.bound);
+            if (bound.has_value()) {
+               initial_working_set.push_back({working_constraint.index, *bound});
+            }
+         }
+      }
+      for (const WorkingConstraint& working_constraint: this->working_set) {
+         this->in_working_set[working_constraint.index] = false;
+      }
+      for (const WorkingConstraint& working_constraint: initial_working_set) {
+         this->in_working_set[working_constraint.index] = true;
+      }
+      for (size_t constraint_index: Range(number_constraints_total)) {
+         if (not this->in_working_set[constraint_index] && lower(constraint_index) == upper(constraint_index)) {
+            initial_working_set.push_back({constraint_index, WorkingBound::EQUALITY});
+            this->in_working_set[constraint_index] = true;
+         }
+      }
+      this->working_set = std::move(initial_working_set);
+      if (this->factorize(problem)) {
+         return true;
+      }
+      if (is_hot_start) {
+         // the previous working set is not compatible with the new constraints: start from the equality constraints
+         DEBUG << "Active-set QP solver: the previous working set is dependent, cold start\n";
+         return this->initialize_working_set(problem, false);
+      }
+      DEBUG << "Active-set QP solver: the equality constraints are linearly dependent\n";
+      return false;
+   }
+
+   // remove the inequality constraints whose multipliers have the wrong sign, until the working set is dual feasible
+   bool ActiveSetQPSolver::restore_dual_feasibility(const QuadraticProgram& problem) {
+      while (true) {
+         if (not this->solve_equality_constrained_qp(problem)) {
+            return false;
+         }
+         std::optional<size_t> infeasible_index{};
+         double smallest_signed_multiplier = -this->tolerance;
+         for (size_t working_index: Range(this->working_set.size())) {
+            const WorkingConstraint& working_constraint = this->working_set[working_index];
+            if (working_constraint.bound != WorkingBound::EQUALITY) {
+               const double signed_multiplier = this->sign(working_constraint) * this->working_multipliers[working_constraint.index];
+               if (signed_multiplier < smallest_signed_multiplier) {
+                  smallest_signed_multiplier = signed_multiplier;
+                  infeasible_index = working_index;
+               }
+            }
+         }
+         if (not infeasible_index.has_value()) {
+            return true;
+         }
+         if (not this->remove_from_working_set(problem, *infeasible_index)) {
+            return false;
+         }
+      }
+   }
+
+   // dual active-set method: starting from a dual feasible working set, the most violated constraint enters the working set.
+   // Blocking constraints (whose multipliers would change sign) leave the working set along the way
+   SubproblemStatus ActiveSetQPSolver::run_dual_active_set_method(const QuadraticProgram& problem) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints_total = number_variables + problem.number_constraints;
+      while (true) {
+         // most violated constraint (scaled violation)
+         std::optional<size_t> entering_index{};
+         WorkingBound entering_bound{WorkingBound::LOWER};
+         double entering_sign = 1.;
+         double largest_violation = 0.;
+         for (size_t constraint_index: Range(number_constraints_total)) {
+            if (this->in_working_set[constraint_index]) {
+               continue;
+            }
+            const double lower = lower_bound(problem.variables_lower_bounds, problem.constraints_lower_bounds, number_variables, constraint_index);
+            const double upper = upper_bound(problem.variables_upper_bounds, problem.constraints_upper_bounds, number_variables, constraint_index);
+            const double value = this->constraint_value(problem, constraint_index, this->primals);
+            const double lower_violation = (value < lower) ? (lower - value) / (std::max(1., std::abs(lower)) * this->constraint_norms[constraint_index]) : 0.;
+            const double upper_violation = (upper < value) ? (value - upper) / (std::max(1., std::abs(upper)) * this->constraint_norms[constraint_index]) : 0.;
+            const double violation = std::max(lower_violation, upper_violation);
+            if (this->tolerance < violation && largest_violation < violation) {
+               largest_violation = violation;
+               entering_index = constraint_index;
+               entering_sign = (0. < lower_violation) ? 1. : -1.;
+               entering_bound = (lower == upper) ? WorkingBound::EQUALITY : ((0. < lower_violation) ? WorkingBound::LOWER : WorkingBound::UPPER);
+            }
+         }
+         if (not entering_index.has_value()) {
+            return SubproblemStatus::OPTIMAL;
+         }
+         const WorkingConstraint entering_constraint{*entering_index, entering_bound};
+         const double entering_target = (0. < entering_sign) ?
+               lower_bound(problem.variables_lower_bounds, problem.constraints_lower_bounds, number_variables, *entering_index) :
+               upper_bound(problem.variables_upper_bounds, problem.constraints_upper_bounds, number_variables, *entering_index);
+         double entering_multiplier = 0.;
+
+         // steps until the entering constraint is satisfied
+         while (true) {
+            if (this->maximum_iterations <= this->number_iterations) {
+               WARNING << "Active-set QP solver: maximum number of iterations reached\n";
+               return SubproblemStatus::ERROR;
+            }
+            this->number_iterations++;
+
+            // step directions: [H A^T; A 0] [z; -Δλ] = [σ a_p; 0]
+            this->rhs.fill(0.);
+            std::fill(this->border_rhs.begin(), this->border_rhs.end(), 0.);
+            this->assemble_border_column(problem, {*entering_index, false}, this->rhs);
+            for (size_t variable_index: Range(number_variables)) {
+               this->rhs[variable_index] *= entering_sign;
+            }
+            this->solve_kkt_system(problem);
+            double primal_step_norm = 0.;
+            for (size_t variable_index: Range(number_variables)) {
+               this->primal_step[variable_index] = this->solution[variable_index];
+               primal_step_norm = std::max(primal_step_norm, std::abs(this->primal_step[variable_index]));
+            }
+            double multiplier_step_norm = 0.;
+            for (const WorkingConstraint& working_constraint: this->working_set) {
+               const double step = this->working_constraint_multiplier(problem, working_constraint.index);
+               this->multiplier_step[working_constraint.index] = step;
+               multiplier_step_norm = std::max(multiplier_step_norm, std::abs(step));
+            }
+
+            // dual step length: largest step that keeps the signs of the multipliers of the inequality constraints
+            double dual_step_length = INF<double>;
+            std::optional<size_t> blocking_index{};
+            for (size_t working_index: Range(this->working_set.size())) {
+               const WorkingConstraint& working_constraint = this->working_set[working_index];
+               if (working_constraint.bound != WorkingBound::EQUALITY) {
+                  const double sign = this->sign(working_constraint);
+                  const double signed_multiplier_step = sign * this->multiplier_step[working_constraint.index];
+                  if (signed_multiplier_step < 0.) {
+                     const double step_length = std::max(0., sign * this->working_multipliers[working_constraint.index]) / -signed_multiplier_step;
+                     if (step_length < dual_step_length) {
+                        dual_step_length = step_length;
+                        blocking_index = working_index;
+                     }
+                  }
+               }
+            }
+
+            // primal step length: the entering constraint becomes active
+            const bool is_dependent = (primal_step_norm <= dependency_tolerance * std::max(1., multiplier_step_norm));
+            const double primal_step_length = is_dependent ? INF<double> :
+                  (entering_target - this->constraint_value(problem, *entering_index, this->primals)) /
+                  this->constraint_value(problem, *entering_index, this->primal_step);
+            if (is_dependent && not blocking_index.has_value()) {
+               // the entering constraint is linearly dependent on the working set and cannot be satisfied
+               return SubproblemStatus::INFEASIBLE;
+            }
+
+            const double step_length = std::min(dual_step_length, primal_step_length);
+            if (not is_dependent) {
+               for (size_t variable_index: Range(number_variables)) {
+                  this->primals[variable_index] += step_length * this->primal_step[variable_index];
+               }
+            }
+            for (const WorkingConstraint& working_constraint: this->working_set) {
+               this->working_multipliers[working_constraint.index] += step_length * this->multiplier_step[working_constraint.index];
+            }
+            entering_multiplier += step_length * entering_sign;
+
+            if (dual_step_length < primal_step_length) {
+               // partial step: the blocking constraint leaves the working set
+               if (not this->remove_from_working_set(problem, *blocking_index)) {
+                  return SubproblemStatus::ERROR;
+               }
+            }
+            else {
+               // full step: the entering constraint joins the working set. The solution is recomputed to avoid the accumulation of errors
+               if (not this->add_to_working_set(problem, entering_constraint, entering_multiplier) ||
+                     not this->solve_equality_constrained_qp(problem)) {
+                  return SubproblemStatus::ERROR;
+               }
+               break;
+            }
+         }
+      }
+   }
+
+   double ActiveSetQPSolver::bound_value(const QuadraticProgram& problem, const WorkingConstraint& working_constraint) const {
+      if (working_constraint.bound == WorkingBound::UPPER) {
+         return upper_bound(problem.variables_upper_bounds, problem.constraints_upper_bounds, problem.number_variables, working_constraint.index);
+      }
+      return lower_bound(problem.variables_lower_bounds, problem.constraints_lower_bounds, problem.number_variables, working_constraint.index);
+   }
+
+   double ActiveSetQPSolver::constraint_value(const QuadraticProgram& problem, size_t constraint_index, const Vector<double>& x) const {
+      if (constraint_index < problem.number_variables) {
+         return x[constraint_index];
+      }
+      return sparse_row_dot(problem.constraint_jacobian[constraint_index - problem.number_variables], x.data());
+   }
+
+   // multipliers are nonnegative at lower bounds and nonpositive at upper bounds
+   double ActiveSetQPSolver::sign(const WorkingConstraint& working_constraint) const {
+      return (working_constraint.bound == WorkingBound::UPPER) ? -1. : 1.;
+   }
+
+   bool ActiveSetQPSolver::add_to_working_set(const QuadraticProgram& problem, const WorkingConstraint& working_constraint, double multiplier) {
+      const size_t constraint_index = working_constraint.index;
+      this->working_set.push_back(working_constraint);
+      this->in_working_set[constraint_index] = true;
+      this->working_multipliers[constraint_index] = multiplier;
+      if (this->factorized_position[constraint_index] != not_factorized) {
+         // the constraint is part of the factorized matrix: cancel its removal
+         for (size_t column_index: Range(this->border.size())) {
+            if (this->border[column_index].constraint_index == constraint_index) {
+               return this->remove_border_column(column_index) || this->factorize(problem);
+            }
+         }
+         return true;
+      }
+      return this->add_border_column(problem, {constraint_index, false});
+   }
+
+   bool ActiveSetQPSolver::remove_from_working_set(const QuadraticProgram& problem, size_t working_index) {
+      const size_t constraint_index = this->working_set[working_index].index;
+      this->working_set[working_index] = this->working_set.back();
+      this->working_set.pop_back();
+      this->in_working_set[constraint_index] = false;
+      this->working_multipliers[constraint_index] = 0.;
+      if (this->factorized_position[constraint_index] != not_factorized) {
+         // the constraint is part of the factorized matrix: its multiplier is set to 0 through the border
+         return this->add_border_column(problem, {constraint_index, true});
+      }
+      for (size_t column_index: Range(this->border.size())) {
+         if (this->border[column_index].constraint_index == constraint_index) {
+            return this->remove_border_column(column_index) || this->factorize(problem);
+         }
+      }
+      return true;
+   }
+
+   // factorize the KKT matrix of the current working set and empty the border
+   bool ActiveSetQPSolver::factorize(const QuadraticProgram& problem) {
+      const size_t number_variables = problem.number_variables;
+      const LowRankCorrection<double>* correction = (problem.hessian != nullptr && this->hessian_correction != nullptr &&
+            0 < this->hessian_correction->get_rank()) ? this->hessian_correction : nullptr;
+      const size_t rank = (correction != nullptr) ? correction->get_rank() : 0;
+      const size_t offset = number_variables + rank;
+
+      std::fill(this->factorized_position.begin(), this->factorized_position.end(), not_factorized);
+      for (size_t position: Range(this->working_set.size())) {
+         this->factorized_position[this->working_set[position].index] = position;
+      }
+      this->number_factorized_constraints = this->working_set.size();
+      const size_t dimension = offset + this->number_factorized_constraints;
+
+      this->kkt_matrix.reset();
+      this->kkt_matrix.set_dimension(dimension);
+      // Hessian and proximal regularization
+      if (problem.hessian != nullptr) {
+         problem.hessian->for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+            this->kkt_matrix.insert(element, row_index, column_index);
+         });
+      }
+      for (size_t variable_index: Range(number_variables)) {
+         this->kkt_matrix.insert(this->regularization, variable_index, variable_index);
+      }
+      // low-rank correction -Ψ N^{-1} Ψ^T: its Schur complement in [H Ψ; Ψ^T N] is added to H
+      if (correction != nullptr) {
+         const size_t correction_dimension = correction->get_dimension();
+         const std::vector<double>& basis = correction->get_basis();
+         const std::vector<double>& middle_matrix = correction->get_middle_matrix();
+         for (size_t rank_index: Range(rank)) {
+            for (size_t variable_index: Range(correction_dimension)) {
+               const double element = basis[rank_index * correction_dimension + variable_index];
+               if (element != 0.) {
+                  this->kkt_matrix.insert(element, variable_index, number_variables + rank_index);
+               }
+            }
+            for (size_t other_rank_index: Range(rank_index + 1)) {
+               this->kkt_matrix.insert(middle_matrix[rank_index * rank + other_rank_index], number_variables + other_rank_index,
+                     number_variables + rank_index);
+            }
+         }
+      }
+      // working set
+      for (size_t position: Range(this->number_factorized_constraints)) {
+         const size_t constraint_index = this->working_set[position].index;
+         const size_t row_index = offset + position;
+         if (constraint_index < number_variables) {
+            this->kkt_matrix.insert(1., constraint_index, row_index);
+         }
+         else {
+            for (const auto [variable_index, derivative]: problem.constraint_jacobian[constraint_index - number_variables]) {
+               this->kkt_matrix.insert(derivative, variable_index, row_index);
+            }
+         }
+         this->kkt_matrix.insert(0., row_index, row_index);
+      }
+
+      // the linear solver is (re)allocated when the matrix outgrows it
+      if (this->linear_solver == nullptr || this->linear_solver_dimension < dimension ||
+            this->linear_solver_number_nonzeros < this->kkt_matrix.number_nonzeros()) {
+         this->linear_solver_dimension = std::max(dimension, offset + number_variables);
+         this->linear_solver_number_nonzeros = this->kkt_matrix.number_nonzeros() + number_variables;
+         this->linear_solver = SymmetricIndefiniteLinearSolverFactory::create(this->linear_solver_dimension, this->linear_solver_number_nonzeros,
+               this->options);
+      }
+      this->linear_solver->factorize(this->kkt_matrix);
+      this->number_factorizations++;
+      this->border.clear();
+      this->border_solutions.clear();
+      this->schur_complement.clear();
+      this->correction_rank = rank;
+      this->is_factorization_with_hessian = (problem.hessian != nullptr);
+      this->rhs.resize(dimension);
+      this->solution.resize(dimension);
+      this->border_rhs.clear();
+      this->border_solution.clear();
+      this->is_factorization_valid = not this->linear_solver->matrix_is_singular();
+      return this->is_factorization_valid;
+   }
+
+   // border the factorized matrix with a column u: the Schur complement gains the row and column -u^T K0^{-1} [U u]
+   bool ActiveSetQPSolver::add_border_column(const QuadraticProgram& problem, const BorderColumn& column) {
+      if (this->maximum_schur_size <= this->border.size()) {
+         DEBUG << "Active-set QP solver: the Schur complement is too large, refactorization\n";
+         return this->factorize(problem);
+      }
+      const size_t dimension = this->kkt_matrix.dimension();
+      this->assemble_border_column(problem, column, this->rhs);
+      this->linear_solver->solve_indefinite_system(this->kkt_matrix, this->rhs, this->solution);
+      this->border_solutions.insert(this->border_solutions.end(), this->solution.begin(), this->solution.begin() +
+            static_cast<std::ptrdiff_t>(dimension));
+
+      // S is stored column-major
+      const size_t old_size = this->border.size();
+      const size_t new_size = old_size + 1;
+      std::vector<double> new_schur_complement(new_size * new_size);
+      for (size_t column_index: Range(old_size)) {
+         for (size_t row_index: Range(old_size)) {
+            new_schur_complement[column_index * new_size + row_index] = this->schur_complement[column_index * old_size + row_index];
+         }
+      }
+      for (size_t row_index: Range(old_size)) {
+         const double element = -this->border_column_product(problem, this->border[row_index], this->solution);
+         new_schur_complement[old_size * new_size + row_index] = element;
+         new_schur_complement[row_index * new_size + old_size] = element;
+      }
+      new_schur_complement[old_size * new_size + old_size] = -this->border_column_product(problem, column, this->solution);
+      this->schur_complement = std::move(new_schur_complement);
+      this->border.push_back(column);
+      this->border_rhs.resize(new_size);
+      this->border_solution.resize(new_size);
+      return this->factorize_schur_complement() || this->factorize(problem);
+   }
+
+   bool ActiveSetQPSolver::remove_border_column(size_t column_index) {
+      const size_t dimension = this->kkt_matrix.dimension();
+      const size_t old_size = this->border.size();
+      const size_t new_size = old_size - 1;
+      std::vector<double> new_schur_complement(new_size * new_size);
+      for (size_t new_column_index: Range(new_size)) {
+         const size_t old_column_index = new_column_index + (column_index <= new_column_index ? 1 : 0);
+         for (size_t new_row_index: Range(new_size)) {
+            const size_t old_row_index = new_row_index + (column_index <= new_row_index ? 1 : 0);
+            new_schur_complement[new_column_index * new_size + new_row_index] = this->schur_complement[old_column_index * old_size + old_row_index];
+         }
+      }
+      this->schur_complement = std::move(new_schur_complement);
+      this->border.erase(this->border.begin() + static_cast<std::ptrdiff_t>(column_index));
+      this->border_solutions.erase(this->border_solutions.begin() + static_cast<std::ptrdiff_t>(column_index * dimension),
+            this->border_solutions.begin() + static_cast<std::ptrdiff_t>((column_index + 1) * dimension));
+      this->border_rhs.resize(new_size);
+      this->border_solution.resize(new_size);
+      return this->factorize_schur_complement();
+   }
+
+   bool ActiveSetQPSolver::factorize_schur_complement() {
+      if (this->border.empty()) {
+         return true;
+      }
+      return this->schur_factorization.factorize(this->schur_complement, this->border.size());
+   }
+
+   void ActiveSetQPSolver::assemble_border_column(const QuadraticProgram& problem, const BorderColumn& column, Vector<double>& vector) const {
+      vector.fill(0.);
+      if (column.is_removal) {
+         vector[problem.number_variables + this->correction_rank + this->factorized_position[column.constraint_index]] = 1.;
+      }
+      else if (column.constraint_index < problem.number_variables) {
+         vector[column.constraint_index] = 1.;
+      }
+      else {
+         for (const auto [variable_index, derivative]: problem.constraint_jacobian[column.constraint_index - problem.number_variables]) {
+            vector[variable_index] = derivative;
+         }
+      }
+   }
+
+   double ActiveSetQPSolver::border_column_product(const QuadraticProgram& problem, const BorderColumn& column, const Vector<double>& vector) const {
+      if (column.is_removal) {
+         return vector[problem.number_variables + this->correction_rank + this->factorized_position[column.constraint_index]];
+      }
+      return this->constraint_value(problem, column.constraint_index, vector);
+   }
+
+   // solve [K0 U; U^T 0] [x; w] = [rhs; border_rhs] with K0 t = rhs, S w = border_rhs - U^T t and x = t - K0^{-1} U w
+   void ActiveSetQPSolver::solve_kkt_system(const QuadraticProgram& problem) {
+      this->linear_solver->solve_indefinite_system(this->kkt_matrix, this->rhs, this->solution);
+      const size_t border_size = this->border.size();
+      if (border_size == 0) {
+         return;
+      }
+      for (size_t column_index: Range(border_size)) {
+         this->border_solution[column_index] = this->border_rhs[column_index] -
+               this->border_column_product(problem, this->border[column_index], this->solution);
+      }
+      this->schur_factorization.solve(this->border_solution);
+      const size_t dimension = this->kkt_matrix.dimension();
+      for (size_t column_index: Range(border_size)) {
+         const double factor = this->border_solution[column_index];
+         const double* border_solution_column = this->border_solutions.data() + column_index * dimension;
+         for (size_t index: Range(dimension)) {
+            this->solution[index] -= factor * border_solution_column[index];
+         }
+      }
+   }
+
+   // solution and multipliers of the QP whose constraints in the working set are equalities
+   bool ActiveSetQPSolver::solve_equality_constrained_qp(const QuadraticProgram& problem) {
+      const size_t number_variables = problem.number_variables;
+      const size_t offset = number_variables + this->correction_rank;
+      this->rhs.fill(0.);
+      std::fill(this->border_rhs.begin(), this->border_rhs.end(), 0.);
+      for (const auto [variable_index, derivative]: problem.linear_objective) {
+         this->rhs[variable_index] = -derivative;
+      }
+      for (const WorkingConstraint& working_constraint: this->working_set) {
+         const double bound = this->bound_value(problem, working_constraint);
+         if (this->factorized_position[working_constraint.index] != not_factorized) {
+            this->rhs[offset + this->factorized_position[working_constraint.index]] = bound;
+         }
+         else {
+            for (size_t column_index: Range(this->border.size())) {
+               if (this->border[column_index].constraint_index == working_constraint.index) {
+                  this->border_rhs[column_index] = bound;
+               }
+            }
+         }
+      }
+      this->solve_kkt_system(problem);
+      for (size_t variable_index: Range(number_variables)) {
+         if (not std::isfinite(this->solution[variable_index])) {
+            return false;
+         }
+         this->primals[variable_index] = this->solution[variable_index];
+      }
+      for (const WorkingConstraint& working_constraint: this->working_set) {
+         this->working_multipliers[working_constraint.index] = this->working_constraint_multiplier(problem, working_constraint.index);
+      }
+      return true;
+   }
+
+   // the KKT systems are solved for the negated multipliers
+   double ActiveSetQPSolver::working_constraint_multiplier(const QuadraticProgram& problem, size_t constraint_index) const {
+      if (this->factorized_position[constraint_index] != not_factorized) {
+         return -this->solution[problem.number_variables + this->correction_rank + this->factorized_position[constraint_index]];
+      }
+      for (size_t column_index: Range(this->border.size())) {
+         if (this->border[column_index].constraint_index == constraint_index) {
+            return -this->border_solution[column_index];
+         }
+      }
+      return 0.;
+   }
+
+   void ActiveSetQPSolver::set_direction(const QuadraticProgram& problem, Direction& direction) const {
+      const size_t number_variables = problem.number_variables;
+      direction.multipliers.reset();
+      for (size_t variable_index: Range(number_variables)) {
+         direction.primals[variable_index] = this->primals[variable_index];
+      }
+      for (const WorkingConstraint& working_constraint: this->working_set) {
+         const size_t constraint_index = working_constraint.index;
+         const double multiplier = this->working_multipliers[constraint_index];
+         if (constraint_index < number_variables) {
+            if (working_constraint.bound == WorkingBound::LOWER || (working_constraint.bound == WorkingBound::EQUALITY && 0. <= multiplier)) {
+               direction.multipliers.lower_bounds[constraint_index] = multiplier;
+               direction.active_bounds.at_lower_bound.emplace_back(constraint_index);
+            }
+            else {
+               direction.multipliers.upper_bounds[constraint_index] = multiplier;
+               direction.active_bounds.at_upper_bound.emplace_back(constraint_index);
+            }
+         }
+         else {
+            direction.multipliers.constraints[constraint_index - number_variables] = multiplier;
+         }
+      }
+      // objective 1/2 d^T H d + g^T d
+      double objective = 0.;
+      for (const auto [variable_index, derivative]: problem.linear_objective) {
+         objective += derivative * this->primals[variable_index];
+      }
+      if (problem.hessian != nullptr) {
+         objective += 0.5 * problem.hessian->quadratic_product(this->primals, this->primals);
+         if (this->correction_rank != 0 && this->hessian_correction != nullptr) {
+            objective += 0.5 * this->hessian_correction->quadratic_product(this->primals);
+         }
+      }
+      direction.subproblem_objective = objective;
+   }
+} // namespace
@@ -0,0 +1,159 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_ACTIVESETQPSOLVER_H
+#define UNO_ACTIVESETQPSOLVER_H
+
+#include <memory>
+#include <vector>
+#include "ingredients/subproblems/SubproblemStatus.hpp"
+#include "linear_algebra/DenseLUFactorization.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "solvers/QPSolver.hpp"
+
+namespace uno {
+   // forward declaration
+   template <typename IndexType, typename ElementType>
+   class DirectSymmetricIndefiniteLinearSolver;
+
+   // side of a constraint of the working set
+   enum class WorkingBound {LOWER, UPPER, EQUALITY};
+
+   // constraint of the working set: a bound constraint (index < number_variables) or a general constraint
+   // (index = number_variables + constraint index), held at one of its bounds
+   struct WorkingConstraint {
+      size_t index;
+      WorkingBound bound;
+   };
+
+   /*! \class ActiveSetQPSolver
+    * \brief In-tree dual active-set (Goldfarb-Idnani) QP solver
+    *
+    * The KKT matrix of the initial working set is factorized once with a symmetric indefinite linear solver. The subsequent
+    * changes of the working set border the factorized matrix and are handled with a dense Schur complement, until it
+    * exceeds a given size and the KKT matrix of the current working set is refactorized.
+    * The method requires a Hessian that is positive definite on the null space of the working set: a small proximal term
+    * is added to the diagonal so that LPs and positive semidefinite QPs can be solved.
+    * The working set (and the factorization when only the bounds changed) is reused by the next subproblem.
+    */
+   class ActiveSetQPSolver : public QPSolver {
+   public:
+      ActiveSetQPSolver(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros,
+            const Options& options);
+      ~ActiveSetQPSolver() override;
+
+      void solve_LP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+            const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+            const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+            const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& initial_point, Direction& direction,
+            const WarmstartInformation& warmstart_information) override;
+
+      void solve_QP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+            const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+            const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+            const RectangularMatrix<double>& constraint_jacobian, const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& initial_point,
+            Direction& direction, const WarmstartInformation& warmstart_information) override;
+
+      [[nodiscard]] size_t get_number_iterations() const { return this->number_iterations; }
+      [[nodiscard]] size_t get_number_factorizations() const { return this->number_factorizations; }
+
+   protected:
+      // data of the QP being solved
+      struct QuadraticProgram {
+         size_t number_variables;
+         size_t number_constraints;
+         const std::vector<double>& variables_lower_bounds;
+         const std::vector<double>& variables_upper_bounds;
+         const std::vector<double>& constraints_lower_bounds;
+         const std::vector<double>& constraints_upper_bounds;
+         const SparseVector<double>& linear_objective;
+         const RectangularMatrix<double>& constraint_jacobian;
+         const SymmetricMatrix<size_t, double>* hessian; // nullptr for LPs
+      };
+
+      // column that borders the factorized KKT matrix: a constraint added to the working set, or a factorized constraint
+      // removed from the working set
+      struct BorderColumn {
+         size_t constraint_index;
+         bool is_removal;
+      };
+
+      static constexpr size_t not_factorized = static_cast<size_t>(-1);
+
+      const Options options;
+      const double regularization;
+      const double tolerance;
+      const size_t maximum_schur_size;
+      const size_t maximum_iterations;
+      const bool print_subproblem;
+
+      // dimensions of the previous subproblem
+      size_t number_variables{0};
+      size_t number_constraints{0};
+
+      // working set and its multipliers (indexed by constraint index)
+      std::vector<WorkingConstraint> working_set{};
+      std::vector<bool> in_working_set{};
+      std::vector<double> working_multipliers{};
+
+      // factorized KKT matrix [H Ψ A0^T; Ψ^T N 0; A0 0 0] where A0 is the working set at factorization time and -Ψ N^{-1} Ψ^T
+      // is the low-rank correction of the Hessian (if any)
+      SymmetricMatrix<size_t, double> kkt_matrix;
+      std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> linear_solver{};
+      size_t linear_solver_dimension{0};
+      size_t linear_solver_number_nonzeros{0};
+      std::vector<size_t> factorized_position{}; // position in A0 (not_factorized otherwise)
+      size_t number_factorized_constraints{0};
+      size_t correction_rank{0};
+      bool is_factorization_valid{false};
+      bool is_factorization_with_hessian{false};
+
+      // Schur complement of the border: S = -U^T K0^{-1} U, with the columns of K0^{-1} U stored in a dense column-major block
+      std::vector<BorderColumn> border{};
+      std::vector<double> border_solutions{};
+      std::vector<double> schur_complement{};
+      DenseLUFactorization<double> schur_factorization{};
+
+      // primal solution and workspace
+      Vector<double> primals{};
+      std::vector<double> constraint_norms{};
+      Vector<double> rhs{};
+      Vector<double> solution{};
+      std::vector<double> border_rhs{};
+      std::vector<double> border_solution{};
+      Vector<double> primal_step{};
+      std::vector<double> multiplier_step{};
+
+      size_t number_iterations{0};
+      size_t number_factorizations{0};
+
+      void solve_subproblem(const QuadraticProgram& problem, Direction& direction, const WarmstartInformation& warmstart_information);
+      [[nodiscard]] bool initialize_working_set(const QuadraticProgram& problem, bool is_hot_start);
+      [[nodiscard]] bool restore_dual_feasibility(const QuadraticProgram& problem);
+      [[nodiscard]] SubproblemStatus run_dual_active_set_method(const QuadraticProgram& problem);
+
+      // working set
+      [[nodiscard]] double bound_value(const QuadraticProgram& problem, const WorkingConstraint& working_constraint) const;
+      [[nodiscard]] double constraint_value(const QuadraticProgram& problem, size_t constraint_index, const Vector<double>& x) const;
+      [[nodiscard]] double sign(const WorkingConstraint& working_constraint) const;
+      [[nodiscard]] bool add_to_working_set(const QuadraticProgram& problem, const WorkingConstraint& working_constraint, double multiplier);
+      [[nodiscard]] bool remove_from_working_set(const QuadraticProgram& problem, size_t working_index);
+
+      // KKT systems
+      [[nodiscard]] bool factorize(const QuadraticProgram& problem);
+      [[nodiscard]] bool add_border_column(const QuadraticProgram& problem, const BorderColumn& column);
+      [[nodiscard]] bool remove_border_column(size_t column_index);
+      [[nodiscard]] bool factorize_schur_complement();
+      void assemble_border_column(const QuadraticProgram& problem, const BorderColumn& column, Vector<double>& vector) const;
+      [[nodiscard]] double border_column_product(const QuadraticProgram& problem, const BorderColumn& column, const Vector<double>& vector) const;
+      void solve_kkt_system(const QuadraticProgram& problem);
+      [[nodiscard]] bool solve_equality_constrained_qp(const QuadraticProgram& problem);
+      [[nodiscard]] double working_constraint_multiplier(const QuadraticProgram& problem, size_t constraint_index) const;
+
+      void set_direction(const QuadraticProgram& problem, Direction& direction) const;
+   };
+} // namespace
+
+#endif // UNO_ACTIVESETQPSOLVER_H
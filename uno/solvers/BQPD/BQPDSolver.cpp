@@ -1,11 +1,13 @@
 // Copyright (c) 2018-2024 Charlie Vanaret
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
-#include <cassert>
 #include <algorithm>
+#include <mutex>
 #include "BQPDSolver.hpp"
 #include "optimization/Direction.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "optimization/WarmstartInformation.hpp"
@@ -17,6 +19,7 @@
 #define WSC FC_GLOBAL(wsc,WSC)
 #define KKTALPHAC FC_GLOBAL(kktalphac,KKTALPHAC)
 #define BQPD FC_GLOBAL(bqpd,BQPD)
+#define HESSCORR FC_GLOBAL(hesscorr,HESSCORR)
 
 namespace uno {
 #define BIG 1e30
@@ -38,26 +41,37 @@ namespace uno {
          int* info, int* iprint, int* nout);
    }
 
+   // low-rank correction of the Hessian of the QP being solved (nullptr if none)
+   thread_local const LowRankCorrection<double>* current_hessian_correction = nullptr;
+
+   extern "C" {
+   // called by gdotx in wdotd.f: result += (low-rank correction) x
+   void HESSCORR(const int* n, const double* x, double* result) {
+      if (current_hessian_correction != nullptr && current_hessian_correction->get_dimension() <= static_cast<size_t>(*n)) {
+         current_hessian_correction->add_product(x, result);
+      }
+   }
+   }
+
+   // BQPD keeps part of its state in global memory (common blocks, saved variables): the calls are serialized, and an instance
+   // that did not make the last call cannot reuse the factors of its previous call
+   std::mutex bqpd_mutex;
+   const BQPDSolver* last_bqpd_instance = nullptr;
+
+   // number of times a workspace may grow during a single call
+   constexpr size_t maximum_number_workspace_resizes = 10;
+
    // preallocate a bunch of stuff
    BQPDSolver::BQPDSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros,
          size_t number_hessian_nonzeros, BQPDProblemType problem_type, const Options& options):
-         QPSolver(), number_hessian_nonzeros(number_hessian_nonzeros),
+         QPSolver(),
          lb(number_variables + number_constraints),
          ub(number_variables + number_constraints),
-         jacobian(number_jacobian_nonzeros + number_objective_gradient_nonzeros), // Jacobian + objective gradient
-         jacobian_sparsity(number_jacobian_nonzeros + number_objective_gradient_nonzeros + number_constraints + 3),
-         kmax(problem_type == BQPDProblemType::QP ? options.get_int("BQPD_kmax") : 0), alp(static_cast<size_t>(this->mlp)),
-         lp(static_cast<size_t>(this->mlp)),
+         workspace(number_variables, number_constraints, number_objective_gradient_nonzeros, number_jacobian_nonzeros, number_hessian_nonzeros,
+               problem_type, problem_type == BQPDProblemType::QP ? options.get_int("BQPD_kmax") : 0),
          active_set(number_variables + number_constraints),
          w(number_variables + number_constraints), gradient_solution(number_variables), residuals(number_variables + number_constraints),
          e(number_variables + number_constraints),
-         size_hessian_sparsity(problem_type == BQPDProblemType::QP ? number_hessian_nonzeros + number_variables + 3 : 0),
-         size_hessian_workspace(number_hessian_nonzeros + static_cast<size_t>(this->kmax * (this->kmax + 9) / 2) + 2 * number_variables +
-                                number_constraints + this->mxwk0),
-         size_hessian_sparsity_workspace(this->size_hessian_sparsity + static_cast<size_t>(this->kmax) + this->mxiwk0),
-         hessian_values(this->size_hessian_workspace),
-         hessian_sparsity(this->size_hessian_sparsity_workspace),
-         current_hessian_indices(number_variables),
          print_subproblem(options.get_bool("print_subproblem")) {
       // default active set
       for (size_t variable_index: Range(number_variables + number_constraints)) {
@@ -65,20 +79,30 @@ namespace uno {
       }
    }
 
+   BQPDSolver::~BQPDSolver() {
+      // a new instance at the same address must not reuse the factors
+      std::lock_guard<std::mutex> lock(bqpd_mutex);
+      if (last_bqpd_instance == this) {
+         last_bqpd_instance = nullptr;
+      }
+   }
+
    void BQPDSolver::solve_QP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
          const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
          const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
          const RectangularMatrix<double>& constraint_jacobian, const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& initial_point,
          Direction& direction, const WarmstartInformation& warmstart_information) {
       if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
-         this->save_hessian_to_local_format(hessian);
+         this->workspace.save_hessian(hessian);
       }
       if (this->print_subproblem) {
          DEBUG << "QP:\n";
          DEBUG << "Hessian: " << hessian;
       }
+      current_hessian_correction = this->hessian_correction;
       this->solve_subproblem(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
             constraints_upper_bounds, linear_objective, constraint_jacobian, initial_point, direction, warmstart_information);
+      current_hessian_correction = nullptr;
    }
 
    void BQPDSolver::solve_LP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
@@ -98,14 +122,6 @@ namespace uno {
          const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
          const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& initial_point, Direction& direction,
          const WarmstartInformation& warmstart_information) {
-      // initialize wsc_ common block (Hessian & workspace for BQPD)
-      // setting the common block here ensures that several instances of BQPD can run simultaneously
-      WSC.kk = static_cast<int>(this->number_hessian_nonzeros);
-      WSC.ll = static_cast<int>(this->size_hessian_sparsity);
-      WSC.mxws = static_cast<int>(this->size_hessian_workspace);
-      WSC.mxlws = static_cast<int>(this->size_hessian_sparsity_workspace);
-      KKTALPHAC.alpha = 0; // inertia control
-
       if (this->print_subproblem) {
          DEBUG << "objective gradient: " << linear_objective;
          for (size_t constraint_index: Range(number_constraints)) {
@@ -121,7 +137,7 @@ namespace uno {
 
       // Jacobian (objective and constraints)
       if (warmstart_information.objective_changed || warmstart_information.constraints_changed) {
-         this->save_gradients_to_local_format(number_constraints, linear_objective, constraint_jacobian);
+         this->workspace.save_gradients(number_constraints, linear_objective, constraint_jacobian);
       }
 
       // set variable bounds
@@ -143,15 +159,43 @@ namespace uno {
       const int n = static_cast<int>(number_variables);
       const int m = static_cast<int>(number_constraints);
 
-      const BQPDMode mode = this->determine_mode(warmstart_information);
-      const int mode_integer = static_cast<int>(mode);
+      {
+         std::lock_guard<std::mutex> lock(bqpd_mutex);
+         BQPDMode mode = this->determine_mode(warmstart_information);
+         if (last_bqpd_instance != this && BQPDMode::USER_DEFINED < mode) {
+            // the factors were overwritten by another instance: refactorize with the current active set
+            mode = BQPDMode::USER_DEFINED;
+         }
+         last_bqpd_instance = this;
+
+         size_t number_workspace_resizes = 0;
+         while (true) {
+            const int mode_integer = static_cast<int>(mode);
+            // initialize wsc_ common block (Hessian & workspace for BQPD)
+            // setting the common block here ensures that several instances of BQPD can run one after the other
+            WSC.kk = static_cast<int>(this->workspace.number_hessian_nonzeros);
+            WSC.ll = static_cast<int>(this->workspace.size_hessian_sparsity);
+            WSC.mxws = static_cast<int>(this->workspace.size_hessian_workspace);
+            WSC.mxlws = static_cast<int>(this->workspace.size_hessian_sparsity_workspace);
+            KKTALPHAC.alpha = 0; // inertia control
 
-      // solve the LP/QP
-      BQPD(&n, &m, &this->k, &this->kmax, this->jacobian.data(), this->jacobian_sparsity.data(), direction.primals.data(), this->lb.data(),
-            this->ub.data(), &direction.subproblem_objective, &this->fmin, this->gradient_solution.data(), this->residuals.data(), this->w.data(),
-            this->e.data(), this->active_set.data(), this->alp.data(), this->lp.data(), &this->mlp, &this->peq_solution, this->hessian_values.data(),
-            this->hessian_sparsity.data(), &mode_integer, &this->ifail, this->info.data(), &this->iprint, &this->nout);
-      const BQPDStatus bqpd_status = BQPDSolver::bqpd_status_from_int(this->ifail);
+            // solve the LP/QP
+            BQPD(&n, &m, &this->k, &this->workspace.kmax, this->workspace.jacobian.data(), this->workspace.jacobian_sparsity.data(),
+                  direction.primals.data(), this->lb.data(), this->ub.data(), &direction.subproblem_objective, &this->fmin, this->gradient_solution.data(),
+                  this->residuals.data(), this->w.data(), this->e.data(), this->active_set.data(), this->workspace.alp.data(), this->workspace.lp.data(),
+                  &this->workspace.mlp, &this->peq_solution, this->workspace.hessian_values.data(), this->workspace.hessian_sparsity.data(),
+                  &mode_integer, &this->ifail, this->info.data(), &this->iprint, &this->nout);
+
+            // BQPD ran out of space: grow the corresponding workspace and solve again with a cold start
+            if (number_workspace_resizes == maximum_number_workspace_resizes || not this->workspace.grow(bqpd_status_from_int(this->ifail))) {
+               break;
+            }
+            number_workspace_resizes++;
+            direction.primals = initial_point;
+            mode = BQPDMode::ACTIVE_SET_EQUALITIES;
+         }
+      }
+      const BQPDStatus bqpd_status = bqpd_status_from_int(this->ifail);
       direction.status = BQPDSolver::status_from_bqpd_status(bqpd_status);
       this->number_calls++;
 
@@ -177,71 +221,6 @@ namespace uno {
       return mode;
    }
 
-   // save Hessian (in arbitrary format) to a "weak" CSC format: compressed columns but row indices are not sorted, nor unique
-   void BQPDSolver::save_hessian_to_local_format(const SymmetricMatrix<size_t, double>& hessian) {
-      const size_t header_size = 1;
-      // pointers withing the single array
-      int* row_indices = &this->hessian_sparsity[header_size];
-      int* column_starts = &this->hessian_sparsity[header_size + hessian.number_nonzeros()];
-      // header
-      this->hessian_sparsity[0] = static_cast<int>(hessian.number_nonzeros() + 1);
-      // count the elements in each column
-      for (size_t column_index: Range(hessian.dimension() + 1)) {
-         column_starts[column_index] = 0;
-      }
-      for (const auto [row_index, column_index, element]: hessian) {
-         column_starts[column_index + 1]++;
-      }
-      // carry over the column starts
-      for (size_t column_index: Range(1, hessian.dimension() + 1)) {
-         column_starts[column_index] += column_starts[column_index - 1];
-         column_starts[column_index - 1] += this->fortran_shift;
-      }
-      column_starts[hessian.dimension()] += this->fortran_shift;
-      // copy the entries
-      //std::vector<int> current_indices(hessian.dimension());
-      this->current_hessian_indices.fill(0);
-      for (const auto [row_index, column_index, element]: hessian) {
-         const size_t index = static_cast<size_t>(column_starts[column_index] + this->current_hessian_indices[column_index] - this->fortran_shift);
-         assert(index <= static_cast<size_t>(column_starts[column_index + 1]) &&
-                "BQPD: error in converting the Hessian matrix to the local format. Try setting the sparse format to CSC");
-         this->hessian_values[index] = element;
-         row_indices[index] = static_cast<int>(row_index) + this->fortran_shift;
-         this->current_hessian_indices[column_index]++;
-      }
-   }
-
-   void BQPDSolver::save_gradients_to_local_format(size_t number_constraints, const SparseVector<double>& linear_objective,
-         const RectangularMatrix<double>& constraint_jacobian) {
-      size_t current_index = 0;
-      for (const auto [variable_index, derivative]: linear_objective) {
-         this->jacobian[current_index] = derivative;
-         this->jacobian_sparsity[current_index + 1] = static_cast<int>(variable_index) + this->fortran_shift;
-         current_index++;
-      }
-      for (size_t constraint_index: Range(number_constraints)) {
-         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
-            this->jacobian[current_index] = derivative;
-            this->jacobian_sparsity[current_index + 1] = static_cast<int>(variable_index) + this->fortran_shift;
-            current_index++;
-         }
-      }
-      current_index++;
-      this->jacobian_sparsity[0] = static_cast<int>(current_index);
-      // header
-      size_t size = 1;
-      this->jacobian_sparsity[current_index] = static_cast<int>(size);
-      current_index++;
-      size += linear_objective.size();
-      this->jacobian_sparsity[current_index] = static_cast<int>(size);
-      current_index++;
-      for (size_t constraint_index: Range(number_constraints)) {
-         size += constraint_jacobian[constraint_index].size();
-         this->jacobian_sparsity[current_index] = static_cast<int>(size);
-         current_index++;
-      }
-   }
-
    void BQPDSolver::categorize_constraints(size_t number_variables, Direction& direction) {
       direction.multipliers.reset();
 
@@ -273,11 +252,6 @@ namespace uno {
       }
    }
 
-   BQPDStatus BQPDSolver::bqpd_status_from_int(int ifail) {
-      assert(0 <= ifail && ifail <= 9 && "BQPDSolver.bqpd_status_from_int: ifail does not belong to [0, 9]");
-      return static_cast<BQPDStatus>(ifail);
-   }
-
    SubproblemStatus BQPDSolver::status_from_bqpd_status(BQPDStatus bqpd_status) {
       switch (bqpd_status) {
          case BQPDStatus::OPTIMAL:
@@ -297,7 +271,7 @@ namespace uno {
             DEBUG << "BQPD error: LP insufficient space\n";
             return SubproblemStatus::ERROR;
          case BQPDStatus::HESSIAN_INSUFFICIENT_SPACE:
-            DEBUG << "BQPD kmax too small, continue anyway\n";
+            DEBUG << "BQPD error: kmax too small\n";
             return SubproblemStatus::ERROR;
          case BQPDStatus::SPARSE_INSUFFICIENT_SPACE:
             DEBUG << "BQPD error: sparse insufficient space\n";
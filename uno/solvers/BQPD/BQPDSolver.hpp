@@ -6,6 +6,7 @@
 
 #include <array>
 #include <vector>
+#include "BQPDWorkspace.hpp"
 #include "ingredients/subproblems/SubproblemStatus.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "solvers/QPSolver.hpp"
@@ -14,20 +15,6 @@ namespace uno {
    // forward declaration
    class Options;
 
-   // see bqpd.f
-   enum class BQPDStatus {
-      OPTIMAL = 0,
-      UNBOUNDED_PROBLEM = 1,
-      BOUND_INCONSISTENCY = 2,
-      INFEASIBLE = 3,
-      INCORRECT_PARAMETER = 4,
-      LP_INSUFFICIENT_SPACE = 5,
-      HESSIAN_INSUFFICIENT_SPACE = 6,
-      SPARSE_INSUFFICIENT_SPACE = 7,
-      MAX_RESTARTS_REACHED = 8,
-      UNDEFINED = 9
-   };
-
    enum BQPDMode {
       COLD_START = 0,
       ACTIVE_SET_EQUALITIES = 1, // cold start
@@ -38,12 +25,11 @@ namespace uno {
       UNCHANGED_ACTIVE_SET_AND_JACOBIAN_AND_REDUCED_HESSIAN = 6, // warm start
    };
 
-   enum class BQPDProblemType {LP, QP};
-
    class BQPDSolver : public QPSolver {
    public:
       BQPDSolver(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros,
             size_t number_hessian_nonzeros, BQPDProblemType problem_type, const Options& options);
+      ~BQPDSolver() override;
 
       void solve_LP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
             const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
@@ -58,28 +44,17 @@ namespace uno {
             Direction& direction, const WarmstartInformation& warmstart_information) override;
 
    private:
-      const size_t number_hessian_nonzeros;
       std::vector<double> lb{}, ub{}; // lower and upper bounds of variables and constraints
 
-      std::vector<double> jacobian{};
-      std::vector<int> jacobian_sparsity{};
-      int kmax{0}, mlp{1000};
-      size_t mxwk0{2000000}, mxiwk0{500000};
+      BQPDWorkspace workspace;
       std::array<int, 100> info{};
-      std::vector<double> alp{};
-      std::vector<int> lp{}, active_set{};
+      std::vector<int> active_set{};
       std::vector<double> w{}, gradient_solution{}, residuals{}, e{};
-      size_t size_hessian_sparsity{};
-      size_t size_hessian_workspace{};
-      size_t size_hessian_sparsity_workspace{};
-      std::vector<double> hessian_values{};
-      std::vector<int> hessian_sparsity{};
       int k{0};
       int iprint{0}, nout{6};
       double fmin{-1e20};
       int peq_solution{0}, ifail{0};
       const int fortran_shift{1};
-      Vector<int> current_hessian_indices{};
 
       size_t number_calls{0};
       const bool print_subproblem;
@@ -90,11 +65,7 @@ namespace uno {
             const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& initial_point, Direction& direction,
             const WarmstartInformation& warmstart_information);
       void categorize_constraints(size_t number_variables, Direction& direction);
-      void save_hessian_to_local_format(const SymmetricMatrix<size_t, double>& hessian);
-      void save_gradients_to_local_format(size_t number_constraints, const SparseVector<double>& linear_objective,
-            const RectangularMatrix<double>& constraint_jacobian);
       [[nodiscard]] BQPDMode determine_mode(const WarmstartInformation& warmstart_information) const;
-      static BQPDStatus bqpd_status_from_int(int ifail);
       static SubproblemStatus status_from_bqpd_status(BQPDStatus bqpd_status);
    };
 } // namespace
@@ -0,0 +1,227 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cassert>
+#include <algorithm>
+#include "BQPDWorkspace.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   BQPDStatus bqpd_status_from_int(int ifail) {
+      assert(0 <= ifail && ifail <= 9 && "bqpd_status_from_int: ifail does not belong to [0, 9]");
+      return static_cast<BQPDStatus>(ifail);
+   }
+
+   BQPDWorkspace::BQPDWorkspace(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros,
+         size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros, BQPDProblemType problem_type, int kmax):
+         number_variables(number_variables), number_constraints(number_constraints), number_hessian_nonzeros(number_hessian_nonzeros),
+         size_hessian_sparsity(problem_type == BQPDProblemType::QP ? number_hessian_nonzeros + number_variables + 3 : 0),
+         kmax(kmax),
+         alp(static_cast<size_t>(this->mlp)),
+         lp(static_cast<size_t>(this->mlp)),
+         jacobian(number_jacobian_nonzeros + number_objective_gradient_nonzeros), // Jacobian + objective gradient
+         jacobian_sparsity(number_jacobian_nonzeros + number_objective_gradient_nonzeros + number_constraints + 3),
+         current_hessian_indices(number_variables) {
+      this->allocate();
+   }
+
+   // grow the workspace whose size made BQPD fail. Returns false if BQPD did not run out of space or the workspace cannot grow
+   bool BQPDWorkspace::grow(BQPDStatus bqpd_status) {
+      switch (bqpd_status) {
+         case BQPDStatus::LP_INSUFFICIENT_SPACE:
+            this->mlp *= 2;
+            this->alp.resize(static_cast<size_t>(this->mlp));
+            this->lp.resize(static_cast<size_t>(this->mlp));
+            DEBUG << "BQPD: increasing mlp to " << this->mlp << '\n';
+            return true;
+         case BQPDStatus::HESSIAN_INSUFFICIENT_SPACE:
+            // the reduced Hessian cannot be larger than the number of variables
+            if (static_cast<size_t>(this->kmax) == this->number_variables) {
+               return false;
+            }
+            this->kmax = static_cast<int>(std::min(static_cast<size_t>(std::max(2 * this->kmax, 1)), this->number_variables));
+            DEBUG << "BQPD: increasing kmax to " << this->kmax << '\n';
+            break;
+         case BQPDStatus::SPARSE_INSUFFICIENT_SPACE:
+            this->mxwk0 *= 2;
+            this->mxiwk0 *= 2;
+            DEBUG << "BQPD: increasing the sparse workspace to " << this->mxwk0 << " reals and " << this->mxiwk0 << " integers\n";
+            break;
+         default:
+            return false;
+      }
+      this->allocate();
+      return true;
+   }
+
+   void BQPDWorkspace::allocate() {
+      this->size_hessian_workspace = this->number_hessian_nonzeros + static_cast<size_t>(this->kmax * (this->kmax + 9) / 2) +
+            2 * this->number_variables + this->number_constraints + this->mxwk0;
+      this->size_hessian_sparsity_workspace = this->size_hessian_sparsity + static_cast<size_t>(this->kmax) + this->mxiwk0;
+      // the Hessian and its sparsity pattern at the beginning of the workspace are preserved
+      this->hessian_values.resize(this->size_hessian_workspace);
+      this->hessian_sparsity.resize(this->size_hessian_sparsity_workspace);
+   }
+
+   // save Hessian (in arbitrary format) to a "weak" CSC format: compressed columns but row indices are not sorted, nor unique
+   void BQPDWorkspace::save_hessian(const SymmetricMatrix<size_t, double>& hessian) {
+      // if the sparsity pattern is unchanged, only the values are rewritten
+      if (this->save_hessian_values(hessian)) {
+         return;
+      }
+      const size_t header_size = 1;
+      // pointers withing the single array
+      int* row_indices = &this->hessian_sparsity[header_size];
+      int* column_starts = &this->hessian_sparsity[header_size + hessian.number_nonzeros()];
+      // header
+      this->hessian_sparsity[0] = static_cast<int>(hessian.number_nonzeros() + 1);
+      // count the elements in each column
+      for (size_t column_index: Range(hessian.dimension() + 1)) {
+         column_starts[column_index] = 0;
+      }
+      hessian.for_each_nonzero([&](size_t /*row_index*/, size_t column_index, double /*element*/) {
+         column_starts[column_index + 1]++;
+      });
+      // carry over the column starts
+      for (size_t column_index: Range(1, hessian.dimension() + 1)) {
+         column_starts[column_index] += column_starts[column_index - 1];
+         column_starts[column_index - 1] += this->fortran_shift;
+      }
+      column_starts[hessian.dimension()] += this->fortran_shift;
+      // copy the entries
+      this->current_hessian_indices.fill(0);
+      this->hessian_entry_positions.resize(hessian.number_nonzeros());
+      size_t entry_index = 0;
+      hessian.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+         const size_t index = static_cast<size_t>(column_starts[column_index] + this->current_hessian_indices[column_index] - this->fortran_shift);
+         assert(index <= static_cast<size_t>(column_starts[column_index + 1]) &&
+                "BQPD: error in converting the Hessian matrix to the local format. Try setting the sparse format to CSC");
+         this->hessian_values[index] = element;
+         row_indices[index] = static_cast<int>(row_index) + this->fortran_shift;
+         this->current_hessian_indices[column_index]++;
+         this->hessian_entry_positions[entry_index] = index;
+         entry_index++;
+      });
+      this->hessian_pattern_saved = true;
+      this->saved_hessian_dimension = hessian.dimension();
+      this->number_hessian_pattern_builds++;
+   }
+
+   // rewrite the Hessian values at their positions in the saved pattern. Returns false (and the pattern must be rebuilt) if the
+   // sparsity pattern of the Hessian differs from the saved one
+   bool BQPDWorkspace::save_hessian_values(const SymmetricMatrix<size_t, double>& hessian) {
+      if (not this->hessian_pattern_saved || hessian.dimension() != this->saved_hessian_dimension ||
+            hessian.number_nonzeros() != this->hessian_entry_positions.size()) {
+         return false;
+      }
+      const size_t header_size = 1;
+      const int* row_indices = &this->hessian_sparsity[header_size];
+      const int* column_starts = &this->hessian_sparsity[header_size + hessian.number_nonzeros()];
+      bool pattern_unchanged = true;
+      size_t entry_index = 0;
+      hessian.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+         if (pattern_unchanged) {
+            const size_t index = this->hessian_entry_positions[entry_index];
+            // the entry must lie in the same column and row as in the saved pattern
+            if (row_indices[index] == static_cast<int>(row_index) + this->fortran_shift &&
+                  static_cast<int>(index) + this->fortran_shift >= column_starts[column_index] &&
+                  static_cast<int>(index) + this->fortran_shift < column_starts[column_index + 1]) {
+               this->hessian_values[index] = element;
+            }
+            else {
+               pattern_unchanged = false;
+            }
+         }
+         entry_index++;
+      });
+      return pattern_unchanged;
+   }
+
+   void BQPDWorkspace::save_gradients(size_t number_constraints, const SparseVector<double>& linear_objective,
+         const RectangularMatrix<double>& constraint_jacobian) {
+      // if the sparsity pattern is unchanged, only the values are rewritten
+      if (this->save_gradient_values(number_constraints, linear_objective, constraint_jacobian)) {
+         return;
+      }
+      size_t current_index = 0;
+      for (const auto [variable_index, derivative]: linear_objective) {
+         this->jacobian[current_index] = derivative;
+         this->jacobian_sparsity[current_index + 1] = static_cast<int>(variable_index) + this->fortran_shift;
+         current_index++;
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            this->jacobian[current_index] = derivative;
+            this->jacobian_sparsity[current_index + 1] = static_cast<int>(variable_index) + this->fortran_shift;
+            current_index++;
+         }
+      }
+      current_index++;
+      this->jacobian_sparsity[0] = static_cast<int>(current_index);
+      // header
+      size_t size = 1;
+      this->jacobian_sparsity[current_index] = static_cast<int>(size);
+      current_index++;
+      size += linear_objective.size();
+      this->jacobian_sparsity[current_index] = static_cast<int>(size);
+      current_index++;
+      for (size_t constraint_index: Range(number_constraints)) {
+         size += constraint_jacobian[constraint_index].size();
+         this->jacobian_sparsity[current_index] = static_cast<int>(size);
+         current_index++;
+      }
+      this->gradient_pattern_saved = true;
+      this->number_gradient_pattern_builds++;
+   }
+
+   // rewrite the gradient values. Returns false (and the pattern must be rebuilt) if the sparsity pattern of the objective
+   // gradient and the Jacobian differs from the saved one
+   bool BQPDWorkspace::save_gradient_values(size_t number_constraints, const SparseVector<double>& linear_objective,
+         const RectangularMatrix<double>& constraint_jacobian) {
+      if (not this->gradient_pattern_saved) {
+         return false;
+      }
+      // compare the header (the starts of the gradients)
+      size_t number_nonzeros = linear_objective.size();
+      for (size_t constraint_index: Range(number_constraints)) {
+         number_nonzeros += constraint_jacobian[constraint_index].size();
+      }
+      if (this->jacobian_sparsity[0] != static_cast<int>(number_nonzeros + 1)) {
+         return false;
+      }
+      const int* header = &this->jacobian_sparsity[number_nonzeros + 1];
+      size_t size = 1 + linear_objective.size();
+      if (header[1] != static_cast<int>(size)) {
+         return false;
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         size += constraint_jacobian[constraint_index].size();
+         if (header[constraint_index + 2] != static_cast<int>(size)) {
+            return false;
+         }
+      }
+      // compare the column indices while copying the values
+      size_t current_index = 0;
+      for (const auto [variable_index, derivative]: linear_objective) {
+         if (this->jacobian_sparsity[current_index + 1] != static_cast<int>(variable_index) + this->fortran_shift) {
+            return false;
+         }
+         this->jacobian[current_index] = derivative;
+         current_index++;
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         for (const auto [variable_index, derivative]: constraint_jacobian[constraint_index]) {
+            if (this->jacobian_sparsity[current_index + 1] != static_cast<int>(variable_index) + this->fortran_shift) {
+               return false;
+            }
+            this->jacobian[current_index] = derivative;
+            current_index++;
+         }
+      }
+      return true;
+   }
+} // namespace
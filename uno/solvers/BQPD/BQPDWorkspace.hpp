@@ -0,0 +1,87 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BQPDWORKSPACE_H
+#define UNO_BQPDWORKSPACE_H
+
+#include <vector>
+#include "linear_algebra/Vector.hpp"
+
+namespace uno {
+   // forward declarations
+   template <typename ElementType>
+   class RectangularMatrix;
+   template <typename ElementType>
+   class SparseVector;
+   template <typename IndexType, typename ElementType>
+   class SymmetricMatrix;
+
+   // see bqpd.f
+   enum class BQPDStatus {
+      OPTIMAL = 0,
+      UNBOUNDED_PROBLEM = 1,
+      BOUND_INCONSISTENCY = 2,
+      INFEASIBLE = 3,
+      INCORRECT_PARAMETER = 4,
+      LP_INSUFFICIENT_SPACE = 5,
+      HESSIAN_INSUFFICIENT_SPACE = 6,
+      SPARSE_INSUFFICIENT_SPACE = 7,
+      MAX_RESTARTS_REACHED = 8,
+      UNDEFINED = 9
+   };
+
+   BQPDStatus bqpd_status_from_int(int ifail);
+
+   enum class BQPDProblemType {LP, QP};
+
+   // the arrays passed to BQPD that do not depend on BQPD itself: the sizes of the workspaces (grown when BQPD runs out of
+   // space) and the Hessian, objective gradient and Jacobian in BQPD's format (whose sparsity patterns are reused when unchanged)
+   class BQPDWorkspace {
+   public:
+      BQPDWorkspace(size_t number_variables, size_t number_constraints, size_t number_objective_gradient_nonzeros, size_t number_jacobian_nonzeros,
+            size_t number_hessian_nonzeros, BQPDProblemType problem_type, int kmax);
+
+      const size_t number_variables;
+      const size_t number_constraints;
+      const size_t number_hessian_nonzeros;
+      const size_t size_hessian_sparsity;
+      int kmax;
+      int mlp{1000};
+      size_t mxwk0{2000000}, mxiwk0{500000};
+      std::vector<double> alp{};
+      std::vector<int> lp{};
+      // the Hessian workspace contains the Hessian and its sparsity pattern, followed by the space for the reduced Hessian and
+      // for the sparse factors
+      size_t size_hessian_workspace{};
+      size_t size_hessian_sparsity_workspace{};
+      std::vector<double> hessian_values{};
+      std::vector<int> hessian_sparsity{};
+      // objective gradient followed by the constraint gradients
+      std::vector<double> jacobian{};
+      std::vector<int> jacobian_sparsity{};
+      // number of times a sparsity pattern was built from scratch
+      size_t number_hessian_pattern_builds{0};
+      size_t number_gradient_pattern_builds{0};
+
+      [[nodiscard]] bool grow(BQPDStatus bqpd_status);
+      void save_hessian(const SymmetricMatrix<size_t, double>& hessian);
+      void save_gradients(size_t number_constraints, const SparseVector<double>& linear_objective,
+            const RectangularMatrix<double>& constraint_jacobian);
+
+   protected:
+      static constexpr int fortran_shift{1};
+      Vector<int> current_hessian_indices{};
+      // position in the local format of each nonzero of the Hessian (in the order of its traversal)
+      bool hessian_pattern_saved{false};
+      size_t saved_hessian_dimension{0};
+      std::vector<size_t> hessian_entry_positions{};
+      bool gradient_pattern_saved{false};
+
+      void allocate();
+      [[nodiscard]] bool save_hessian_values(const SymmetricMatrix<size_t, double>& hessian);
+      [[nodiscard]] bool save_gradient_values(size_t number_constraints, const SparseVector<double>& linear_objective,
+            const RectangularMatrix<double>& constraint_jacobian);
+   };
+} // namespace
+
+#endif // UNO_BQPDWORKSPACE_H
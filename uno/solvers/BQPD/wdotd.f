@@ -77,6 +77,9 @@ c     ... allow for scaling of variables
 c     ... form v = W.d from sparse, upper triangular Hessian
       call Wdotd (n, x, ws(phe+1), lws, result)
 
+c     ... add the low-rank correction of quasi-Newton Hessians in compact form
+      call hesscorr (n, x, result)
+
 c     ... allow for scaling of variables 
       if ((scale_mode.eq.1).or.(scale_mode.eq.3)) then
          do i=1,n
@@ -4,7 +4,14 @@
 #ifndef UNO_DIRECTSYMMETRICINDEFINITELINEARSOLVER_H
 #define UNO_DIRECTSYMMETRICINDEFINITELINEARSOLVER_H
 
+#include <cassert>
+#include <memory>
+#include <optional>
+#include <vector>
 #include "solvers/SymmetricIndefiniteLinearSolver.hpp"
+#include "linear_algebra/SparsityPatternFingerprint.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "ordering/FillReducingOrdering.hpp"
 
 namespace uno {
    template <typename IndexType, typename ElementType>
@@ -17,12 +24,84 @@ namespace uno {
       virtual void do_symbolic_factorization(const SymmetricMatrix<IndexType, ElementType>& matrix) = 0;
       virtual void do_numerical_factorization(const SymmetricMatrix<IndexType, ElementType>& matrix) = 0;
 
+      // solve with number_rhs right-hand sides against the current factorization. rhs and result are dense column-major
+      // blocks whose columns have size matrix.dimension(). By default, the columns are solved one at a time
+      virtual void solve_indefinite_systems(const SymmetricMatrix<IndexType, ElementType>& matrix, const Vector<ElementType>& rhs,
+            Vector<ElementType>& result, size_t number_rhs);
+
       [[nodiscard]] virtual std::tuple<size_t, size_t, size_t> get_inertia() const = 0;
       [[nodiscard]] virtual size_t number_negative_eigenvalues() const = 0;
       // [[nodiscard]] virtual bool matrix_is_positive_definite() const = 0;
       [[nodiscard]] virtual bool matrix_is_singular() const = 0;
       [[nodiscard]] virtual size_t rank() const = 0;
+      // false if the backend cannot report the inertia of the factorized matrix. The inertia correction then relies on
+      // an inertia-free curvature test
+      [[nodiscard]] virtual bool provides_inertia() const { return true; }
+
+      // fill-reducing ordering used by the symbolic factorization. If none is set, the backend computes its own
+      void set_ordering(std::unique_ptr<FillReducingOrdering> new_ordering) { this->ordering = std::move(new_ordering); }
+
+   protected:
+      std::unique_ptr<FillReducingOrdering> ordering{};
+
+      // fingerprint and (row, column) indices in storage order of the matrix whose symbolic factorization is currently stored
+      // by the solver
+      std::optional<SparsityPatternFingerprint> analyzed_pattern{};
+      std::vector<IndexType> analyzed_indices{};
+
+      // returns true if the sparsity pattern of the matrix differs from the analyzed one (and records the new pattern).
+      // Backends call it at the start of do_symbolic_factorization to skip the analysis when the pattern is unchanged.
+      // The fingerprint rejects most changes; if it matches, the indices are compared to rule out a hash collision
+      bool sparsity_pattern_changed(const SymmetricMatrix<IndexType, ElementType>& matrix) {
+         const SparsityPatternFingerprint fingerprint = SparsityPatternFingerprint::compute(matrix);
+         if (this->analyzed_pattern.has_value() && *this->analyzed_pattern == fingerprint && this->has_analyzed_indices(matrix)) {
+            return false;
+         }
+         this->analyzed_pattern = fingerprint;
+         this->analyzed_indices.clear();
+         this->analyzed_indices.reserve(2 * matrix.number_nonzeros());
+         matrix.for_each_nonzero([&](IndexType row_index, IndexType column_index, ElementType /*element*/) {
+            this->analyzed_indices.emplace_back(row_index);
+            this->analyzed_indices.emplace_back(column_index);
+         });
+         return true;
+      }
+
+      [[nodiscard]] bool has_analyzed_indices(const SymmetricMatrix<IndexType, ElementType>& matrix) const {
+         if (this->analyzed_indices.size() != 2 * matrix.number_nonzeros()) {
+            return false;
+         }
+         bool same_indices = true;
+         size_t position = 0;
+         matrix.for_each_nonzero([&](IndexType row_index, IndexType column_index, ElementType /*element*/) {
+            if (same_indices && (position + 1 >= this->analyzed_indices.size() || this->analyzed_indices[position] != row_index ||
+                  this->analyzed_indices[position + 1] != column_index)) {
+               same_indices = false;
+            }
+            position += 2;
+         });
+         return same_indices && position == this->analyzed_indices.size();
+      }
    };
+
+   template <typename IndexType, typename ElementType>
+   void DirectSymmetricIndefiniteLinearSolver<IndexType, ElementType>::solve_indefinite_systems(const SymmetricMatrix<IndexType, ElementType>& matrix,
+         const Vector<ElementType>& rhs, Vector<ElementType>& result, size_t number_rhs) {
+      const size_t n = matrix.dimension();
+      assert(n * number_rhs <= rhs.size() && n * number_rhs <= result.size() && "The right-hand side blocks are too small");
+      Vector<ElementType> column_rhs(n);
+      Vector<ElementType> column_result(n);
+      for (size_t rhs_index = 0; rhs_index < number_rhs; rhs_index++) {
+         const size_t offset = rhs_index * n;
+         for (size_t index = 0; index < n; index++) {
+            column_rhs[index] = rhs[offset + index];
+         }
+         this->solve_indefinite_system(matrix, column_rhs, column_result);
+         for (size_t index = 0; index < n; index++) {
+            result[offset + index] = column_result[index];
+         }
+      }
+   }
 } // namespace
 
 #endif // UNO_DIRECTSYMMETRICINDEFINITELINEARSOLVER_H
\ No newline at end of file
@@ -1,15 +1,23 @@
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
+#include <string>
 #include "HiGHSSolver.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "optimization/Direction.hpp"
+#include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
+#include "symbolic/Range.hpp"
 #include "symbolic/VectorView.hpp"
 
 namespace uno {
-   HiGHSSolver::HiGHSSolver(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros, size_t /*number_hessian_nonzeros*/,
-         const Options& options): LPSolver(), print_subproblem(options.get_bool("print_subproblem")) {
+   HiGHSSolver::HiGHSSolver(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros,
+         const Options& options): QPSolver(), print_subproblem(options.get_bool("print_subproblem")),
+         maximum_dense_hessian_dimension(options.get_unsigned_int("HiGHS_maximum_dense_hessian_dimension")) {
       this->model.lp_.sense_ = ObjSense::kMinimize;
       this->model.lp_.offset_ = 0.;
       // the linear part of the objective is a dense vector
@@ -25,6 +33,10 @@ namespace uno {
       this->model.lp_.a_matrix_.value_.reserve(number_jacobian_nonzeros);
       this->model.lp_.a_matrix_.index_.reserve(number_jacobian_nonzeros);
       this->model.lp_.a_matrix_.start_.reserve(number_variables + 1);
+      // lower triangle of the Hessian in CSC format (empty for LPs)
+      this->model.hessian_.dim_ = 0;
+      this->model.hessian_.format_ = HessianFormat::kTriangular;
+      this->hessian_entries.reserve(number_hessian_nonzeros + number_variables);
 
       this->highs_solver.setOptionValue("output_flag", "false");
    }
@@ -88,22 +100,212 @@ namespace uno {
       }
    }
 
+   // the diagonal entries are explicit (and come first in their column); duplicate entries are summed
+   void HiGHSSolver::build_hessian(size_t number_variables, const SymmetricMatrix<size_t, double>& hessian) {
+      this->hessian_entries.clear();
+      for (size_t variable_index: Range(number_variables)) {
+         this->hessian_entries.emplace_back(variable_index, variable_index, 0.);
+      }
+      hessian.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+         this->hessian_entries.emplace_back(std::min(row_index, column_index), std::max(row_index, column_index), element);
+      });
+      // the low-rank correction of a compact quasi-Newton Hessian is dense: its lower triangle is added explicitly, column by column
+      // (O(rank dimension^2) time and O(dimension^2) memory)
+      if (this->hessian_correction != nullptr && 0 < this->hessian_correction->get_rank()) {
+         const size_t dimension = this->hessian_correction->get_dimension();
+         if (this->maximum_dense_hessian_dimension < dimension) {
+            throw std::invalid_argument("HiGHS forms the LBFGS Hessian densely: " + std::to_string(dimension) + " variables exceed "
+               "HiGHS_maximum_dense_hessian_dimension = " + std::to_string(this->maximum_dense_hessian_dimension) +
+               ". Use another QP solver or Hessian model");
+         }
+         std::vector<double> unit_vector(dimension, 0.);
+         std::vector<double> correction_column(dimension);
+         for (size_t column_index: Range(dimension)) {
+            unit_vector[column_index] = 1.;
+            std::fill(correction_column.begin(), correction_column.end(), 0.);
+            this->hessian_correction->add_product(unit_vector, correction_column);
+            unit_vector[column_index] = 0.;
+            for (size_t row_index: Range(column_index, dimension)) {
+               if (correction_column[row_index] != 0.) {
+                  this->hessian_entries.emplace_back(column_index, row_index, correction_column[row_index]);
+               }
+            }
+         }
+      }
+      std::sort(this->hessian_entries.begin(), this->hessian_entries.end(), [](const auto& entry, const auto& other_entry) {
+         return std::tie(std::get<0>(entry), std::get<1>(entry)) < std::tie(std::get<0>(other_entry), std::get<1>(other_entry));
+      });
+
+      // compress the columns
+      HighsHessian& highs_hessian = this->model.hessian_;
+      highs_hessian.dim_ = static_cast<HighsInt>(number_variables);
+      highs_hessian.start_.assign(number_variables + 1, 0);
+      highs_hessian.index_.clear();
+      highs_hessian.value_.clear();
+      for (size_t entry_index: Range(this->hessian_entries.size())) {
+         const auto [column_index, row_index, element] = this->hessian_entries[entry_index];
+         if (0 < entry_index && std::get<0>(this->hessian_entries[entry_index - 1]) == column_index &&
+               std::get<1>(this->hessian_entries[entry_index - 1]) == row_index) {
+            highs_hessian.value_.back() += element;
+         }
+         else {
+            highs_hessian.index_.emplace_back(static_cast<HighsInt>(row_index));
+            highs_hessian.value_.emplace_back(element);
+            highs_hessian.start_[column_index + 1]++;
+         }
+      }
+      for (size_t column_index: Range(number_variables)) {
+         highs_hessian.start_[column_index + 1] += highs_hessian.start_[column_index];
+      }
+      if (this->print_subproblem) {
+         DEBUG << "Hessian (lower triangle):\n";
+         DEBUG << "H = "; print_vector(DEBUG, highs_hessian.value_);
+         DEBUG << "with column start: "; print_vector(DEBUG, highs_hessian.start_);
+         DEBUG << "and row index: "; print_vector(DEBUG, highs_hessian.index_);
+      }
+   }
 
+   void HiGHSSolver::clear_hessian() {
+      this->model.hessian_.dim_ = 0;
+      this->model.hessian_.start_.clear();
+      this->model.hessian_.index_.clear();
+      this->model.hessian_.value_.clear();
+   }
 
-   void HiGHSSolver::solve_subproblem(Direction& direction, size_t number_variables, size_t number_constraints) {
-      // solve the LP
-      HighsStatus return_status = this->highs_solver.passModel(this->model);
+   // load the whole subproblem when its dimensions or structure changed, modify it in place otherwise
+   void HiGHSSolver::prepare_subproblem(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+         const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+         const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+         const RectangularMatrix<double>& constraint_jacobian, const WarmstartInformation& warmstart_information, bool hessian_changed) {
+      const bool same_dimensions = (static_cast<size_t>(this->model.lp_.num_col_) == number_variables &&
+            static_cast<size_t>(this->model.lp_.num_row_) == number_constraints);
+      if (this->is_model_loaded && same_dimensions && not warmstart_information.problem_changed) {
+         const bool is_reloaded = this->update_linear_subproblem(number_variables, number_constraints, variables_lower_bounds,
+               variables_upper_bounds, constraints_lower_bounds, constraints_upper_bounds, linear_objective, constraint_jacobian,
+               warmstart_information);
+         if (hessian_changed && not is_reloaded) {
+            [[maybe_unused]] const HighsStatus return_status = this->highs_solver.passHessian(this->model.hessian_);
+            assert(return_status == HighsStatus::kOk);
+            this->restore_basis(number_variables, number_constraints);
+         }
+      }
+      else {
+         // build the subproblem in the HiGHS format
+         this->build_linear_subproblem(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+               constraints_upper_bounds, linear_objective, constraint_jacobian);
+         this->load_model(number_variables, number_constraints);
+      }
+   }
+
+   // apply only the pieces of the LP that changed since the previous call. The Highs instance keeps its basis across the
+   // modifications, so that the simplex restarts from the previous basis. Returns true if the whole model was reloaded
+   bool HiGHSSolver::update_linear_subproblem(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+         const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+         const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+         const RectangularMatrix<double>& constraint_jacobian, const WarmstartInformation& warmstart_information) {
+      const HighsInt n = static_cast<HighsInt>(number_variables);
+      const HighsInt m = static_cast<HighsInt>(number_constraints);
+      if (warmstart_information.constraints_changed && not this->update_constraint_matrix(number_constraints, constraint_jacobian)) {
+         // the sparsity pattern of the Jacobian changed: reload the whole LP
+         this->build_linear_subproblem(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+               constraints_upper_bounds, linear_objective, constraint_jacobian);
+         this->load_model(number_variables, number_constraints);
+         return true;
+      }
+      if (warmstart_information.objective_changed && 0 < n) {
+         std::fill(this->model.lp_.col_cost_.begin(), this->model.lp_.col_cost_.begin() + n, 0.);
+         for (const auto [variable_index, value]: linear_objective) {
+            this->model.lp_.col_cost_[variable_index] = value;
+         }
+         this->highs_solver.changeColsCost(0, n - 1, this->model.lp_.col_cost_.data());
+      }
+      if (warmstart_information.variable_bounds_changed && 0 < n) {
+         for (size_t variable_index: Range(number_variables)) {
+            this->model.lp_.col_lower_[variable_index] = variables_lower_bounds[variable_index];
+            this->model.lp_.col_upper_[variable_index] = variables_upper_bounds[variable_index];
+         }
+         this->highs_solver.changeColsBounds(0, n - 1, this->model.lp_.col_lower_.data(), this->model.lp_.col_upper_.data());
+      }
+      if (warmstart_information.constraint_bounds_changed && 0 < m) {
+         for (size_t constraint_index: Range(number_constraints)) {
+            this->model.lp_.row_lower_[constraint_index] = constraints_lower_bounds[constraint_index];
+            this->model.lp_.row_upper_[constraint_index] = constraints_upper_bounds[constraint_index];
+         }
+         this->highs_solver.changeRowsBounds(0, m - 1, this->model.lp_.row_lower_.data(), this->model.lp_.row_upper_.data());
+      }
+      return false;
+   }
+
+   // overwrite the coefficients that changed when the sparsity pattern of the Jacobian is unchanged. Returns false otherwise
+   bool HiGHSSolver::update_constraint_matrix(size_t number_constraints, const RectangularMatrix<double>& constraint_jacobian) {
+      HighsSparseMatrix& matrix = this->model.lp_.a_matrix_;
+      // compare the sparsity patterns
+      for (size_t constraint_index: Range(number_constraints)) {
+         size_t position = static_cast<size_t>(matrix.start_[constraint_index]);
+         const size_t row_end = static_cast<size_t>(matrix.start_[constraint_index + 1]);
+         for (const auto [variable_index, value]: constraint_jacobian[constraint_index]) {
+            if (position == row_end || static_cast<size_t>(matrix.index_[position]) != variable_index) {
+               return false;
+            }
+            position++;
+         }
+         if (position != row_end) {
+            return false;
+         }
+      }
+      // change the coefficients
+      size_t position = 0;
+      for (size_t constraint_index: Range(number_constraints)) {
+         for (const auto [variable_index, value]: constraint_jacobian[constraint_index]) {
+            if (matrix.value_[position] != value) {
+               matrix.value_[position] = value;
+               this->highs_solver.changeCoeff(static_cast<HighsInt>(constraint_index), static_cast<HighsInt>(variable_index), value);
+            }
+            position++;
+         }
+      }
+      return true;
+   }
+
+   // pass the whole LP to HiGHS and restart from the previous basis when the dimensions match
+   void HiGHSSolver::load_model(size_t number_variables, size_t number_constraints) {
+      [[maybe_unused]] const HighsStatus return_status = this->highs_solver.passModel(this->model);
       assert(return_status == HighsStatus::kOk);
-      return_status = this->highs_solver.run(); // solve
+      this->is_model_loaded = true;
+      this->restore_basis(number_variables, number_constraints);
+   }
+
+   void HiGHSSolver::restore_basis(size_t number_variables, size_t number_constraints) {
+      if (this->basis.valid && this->basis.col_status.size() == number_variables && this->basis.row_status.size() == number_constraints) {
+         this->highs_solver.setBasis(this->basis);
+      }
+   }
+
+   void HiGHSSolver::solve_subproblem(Direction& direction, size_t number_variables, size_t number_constraints) {
+      // solve the LP/QP
+      const HighsStatus return_status = this->highs_solver.run(); // solve
       DEBUG << "HiGHS status: " << static_cast<int>(return_status) << '\n';
 
       // if HiGHS could not optimize (e.g. because of indefinite Hessian), return an error
       if (return_status == HighsStatus::kError) {
          direction.status = SubproblemStatus::ERROR;
+         // the next subproblem is solved from scratch
+         this->basis.valid = false;
+         this->is_model_loaded = false;
          return;
       }
+      // save the basis for the next subproblem
+      this->basis = this->highs_solver.getBasis();
 
-      // TODO check unbounded problems
+      const HighsModelStatus model_status = this->highs_solver.getModelStatus();
+      if (model_status == HighsModelStatus::kInfeasible) {
+         direction.status = SubproblemStatus::INFEASIBLE;
+         return;
+      }
+      else if (model_status == HighsModelStatus::kUnbounded || model_status == HighsModelStatus::kUnboundedOrInfeasible) {
+         direction.status = SubproblemStatus::UNBOUNDED_PROBLEM;
+         return;
+      }
       direction.status = SubproblemStatus::OPTIMAL;
       const HighsSolution& solution = this->highs_solver.getSolution();
       // read the primal solution and bound dual solution
@@ -129,12 +331,34 @@ namespace uno {
          const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
          const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
          const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& /*initial_point*/, Direction& direction,
-         const WarmstartInformation& /*warmstart_information*/) {
-      // build the LP in the HiGHS format
-      this->build_linear_subproblem(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
-            constraints_upper_bounds, linear_objective, constraint_jacobian);
+         const WarmstartInformation& warmstart_information) {
+      // remove the Hessian of a previous QP
+      const bool hessian_changed = (0 < this->model.hessian_.dim_);
+      if (hessian_changed) {
+         this->clear_hessian();
+      }
+      this->prepare_subproblem(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+            constraints_upper_bounds, linear_objective, constraint_jacobian, warmstart_information, hessian_changed);
 
       // solve the LP
       this->solve_subproblem(direction, number_variables, number_constraints);
    }
+
+   void HiGHSSolver::solve_QP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+         const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+         const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+         const RectangularMatrix<double>& constraint_jacobian, const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& /*initial_point*/,
+         Direction& direction, const WarmstartInformation& warmstart_information) {
+      // the Hessian is reevaluated when the objective or the constraints changed
+      const bool hessian_changed = warmstart_information.objective_changed || warmstart_information.constraints_changed ||
+            static_cast<size_t>(this->model.hessian_.dim_) != number_variables;
+      if (hessian_changed) {
+         this->build_hessian(number_variables, hessian);
+      }
+      this->prepare_subproblem(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+            constraints_upper_bounds, linear_objective, constraint_jacobian, warmstart_information, hessian_changed);
+
+      // solve the QP
+      this->solve_subproblem(direction, number_variables, number_constraints);
+   }
 } // namespace
\ No newline at end of file
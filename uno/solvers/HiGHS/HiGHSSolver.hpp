@@ -1,14 +1,19 @@
 #ifndef UNO_HIGHSSOLVER_H
 #define UNO_HIGHSSOLVER_H
 
-#include "solvers/LPSolver.hpp"
+#include <tuple>
+#include <vector>
+#include "solvers/QPSolver.hpp"
 #include "Highs.h"
 
 namespace uno {
    // forward declaration
    class Options;
 
-   class HiGHSSolver : public LPSolver {
+   // LP solver (dual simplex) and convex QP solver of HiGHS. The Hessian must be positive semidefinite.
+   // HiGHS needs the explicit Hessian: the dense low-rank correction of the LBFGS model is only formed up to
+   // HiGHS_maximum_dense_hessian_dimension variables
+   class HiGHSSolver : public QPSolver {
    public:
       HiGHSSolver(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros,
             const Options& options);
@@ -19,11 +24,36 @@ namespace uno {
             const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& initial_point, Direction& direction,
             const WarmstartInformation& warmstart_information) override;
 
+      void solve_QP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+            const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+            const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+            const RectangularMatrix<double>& constraint_jacobian, const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& initial_point,
+            Direction& direction, const WarmstartInformation& warmstart_information) override;
+
    protected:
       HighsModel model;
+      // the Highs instance keeps the model and the basis of the previous LP between calls
       Highs highs_solver;
+      HighsBasis basis{};
+      bool is_model_loaded{false};
+      // (column, row, value) entries of the lower triangle of the Hessian
+      std::vector<std::tuple<size_t, size_t, double>> hessian_entries{};
       const bool print_subproblem;
+      const size_t maximum_dense_hessian_dimension;
 
+      void prepare_subproblem(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+            const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+            const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+            const RectangularMatrix<double>& constraint_jacobian, const WarmstartInformation& warmstart_information, bool hessian_changed);
+      [[nodiscard]] bool update_linear_subproblem(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+            const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+            const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+            const RectangularMatrix<double>& constraint_jacobian, const WarmstartInformation& warmstart_information);
+      [[nodiscard]] bool update_constraint_matrix(size_t number_constraints, const RectangularMatrix<double>& constraint_jacobian);
+      void load_model(size_t number_variables, size_t number_constraints);
+      void restore_basis(size_t number_variables, size_t number_constraints);
+      void build_hessian(size_t number_variables, const SymmetricMatrix<size_t, double>& hessian);
+      void clear_hessian();
       void build_linear_subproblem(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
             const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
             const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
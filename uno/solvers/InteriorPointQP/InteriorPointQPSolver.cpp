@@ -0,0 +1,641 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cmath>
+#include "InteriorPointQPSolver.hpp"
+#include "ingredients/hessian_models/UnstableRegularization.hpp"
+#include "linear_algebra/SparseKernels.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+#include "solvers/SymmetricIndefiniteLinearSolverFactory.hpp"
+#include "symbolic/Range.hpp"
+#include "tools/Infinity.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   // norm of the primals (resp. of the multipliers) beyond which the QP is declared unbounded (resp. infeasible)
+   constexpr double divergence_threshold = 1e15;
+   // relative norm of the multipliers beyond which a stagnating primal infeasibility indicates an infeasible QP
+   constexpr double infeasibility_multiplier_threshold = 1e10;
+
+   InteriorPointQPSolver::InteriorPointQPSolver(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros,
+         size_t number_hessian_nonzeros, const Options& options):
+         QPSolver(), options(options),
+         tolerance(options.get_double("interior_point_QP_tolerance")),
+         maximum_iterations(options.get_unsigned_int("interior_point_QP_maximum_iterations")),
+         fraction_to_boundary(options.get_double("interior_point_QP_fraction_to_boundary")),
+         warm_start(options.get_bool("interior_point_QP_warm_start")),
+         warm_start_barrier_parameter(options.get_double("interior_point_QP_warm_start_barrier_parameter")),
+         push_variable_to_interior_k1(options.get_double("barrier_push_variable_to_interior_k1")),
+         push_variable_to_interior_k2(options.get_double("barrier_push_variable_to_interior_k2")),
+         regularization_exponent(options.get_double("barrier_regularization_exponent")),
+         print_subproblem(options.get_bool("print_subproblem")),
+         hessian(number_variables + number_constraints, number_hessian_nonzeros + number_variables + number_constraints, false, "COO"),
+         jacobian(number_constraints, number_variables + number_constraints),
+         statistics(options) {
+      this->allocate(number_variables, number_constraints, number_jacobian_nonzeros, number_hessian_nonzeros);
+   }
+
+   InteriorPointQPSolver::~InteriorPointQPSolver() = default;
+
+   void InteriorPointQPSolver::solve_LP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+         const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+         const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+         const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& initial_point, Direction& direction,
+         const WarmstartInformation& warmstart_information) {
+      const QuadraticProgram problem{number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+            constraints_upper_bounds, linear_objective, constraint_jacobian, nullptr, initial_point};
+      this->solve_subproblem(problem, direction, warmstart_information);
+   }
+
+   void InteriorPointQPSolver::solve_QP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+         const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+         const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+         const RectangularMatrix<double>& constraint_jacobian, const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& initial_point,
+         Direction& direction, const WarmstartInformation& warmstart_information) {
+      const QuadraticProgram problem{number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+            constraints_upper_bounds, linear_objective, constraint_jacobian, &hessian, initial_point};
+      this->solve_subproblem(problem, direction, warmstart_information);
+   }
+
+   // (re)allocate the augmented system and the workspace for subproblems of the given size
+   void InteriorPointQPSolver::allocate(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros,
+         size_t number_hessian_nonzeros) {
+      this->maximum_number_variables = number_variables;
+      this->maximum_number_constraints = number_constraints;
+      this->maximum_number_jacobian_nonzeros = number_jacobian_nonzeros;
+      this->maximum_number_hessian_nonzeros = number_hessian_nonzeros;
+      const size_t number_primals = number_variables + number_constraints;
+      const size_t dimension = number_primals + number_constraints;
+      const size_t number_nonzeros = number_hessian_nonzeros + number_primals /* diagonal */ + number_jacobian_nonzeros
+            + number_constraints /* slacks */;
+      this->augmented_system = std::make_unique<SymmetricIndefiniteLinearSystem<double>>(this->options.get_string("sparse_format"), dimension,
+            number_nonzeros, true, /* use regularization */ this->options);
+      this->linear_solver = SymmetricIndefiniteLinearSolverFactory::create(dimension, number_nonzeros + dimension /* regularization */,
+            this->options);
+      // the COO Hessian grows with its number of nonzeros
+      if (this->jacobian.number_rows() < number_constraints || this->jacobian.number_columns() < number_primals) {
+         this->jacobian = RectangularMatrix<double>(number_constraints, number_primals);
+      }
+
+      this->lower_bounds.resize(number_primals);
+      this->upper_bounds.resize(number_primals);
+      this->is_fixed.resize(number_primals);
+      this->previously_active_at_lower_bound.resize(number_primals, false);
+      this->previously_active_at_upper_bound.resize(number_primals, false);
+      for (Vector<double>* vector: {&this->primals, &this->lower_bound_multipliers, &this->upper_bound_multipliers, &this->dual_residuals,
+            &this->primal_step, &this->lower_bound_multiplier_step, &this->upper_bound_multiplier_step, &this->affine_primal_step,
+            &this->affine_lower_bound_multiplier_step, &this->affine_upper_bound_multiplier_step}) {
+         vector->resize(number_primals);
+      }
+      this->constraint_multipliers.resize(number_constraints);
+      this->primal_residuals.resize(number_constraints);
+      this->constraint_multiplier_step.resize(number_constraints);
+   }
+
+   void InteriorPointQPSolver::solve_subproblem(const QuadraticProgram& problem, Direction& direction,
+         const WarmstartInformation& warmstart_information) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_constraints = problem.number_constraints;
+      const size_t number_jacobian_nonzeros = problem.constraint_jacobian.number_nonzeros();
+      const size_t number_hessian_nonzeros = (problem.hessian != nullptr) ? problem.hessian->number_nonzeros() : 0;
+      // the augmented system is reallocated when the subproblem is larger than the preallocated size
+      if (this->maximum_number_variables < number_variables || this->maximum_number_constraints < number_constraints ||
+            this->maximum_number_jacobian_nonzeros < number_jacobian_nonzeros || this->maximum_number_hessian_nonzeros < number_hessian_nonzeros) {
+         this->allocate(std::max(number_variables, this->maximum_number_variables), std::max(number_constraints, this->maximum_number_constraints),
+               std::max(number_jacobian_nonzeros, this->maximum_number_jacobian_nonzeros),
+               std::max(number_hessian_nonzeros, this->maximum_number_hessian_nonzeros));
+         this->previous_solve_succeeded = false;
+      }
+      const bool same_dimensions = (number_variables == this->number_variables && number_constraints == this->number_constraints);
+      this->warm_started = this->warm_start && this->previous_solve_succeeded && same_dimensions && not warmstart_information.problem_changed;
+      this->number_variables = number_variables;
+      this->number_constraints = number_constraints;
+      this->number_iterations = 0;
+
+      if (this->print_subproblem) {
+         DEBUG << "objective gradient: " << problem.linear_objective;
+         for (size_t constraint_index: Range(number_constraints)) {
+            DEBUG << "gradient c" << constraint_index << ": " << problem.constraint_jacobian[constraint_index];
+         }
+         for (size_t variable_index: Range(number_variables)) {
+            DEBUG << "d" << variable_index << " in [" << problem.variables_lower_bounds[variable_index] << ", " <<
+               problem.variables_upper_bounds[variable_index] << "]\n";
+         }
+         for (size_t constraint_index: Range(number_constraints)) {
+            DEBUG << "linearized c" << constraint_index << " in [" << problem.constraints_lower_bounds[constraint_index] << ", " <<
+               problem.constraints_upper_bounds[constraint_index] << "]\n";
+         }
+      }
+
+      // bounds of the variables (d, s)
+      for (size_t variable_index: Range(number_variables)) {
+         this->lower_bounds[variable_index] = problem.variables_lower_bounds[variable_index];
+         this->upper_bounds[variable_index] = problem.variables_upper_bounds[variable_index];
+      }
+      for (size_t constraint_index: Range(number_constraints)) {
+         this->lower_bounds[number_variables + constraint_index] = problem.constraints_lower_bounds[constraint_index];
+         this->upper_bounds[number_variables + constraint_index] = problem.constraints_upper_bounds[constraint_index];
+      }
+      for (size_t index: Range(number_variables + number_constraints)) {
+         this->is_fixed[index] = (this->lower_bounds[index] == this->upper_bounds[index]);
+      }
+
+      if (this->warm_started) {
+         this->initialize_warm_start(problem);
+      }
+      else {
+         this->initialize_cold_start(problem);
+      }
+      this->assemble_augmented_matrix(problem);
+      direction.status = this->run_predictor_corrector_method(problem);
+      DEBUG << "Interior-point QP solver: " << this->number_iterations << " iterations (" << (this->warm_started ? "warm" : "cold") << " start)\n";
+      this->previous_solve_succeeded = (direction.status == SubproblemStatus::OPTIMAL);
+      this->set_direction(problem, direction);
+   }
+
+   // sparsity pattern of the augmented system: the Hessian followed by the diagonal Σ and the Jacobian [J -I], without the
+   // fixed variables and the slacks of the equality constraints. Their steps are then zero
+   void InteriorPointQPSolver::assemble_augmented_matrix(const QuadraticProgram& problem) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_primals = number_variables + problem.number_constraints;
+      this->hessian.set_dimension(number_primals);
+      this->hessian.reset();
+      if (problem.hessian != nullptr) {
+         problem.hessian->for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+            if (not this->is_fixed[row_index] && not this->is_fixed[column_index]) {
+               this->hessian.insert(element, row_index, column_index);
+            }
+         });
+      }
+      this->diagonal_offset = this->hessian.number_nonzeros();
+      for (size_t index: Range(number_primals)) {
+         this->hessian.insert(0., index, index);
+      }
+      this->jacobian.clear();
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         for (const auto [variable_index, derivative]: problem.constraint_jacobian[constraint_index]) {
+            if (not this->is_fixed[variable_index]) {
+               this->jacobian.insert(derivative, constraint_index, variable_index);
+            }
+         }
+         if (not this->is_fixed[number_variables + constraint_index]) {
+            this->jacobian.insert(-1., constraint_index, number_variables + constraint_index);
+         }
+      }
+      this->augmented_system->discard_assembly_pattern();
+
+      // the quasi-Newton correction does not act on the fixed variables
+      this->use_hessian_correction = (problem.hessian != nullptr && this->hessian_correction != nullptr &&
+            0 < this->hessian_correction->get_rank());
+      if (this->use_hessian_correction) {
+         const size_t dimension = this->hessian_correction->get_dimension();
+         std::vector<double> basis = this->hessian_correction->get_basis();
+         for (size_t column_index: Range(this->hessian_correction->get_rank())) {
+            for (size_t variable_index: Range(dimension)) {
+               if (this->is_fixed[variable_index]) {
+                  basis[column_index * dimension + variable_index] = 0.;
+               }
+            }
+         }
+         this->restricted_hessian_correction.set(dimension, this->hessian_correction->get_rank(), std::move(basis),
+               this->hessian_correction->get_middle_matrix());
+      }
+   }
+
+   // the primals start from the initial point (the slacks from the constraint values) pushed inside the bounds
+   void InteriorPointQPSolver::initialize_primals(const QuadraticProgram& problem) {
+      const size_t number_variables = problem.number_variables;
+      for (size_t variable_index: Range(number_variables)) {
+         this->primals[variable_index] = (variable_index < problem.initial_point.size()) ? problem.initial_point[variable_index] : 0.;
+      }
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         this->primals[number_variables + constraint_index] = sparse_row_dot(problem.constraint_jacobian[constraint_index], this->primals.data());
+      }
+      for (size_t index: Range(number_variables + problem.number_constraints)) {
+         this->primals[index] = this->is_fixed[index] ? this->lower_bounds[index] :
+               this->push_variable_to_interior(this->primals[index], this->lower_bounds[index], this->upper_bounds[index]);
+      }
+   }
+
+   void InteriorPointQPSolver::initialize_cold_start(const QuadraticProgram& problem) {
+      this->initialize_primals(problem);
+      for (size_t index: Range(problem.number_variables + problem.number_constraints)) {
+         this->lower_bound_multipliers[index] = (not this->is_fixed[index] && is_finite(this->lower_bounds[index])) ? 1. : 0.;
+         this->upper_bound_multipliers[index] = (not this->is_fixed[index] && is_finite(this->upper_bounds[index])) ? 1. : 0.;
+      }
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         this->constraint_multipliers[constraint_index] = 0.;
+      }
+   }
+
+   // the primals start from the solution of the previous subproblem pushed inside the new bounds. The bounds of its approximate
+   // active set are predicted active: the variable is placed close to the bound and keeps its multiplier, the other multipliers
+   // are small. All complementarity products are close to the warm-start barrier parameter, and the constraint multipliers of the
+   // previous subproblem are kept
+   void InteriorPointQPSolver::initialize_warm_start(const QuadraticProgram& problem) {
+      for (size_t index: Range(problem.number_variables + problem.number_constraints)) {
+         this->primals[index] = this->is_fixed[index] ? this->lower_bounds[index] :
+               this->push_variable_to_interior(this->primals[index], this->lower_bounds[index], this->upper_bounds[index]);
+      }
+      const double barrier_parameter = this->warm_start_barrier_parameter;
+      for (size_t index: Range(problem.number_variables + problem.number_constraints)) {
+         const double lower_bound = this->lower_bounds[index];
+         const double upper_bound = this->upper_bounds[index];
+         const bool predicted_at_lower_bound = is_finite(lower_bound) && this->previously_active_at_lower_bound[index];
+         const bool predicted_at_upper_bound = is_finite(upper_bound) && this->previously_active_at_upper_bound[index];
+         if (this->is_fixed[index]) {
+            this->lower_bound_multipliers[index] = 0.;
+            this->upper_bound_multipliers[index] = 0.;
+            continue;
+         }
+         // maximum distance to a bound predicted active
+         const double maximum_distance = (is_finite(lower_bound) && is_finite(upper_bound)) ? 0.5 * (upper_bound - lower_bound) : INF<double>;
+         if (predicted_at_lower_bound) {
+            this->lower_bound_multipliers[index] = std::max(this->lower_bound_multipliers[index], std::sqrt(barrier_parameter));
+            this->primals[index] = lower_bound + std::min(barrier_parameter / this->lower_bound_multipliers[index], maximum_distance);
+         }
+         else if (predicted_at_upper_bound) {
+            this->upper_bound_multipliers[index] = std::max(this->upper_bound_multipliers[index], std::sqrt(barrier_parameter));
+            this->primals[index] = upper_bound - std::min(barrier_parameter / this->upper_bound_multipliers[index], maximum_distance);
+         }
+         if (not predicted_at_lower_bound) {
+            this->lower_bound_multipliers[index] = is_finite(lower_bound) ? barrier_parameter / (this->primals[index] - lower_bound) : 0.;
+         }
+         if (not predicted_at_upper_bound) {
+            this->upper_bound_multipliers[index] = is_finite(upper_bound) ? barrier_parameter / (upper_bound - this->primals[index]) : 0.;
+         }
+      }
+   }
+
+   // same rule as the barrier subproblem
+   double InteriorPointQPSolver::push_variable_to_interior(double variable_value, double lower_bound, double upper_bound) const {
+      const double range = upper_bound - lower_bound;
+      const double perturbation_lb = std::min(this->push_variable_to_interior_k1 * std::max(1., std::abs(lower_bound)),
+            this->push_variable_to_interior_k2 * range);
+      const double perturbation_ub = std::min(this->push_variable_to_interior_k1 * std::max(1., std::abs(upper_bound)),
+            this->push_variable_to_interior_k2 * range);
+      variable_value = std::max(variable_value, lower_bound + perturbation_lb);
+      variable_value = std::min(variable_value, upper_bound - perturbation_ub);
+      return variable_value;
+   }
+
+   // dual residuals H d + g - J^T y - z_L + z_U (for d) and y - z_L + z_U (for s), primal residuals J d - s
+   void InteriorPointQPSolver::compute_residuals(const QuadraticProgram& problem) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_primals = number_variables + problem.number_constraints;
+      for (size_t index: Range(number_primals)) {
+         this->dual_residuals[index] = 0.;
+      }
+      if (problem.hessian != nullptr) {
+         problem.hessian->for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+            this->dual_residuals[row_index] += element * this->primals[column_index];
+            if (row_index != column_index) {
+               this->dual_residuals[column_index] += element * this->primals[row_index];
+            }
+         });
+         if (this->use_hessian_correction) {
+            this->hessian_correction->add_product(this->primals, this->dual_residuals);
+         }
+      }
+      for (const auto [variable_index, derivative]: problem.linear_objective) {
+         this->dual_residuals[variable_index] += derivative;
+      }
+      transposed_matrix_vector_product(problem.constraint_jacobian, this->constraint_multipliers, -1., this->dual_residuals);
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         const double constraint_value = sparse_row_dot(problem.constraint_jacobian[constraint_index], this->primals.data());
+         this->primal_residuals[constraint_index] = constraint_value - this->primals[number_variables + constraint_index];
+         this->dual_residuals[number_variables + constraint_index] += this->constraint_multipliers[constraint_index];
+      }
+      for (size_t index: Range(number_primals)) {
+         this->dual_residuals[index] += -this->lower_bound_multipliers[index] + this->upper_bound_multipliers[index];
+      }
+   }
+
+   double InteriorPointQPSolver::average_complementarity() const {
+      double complementarity = 0.;
+      size_t number_pairs = 0;
+      for (size_t index: Range(this->number_variables + this->number_constraints)) {
+         if (not this->is_fixed[index]) {
+            if (is_finite(this->lower_bounds[index])) {
+               complementarity += (this->primals[index] - this->lower_bounds[index]) * this->lower_bound_multipliers[index];
+               number_pairs++;
+            }
+            if (is_finite(this->upper_bounds[index])) {
+               complementarity += (this->upper_bounds[index] - this->primals[index]) * this->upper_bound_multipliers[index];
+               number_pairs++;
+            }
+         }
+      }
+      return (0 < number_pairs) ? complementarity / static_cast<double>(number_pairs) : 0.;
+   }
+
+   SubproblemStatus InteriorPointQPSolver::run_predictor_corrector_method(const QuadraticProgram& problem) {
+      const size_t number_variables = problem.number_variables;
+      const size_t number_primals = number_variables + problem.number_constraints;
+      // with the same primal and dual step lengths, the dual residuals of a QP decrease linearly
+      const bool separate_step_lengths = (problem.hessian == nullptr);
+      double objective_scale = 1.;
+      for (const auto [variable_index, derivative]: problem.linear_objective) {
+         objective_scale = std::max(objective_scale, std::abs(derivative));
+      }
+
+      double previous_primal_infeasibility = INF<double>;
+      while (true) {
+         this->compute_residuals(problem);
+         double primal_infeasibility = 0.;
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            primal_infeasibility = std::max(primal_infeasibility, std::abs(this->primal_residuals[constraint_index]));
+         }
+         double dual_infeasibility = 0.;
+         double primal_norm = 0.;
+         double multiplier_norm = 0.;
+         for (size_t index: Range(number_primals)) {
+            if (not this->is_fixed[index]) {
+               dual_infeasibility = std::max(dual_infeasibility, std::abs(this->dual_residuals[index]));
+            }
+            primal_norm = std::max(primal_norm, std::abs(this->primals[index]));
+            multiplier_norm = std::max({multiplier_norm, this->lower_bound_multipliers[index], this->upper_bound_multipliers[index]});
+         }
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            multiplier_norm = std::max(multiplier_norm, std::abs(this->constraint_multipliers[constraint_index]));
+         }
+         const double barrier_parameter = this->average_complementarity();
+         DEBUG2 << "IPM iteration " << this->number_iterations << ": primal inf. " << primal_infeasibility << ", dual inf. " << dual_infeasibility <<
+            ", complementarity " << barrier_parameter << '\n';
+
+         if (primal_infeasibility <= this->tolerance * (1. + primal_norm) && dual_infeasibility <= this->tolerance * objective_scale &&
+               barrier_parameter <= this->tolerance) {
+            return SubproblemStatus::OPTIMAL;
+         }
+         if (not std::isfinite(primal_infeasibility + dual_infeasibility + barrier_parameter)) {
+            WARNING << "The interior-point QP solver produced a non-finite iterate\n";
+            return SubproblemStatus::ERROR;
+         }
+         if (divergence_threshold < primal_norm) {
+            return SubproblemStatus::UNBOUNDED_PROBLEM;
+         }
+         // the iterates converge to a minimizer of the infeasibility while the multipliers diverge
+         if (divergence_threshold < multiplier_norm || (infeasibility_multiplier_threshold * objective_scale < multiplier_norm &&
+               0.9 * previous_primal_infeasibility <= primal_infeasibility)) {
+            return SubproblemStatus::INFEASIBLE;
+         }
+         previous_primal_infeasibility = primal_infeasibility;
+         if (this->maximum_iterations <= this->number_iterations) {
+            WARNING << "The interior-point QP solver reached the maximum number of iterations\n";
+            return SubproblemStatus::ERROR;
+         }
+         this->number_iterations++;
+
+         // predictor (affine scaling) step
+         this->update_diagonal(problem);
+         this->assemble_rhs(problem, 0., false);
+         try {
+            const double dual_regularization_parameter = std::pow(std::max(barrier_parameter, this->tolerance), this->regularization_exponent);
+            this->augmented_system->regularize_matrix(this->statistics, *this->linear_solver, number_primals, problem.number_constraints,
+                  dual_regularization_parameter);
+         }
+         catch (const UnstableRegularization&) {
+            WARNING << "The augmented system of the interior-point QP solver could not be regularized\n";
+            return SubproblemStatus::ERROR;
+         }
+         this->compute_step(problem, 0., false);
+         double primal_step_length = this->primal_step_length(problem, 1.);
+         double dual_step_length = this->dual_step_length(problem, 1.);
+         if (not separate_step_lengths) {
+            primal_step_length = dual_step_length = std::min(primal_step_length, dual_step_length);
+         }
+         for (size_t index: Range(number_primals)) {
+            this->affine_primal_step[index] = this->primal_step[index];
+            this->affine_lower_bound_multiplier_step[index] = this->lower_bound_multiplier_step[index];
+            this->affine_upper_bound_multiplier_step[index] = this->upper_bound_multiplier_step[index];
+         }
+
+         // centering parameter σ = (μ_aff / μ)^3
+         double centering_target = 0.;
+         if (0. < barrier_parameter) {
+            double affine_complementarity = 0.;
+            size_t number_pairs = 0;
+            for (size_t index: Range(number_primals)) {
+               if (not this->is_fixed[index]) {
+                  const double primal = this->primals[index] + primal_step_length * this->primal_step[index];
+                  if (is_finite(this->lower_bounds[index])) {
+                     affine_complementarity += (primal - this->lower_bounds[index]) *
+                           (this->lower_bound_multipliers[index] + dual_step_length * this->lower_bound_multiplier_step[index]);
+                     number_pairs++;
+                  }
+                  if (is_finite(this->upper_bounds[index])) {
+                     affine_complementarity += (this->upper_bounds[index] - primal) *
+                           (this->upper_bound_multipliers[index] + dual_step_length * this->upper_bound_multiplier_step[index]);
+                     number_pairs++;
+                  }
+               }
+            }
+            const double centering_parameter = std::pow(affine_complementarity / static_cast<double>(number_pairs) / barrier_parameter, 3);
+            centering_target = std::min(centering_parameter, 1.) * barrier_parameter;
+         }
+
+         // corrector step (same factorization)
+         this->assemble_rhs(problem, centering_target, true);
+         this->compute_step(problem, centering_target, true);
+         const double tau = std::max(this->fraction_to_boundary, 1. - barrier_parameter);
+         primal_step_length = this->primal_step_length(problem, tau);
+         dual_step_length = this->dual_step_length(problem, tau);
+         if (not separate_step_lengths) {
+            primal_step_length = dual_step_length = std::min(primal_step_length, dual_step_length);
+         }
+         for (size_t index: Range(number_primals)) {
+            this->primals[index] += primal_step_length * this->primal_step[index];
+            this->lower_bound_multipliers[index] += dual_step_length * this->lower_bound_multiplier_step[index];
+            this->upper_bound_multipliers[index] += dual_step_length * this->upper_bound_multiplier_step[index];
+         }
+         for (size_t constraint_index: Range(problem.number_constraints)) {
+            this->constraint_multipliers[constraint_index] += dual_step_length * this->constraint_multiplier_step[constraint_index];
+         }
+      }
+   }
+
+   // Σ = Z_L (V - L)^{-1} + Z_U (U - V)^{-1}. The rows of the fixed variables and of the slacks of the equality constraints are
+   // decoupled: their diagonal is 1 and their rhs is 0
+   void InteriorPointQPSolver::update_diagonal(const QuadraticProgram& problem) {
+      double* values = this->hessian.data_pointer();
+      for (size_t index: Range(problem.number_variables + problem.number_constraints)) {
+         double diagonal_term = 1.;
+         if (not this->is_fixed[index]) {
+            diagonal_term = 0.;
+            if (is_finite(this->lower_bounds[index])) {
+               diagonal_term += this->lower_bound_multipliers[index] / (this->primals[index] - this->lower_bounds[index]);
+            }
+            if (is_finite(this->upper_bounds[index])) {
+               diagonal_term += this->upper_bound_multipliers[index] / (this->upper_bounds[index] - this->primals[index]);
+            }
+         }
+         values[this->diagonal_offset + index] = diagonal_term;
+      }
+      this->augmented_system->assemble_matrix(this->hessian, this->jacobian, problem.number_variables + problem.number_constraints,
+            problem.number_constraints);
+   }
+
+   // rhs of the linearized complementarity (V - L) Δz_L + Z_L Δv = r_L for the lower bounds: r_L = σμ - (V - L) z_L for the
+   // predictor, and the second-order term -Δv_aff Δz_L,aff is added for the corrector
+   double InteriorPointQPSolver::lower_complementarity_rhs(size_t index, double centering_target, bool corrector) const {
+      double rhs = centering_target - (this->primals[index] - this->lower_bounds[index]) * this->lower_bound_multipliers[index];
+      if (corrector) {
+         rhs -= this->affine_primal_step[index] * this->affine_lower_bound_multiplier_step[index];
+      }
+      return rhs;
+   }
+
+   // same for (U - V) Δz_U - Z_U Δv = r_U
+   double InteriorPointQPSolver::upper_complementarity_rhs(size_t index, double centering_target, bool corrector) const {
+      double rhs = centering_target - (this->upper_bounds[index] - this->primals[index]) * this->upper_bound_multipliers[index];
+      if (corrector) {
+         rhs += this->affine_primal_step[index] * this->affine_upper_bound_multiplier_step[index];
+      }
+      return rhs;
+   }
+
+   // the bound multipliers are eliminated: [H + Σ A^T; A 0] [Δv; -Δy] = [-r_d + r_L/(V - L) - r_U/(U - V); -r_p]
+   void InteriorPointQPSolver::assemble_rhs(const QuadraticProgram& problem, double centering_target, bool corrector) {
+      const size_t number_primals = problem.number_variables + problem.number_constraints;
+      Vector<double>& rhs = this->augmented_system->rhs;
+      for (size_t index: Range(number_primals)) {
+         double rhs_term = 0.;
+         if (not this->is_fixed[index]) {
+            rhs_term = -this->dual_residuals[index];
+            if (is_finite(this->lower_bounds[index])) {
+               rhs_term += this->lower_complementarity_rhs(index, centering_target, corrector) / (this->primals[index] - this->lower_bounds[index]);
+            }
+            if (is_finite(this->upper_bounds[index])) {
+               rhs_term -= this->upper_complementarity_rhs(index, centering_target, corrector) / (this->upper_bounds[index] - this->primals[index]);
+            }
+         }
+         rhs[index] = rhs_term;
+      }
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         rhs[number_primals + constraint_index] = -this->primal_residuals[constraint_index];
+      }
+   }
+
+   // solve the augmented system and recover the steps of the bound multipliers
+   void InteriorPointQPSolver::compute_step(const QuadraticProgram& problem, double centering_target, bool corrector) {
+      const size_t number_primals = problem.number_variables + problem.number_constraints;
+      // quasi-Newton Hessian in compact form: the low-rank correction is handled by the Sherman-Morrison-Woodbury formula
+      if (this->use_hessian_correction) {
+         this->augmented_system->solve(*this->linear_solver, this->restricted_hessian_correction);
+      }
+      else {
+         this->augmented_system->solve(*this->linear_solver);
+      }
+      const Vector<double>& solution = this->augmented_system->solution;
+      for (size_t index: Range(number_primals)) {
+         double primal_step = 0.;
+         double lower_bound_multiplier_step = 0.;
+         double upper_bound_multiplier_step = 0.;
+         if (not this->is_fixed[index]) {
+            primal_step = solution[index];
+            if (is_finite(this->lower_bounds[index])) {
+               lower_bound_multiplier_step = (this->lower_complementarity_rhs(index, centering_target, corrector) -
+                     this->lower_bound_multipliers[index] * primal_step) / (this->primals[index] - this->lower_bounds[index]);
+            }
+            if (is_finite(this->upper_bounds[index])) {
+               upper_bound_multiplier_step = (this->upper_complementarity_rhs(index, centering_target, corrector) +
+                     this->upper_bound_multipliers[index] * primal_step) / (this->upper_bounds[index] - this->primals[index]);
+            }
+         }
+         this->primal_step[index] = primal_step;
+         this->lower_bound_multiplier_step[index] = lower_bound_multiplier_step;
+         this->upper_bound_multiplier_step[index] = upper_bound_multiplier_step;
+      }
+      // the system is solved for the negated multipliers
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         this->constraint_multiplier_step[constraint_index] = -solution[number_primals + constraint_index];
+      }
+   }
+
+   // largest step length in (0, 1] that keeps the primals at a fraction tau of the distance to their bounds
+   double InteriorPointQPSolver::primal_step_length(const QuadraticProgram& problem, double tau) const {
+      double step_length = 1.;
+      for (size_t index: Range(problem.number_variables + problem.number_constraints)) {
+         const double step = this->primal_step[index];
+         if (step < 0. && is_finite(this->lower_bounds[index])) {
+            step_length = std::min(step_length, -tau * (this->primals[index] - this->lower_bounds[index]) / step);
+         }
+         else if (0. < step && is_finite(this->upper_bounds[index])) {
+            step_length = std::min(step_length, tau * (this->upper_bounds[index] - this->primals[index]) / step);
+         }
+      }
+      return step_length;
+   }
+
+   // largest step length in (0, 1] that keeps the bound multipliers at a fraction tau of their distance to 0
+   double InteriorPointQPSolver::dual_step_length(const QuadraticProgram& problem, double tau) const {
+      double step_length = 1.;
+      for (size_t index: Range(problem.number_variables + problem.number_constraints)) {
+         if (this->lower_bound_multiplier_step[index] < 0.) {
+            step_length = std::min(step_length, -tau * this->lower_bound_multipliers[index] / this->lower_bound_multiplier_step[index]);
+         }
+         if (this->upper_bound_multiplier_step[index] < 0.) {
+            step_length = std::min(step_length, -tau * this->upper_bound_multipliers[index] / this->upper_bound_multiplier_step[index]);
+         }
+      }
+      return step_length;
+   }
+
+   // no crossover: a bound is considered active when its multiplier exceeds the distance to the bound. The approximate active set
+   // is returned to the SQP layer and predicts the active bounds of the next subproblem
+   void InteriorPointQPSolver::set_direction(const QuadraticProgram& problem, Direction& direction) {
+      const size_t number_variables = problem.number_variables;
+      direction.multipliers.reset();
+      for (size_t index: Range(number_variables + problem.number_constraints)) {
+         this->previously_active_at_lower_bound[index] = not this->is_fixed[index] && is_finite(this->lower_bounds[index]) &&
+               (this->primals[index] - this->lower_bounds[index]) < this->lower_bound_multipliers[index];
+         this->previously_active_at_upper_bound[index] = not this->is_fixed[index] && is_finite(this->upper_bounds[index]) &&
+               (this->upper_bounds[index] - this->primals[index]) < this->upper_bound_multipliers[index];
+      }
+      for (size_t variable_index: Range(number_variables)) {
+         direction.primals[variable_index] = this->primals[variable_index];
+         if (this->is_fixed[variable_index]) {
+            // the multiplier of a fixed variable is the dual residual (computed without bound multipliers)
+            const double multiplier = this->dual_residuals[variable_index];
+            if (0. <= multiplier) {
+               direction.multipliers.lower_bounds[variable_index] = multiplier;
+               direction.active_bounds.at_lower_bound.emplace_back(variable_index);
+            }
+            else {
+               direction.multipliers.upper_bounds[variable_index] = multiplier;
+               direction.active_bounds.at_upper_bound.emplace_back(variable_index);
+            }
+         }
+         else {
+            direction.multipliers.lower_bounds[variable_index] = this->lower_bound_multipliers[variable_index];
+            direction.multipliers.upper_bounds[variable_index] = -this->upper_bound_multipliers[variable_index];
+            if (this->previously_active_at_lower_bound[variable_index]) {
+               direction.active_bounds.at_lower_bound.emplace_back(variable_index);
+            }
+            else if (this->previously_active_at_upper_bound[variable_index]) {
+               direction.active_bounds.at_upper_bound.emplace_back(variable_index);
+            }
+         }
+      }
+      for (size_t constraint_index: Range(problem.number_constraints)) {
+         direction.multipliers.constraints[constraint_index] = this->constraint_multipliers[constraint_index];
+      }
+      // objective 1/2 d^T H d + g^T d
+      double objective = 0.;
+      for (const auto [variable_index, derivative]: problem.linear_objective) {
+         objective += derivative * this->primals[variable_index];
+      }
+      if (problem.hessian != nullptr) {
+         objective += 0.5 * problem.hessian->quadratic_product(this->primals, this->primals);
+         if (this->use_hessian_correction) {
+            objective += 0.5 * this->hessian_correction->quadratic_product(this->primals);
+         }
+      }
+      direction.subproblem_objective = objective;
+   }
+} // namespace
@@ -0,0 +1,150 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_INTERIORPOINTQPSOLVER_H
+#define UNO_INTERIORPOINTQPSOLVER_H
+
+#include <memory>
+#include <vector>
+#include "ingredients/subproblems/SubproblemStatus.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "solvers/QPSolver.hpp"
+#include "tools/Statistics.hpp"
+
+namespace uno {
+   // forward declarations
+   template <typename IndexType, typename ElementType>
+   class DirectSymmetricIndefiniteLinearSolver;
+   template <typename ElementType>
+   class SymmetricIndefiniteLinearSystem;
+
+   /*! \class InteriorPointQPSolver
+    * \brief In-tree primal-dual interior-point QP/LP solver
+    *
+    * The general constraints are turned into equality constraints with slacks: the variables of the method are v = (d, s)
+    * subject to J d - s = 0 and to the bounds l <= v <= u. Each iteration is a Mehrotra predictor-corrector step: the
+    * augmented system [H + Σ A^T; A 0] is factorized once (and regularized if its inertia is wrong) and solved for the affine
+    * and the corrected right-hand sides. Fixed variables and equality constraints are eliminated from the augmented system.
+    * The number of iterations hardly depends on the number of constraints that change activity. No crossover is performed:
+    * the bounds whose multiplier exceeds the distance to the bound form an approximate active set, which is returned to
+    * the SQP layer and used to warm start the next subproblem.
+    */
+   class InteriorPointQPSolver : public QPSolver {
+   public:
+      InteriorPointQPSolver(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros,
+            const Options& options);
+      ~InteriorPointQPSolver() override;
+
+      void solve_LP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+            const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+            const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+            const RectangularMatrix<double>& constraint_jacobian, const Vector<double>& initial_point, Direction& direction,
+            const WarmstartInformation& warmstart_information) override;
+
+      void solve_QP(size_t number_variables, size_t number_constraints, const std::vector<double>& variables_lower_bounds,
+            const std::vector<double>& variables_upper_bounds, const std::vector<double>& constraints_lower_bounds,
+            const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
+            const RectangularMatrix<double>& constraint_jacobian, const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& initial_point,
+            Direction& direction, const WarmstartInformation& warmstart_information) override;
+
+      [[nodiscard]] size_t get_number_iterations() const { return this->number_iterations; }
+      [[nodiscard]] bool is_warm_started() const { return this->warm_started; }
+
+   protected:
+      // data of the QP being solved
+      struct QuadraticProgram {
+         size_t number_variables;
+         size_t number_constraints;
+         const std::vector<double>& variables_lower_bounds;
+         const std::vector<double>& variables_upper_bounds;
+         const std::vector<double>& constraints_lower_bounds;
+         const std::vector<double>& constraints_upper_bounds;
+         const SparseVector<double>& linear_objective;
+         const RectangularMatrix<double>& constraint_jacobian;
+         const SymmetricMatrix<size_t, double>* hessian; // nullptr for LPs
+         const Vector<double>& initial_point;
+      };
+
+      const Options options;
+      const double tolerance;
+      const size_t maximum_iterations;
+      const double fraction_to_boundary;
+      const bool warm_start;
+      const double warm_start_barrier_parameter;
+      const double push_variable_to_interior_k1;
+      const double push_variable_to_interior_k2;
+      const double regularization_exponent;
+      const bool print_subproblem;
+
+      // augmented system [H + Σ A^T; A 0] in the variables (d, s) and the multipliers of J d - s = 0
+      size_t maximum_number_variables;
+      size_t maximum_number_constraints;
+      size_t maximum_number_jacobian_nonzeros;
+      size_t maximum_number_hessian_nonzeros;
+      std::unique_ptr<SymmetricIndefiniteLinearSystem<double>> augmented_system;
+      std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> linear_solver;
+      SymmetricMatrix<size_t, double> hessian; // Hessian of the fixed variables removed, followed by the diagonal Σ
+      RectangularMatrix<double> jacobian; // [J -I] with the fixed variables and the equality constraints removed
+      size_t diagonal_offset{0};
+      // low-rank correction of the Hessian without the rows of the fixed variables
+      LowRankCorrection<double> restricted_hessian_correction{};
+      bool use_hessian_correction{false};
+      Statistics statistics; // records the regularization of the augmented system
+
+      // primal-dual iterate: v = (d, s), multipliers y of J d - s = 0 and nonnegative multipliers of the lower and upper bounds
+      std::vector<double> lower_bounds{};
+      std::vector<double> upper_bounds{};
+      std::vector<bool> is_fixed{};
+      // approximate active set of the previous subproblem
+      std::vector<bool> previously_active_at_lower_bound{};
+      std::vector<bool> previously_active_at_upper_bound{};
+      Vector<double> primals{};
+      Vector<double> constraint_multipliers{};
+      Vector<double> lower_bound_multipliers{};
+      Vector<double> upper_bound_multipliers{};
+
+      // residuals and steps
+      Vector<double> dual_residuals{};
+      Vector<double> primal_residuals{};
+      Vector<double> primal_step{};
+      Vector<double> constraint_multiplier_step{};
+      Vector<double> lower_bound_multiplier_step{};
+      Vector<double> upper_bound_multiplier_step{};
+      Vector<double> affine_primal_step{};
+      Vector<double> affine_lower_bound_multiplier_step{};
+      Vector<double> affine_upper_bound_multiplier_step{};
+
+      // dimensions and status of the previous subproblem (for the warm start)
+      size_t number_variables{0};
+      size_t number_constraints{0};
+      bool previous_solve_succeeded{false};
+      bool warm_started{false};
+      size_t number_iterations{0};
+
+      void solve_subproblem(const QuadraticProgram& problem, Direction& direction, const WarmstartInformation& warmstart_information);
+      void allocate(size_t number_variables, size_t number_constraints, size_t number_jacobian_nonzeros, size_t number_hessian_nonzeros);
+      void assemble_augmented_matrix(const QuadraticProgram& problem);
+      void initialize_primals(const QuadraticProgram& problem);
+      void initialize_cold_start(const QuadraticProgram& problem);
+      void initialize_warm_start(const QuadraticProgram& problem);
+      [[nodiscard]] double push_variable_to_interior(double variable_value, double lower_bound, double upper_bound) const;
+      void compute_residuals(const QuadraticProgram& problem);
+      [[nodiscard]] double average_complementarity() const;
+      [[nodiscard]] SubproblemStatus run_predictor_corrector_method(const QuadraticProgram& problem);
+      void update_diagonal(const QuadraticProgram& problem);
+      [[nodiscard]] double lower_complementarity_rhs(size_t index, double centering_target, bool corrector) const;
+      [[nodiscard]] double upper_complementarity_rhs(size_t index, double centering_target, bool corrector) const;
+      void assemble_rhs(const QuadraticProgram& problem, double centering_target, bool corrector);
+      void compute_step(const QuadraticProgram& problem, double centering_target, bool corrector);
+      [[nodiscard]] double primal_step_length(const QuadraticProgram& problem, double tau) const;
+      [[nodiscard]] double dual_step_length(const QuadraticProgram& problem, double tau) const;
+
+      void set_direction(const QuadraticProgram& problem, Direction& direction);
+   };
+} // namespace
+
+#endif // UNO_INTERIORPOINTQPSOLVER_H
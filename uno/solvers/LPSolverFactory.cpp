@@ -6,6 +6,7 @@
 #include "linear_algebra/Vector.hpp"
 #include "options/Options.hpp"
 #include "solvers/LPSolver.hpp"
+#include "solvers/InteriorPointQP/InteriorPointQPSolver.hpp"
 
 #ifdef HAS_BQPD
 #include "solvers/BQPD/BQPDSolver.hpp"
@@ -31,6 +32,9 @@ namespace uno {
             return std::make_unique<HiGHSSolver>(number_variables, number_constraints, number_jacobian_nonzeros, 0, options);
          }
 #endif
+         if (LP_solver_name == "interior_point") {
+            return std::make_unique<InteriorPointQPSolver>(number_variables, number_constraints, number_jacobian_nonzeros, 0, options);
+         }
          std::string message = "The LP solver ";
          message.append(LP_solver_name).append(" is unknown").append("\n").append("The following values are available: ")
                .append(join(LPSolverFactory::available_solvers(), ", "));
@@ -51,6 +55,7 @@ namespace uno {
 #ifdef HAS_HIGHS
       solvers.emplace_back("HiGHS");
 #endif
+      solvers.emplace_back("interior_point");
       return solvers;
    }
 } // namespace
\ No newline at end of file
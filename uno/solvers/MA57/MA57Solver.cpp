@@ -61,12 +61,27 @@ namespace uno {
       assert(matrix.number_nonzeros() <= this->row_indices.capacity() &&
              "MA57Solver: the number of nonzeros of the matrix is larger than the preallocated size");
 
+      // reuse the previous symbolic factorization if the sparsity pattern did not change
+      if (not this->sparsity_pattern_changed(matrix)) {
+         DEBUG << "MA57: sparsity pattern unchanged, skipping the symbolic factorization\n";
+         return;
+      }
+
       // build the internal matrix representation
       this->save_sparsity_pattern_internally(matrix);
 
       const int n = static_cast<int>(matrix.dimension());
       const int nnz = static_cast<int>(matrix.number_nonzeros());
 
+      // user-supplied pivot order: KEEP(i) is the position of variable i in the pivot order
+      if (this->ordering != nullptr) {
+         const Permutation inverse_permutation = invert_permutation(*this->ordering->permutation(matrix, *this->analyzed_pattern));
+         for (size_t index = 0; index < matrix.dimension(); index++) {
+            this->keep[index] = static_cast<int>(inverse_permutation[index] + this->fortran_shift);
+         }
+         this->icntl[5] = 1;
+      }
+
       // symbolic factorization
       MA57AD(/* const */ &n,
             /* const */ &nnz,
@@ -138,6 +153,29 @@ namespace uno {
       }
    }
 
+   void MA57Solver::solve_indefinite_systems(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+         size_t number_rhs) {
+      // MA57DD (iterative refinement) handles a single right-hand side
+      if (this->use_iterative_refinement) {
+         DirectSymmetricIndefiniteLinearSolver<size_t, double>::solve_indefinite_systems(matrix, rhs, result, number_rhs);
+         return;
+      }
+      const int n = static_cast<int>(matrix.dimension());
+      const int nrhs = static_cast<int>(number_rhs);
+      const int lrhs = n; // leading dimension of the rhs block
+      // MA57CD requires LWORK >= N*NRHS
+      if (this->lwork < n * nrhs) {
+         this->lwork = n * nrhs;
+         this->work.resize(static_cast<size_t>(this->lwork));
+      }
+
+      // copy rhs into result (overwritten by MA57)
+      result = rhs;
+      MA57CD(&this->job, &n, this->fact.data(), &this->factorization.lfact, this->ifact.data(),
+            &this->factorization.lifact, &nrhs, result.data(), &lrhs, this->work.data(), &this->lwork, this->iwork.data(),
+            this->icntl.data(), this->info.data());
+   }
+
    std::tuple<size_t, size_t, size_t> MA57Solver::get_inertia() const {
       // rank = number_positive_eigenvalues + number_negative_eigenvalues
       // n = rank + number_zero_eigenvalues
@@ -171,9 +209,9 @@ namespace uno {
       // build the internal matrix representation
       this->row_indices.clear();
       this->column_indices.clear();
-      for (const auto [row_index, column_index, element]: matrix) {
+      matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double /*element*/) {
          this->row_indices.emplace_back(static_cast<int>(row_index + this->fortran_shift));
          this->column_indices.emplace_back(static_cast<int>(column_index + this->fortran_shift));
-      }
+      });
    }
 } // namespace
@@ -0,0 +1,179 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include "MINRESSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "tools/Logger.hpp"
+
+namespace uno {
+   MINRESSolver::MINRESSolver(size_t dimension, const Options& options):
+         DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension),
+         maximum_iterations(options.get_unsigned_int("MINRES_maximum_iterations")),
+         maximum_relative_tolerance(options.get_double("MINRES_maximum_relative_tolerance")),
+         minimum_relative_tolerance(options.get_double("MINRES_minimum_relative_tolerance")),
+         inverse_preconditioner(dimension),
+         v(dimension), r1(dimension), r2(dimension), y(dimension), w(dimension), w1(dimension), w2(dimension) {
+      if (this->maximum_relative_tolerance < this->minimum_relative_tolerance) {
+         throw std::invalid_argument("The option MINRES_minimum_relative_tolerance should not exceed MINRES_maximum_relative_tolerance");
+      }
+   }
+
+   void MINRESSolver::factorize(const SymmetricMatrix<size_t, double>& matrix) {
+      this->do_symbolic_factorization(matrix);
+      this->do_numerical_factorization(matrix);
+   }
+
+   void MINRESSolver::do_symbolic_factorization([[maybe_unused]] const SymmetricMatrix<size_t, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "MINRESSolver: the dimension of the matrix is larger than the preallocated size");
+   }
+
+   // diagonal preconditioner: 2-norms of the rows of the matrix
+   void MINRESSolver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+      const size_t n = matrix.dimension();
+      std::fill(this->inverse_preconditioner.begin(), this->inverse_preconditioner.begin() + static_cast<std::ptrdiff_t>(n), 0.);
+      matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+         const double squared_element = element * element;
+         this->inverse_preconditioner[row_index] += squared_element;
+         if (row_index != column_index) {
+            this->inverse_preconditioner[column_index] += squared_element;
+         }
+      });
+      for (size_t index = 0; index < n; index++) {
+         const double row_norm = std::sqrt(this->inverse_preconditioner[index]);
+         // empty rows are left unscaled
+         this->inverse_preconditioner[index] = (0. < row_norm) ? 1. / row_norm : 1.;
+      }
+   }
+
+   // preconditioned MINRES (Paige and Saunders, 1975), starting from x = 0
+   void MINRESSolver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) {
+      const size_t n = matrix.dimension();
+      this->number_iterations = 0;
+      for (size_t index = 0; index < n; index++) {
+         result[index] = 0.;
+         this->r1[index] = rhs[index];
+         this->r2[index] = rhs[index];
+         this->y[index] = this->inverse_preconditioner[index] * rhs[index];
+         this->w[index] = 0.;
+         this->w2[index] = 0.;
+      }
+      double rhs_norm = 0.;
+      double beta1 = 0.;
+      for (size_t index = 0; index < n; index++) {
+         rhs_norm += rhs[index] * rhs[index];
+         beta1 += this->r1[index] * this->y[index];
+      }
+      rhs_norm = std::sqrt(rhs_norm);
+      beta1 = std::sqrt(beta1);
+      if (beta1 == 0.) {
+         return;
+      }
+      // inexact Newton forcing term
+      const double relative_tolerance = std::max(this->minimum_relative_tolerance, std::min(this->maximum_relative_tolerance, std::sqrt(rhs_norm)));
+
+      double old_beta = 0., beta = beta1, dbar = 0., epsilon = 0., phibar = beta1;
+      double cs = -1., sn = 0.;
+      double residual_norm = beta1;
+      while (this->number_iterations < this->maximum_iterations) {
+         this->number_iterations++;
+         // Lanczos step
+         const double s = 1. / beta;
+         for (size_t index = 0; index < n; index++) {
+            this->v[index] = s * this->y[index];
+         }
+         MINRESSolver::symmetric_product(matrix, this->v, this->y);
+         if (2 <= this->number_iterations) {
+            const double factor = beta / old_beta;
+            for (size_t index = 0; index < n; index++) {
+               this->y[index] -= factor * this->r1[index];
+            }
+         }
+         double alpha = 0.;
+         for (size_t index = 0; index < n; index++) {
+            alpha += this->v[index] * this->y[index];
+         }
+         const double factor = alpha / beta;
+         for (size_t index = 0; index < n; index++) {
+            this->y[index] -= factor * this->r2[index];
+         }
+         std::swap(this->r1, this->r2);
+         old_beta = beta;
+         beta = 0.;
+         for (size_t index = 0; index < n; index++) {
+            this->r2[index] = this->y[index];
+            this->y[index] = this->inverse_preconditioner[index] * this->r2[index];
+            beta += this->r2[index] * this->y[index];
+         }
+         if (beta < 0.) {
+            throw std::runtime_error("MINRES: the preconditioner is not positive definite");
+         }
+         beta = std::sqrt(beta);
+
+         // apply the previous rotation, then compute and apply the new one
+         const double old_epsilon = epsilon;
+         const double delta = cs * dbar + sn * alpha;
+         const double gbar = sn * dbar - cs * alpha;
+         epsilon = sn * beta;
+         dbar = -cs * beta;
+         const double gamma = std::max(std::hypot(gbar, beta), std::numeric_limits<double>::epsilon());
+         cs = gbar / gamma;
+         sn = beta / gamma;
+         const double phi = cs * phibar;
+         phibar = sn * phibar;
+
+         // update the search direction and the solution
+         const double inverse_gamma = 1. / gamma;
+         std::swap(this->w1, this->w2);
+         std::swap(this->w2, this->w);
+         for (size_t index = 0; index < n; index++) {
+            this->w[index] = (this->v[index] - old_epsilon * this->w1[index] - delta * this->w2[index]) * inverse_gamma;
+            result[index] += phi * this->w[index];
+         }
+         residual_norm = phibar;
+         if (residual_norm <= relative_tolerance * beta1 || beta == 0.) {
+            DEBUG << "MINRES converged in " << this->number_iterations << " iterations (relative residual " << residual_norm / beta1 << ")\n";
+            return;
+         }
+      }
+      WARNING << "MINRES did not converge in " << this->maximum_iterations << " iterations (relative residual " << residual_norm / beta1 << ")\n";
+   }
+
+   std::tuple<size_t, size_t, size_t> MINRESSolver::get_inertia() const {
+      throw std::runtime_error("MINRES does not provide the inertia of the matrix");
+   }
+
+   size_t MINRESSolver::number_negative_eigenvalues() const {
+      throw std::runtime_error("MINRES does not provide the inertia of the matrix");
+   }
+
+   bool MINRESSolver::matrix_is_singular() const {
+      // singularity shows up as a non-finite solution
+      return false;
+   }
+
+   size_t MINRESSolver::rank() const {
+      throw std::runtime_error("MINRES does not provide the rank of the matrix");
+   }
+
+   size_t MINRESSolver::get_number_iterations() const {
+      return this->number_iterations;
+   }
+
+   // result = matrix x, where only the lower (or upper) triangle of the symmetric matrix is stored
+   void MINRESSolver::symmetric_product(const SymmetricMatrix<size_t, double>& matrix, const std::vector<double>& x, std::vector<double>& result) {
+      std::fill(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(matrix.dimension()), 0.);
+      matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+         result[row_index] += element * x[column_index];
+         if (row_index != column_index) {
+            result[column_index] += element * x[row_index];
+         }
+      });
+   }
+} // namespace
@@ -0,0 +1,61 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_MINRESSOLVER_H
+#define UNO_MINRESSOLVER_H
+
+#include <vector>
+#include "solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+
+namespace uno {
+   // forward declarations
+   class Options;
+   template <typename ElementType>
+   class Vector;
+
+   /*! \class MINRESSolver
+    * \brief Matrix-free Krylov solver for symmetric indefinite systems
+    *
+    *  Preconditioned MINRES (Paige and Saunders). The matrix is only accessed through matrix-vector products, therefore
+    *  the memory scales with the number of nonzeros of the matrix instead of the fill-in of a factorization.
+    *  - "factorization": computation of a diagonal SPD preconditioner from the 2-norms of the rows of the matrix. On the
+    *    augmented system, this is a block-diagonal preconditioner whose dual block scales with the constraint gradients
+    *  - solve: inexact Newton tolerance. The relative residual tolerance is the forcing term
+    *    min(maximum tolerance, sqrt(||rhs||)), bounded below by the minimum tolerance: the linear systems are solved
+    *    loosely far from a solution and more accurately as the rhs (the KKT residual) goes to zero
+    *  - the inertia is not available: the inertia correction of the augmented system uses the curvature test
+    */
+   class MINRESSolver : public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+   public:
+      MINRESSolver(size_t dimension, const Options& options);
+      ~MINRESSolver() override = default;
+
+      void factorize(const SymmetricMatrix<size_t, double>& matrix) override;
+      void do_symbolic_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+      [[nodiscard]] bool provides_inertia() const override { return false; }
+
+      [[nodiscard]] size_t get_number_iterations() const;
+
+   private:
+      const size_t maximum_iterations;
+      const double maximum_relative_tolerance;
+      const double minimum_relative_tolerance;
+      size_t number_iterations{0}; // of the last solve
+
+      // inverse of the diagonal preconditioner
+      std::vector<double> inverse_preconditioner{};
+      // Lanczos vectors and search directions
+      std::vector<double> v{}, r1{}, r2{}, y{}, w{}, w1{}, w2{};
+
+      static void symmetric_product(const SymmetricMatrix<size_t, double>& matrix, const std::vector<double>& x, std::vector<double>& result);
+   };
+} // namespace
+
+#endif // UNO_MINRESSOLVER_H
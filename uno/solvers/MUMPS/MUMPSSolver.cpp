@@ -3,6 +3,7 @@
 
 #include "MUMPSSolver.hpp"
 #include "linear_algebra/SymmetricMatrix.hpp"
+#include "tools/Logger.hpp"
 #if defined(HAS_MPI) && defined(MUMPS_PARALLEL)
 #include "mpi.h"
 #endif
@@ -44,6 +45,11 @@ namespace uno {
    }
 
    void MUMPSSolver::do_symbolic_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+      // reuse the previous analysis if the sparsity pattern did not change
+      if (not this->sparsity_pattern_changed(matrix)) {
+         DEBUG << "MUMPS: sparsity pattern unchanged, skipping the analysis\n";
+         return;
+      }
       this->save_matrix_to_local_format(matrix);
       this->mumps_structure.n = static_cast<int>(matrix.dimension());
       this->mumps_structure.nnz = static_cast<int>(matrix.number_nonzeros());
@@ -51,6 +57,16 @@ namespace uno {
       // connect the local COO matrix with the pointers in the structure
       this->mumps_structure.irn = this->COO_matrix.row_indices_pointer();
       this->mumps_structure.jcn = this->COO_matrix.column_indices_pointer();
+      // user-supplied pivot order: PERM_IN(i) is the position of variable i in the pivot order
+      if (this->ordering != nullptr) {
+         const Permutation inverse_permutation = invert_permutation(*this->ordering->permutation(matrix, *this->analyzed_pattern));
+         this->pivot_order.resize(matrix.dimension());
+         for (size_t index = 0; index < matrix.dimension(); index++) {
+            this->pivot_order[index] = static_cast<int>(inverse_permutation[index] + this->fortran_shift);
+         }
+         this->mumps_structure.perm_in = this->pivot_order.data();
+         this->mumps_structure.icntl[6] = 1;
+      }
       dmumps_c(&this->mumps_structure);
    }
 
@@ -63,10 +79,23 @@ namespace uno {
    void MUMPSSolver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& /*matrix*/, const Vector<double>& rhs, Vector<double>& result) {
       result = rhs;
       this->mumps_structure.rhs = result.data();
+      this->mumps_structure.nrhs = 1;
       this->mumps_structure.job = MUMPSSolver::JOB_SOLVE;
       dmumps_c(&this->mumps_structure);
    }
 
+   void MUMPSSolver::solve_indefinite_systems(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+         size_t number_rhs) {
+      // dense centralized right-hand sides, overwritten by the solutions
+      result = rhs;
+      this->mumps_structure.rhs = result.data();
+      this->mumps_structure.nrhs = static_cast<int>(number_rhs);
+      this->mumps_structure.lrhs = static_cast<int>(matrix.dimension());
+      this->mumps_structure.job = MUMPSSolver::JOB_SOLVE;
+      dmumps_c(&this->mumps_structure);
+      this->mumps_structure.nrhs = 1;
+   }
+
    std::tuple<size_t, size_t, size_t> MUMPSSolver::get_inertia() const {
       const size_t number_negative_eigenvalues = this->number_negative_eigenvalues();
       const size_t number_zero_eigenvalues = this->number_zero_eigenvalues();
@@ -95,8 +124,8 @@ namespace uno {
    void MUMPSSolver::save_matrix_to_local_format(const SymmetricMatrix<size_t, double>& matrix) {
       // build the internal matrix representation
       this->COO_matrix.reset();
-      for (const auto [row_index, column_index, element]: matrix) {
+      matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
          this->COO_matrix.insert(element, static_cast<int>(row_index + this->fortran_shift), static_cast<int>(column_index + this->fortran_shift));
-      }
+      });
    }
 } // namespace
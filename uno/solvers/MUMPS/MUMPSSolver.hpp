@@ -4,6 +4,7 @@
 #ifndef UNO_MUMPSSOLVER_H
 #define UNO_MUMPSSOLVER_H
 
+#include <vector>
 #include "solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "linear_algebra/COOSparseStorage.hpp"
 #include "dmumps_c.h"
@@ -19,6 +20,8 @@ namespace uno {
       void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
       void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs,
             Vector<double>& result) override;
+      void solve_indefinite_systems(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+            size_t number_rhs) override;
 
       [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
       [[nodiscard]] size_t number_negative_eigenvalues() const override;
@@ -30,6 +33,7 @@ namespace uno {
    protected:
       DMUMPS_STRUC_C mumps_structure{};
       COOSparseStorage<int, double> COO_matrix;
+      std::vector<int> pivot_order{}; // PERM_IN when an ordering is set
 
       static const int JOB_INIT = -1;
       static const int JOB_END = -2;
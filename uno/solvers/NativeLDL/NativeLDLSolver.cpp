@@ -0,0 +1,691 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include "NativeLDLSolver.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/Options.hpp"
+#include "ordering/ApproximateMinimumDegreeOrdering.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+
+namespace uno {
+   NativeLDLSolver::NativeLDLSolver(size_t dimension, size_t number_nonzeros, const Options& options):
+         DirectSymmetricIndefiniteLinearSolver<size_t, double>(dimension),
+         pivot_tolerance(options.get_double("native_LDL_pivot_tolerance")),
+         zero_pivot_tolerance(options.get_double("native_LDL_zero_pivot_tolerance")),
+         number_threads(ThreadPool::number_threads_from_option(options.get_unsigned_int("native_LDL_threads"))),
+         solve_workspace(dimension) {
+      if (this->pivot_tolerance <= 0. || 0.5 < this->pivot_tolerance) {
+         throw std::invalid_argument("The option native_LDL_pivot_tolerance should be in (0, 0.5]");
+      }
+      if (1 < this->number_threads) {
+         this->thread_pool = std::make_unique<ThreadPool>(this->number_threads);
+      }
+      this->ordering = std::make_unique<ApproximateMinimumDegreeOrdering>();
+      this->entry_rows.reserve(number_nonzeros);
+      this->entry_positions.reserve(number_nonzeros);
+   }
+
+   NativeLDLSolver::~NativeLDLSolver() = default;
+
+   // general factorization method: symbolic factorization and numerical factorization
+   void NativeLDLSolver::factorize(const SymmetricMatrix<size_t, double>& matrix) {
+      this->do_symbolic_factorization(matrix);
+      this->do_numerical_factorization(matrix);
+   }
+
+   void NativeLDLSolver::do_symbolic_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+      assert(matrix.dimension() <= this->dimension && "NativeLDLSolver: the dimension of the matrix is larger than the preallocated size");
+
+      // reuse the previous symbolic factorization if the sparsity pattern did not change
+      if (not this->sparsity_pattern_changed(matrix)) {
+         DEBUG << "native LDL: sparsity pattern unchanged, skipping the symbolic factorization\n";
+         return;
+      }
+      const size_t n = matrix.dimension();
+      this->analyzed_dimension = n;
+      this->analyzed_number_nonzeros = matrix.number_nonzeros();
+
+      // fill-reducing ordering, then postordering of the elimination tree so that supernodes are consecutive columns
+      this->permutation = *this->ordering->permutation(matrix, *this->analyzed_pattern);
+      this->inverse_permutation = invert_permutation(this->permutation);
+      this->build_permuted_lower_triangle(matrix);
+      const std::vector<size_t> postorder = NativeLDLSolver::compute_postorder(this->compute_elimination_tree());
+      std::vector<size_t> postordered_permutation(n);
+      for (size_t index = 0; index < n; index++) {
+         postordered_permutation[index] = this->permutation[postorder[index]];
+      }
+      this->permutation = std::move(postordered_permutation);
+      this->inverse_permutation = invert_permutation(this->permutation);
+      this->build_permuted_lower_triangle(matrix);
+
+      // supernodal structure
+      this->compute_supernodes(this->compute_elimination_tree());
+      this->fronts.clear();
+      this->fronts.resize(this->supernodes.size());
+      const size_t number_workspaces = (this->thread_pool != nullptr) ? this->thread_pool->size() : 1;
+      this->local_positions_per_thread.assign(number_workspaces, std::vector<size_t>(n, NativeLDLSolver::UNDEFINED));
+      DEBUG << "native LDL: " << this->supernodes.size() << " supernodes for a matrix of dimension " << n << '\n';
+   }
+
+   void NativeLDLSolver::do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) {
+      assert(matrix.dimension() == this->analyzed_dimension && "NativeLDLSolver: the dimension does not match the symbolic factorization");
+      assert(matrix.number_nonzeros() == this->analyzed_number_nonzeros && "NativeLDLSolver: the numbers of nonzeros do not match");
+
+      const double* values = matrix.data_pointer();
+      if (this->thread_pool != nullptr && 1 < this->supernodes.size()) {
+         this->factorize_fronts_in_parallel(values);
+      }
+      else {
+         for (size_t supernode_index = 0; supernode_index < this->supernodes.size(); supernode_index++) {
+            this->factorize_front(supernode_index, values, this->local_positions_per_thread[0]);
+         }
+      }
+      this->compute_inertia();
+      if (0 < this->number_forced_pivots) {
+         DEBUG << "native LDL: " << this->number_forced_pivots << " pivots were forced at the roots, " << this->number_zero << " zero pivots\n";
+      }
+   }
+
+   void NativeLDLSolver::solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) {
+      this->solve_indefinite_systems(matrix, rhs, result, 1);
+   }
+
+   // blocked solve: the factors are traversed once for all the right-hand sides
+   void NativeLDLSolver::solve_indefinite_systems(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+         size_t number_rhs) {
+      assert(matrix.dimension() == this->analyzed_dimension && "NativeLDLSolver: the dimension does not match the factorization");
+      const size_t n = matrix.dimension();
+      assert(n * number_rhs <= rhs.size() && n * number_rhs <= result.size() && "NativeLDLSolver: the right-hand side blocks are too small");
+      // row-major workspace: the number_rhs entries of a (permuted) row are contiguous
+      std::vector<double>& y = this->solve_workspace;
+      y.resize(n * number_rhs);
+      for (size_t rhs_index = 0; rhs_index < number_rhs; rhs_index++) {
+         for (size_t index = 0; index < n; index++) {
+            y[index * number_rhs + rhs_index] = rhs[rhs_index * n + this->permutation[index]];
+         }
+      }
+
+      // forward substitution with L
+      for (const Front& front: this->fronts) {
+         const size_t front_size = front.indices.size();
+         for (size_t k = 0; k < front.number_eliminated; k++) {
+            const double* L_k = front.L.data() + k * front_size;
+            const double* y_k = y.data() + front.indices[k] * number_rhs;
+            for (size_t i = k + 1; i < front_size; i++) {
+               const double l_ik = L_k[i];
+               if (l_ik != 0.) {
+                  double* y_i = y.data() + front.indices[i] * number_rhs;
+                  for (size_t rhs_index = 0; rhs_index < number_rhs; rhs_index++) {
+                     y_i[rhs_index] -= l_ik * y_k[rhs_index];
+                  }
+               }
+            }
+         }
+      }
+      // block diagonal solve with D
+      for (const Front& front: this->fronts) {
+         for (size_t k = 0; k < front.number_eliminated; k++) {
+            if (front.pivot_sizes[k] == 1) {
+               double* y_k = y.data() + front.indices[k] * number_rhs;
+               // pseudo-solve for zero pivots
+               const double inverse_pivot = (front.D[k] == 0.) ? 0. : 1. / front.D[k];
+               for (size_t rhs_index = 0; rhs_index < number_rhs; rhs_index++) {
+                  y_k[rhs_index] *= inverse_pivot;
+               }
+            }
+            else if (front.pivot_sizes[k] == 2) {
+               const double d11 = front.D[k], d21 = front.off_diagonal_D[k], d22 = front.D[k + 1];
+               const double determinant = d11 * d22 - d21 * d21;
+               double* y1 = y.data() + front.indices[k] * number_rhs;
+               double* y2 = y.data() + front.indices[k + 1] * number_rhs;
+               for (size_t rhs_index = 0; rhs_index < number_rhs; rhs_index++) {
+                  const double solution1 = (d22 * y1[rhs_index] - d21 * y2[rhs_index]) / determinant;
+                  const double solution2 = (d11 * y2[rhs_index] - d21 * y1[rhs_index]) / determinant;
+                  y1[rhs_index] = solution1;
+                  y2[rhs_index] = solution2;
+               }
+            }
+         }
+      }
+      // backward substitution with L^T
+      for (size_t front_index = this->fronts.size(); 0 < front_index; front_index--) {
+         const Front& front = this->fronts[front_index - 1];
+         const size_t front_size = front.indices.size();
+         for (size_t k = front.number_eliminated; 0 < k; k--) {
+            const double* L_k = front.L.data() + (k - 1) * front_size;
+            double* y_k = y.data() + front.indices[k - 1] * number_rhs;
+            for (size_t i = k; i < front_size; i++) {
+               const double l_ik = L_k[i];
+               if (l_ik != 0.) {
+                  const double* y_i = y.data() + front.indices[i] * number_rhs;
+                  for (size_t rhs_index = 0; rhs_index < number_rhs; rhs_index++) {
+                     y_k[rhs_index] -= l_ik * y_i[rhs_index];
+                  }
+               }
+            }
+         }
+      }
+
+      for (size_t rhs_index = 0; rhs_index < number_rhs; rhs_index++) {
+         for (size_t index = 0; index < n; index++) {
+            result[rhs_index * n + this->permutation[index]] = y[index * number_rhs + rhs_index];
+         }
+      }
+   }
+
+   std::tuple<size_t, size_t, size_t> NativeLDLSolver::get_inertia() const {
+      return std::make_tuple(this->number_positive, this->number_negative, this->number_zero);
+   }
+
+   size_t NativeLDLSolver::number_negative_eigenvalues() const {
+      return this->number_negative;
+   }
+
+   bool NativeLDLSolver::matrix_is_singular() const {
+      return (0 < this->number_zero);
+   }
+
+   size_t NativeLDLSolver::rank() const {
+      return this->analyzed_dimension - this->number_zero;
+   }
+
+   // store the entries of the lower triangle of the permuted matrix by columns, along with their position in the array of values
+   void NativeLDLSolver::build_permuted_lower_triangle(const SymmetricMatrix<size_t, double>& matrix) {
+      const size_t n = this->analyzed_dimension;
+      this->column_starts.assign(n + 1, 0);
+      matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double /*element*/) {
+         const size_t permuted_column = std::min(this->inverse_permutation[row_index], this->inverse_permutation[column_index]);
+         this->column_starts[permuted_column + 1]++;
+      });
+      for (size_t column_index = 0; column_index < n; column_index++) {
+         this->column_starts[column_index + 1] += this->column_starts[column_index];
+      }
+      this->entry_rows.resize(this->analyzed_number_nonzeros);
+      this->entry_positions.resize(this->analyzed_number_nonzeros);
+      std::vector<size_t> current_positions(this->column_starts.begin(), this->column_starts.end() - 1);
+      size_t value_position = 0;
+      matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double /*element*/) {
+         const size_t permuted_row = this->inverse_permutation[row_index];
+         const size_t permuted_column = this->inverse_permutation[column_index];
+         const size_t position = current_positions[std::min(permuted_row, permuted_column)]++;
+         this->entry_rows[position] = std::max(permuted_row, permuted_column);
+         this->entry_positions[position] = value_position;
+         value_position++;
+      });
+   }
+
+   // elimination tree of the permuted matrix (Liu's algorithm with path compression)
+   std::vector<size_t> NativeLDLSolver::compute_elimination_tree() const {
+      const size_t n = this->analyzed_dimension;
+      // transpose of the strict lower triangle: for each row, the columns of its off-diagonal entries
+      std::vector<size_t> row_starts(n + 1, 0);
+      for (size_t column_index = 0; column_index < n; column_index++) {
+         for (size_t position = this->column_starts[column_index]; position < this->column_starts[column_index + 1]; position++) {
+            if (this->entry_rows[position] != column_index) {
+               row_starts[this->entry_rows[position] + 1]++;
+            }
+         }
+      }
+      for (size_t row_index = 0; row_index < n; row_index++) {
+         row_starts[row_index + 1] += row_starts[row_index];
+      }
+      std::vector<size_t> row_columns(row_starts.back());
+      std::vector<size_t> current_positions(row_starts.begin(), row_starts.end() - 1);
+      for (size_t column_index = 0; column_index < n; column_index++) {
+         for (size_t position = this->column_starts[column_index]; position < this->column_starts[column_index + 1]; position++) {
+            if (this->entry_rows[position] != column_index) {
+               row_columns[current_positions[this->entry_rows[position]]++] = column_index;
+            }
+         }
+      }
+
+      std::vector<size_t> parent(n, NativeLDLSolver::UNDEFINED);
+      std::vector<size_t> ancestor(n, NativeLDLSolver::UNDEFINED);
+      for (size_t row_index = 0; row_index < n; row_index++) {
+         for (size_t position = row_starts[row_index]; position < row_starts[row_index + 1]; position++) {
+            size_t node = row_columns[position];
+            while (node != NativeLDLSolver::UNDEFINED && node < row_index) {
+               const size_t next_node = ancestor[node];
+               ancestor[node] = row_index;
+               if (next_node == NativeLDLSolver::UNDEFINED) {
+                  parent[node] = row_index;
+               }
+               node = next_node;
+            }
+         }
+      }
+      return parent;
+   }
+
+   // fundamental supernodes: chains of columns j, j+1 where j+1 is the only child of ... and struct(L_j) = {j+1} U struct(L_{j+1})
+   void NativeLDLSolver::compute_supernodes(const std::vector<size_t>& parent) {
+      const size_t n = this->analyzed_dimension;
+      // children of each column in the elimination tree
+      std::vector<size_t> child_starts(n + 1, 0);
+      for (size_t column_index = 0; column_index < n; column_index++) {
+         if (parent[column_index] != NativeLDLSolver::UNDEFINED) {
+            child_starts[parent[column_index] + 1]++;
+         }
+      }
+      for (size_t column_index = 0; column_index < n; column_index++) {
+         child_starts[column_index + 1] += child_starts[column_index];
+      }
+      std::vector<size_t> children(child_starts.back());
+      std::vector<size_t> current_positions(child_starts.begin(), child_starts.end() - 1);
+      for (size_t column_index = 0; column_index < n; column_index++) {
+         if (parent[column_index] != NativeLDLSolver::UNDEFINED) {
+            children[current_positions[parent[column_index]]++] = column_index;
+         }
+      }
+
+      // structure of each column of L: struct(L_j) = struct(A_j) U (U_{c child of j} struct(L_c) \ {j})
+      std::vector<std::vector<size_t>> structures(n);
+      std::vector<size_t> marker(n, NativeLDLSolver::UNDEFINED);
+      for (size_t column_index = 0; column_index < n; column_index++) {
+         std::vector<size_t>& structure = structures[column_index];
+         marker[column_index] = column_index;
+         for (size_t position = this->column_starts[column_index]; position < this->column_starts[column_index + 1]; position++) {
+            const size_t row_index = this->entry_rows[position];
+            if (marker[row_index] != column_index) {
+               marker[row_index] = column_index;
+               structure.emplace_back(row_index);
+            }
+         }
+         for (size_t child_position = child_starts[column_index]; child_position < child_starts[column_index + 1]; child_position++) {
+            for (size_t row_index: structures[children[child_position]]) {
+               if (marker[row_index] != column_index) {
+                  marker[row_index] = column_index;
+                  structure.emplace_back(row_index);
+               }
+            }
+         }
+         std::sort(structure.begin(), structure.end());
+      }
+
+      // group the columns into fundamental supernodes
+      this->supernodes.clear();
+      std::vector<size_t> supernode_of(n);
+      for (size_t column_index = 0; column_index < n; column_index++) {
+         const bool extends_supernode = 0 < column_index && parent[column_index - 1] == column_index &&
+               child_starts[column_index + 1] - child_starts[column_index] == 1 &&
+               structures[column_index - 1].size() == structures[column_index].size() + 1;
+         if (not extends_supernode) {
+            this->supernodes.emplace_back();
+            this->supernodes.back().first_column = column_index;
+         }
+         this->supernodes.back().end_column = column_index + 1;
+         supernode_of[column_index] = this->supernodes.size() - 1;
+      }
+      for (size_t supernode_index = 0; supernode_index < this->supernodes.size(); supernode_index++) {
+         Supernode& supernode = this->supernodes[supernode_index];
+         for (size_t row_index: structures[supernode.first_column]) {
+            if (supernode.end_column <= row_index) {
+               supernode.structure.emplace_back(row_index);
+            }
+         }
+         const size_t last_column = supernode.end_column - 1;
+         if (parent[last_column] != NativeLDLSolver::UNDEFINED) {
+            supernode.parent = supernode_of[parent[last_column]];
+            this->supernodes[supernode.parent].children.emplace_back(supernode_index);
+         }
+      }
+   }
+
+   // assemble the front of a supernode, eliminate its fully summed columns and form its contribution block
+   void NativeLDLSolver::factorize_front(size_t supernode_index, const double* values, std::vector<size_t>& local_positions) {
+      const Supernode& supernode = this->supernodes[supernode_index];
+      Front& front = this->fronts[supernode_index];
+
+      // indices of the front: columns delayed by the children, columns of the supernode, rows below the supernode
+      front.indices.clear();
+      for (size_t child_index: supernode.children) {
+         const Front& child_front = this->fronts[child_index];
+         for (size_t k = 0; k < child_front.number_delayed; k++) {
+            front.indices.emplace_back(child_front.indices[child_front.number_eliminated + k]);
+         }
+      }
+      for (size_t column_index = supernode.first_column; column_index < supernode.end_column; column_index++) {
+         front.indices.emplace_back(column_index);
+      }
+      const size_t number_fully_summed = front.indices.size();
+      front.indices.insert(front.indices.end(), supernode.structure.begin(), supernode.structure.end());
+      const size_t front_size = front.indices.size();
+      for (size_t local_index = 0; local_index < front_size; local_index++) {
+         local_positions[front.indices[local_index]] = local_index;
+      }
+
+      // dense front (only the lower triangle is referenced)
+      std::vector<double> F(front_size * front_size, 0.);
+      const auto entry = [&](size_t i, size_t j) -> double& {
+         return (j <= i) ? F[i + j * front_size] : F[j + i * front_size];
+      };
+      // original entries
+      for (size_t column_index = supernode.first_column; column_index < supernode.end_column; column_index++) {
+         const size_t local_column = local_positions[column_index];
+         for (size_t position = this->column_starts[column_index]; position < this->column_starts[column_index + 1]; position++) {
+            entry(local_positions[this->entry_rows[position]], local_column) += values[this->entry_positions[position]];
+         }
+      }
+      // extend-add of the contribution blocks of the children
+      for (size_t child_index: supernode.children) {
+         Front& child_front = this->fronts[child_index];
+         const size_t contribution_size = child_front.indices.size() - child_front.number_eliminated;
+         const size_t* contribution_indices = child_front.indices.data() + child_front.number_eliminated;
+         for (size_t j = 0; j < contribution_size; j++) {
+            const size_t local_column = local_positions[contribution_indices[j]];
+            for (size_t i = j; i < contribution_size; i++) {
+               entry(local_positions[contribution_indices[i]], local_column) += child_front.contribution[i + j * contribution_size];
+            }
+         }
+         std::vector<double>().swap(child_front.contribution);
+      }
+
+      // symmetric permutation of two rows/columns of the front
+      const auto swap_symmetric = [&](size_t p, size_t q) {
+         if (p != q) {
+            for (size_t t = 0; t < front_size; t++) {
+               if (t != p && t != q) {
+                  std::swap(entry(p, t), entry(q, t));
+               }
+            }
+            std::swap(entry(p, p), entry(q, q));
+            std::swap(front.indices[p], front.indices[q]);
+         }
+      };
+
+      // partial LDL^T factorization of the fully summed columns with threshold Bunch-Kaufman pivoting
+      front.D.clear();
+      front.off_diagonal_D.clear();
+      front.pivot_sizes.clear();
+      front.number_forced_pivots = 0;
+      const bool is_root = (supernode.parent == NativeLDLSolver::UNDEFINED);
+      size_t k = 0;
+      while (k < number_fully_summed) {
+         // largest entry of column c in the remaining rows, other than rows excluded1 and excluded2
+         const auto column_maximum = [&](size_t c, size_t excluded1, size_t excluded2) {
+            double maximum = 0.;
+            for (size_t i = k; i < front_size; i++) {
+               if (i != c && i != excluded1 && i != excluded2) {
+                  maximum = std::max(maximum, std::abs(entry(i, c)));
+               }
+            }
+            return maximum;
+         };
+
+         // pivot search among the remaining fully summed columns
+         size_t pivot_column = NativeLDLSolver::UNDEFINED;
+         size_t partner_column = NativeLDLSolver::UNDEFINED;
+         bool zero_pivot = false;
+         for (size_t c = k; c < number_fully_summed && pivot_column == NativeLDLSolver::UNDEFINED; c++) {
+            const double diagonal = std::abs(entry(c, c));
+            const double gamma = column_maximum(c, c, c);
+            if (diagonal <= this->zero_pivot_tolerance && gamma <= this->zero_pivot_tolerance) {
+               pivot_column = c;
+               zero_pivot = true;
+            }
+            else if (this->zero_pivot_tolerance < diagonal && this->pivot_tolerance * gamma <= diagonal) {
+               pivot_column = c;
+            }
+            else {
+               // 2x2 pivot with the largest fully summed entry of the column
+               size_t r = NativeLDLSolver::UNDEFINED;
+               double largest_entry = 0.;
+               for (size_t i = k; i < number_fully_summed; i++) {
+                  if (i != c && largest_entry < std::abs(entry(i, c))) {
+                     largest_entry = std::abs(entry(i, c));
+                     r = i;
+                  }
+               }
+               if (r != NativeLDLSolver::UNDEFINED) {
+                  const double a_cc = entry(c, c), a_rc = entry(r, c), a_rr = entry(r, r);
+                  const double determinant = std::abs(a_cc * a_rr - a_rc * a_rc);
+                  const double gamma_c = column_maximum(c, c, r);
+                  const double gamma_r = column_maximum(r, r, c);
+                  // the entries of the 2x2 multipliers are bounded by 1/pivot_tolerance
+                  if (this->zero_pivot_tolerance < determinant &&
+                        this->pivot_tolerance * (std::abs(a_rr) * gamma_c + std::abs(a_rc) * gamma_r) <= determinant &&
+                        this->pivot_tolerance * (std::abs(a_rc) * gamma_c + std::abs(a_cc) * gamma_r) <= determinant) {
+                     pivot_column = c;
+                     partner_column = r;
+                  }
+               }
+            }
+         }
+         if (pivot_column == NativeLDLSolver::UNDEFINED) {
+            if (not is_root) {
+               // delay the remaining fully summed columns to the parent front
+               break;
+            }
+            // no column can be delayed at a root: pivot on the next column regardless of the stability test. A zero pivot is
+            // recorded in D and counted in the inertia
+            pivot_column = k;
+            zero_pivot = (std::abs(entry(k, k)) <= this->zero_pivot_tolerance);
+            front.number_forced_pivots++;
+         }
+
+         if (partner_column == NativeLDLSolver::UNDEFINED) {
+            // 1x1 pivot
+            swap_symmetric(k, pivot_column);
+            double* F_k = F.data() + k * front_size;
+            if (zero_pivot) {
+               std::fill(F_k + k + 1, F_k + front_size, 0.);
+               front.D.emplace_back(0.);
+            }
+            else {
+               const double d = F_k[k];
+               // rank-1 update of the trailing block
+               for (size_t j = k + 1; j < front_size; j++) {
+                  const double l_j = F_k[j] / d;
+                  if (l_j != 0.) {
+                     double* F_j = F.data() + j * front_size;
+                     for (size_t i = j; i < front_size; i++) {
+                        F_j[i] -= F_k[i] * l_j;
+                     }
+                  }
+               }
+               for (size_t i = k + 1; i < front_size; i++) {
+                  F_k[i] /= d;
+               }
+               front.D.emplace_back(d);
+            }
+            front.off_diagonal_D.emplace_back(0.);
+            front.pivot_sizes.emplace_back(1);
+            k++;
+         }
+         else {
+            // 2x2 pivot
+            swap_symmetric(k, pivot_column);
+            if (partner_column == k) {
+               partner_column = pivot_column;
+            }
+            swap_symmetric(k + 1, partner_column);
+            double* F_k1 = F.data() + k * front_size;
+            double* F_k2 = F.data() + (k + 1) * front_size;
+            const double d11 = F_k1[k], d21 = F_k1[k + 1], d22 = F_k2[k + 1];
+            const double determinant = d11 * d22 - d21 * d21;
+            // rank-2 update of the trailing block
+            for (size_t j = k + 2; j < front_size; j++) {
+               const double w1 = F_k1[j], w2 = F_k2[j];
+               const double l1 = (d22 * w1 - d21 * w2) / determinant;
+               const double l2 = (d11 * w2 - d21 * w1) / determinant;
+               if (l1 != 0. || l2 != 0.) {
+                  double* F_j = F.data() + j * front_size;
+                  for (size_t i = j; i < front_size; i++) {
+                     F_j[i] -= F_k1[i] * l1 + F_k2[i] * l2;
+                  }
+               }
+            }
+            for (size_t i = k + 2; i < front_size; i++) {
+               const double w1 = F_k1[i], w2 = F_k2[i];
+               F_k1[i] = (d22 * w1 - d21 * w2) / determinant;
+               F_k2[i] = (d11 * w2 - d21 * w1) / determinant;
+            }
+            F_k1[k + 1] = 0.;
+            front.D.emplace_back(d11);
+            front.D.emplace_back(d22);
+            front.off_diagonal_D.emplace_back(d21);
+            front.off_diagonal_D.emplace_back(0.);
+            front.pivot_sizes.emplace_back(2);
+            front.pivot_sizes.emplace_back(0);
+            k += 2;
+         }
+      }
+      front.number_eliminated = k;
+      front.number_delayed = number_fully_summed - k;
+
+      // factors of the eliminated columns
+      front.L.assign(F.begin(), F.begin() + static_cast<std::ptrdiff_t>(front_size * k));
+      // contribution block (Schur complement of the eliminated columns)
+      const size_t contribution_size = front_size - k;
+      front.contribution.resize(contribution_size * contribution_size);
+      for (size_t j = 0; j < contribution_size; j++) {
+         for (size_t i = j; i < contribution_size; i++) {
+            front.contribution[i + j * contribution_size] = F[(k + i) + (k + j) * front_size];
+         }
+      }
+      for (size_t index: front.indices) {
+         local_positions[index] = NativeLDLSolver::UNDEFINED;
+      }
+   }
+
+   // tree-level parallelism: a front is factorized as soon as all its children are
+   void NativeLDLSolver::factorize_fronts_in_parallel(const double* values) {
+      const size_t number_supernodes = this->supernodes.size();
+      std::vector<size_t> remaining_children(number_supernodes);
+      std::deque<size_t> ready_supernodes{};
+      for (size_t supernode_index = 0; supernode_index < number_supernodes; supernode_index++) {
+         remaining_children[supernode_index] = this->supernodes[supernode_index].children.size();
+         if (remaining_children[supernode_index] == 0) {
+            ready_supernodes.emplace_back(supernode_index);
+         }
+      }
+      std::mutex mutex;
+      std::condition_variable condition;
+      size_t number_completed = 0;
+      bool has_failed = false;
+
+      // each task of the pool is a worker that factorizes the ready fronts until all the fronts are factorized. A worker only
+      // waits while another worker factorizes a front, therefore the tasks cannot deadlock if the pool runs them one after the other
+      const auto worker = [&](size_t /*task_index*/, size_t thread_index) {
+         std::vector<size_t>& local_positions = this->local_positions_per_thread[thread_index];
+         while (true) {
+            size_t supernode_index;
+            {
+               std::unique_lock<std::mutex> lock(mutex);
+               condition.wait(lock, [&]() {
+                  return not ready_supernodes.empty() || number_completed == number_supernodes || has_failed;
+               });
+               if (number_completed == number_supernodes || has_failed) {
+                  return;
+               }
+               supernode_index = ready_supernodes.front();
+               ready_supernodes.pop_front();
+            }
+            try {
+               this->factorize_front(supernode_index, values, local_positions);
+            }
+            catch (...) {
+               // wake up the other workers; the pool rethrows the exception
+               {
+                  std::lock_guard<std::mutex> lock(mutex);
+                  has_failed = true;
+               }
+               condition.notify_all();
+               throw;
+            }
+            {
+               std::lock_guard<std::mutex> lock(mutex);
+               number_completed++;
+               const size_t parent = this->supernodes[supernode_index].parent;
+               if (parent != NativeLDLSolver::UNDEFINED) {
+                  remaining_children[parent]--;
+                  if (remaining_children[parent] == 0) {
+                     ready_supernodes.emplace_back(parent);
+                  }
+               }
+            }
+            condition.notify_all();
+         }
+      };
+      this->thread_pool->parallel_for(std::min(this->thread_pool->size(), number_supernodes), worker);
+   }
+
+   // inertia of the block diagonal factor D (Sylvester's law of inertia)
+   void NativeLDLSolver::compute_inertia() {
+      this->number_positive = 0;
+      this->number_negative = 0;
+      this->number_zero = 0;
+      this->number_forced_pivots = 0;
+      for (const Front& front: this->fronts) {
+         this->number_forced_pivots += front.number_forced_pivots;
+         for (size_t k = 0; k < front.number_eliminated; k++) {
+            if (front.pivot_sizes[k] == 1) {
+               if (front.D[k] == 0.) {
+                  this->number_zero++;
+               }
+               else if (0. < front.D[k]) {
+                  this->number_positive++;
+               }
+               else {
+                  this->number_negative++;
+               }
+            }
+            else if (front.pivot_sizes[k] == 2) {
+               const double determinant = front.D[k] * front.D[k + 1] - front.off_diagonal_D[k] * front.off_diagonal_D[k];
+               if (determinant < 0.) {
+                  this->number_positive++;
+                  this->number_negative++;
+               }
+               else if (0. < front.D[k] + front.D[k + 1]) {
+                  this->number_positive += 2;
+               }
+               else {
+                  this->number_negative += 2;
+               }
+            }
+         }
+      }
+   }
+
+   // postorder of a forest given by its parent array
+   std::vector<size_t> NativeLDLSolver::compute_postorder(const std::vector<size_t>& parent) {
+      const size_t n = parent.size();
+      std::vector<size_t> first_child(n, NativeLDLSolver::UNDEFINED);
+      std::vector<size_t> next_sibling(n, NativeLDLSolver::UNDEFINED);
+      for (size_t node = n; 0 < node; node--) {
+         if (parent[node - 1] != NativeLDLSolver::UNDEFINED) {
+            next_sibling[node - 1] = first_child[parent[node - 1]];
+            first_child[parent[node - 1]] = node - 1;
+         }
+      }
+      std::vector<size_t> postorder{};
+      postorder.reserve(n);
+      std::vector<size_t> stack{};
+      for (size_t root = 0; root < n; root++) {
+         if (parent[root] == NativeLDLSolver::UNDEFINED) {
+            stack.emplace_back(root);
+            while (not stack.empty()) {
+               const size_t node = stack.back();
+               const size_t child = first_child[node];
+               if (child == NativeLDLSolver::UNDEFINED) {
+                  postorder.emplace_back(node);
+                  stack.pop_back();
+               }
+               else {
+                  first_child[node] = next_sibling[child];
+                  stack.emplace_back(child);
+               }
+            }
+         }
+      }
+      return postorder;
+   }
+} // namespace
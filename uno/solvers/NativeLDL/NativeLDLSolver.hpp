@@ -0,0 +1,111 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_NATIVELDLSOLVER_H
+#define UNO_NATIVELDLSOLVER_H
+
+#include <limits>
+#include <memory>
+#include <vector>
+#include "solvers/DirectSymmetricIndefiniteLinearSolver.hpp"
+
+namespace uno {
+   // forward declarations
+   class Options;
+   class ThreadPool;
+   template <typename ElementType>
+   class Vector;
+
+   /*! \class NativeLDLSolver
+    * \brief In-tree multifrontal LDL^T factorization
+    *
+    *  Sparse symmetric indefinite solver with no external dependency:
+    *  - symbolic factorization: fill-reducing ordering (AMD by default), postordered elimination tree and fundamental supernodes
+    *  - numerical factorization: multifrontal method with threshold Bunch-Kaufman pivoting (1x1 and 2x2 pivots) inside
+    *    the fully summed block of each front. Columns that cannot be pivoted stably are delayed to the parent front; at a root,
+    *    the pivot is forced and a zero pivot makes the matrix singular.
+    *    Independent subtrees of the assembly tree are factorized in parallel by a persistent thread pool when several threads
+    *    are requested
+    *  - the inertia is read off the block diagonal factor D
+    */
+   class NativeLDLSolver : public DirectSymmetricIndefiniteLinearSolver<size_t, double> {
+   public:
+      NativeLDLSolver(size_t dimension, size_t number_nonzeros, const Options& options);
+      ~NativeLDLSolver() override;
+
+      void factorize(const SymmetricMatrix<size_t, double>& matrix) override;
+      void do_symbolic_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
+      void do_numerical_factorization(const SymmetricMatrix<size_t, double>& matrix) override;
+      void solve_indefinite_system(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result) override;
+      void solve_indefinite_systems(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, Vector<double>& result,
+            size_t number_rhs) override;
+
+      [[nodiscard]] std::tuple<size_t, size_t, size_t> get_inertia() const override;
+      [[nodiscard]] size_t number_negative_eigenvalues() const override;
+      [[nodiscard]] bool matrix_is_singular() const override;
+      [[nodiscard]] size_t rank() const override;
+
+   private:
+      static constexpr size_t UNDEFINED{std::numeric_limits<size_t>::max()};
+
+      // set of consecutive columns (in the permuted ordering) with the same structure below the diagonal block
+      struct Supernode {
+         size_t first_column{};
+         size_t end_column{}; // past-the-end
+         std::vector<size_t> structure{}; // rows below the diagonal block (sorted)
+         size_t parent{UNDEFINED};
+         std::vector<size_t> children{};
+      };
+
+      // numerical factor of a supernode
+      struct Front {
+         std::vector<size_t> indices{}; // permuted indices of the front rows: eliminated, then delayed, then remaining rows
+         size_t number_eliminated{0};
+         size_t number_delayed{0};
+         std::vector<double> L{}; // unit lower triangular factor: column-major, |indices| x number_eliminated
+         std::vector<double> D{}; // block diagonal factor: for a 2x2 pivot (k, k+1), D[k] = d11, D[k+1] = d22 and off_diagonal_D[k] = d21
+         std::vector<double> off_diagonal_D{};
+         std::vector<size_t> pivot_sizes{}; // 1, or 2 for the first column of a 2x2 pivot and 0 for the second one
+         size_t number_forced_pivots{0}; // pivots of a root front that failed the stability test
+         std::vector<double> contribution{}; // Schur complement on indices[number_eliminated:], released once assembled
+      };
+
+      const double pivot_tolerance;
+      const double zero_pivot_tolerance;
+      const size_t number_threads;
+      // created once when several threads are requested, and reused by all the numerical factorizations
+      std::unique_ptr<ThreadPool> thread_pool{};
+
+      // symbolic factorization
+      size_t analyzed_dimension{0};
+      size_t analyzed_number_nonzeros{0};
+      std::vector<size_t> permutation{}; // permutation[new index] = original index
+      std::vector<size_t> inverse_permutation{}; // inverse_permutation[original index] = new index
+      // original entries of the permuted lower triangle: column j contains the pairs (row, position in the array of values)
+      std::vector<size_t> column_starts{};
+      std::vector<size_t> entry_rows{};
+      std::vector<size_t> entry_positions{};
+      std::vector<Supernode> supernodes{}; // postordered: children before their parent
+
+      // numerical factorization
+      std::vector<Front> fronts{};
+      // per-thread map from permuted index to local position in the current front (UNDEFINED outside of it)
+      std::vector<std::vector<size_t>> local_positions_per_thread{};
+      size_t number_positive{0};
+      size_t number_negative{0};
+      size_t number_zero{0};
+      size_t number_forced_pivots{0};
+      std::vector<double> solve_workspace{}; // row-major block of the permuted right-hand sides
+
+      void build_permuted_lower_triangle(const SymmetricMatrix<size_t, double>& matrix);
+      [[nodiscard]] std::vector<size_t> compute_elimination_tree() const;
+      void compute_supernodes(const std::vector<size_t>& parent);
+      void factorize_front(size_t supernode_index, const double* values, std::vector<size_t>& local_positions);
+      void factorize_fronts_in_parallel(const double* values);
+      void compute_inertia();
+
+      static std::vector<size_t> compute_postorder(const std::vector<size_t>& parent);
+   };
+} // namespace
+
+#endif // UNO_NATIVELDLSOLVER_H
@@ -11,6 +11,8 @@ namespace uno {
    // forward declarations
    class Direction;
    template <typename ElementType>
+   class LowRankCorrection;
+   template <typename ElementType>
    class RectangularMatrix;
    template <typename ElementType>
    class SparseVector;
@@ -38,6 +40,12 @@ namespace uno {
             const std::vector<double>& constraints_upper_bounds, const SparseVector<double>& linear_objective,
             const RectangularMatrix<double>& constraint_jacobian, const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& initial_point,
             Direction& direction, const WarmstartInformation& warmstart_information) = 0;
+
+      // low-rank correction added to the Hessian in the products with the Hessian (quasi-Newton models in compact form)
+      void set_hessian_correction(const LowRankCorrection<double>* correction) { this->hessian_correction = correction; }
+
+   protected:
+      const LowRankCorrection<double>* hessian_correction{nullptr};
    };
 } // namespace
 
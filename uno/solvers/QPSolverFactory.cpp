@@ -6,10 +6,15 @@
 #include "linear_algebra/Vector.hpp"
 #include "options/Options.hpp"
 #include "solvers/QPSolver.hpp"
+#include "solvers/ActiveSetQP/ActiveSetQPSolver.hpp"
+#include "solvers/InteriorPointQP/InteriorPointQPSolver.hpp"
 
 #ifdef HAS_BQPD
 #include "solvers/BQPD/BQPDSolver.hpp"
 #endif
+#ifdef HAS_HIGHS
+#include "solvers/HiGHS/HiGHSSolver.hpp"
+#endif
 
 namespace uno {
    std::unique_ptr<QPSolver> QPSolverFactory::create([[maybe_unused]] size_t number_variables, [[maybe_unused]] size_t number_constraints,
@@ -23,6 +28,19 @@ namespace uno {
                   number_hessian_nonzeros, BQPDProblemType::QP, options);
          }
 #endif
+#ifdef HAS_HIGHS
+         if (QP_solver_name == "HiGHS") {
+            return std::make_unique<HiGHSSolver>(number_variables, number_constraints, number_jacobian_nonzeros, number_hessian_nonzeros, options);
+         }
+#endif
+         if (QP_solver_name == "active_set") {
+            return std::make_unique<ActiveSetQPSolver>(number_variables, number_constraints, number_jacobian_nonzeros, number_hessian_nonzeros,
+                  options);
+         }
+         if (QP_solver_name == "interior_point") {
+            return std::make_unique<InteriorPointQPSolver>(number_variables, number_constraints, number_jacobian_nonzeros, number_hessian_nonzeros,
+                  options);
+         }
          std::string message = "The QP solver ";
          message.append(QP_solver_name).append(" is unknown").append("\n").append("The following values are available: ")
                .append(join(QPSolverFactory::available_solvers(), ", "));
@@ -41,6 +59,23 @@ namespace uno {
 #ifdef HAS_BQPD
       solvers.emplace_back("BQPD");
 #endif
+#ifdef HAS_HIGHS
+      solvers.emplace_back("HiGHS");
+#endif
+      solvers.emplace_back("active_set");
+      solvers.emplace_back("interior_point");
       return solvers;
    }
+
+   // BQPD finds local solutions of nonconvex QPs, HiGHS and the in-tree solvers require a positive semidefinite Hessian
+   bool QPSolverFactory::requires_convex_hessian(const Options& options) {
+      try {
+         const std::string& QP_solver_name = options.get_string("QP_solver");
+         return (QP_solver_name == "HiGHS" || QP_solver_name == "active_set" || QP_solver_name == "interior_point");
+      }
+      catch (const std::out_of_range&) {
+         // no QP solver available: the error is reported when the QP solver is created
+         return false;
+      }
+   }
 } // namespace
@@ -21,6 +21,9 @@ namespace uno {
 
       // return the list of available QP solvers
       static std::vector<std::string> available_solvers();
+
+      // whether the QP solver can only solve convex QPs
+      static bool requires_convex_hessian(const Options& options);
    };
 } // namespace
 
@@ -7,6 +7,9 @@
 #include "DirectSymmetricIndefiniteLinearSolver.hpp"
 #include "linear_algebra/Vector.hpp"
 #include "options/Options.hpp"
+#include "ordering/FillReducingOrdering.hpp"
+#include "solvers/MINRES/MINRESSolver.hpp"
+#include "solvers/NativeLDL/NativeLDLSolver.hpp"
 
 #if defined(HAS_HSL) || defined(HAS_MA57)
 #include "solvers/MA57/MA57Solver.hpp"
@@ -27,6 +30,17 @@ namespace uno {
 namespace uno {
    std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> SymmetricIndefiniteLinearSolverFactory::create([[maybe_unused]] size_t dimension,
          [[maybe_unused]] size_t number_nonzeros, const Options& options) {
+      auto linear_solver = SymmetricIndefiniteLinearSolverFactory::create_backend(dimension, number_nonzeros, options);
+      // user-selected fill-reducing ordering
+      const std::string& ordering_name = options.get_string("linear_solver_ordering");
+      if (ordering_name != "solver") {
+         linear_solver->set_ordering(FillReducingOrderingFactory::create(ordering_name));
+      }
+      return linear_solver;
+   }
+
+   std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> SymmetricIndefiniteLinearSolverFactory::create_backend(
+         [[maybe_unused]] size_t dimension, [[maybe_unused]] size_t number_nonzeros, const Options& options) {
       try {
          [[maybe_unused]] const std::string& linear_solver_name = options.get_string("linear_solver");
 #if defined(HAS_HSL) || defined(HAS_MA57)
@@ -43,6 +57,12 @@ namespace uno {
             return std::make_unique<MUMPSSolver>(dimension, number_nonzeros);
          }
 #endif
+         if (linear_solver_name == "native_LDL") {
+            return std::make_unique<NativeLDLSolver>(dimension, number_nonzeros, options);
+         }
+         if (linear_solver_name == "MINRES") {
+            return std::make_unique<MINRESSolver>(dimension, options);
+         }
          std::string message = "The linear solver ";
          message.append(linear_solver_name).append(" is unknown").append("\n").append("The following values are available: ")
                .append(join(SymmetricIndefiniteLinearSolverFactory::available_solvers(), ", "));
@@ -69,6 +89,8 @@ namespace uno {
 #ifdef HAS_MUMPS
       solvers.emplace_back("MUMPS");
 #endif
+      solvers.emplace_back("native_LDL");
+      solvers.emplace_back("MINRES");
       return solvers;
    }
 } // namespace
\ No newline at end of file
@@ -5,6 +5,7 @@
 #define UNO_LINEARSOLVERFACTORY_H
 
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace uno {
@@ -20,6 +21,10 @@ namespace uno {
 
       // return the list of available solvers
       static std::vector<std::string> available_solvers();
+
+   protected:
+      static std::unique_ptr<DirectSymmetricIndefiniteLinearSolver<size_t, double>> create_backend([[maybe_unused]] size_t dimension,
+            [[maybe_unused]] size_t number_nonzeros, const Options& options);
    };
 } // namespace
 
@@ -4,9 +4,18 @@
 #ifndef UNO_MATRIXVECTORPRODUCT_H
 #define UNO_MATRIXVECTORPRODUCT_H
 
+#include <type_traits>
+#include "linear_algebra/SparseKernels.hpp"
 #include "linear_algebra/SparseVector.hpp"
 
 namespace uno {
+   // whether a vector stores its elements contiguously
+   template <typename Vector, typename = void>
+   struct has_contiguous_data: std::false_type { };
+
+   template <typename Vector>
+   struct has_contiguous_data<Vector, std::void_t<decltype(std::declval<const Vector&>().data())>>: std::true_type { };
+
    // symbolic matrix-vector product
    template <typename Matrix, typename Vector>
    class MatrixVectorProduct {
@@ -17,9 +26,15 @@ namespace uno {
 
       [[nodiscard]] constexpr size_t size() const { return this->vector.size(); }
 
-      // product computed using row-major matrix
+      // product computed using row-major matrix. The rows of a RectangularMatrix use the sparse kernel when the vector is contiguous
       [[nodiscard]] typename MatrixVectorProduct::value_type operator[](size_t row_index) const {
-         return dot(this->vector, this->matrix[row_index]);
+         if constexpr (std::is_same_v<std::decay_t<Matrix>, RectangularMatrix<value_type>> &&
+               has_contiguous_data<std::remove_reference_t<Vector>>::value) {
+            return sparse_row_dot(this->matrix[row_index], this->vector.data());
+         }
+         else {
+            return dot(this->vector, this->matrix[row_index]);
+         }
       }
 
    protected:
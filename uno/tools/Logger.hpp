@@ -12,12 +12,29 @@ namespace uno {
        SILENT = 0, DISCRETE, WARNING, INFO, DEBUG, DEBUG2, DEBUG3
    };
 
+   // the level is per thread: concurrent solves may use different levels
    class Logger {
    public:
-       static Level level;
+       static thread_local Level level;
        static void set_logger(const std::string& logger_level);
    };
 
+   // sets the level of the current thread and restores the previous level when it goes out of scope
+   class ScopedLoggerLevel {
+   public:
+      explicit ScopedLoggerLevel(const std::string& logger_level): previous_level(Logger::level) {
+         Logger::set_logger(logger_level);
+      }
+      ~ScopedLoggerLevel() {
+         Logger::level = this->previous_level;
+      }
+      ScopedLoggerLevel(const ScopedLoggerLevel&) = delete;
+      ScopedLoggerLevel& operator=(const ScopedLoggerLevel&) = delete;
+
+   protected:
+      const Level previous_level;
+   };
+
    template <typename T>
    const Level& operator<<(const Level& level, T& element) {
       if (level <= Logger::level) {
@@ -8,12 +8,6 @@
 #include "options/Options.hpp"
 
 namespace uno {
-   // TODO move this to the option file
-   int Statistics::int_width = 7;
-   int Statistics::double_width = 17;
-   int Statistics::string_width = 26;
-   int Statistics::numerical_format_size = 6;
-
    Statistics::Statistics(const Options& options): print_header_frequency(options.get_unsigned_int("statistics_print_header_frequency")) { }
 
    void Statistics::add_column(std::string_view name, int width, int order) {
@@ -133,7 +127,8 @@ namespace uno {
    }
    
    std::string_view Statistics::symbol(std::string_view value) {
-      static std::map<std::string_view, std::string_view> symbols = {
+      // read-only: the table can be shared by concurrent solves
+      static const std::map<std::string_view, std::string_view> symbols = {
             {"top", "─"},
             {"top-mid", "┬"},
             {"top-left", "┌"},
@@ -150,6 +145,6 @@ namespace uno {
             {"right-mid", "┤"},
             {"middle", "│"}
       };
-      return symbols[value];
+      return symbols.at(value);
    }
 } // namespace
@@ -15,10 +15,11 @@ namespace uno {
    public:
       explicit Statistics(const Options& options);
 
-      static int int_width;
-      static int double_width;
-      static int string_width;
-      static int numerical_format_size;
+      // TODO move this to the option file
+      static constexpr int int_width = 7;
+      static constexpr int double_width = 17;
+      static constexpr int string_width = 26;
+      static constexpr int numerical_format_size = 6;
 
       void add_column(std::string_view name, int width, int order);
       void start_new_line();
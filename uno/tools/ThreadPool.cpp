@@ -0,0 +1,105 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include "ThreadPool.hpp"
+
+namespace uno {
+   ThreadPool::ThreadPool(size_t number_threads) {
+      const size_t number_workers = std::max(size_t(1), number_threads) - 1;
+      this->workers.reserve(number_workers);
+      for (size_t thread_index = 1; thread_index <= number_workers; thread_index++) {
+         this->workers.emplace_back(&ThreadPool::run_worker, this, thread_index);
+      }
+   }
+
+   ThreadPool::~ThreadPool() {
+      {
+         std::lock_guard<std::mutex> lock(this->mutex);
+         this->stopping = true;
+      }
+      this->work_available.notify_all();
+      for (std::thread& worker: this->workers) {
+         worker.join();
+      }
+   }
+
+   void ThreadPool::parallel_for(size_t number_tasks, const std::function<void(size_t, size_t)>& task) {
+      if (number_tasks == 0) {
+         return;
+      }
+      // sequential execution
+      if (this->workers.empty() || number_tasks == 1) {
+         for (size_t task_index = 0; task_index < number_tasks; task_index++) {
+            task(task_index, 0);
+         }
+         return;
+      }
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->task = &task;
+      this->number_tasks = number_tasks;
+      this->next_task = 0;
+      this->number_completed_tasks = 0;
+      this->exception = nullptr;
+      this->batch_index++;
+      this->logger_level = Logger::level;
+      this->work_available.notify_all();
+      this->execute_tasks(lock, 0);
+      this->work_completed.wait(lock, [&]() {
+         return this->number_completed_tasks == this->number_tasks;
+      });
+      this->task = nullptr;
+      if (this->exception != nullptr) {
+         std::exception_ptr task_exception = this->exception;
+         this->exception = nullptr;
+         std::rethrow_exception(task_exception);
+      }
+   }
+
+   size_t ThreadPool::number_threads_from_option(size_t option_value) {
+      return (option_value == 0) ? static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())) : option_value;
+   }
+
+   void ThreadPool::run_worker(size_t thread_index) {
+      size_t last_batch_index = 0;
+      std::unique_lock<std::mutex> lock(this->mutex);
+      while (true) {
+         this->work_available.wait(lock, [&]() {
+            return this->stopping || (this->task != nullptr && this->batch_index != last_batch_index);
+         });
+         if (this->stopping) {
+            return;
+         }
+         last_batch_index = this->batch_index;
+         Logger::level = this->logger_level;
+         this->execute_tasks(lock, thread_index);
+      }
+   }
+
+   // the tasks are handed out one at a time (dynamic scheduling). The lock is released while a task runs
+   void ThreadPool::execute_tasks(std::unique_lock<std::mutex>& lock, size_t thread_index) {
+      const std::function<void(size_t, size_t)>& current_task = *this->task;
+      while (this->next_task < this->number_tasks) {
+         const size_t task_index = this->next_task++;
+         // the remaining tasks are skipped after an exception
+         if (this->exception == nullptr) {
+            lock.unlock();
+            try {
+               current_task(task_index, thread_index);
+            }
+            catch (...) {
+               lock.lock();
+               if (this->exception == nullptr) {
+                  this->exception = std::current_exception();
+               }
+               lock.unlock();
+            }
+            lock.lock();
+         }
+         this->number_completed_tasks++;
+         if (this->number_completed_tasks == this->number_tasks) {
+            this->work_completed.notify_all();
+         }
+      }
+   }
+} // namespace
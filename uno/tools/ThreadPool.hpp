@@ -0,0 +1,54 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_THREADPOOL_H
+#define UNO_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "tools/Logger.hpp"
+
+namespace uno {
+   // persistent pool of worker threads. parallel_for(number_tasks, task) calls task(task_index, thread_index) for each task index
+   // and blocks until all the tasks are completed. The calling thread participates with thread index 0; the thread index
+   // (< size()) can be used to select per-thread resources. The first exception thrown by a task is rethrown by parallel_for.
+   // The workers run the tasks with the logger level of the calling thread.
+   class ThreadPool {
+   public:
+      explicit ThreadPool(size_t number_threads);
+      ~ThreadPool();
+      ThreadPool(const ThreadPool&) = delete;
+      ThreadPool& operator=(const ThreadPool&) = delete;
+
+      [[nodiscard]] size_t size() const { return this->workers.size() + 1; }
+      void parallel_for(size_t number_tasks, const std::function<void(size_t /*task_index*/, size_t /*thread_index*/)>& task);
+
+      // number of threads from an option value (0: number of hardware threads)
+      [[nodiscard]] static size_t number_threads_from_option(size_t option_value);
+
+   protected:
+      std::vector<std::thread> workers{};
+      std::mutex mutex;
+      std::condition_variable work_available;
+      std::condition_variable work_completed;
+      // current batch of tasks
+      const std::function<void(size_t, size_t)>* task{nullptr};
+      size_t number_tasks{0};
+      size_t next_task{0};
+      size_t number_completed_tasks{0};
+      size_t batch_index{0};
+      Level logger_level{INFO};
+      std::exception_ptr exception{nullptr};
+      bool stopping{false};
+
+      void run_worker(size_t thread_index);
+      void execute_tasks(std::unique_lock<std::mutex>& lock, size_t thread_index);
+   };
+} // namespace
+
+#endif // UNO_THREADPOOL_H
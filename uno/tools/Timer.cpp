@@ -2,20 +2,23 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include "Timer.hpp"
-#include <chrono>
 #include <ctime>
+#include <mutex>
 
 namespace uno {
-   Timer::Timer(): start_time(std::clock()) {
+   Timer::Timer(): start_time(std::chrono::steady_clock::now()) {
    }
 
    double Timer::get_duration() const {
-      return static_cast<double>(std::clock() - this->start_time) / static_cast<double>(CLOCKS_PER_SEC);
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - this->start_time).count();
    }
 
-   char* Timer::get_current_date() {
+   std::string Timer::get_current_date() {
+      // std::ctime returns a static buffer
+      static std::mutex mutex;
       const auto current_time = std::chrono::system_clock::now();
       const auto formatted_current_time = std::chrono::system_clock::to_time_t(current_time);
+      std::lock_guard<std::mutex> lock(mutex);
       return std::ctime(&formatted_current_time);
    }
 } // namespace
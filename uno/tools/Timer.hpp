@@ -4,18 +4,19 @@
 #ifndef UNO_TIMER_H
 #define UNO_TIMER_H
 
-#include <ctime>
+#include <chrono>
+#include <string>
 
 namespace uno {
-   // timer starts upon creation
+   // timer starts upon creation. The elapsed (wall-clock) time is measured: the process CPU time would include the concurrent solves
    class Timer {
    public:
       Timer();
       [[nodiscard]] double get_duration() const;
-      [[nodiscard]] static char* get_current_date();
+      [[nodiscard]] static std::string get_current_date();
 
    private:
-      std::clock_t start_time;
+      std::chrono::steady_clock::time_point start_time;
    };
 } // namespace
 
@@ -0,0 +1,45 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_BENCHMARK_H
+#define UNO_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+
+namespace uno::benchmark {
+   // best wall-clock time (in seconds) over several repetitions
+   template <typename Function>
+   double best_time(Function&& function, size_t number_repetitions = 5) {
+      double best = std::numeric_limits<double>::infinity();
+      for (size_t repetition = 0; repetition < number_repetitions; repetition++) {
+         const auto start = std::chrono::steady_clock::now();
+         function();
+         const auto end = std::chrono::steady_clock::now();
+         best = std::min(best, std::chrono::duration<double>(end - start).count());
+      }
+      return best;
+   }
+
+   inline void report(const std::string& name, double time, double reference_time = 0.) {
+      std::cout << "   " << std::left << std::setw(55) << name << std::right << std::setw(10) << std::fixed << std::setprecision(2) <<
+         1e3 * time << " ms";
+      if (0. < reference_time) {
+         std::cout << "   (speedup " << std::setprecision(2) << reference_time / time << "x)";
+      }
+      std::cout << '\n' << std::defaultfloat;
+   }
+
+   inline void check(double result, double reference) {
+      if (1e-10 * std::max(1., std::abs(reference)) < std::abs(result - reference)) {
+         std::cout << "   WARNING: results differ (" << result << " vs " << reference << ")\n";
+      }
+   }
+} // namespace
+
+#endif // UNO_BENCHMARK_H
@@ -0,0 +1,85 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <cmath>
+#include <iostream>
+#include "Benchmark.hpp"
+#include "linear_algebra/Norm.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "solvers/NativeLDL/NativeLDLSolver.hpp"
+
+using namespace uno;
+
+namespace {
+   // KKT matrix [H J^T; J -δI] where H is a 5-point Laplacian on a grid and J couples neighboring pairs of variables
+   void fill_KKT_matrix(SymmetricMatrix<size_t, double>& matrix, size_t grid_size) {
+      const size_t number_variables = grid_size * grid_size;
+      for (size_t i = 0; i < grid_size; i++) {
+         for (size_t j = 0; j < grid_size; j++) {
+            const size_t vertex = i * grid_size + j;
+            matrix.insert(4., vertex, vertex);
+            if (j + 1 < grid_size) {
+               matrix.insert(-1., vertex, vertex + 1);
+            }
+            if (i + 1 < grid_size) {
+               matrix.insert(-1., vertex, vertex + grid_size);
+            }
+         }
+      }
+      const size_t number_constraints = number_variables / 2;
+      for (size_t constraint_index = 0; constraint_index < number_constraints; constraint_index++) {
+         const size_t row_index = number_variables + constraint_index;
+         matrix.insert(1., 2 * constraint_index, row_index);
+         matrix.insert(-1., 2 * constraint_index + 1, row_index);
+         matrix.insert(-1e-8, row_index, row_index);
+      }
+   }
+
+   void run(size_t grid_size, size_t number_rhs) {
+      const size_t number_variables = grid_size * grid_size;
+      const size_t n = number_variables + number_variables / 2;
+      const size_t nnz = 3 * number_variables + 3 * (number_variables / 2);
+      SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+      fill_KKT_matrix(matrix, grid_size);
+      std::cout << "KKT matrix of dimension " << n << " with " << matrix.number_nonzeros() << " nonzeros, " << number_rhs << " right-hand sides\n";
+
+      const Options options = DefaultOptions::load();
+      NativeLDLSolver solver(n, nnz, options);
+      const double time_factorization = benchmark::best_time([&]() {
+         solver.factorize(matrix);
+      }, 1);
+      benchmark::report("symbolic + numerical factorization", time_factorization);
+
+      Vector<double> rhs(n * number_rhs);
+      for (size_t index = 0; index < n * number_rhs; index++) {
+         rhs[index] = std::sin(static_cast<double>(index));
+      }
+      Vector<double> result(n * number_rhs);
+      Vector<double> column_rhs(n), column_result(n);
+      const double time_single_solves = benchmark::best_time([&]() {
+         for (size_t rhs_index = 0; rhs_index < number_rhs; rhs_index++) {
+            for (size_t index = 0; index < n; index++) {
+               column_rhs[index] = rhs[rhs_index * n + index];
+            }
+            solver.solve_indefinite_system(matrix, column_rhs, column_result);
+            for (size_t index = 0; index < n; index++) {
+               result[rhs_index * n + index] = column_result[index];
+            }
+         }
+      });
+      const double reference = norm_1(result);
+      const double time_blocked_solve = benchmark::best_time([&]() {
+         solver.solve_indefinite_systems(matrix, rhs, result, number_rhs);
+      });
+      benchmark::report("repeated single solves", time_single_solves);
+      benchmark::report("blocked multi-RHS solve", time_blocked_solve, time_single_solves);
+      benchmark::check(norm_1(result), reference);
+   }
+} // namespace
+
+void run_native_LDL_benchmark() {
+   run(150, 16);
+}
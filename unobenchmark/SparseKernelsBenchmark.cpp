@@ -0,0 +1,108 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "Benchmark.hpp"
+#include "linear_algebra/Norm.hpp"
+#include "linear_algebra/SparseKernels.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/Expression.hpp"
+#include "symbolic/MatrixVectorProduct.hpp"
+#include "symbolic/VectorExpression.hpp"
+
+using namespace uno;
+
+namespace {
+   // pseudo-random Jacobian pattern with a fixed number of nonzeros per row
+   void fill_jacobian(RectangularMatrix<double>& jacobian, size_t number_rows, size_t number_columns, size_t nonzeros_per_row) {
+      jacobian.clear();
+      for (size_t row_index: Range(number_rows)) {
+         for (size_t k: Range(nonzeros_per_row)) {
+            const size_t column_index = (row_index * 7919 + k * (k + 13) * 104729) % number_columns;
+            jacobian.insert(1. / static_cast<double>(1 + row_index + k), row_index, column_index);
+         }
+      }
+      // fix the pattern
+      jacobian.finalize_pattern();
+   }
+
+   double violation(double value) {
+      return std::max(0., value);
+   }
+
+   void run(size_t number_rows, size_t number_columns, size_t nonzeros_per_row) {
+      RectangularMatrix<double> jacobian(number_rows, number_columns);
+      fill_jacobian(jacobian, number_rows, number_columns, nonzeros_per_row);
+      Vector<double> direction(number_columns);
+      for (size_t index: Range(number_columns)) {
+         direction[index] = 1. - 2. / static_cast<double>(index + 1);
+      }
+      std::vector<double> constraints(number_rows);
+      for (size_t index: Range(number_rows)) {
+         constraints[index] = (index % 2 == 0) ? -0.5 : 0.5;
+      }
+      const double step_length = 0.7;
+      std::cout << "Jacobian with " << number_rows << " rows, " << number_columns << " columns and " << jacobian.number_nonzeros() << " nonzeros\n";
+
+      // J*d
+      Vector<double> product(number_rows);
+      const double time_expression_product = benchmark::best_time([&]() {
+         product = jacobian * direction;
+      });
+      const double reference_product = norm_1(product);
+      const double time_kernel_product = benchmark::best_time([&]() {
+         matrix_vector_product(jacobian, direction, product);
+      });
+      benchmark::report("J*d (expression template)", time_expression_product);
+      benchmark::report("J*d (kernel)", time_kernel_product, time_expression_product);
+      benchmark::check(norm_1(product), reference_product);
+
+      // J^T y
+      Vector<double> transposed_product(number_columns);
+      const double time_loop_transposed = benchmark::best_time([&]() {
+         transposed_product.fill(0.);
+         for (size_t row_index: Range(number_rows)) {
+            if (constraints[row_index] != 0.) {
+               for (const auto [column_index, derivative]: jacobian[row_index]) {
+                  transposed_product[column_index] -= constraints[row_index] * derivative;
+               }
+            }
+         }
+      });
+      const double reference_transposed = norm_1(transposed_product);
+      const double time_kernel_transposed = benchmark::best_time([&]() {
+         transposed_product.fill(0.);
+         transposed_matrix_vector_product(jacobian, constraints, -1., transposed_product);
+      });
+      benchmark::report("J^T y (row loop)", time_loop_transposed);
+      benchmark::report("J^T y (kernel)", time_kernel_transposed, time_loop_transposed);
+      benchmark::check(norm_1(transposed_product), reference_transposed);
+
+      // ||v(c + α J d)||_1
+      double reference_residual = 0.;
+      const double time_expression_residual = benchmark::best_time([&]() {
+         const auto linearized_constraints = constraints + step_length * (jacobian * direction);
+         const Range rows_range = Range(number_rows);
+         const VectorExpression linearized_violation{rows_range, [&](size_t row_index) {
+            return violation(linearized_constraints[row_index]);
+         }};
+         reference_residual = norm(Norm::L1, linearized_violation);
+      });
+      double residual = 0.;
+      const double time_kernel_residual = benchmark::best_time([&]() {
+         residual = linearized_residual_norm(Norm::L1, constraints, step_length, jacobian, direction, [](double value, size_t /*row_index*/) {
+            return violation(value);
+         });
+      });
+      benchmark::report("||v(c + a J d)||_1 (expression template)", time_expression_residual);
+      benchmark::report("||v(c + a J d)||_1 (fused kernel)", time_kernel_residual, time_expression_residual);
+      benchmark::check(residual, reference_residual);
+   }
+} // namespace
+
+void run_sparse_kernels_benchmark() {
+   run(200000, 100000, 5);
+   run(20000, 20000, 60);
+}
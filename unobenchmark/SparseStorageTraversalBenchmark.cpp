@@ -0,0 +1,83 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Benchmark.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+
+using namespace uno;
+
+namespace {
+   // pseudo-random banded pattern with a fixed number of nonzeros per column (lower triangle)
+   void fill_matrix(SymmetricMatrix<size_t, double>& matrix, size_t dimension, size_t nonzeros_per_column) {
+      for (size_t column_index: Range(dimension)) {
+         for (size_t k: Range(nonzeros_per_column)) {
+            const size_t row_index = std::min(dimension - 1, column_index + k * (k + 7));
+            matrix.insert(1. / static_cast<double>(1 + row_index + column_index), row_index, column_index);
+         }
+         matrix.finalize_column(column_index);
+      }
+   }
+
+   // reference: traversal through the virtual iterator of SparseStorage
+   double quadratic_product_with_iterator(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& x) {
+      double result = 0.;
+      for (const auto [row_index, column_index, element]: matrix) {
+         result += (row_index == column_index) ? element * x[row_index] * x[row_index] : 2. * element * x[row_index] * x[column_index];
+      }
+      return result;
+   }
+
+   void run(const std::string& sparse_format, size_t dimension, size_t nonzeros_per_column) {
+      SymmetricMatrix<size_t, double> matrix(dimension, dimension * nonzeros_per_column, false, sparse_format);
+      fill_matrix(matrix, dimension, nonzeros_per_column);
+      Vector<double> x(dimension);
+      for (size_t index: Range(dimension)) {
+         x[index] = 1. + 1. / static_cast<double>(index + 1);
+      }
+      std::cout << sparse_format << " matrix with " << matrix.number_nonzeros() << " nonzeros\n";
+
+      double reference = 0.;
+      const double time_iterator = benchmark::best_time([&]() {
+         reference = quadratic_product_with_iterator(matrix, x);
+      });
+      double result = 0.;
+      const double time_for_each = benchmark::best_time([&]() {
+         result = matrix.quadratic_product(x, x);
+      });
+      benchmark::report("quadratic product (virtual iterator)", time_iterator);
+      benchmark::report("quadratic product (for_each_nonzero)", time_for_each, time_iterator);
+      benchmark::check(result, reference);
+
+      std::vector<int> row_indices(matrix.number_nonzeros()), column_indices(matrix.number_nonzeros());
+      const double time_copy_iterator = benchmark::best_time([&]() {
+         size_t nonzero_index = 0;
+         for (const auto [row_index, column_index, element]: matrix) {
+            row_indices[nonzero_index] = static_cast<int>(row_index + 1);
+            column_indices[nonzero_index] = static_cast<int>(column_index + 1);
+            nonzero_index++;
+         }
+      });
+      const double time_copy_for_each = benchmark::best_time([&]() {
+         size_t nonzero_index = 0;
+         matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double /*element*/) {
+            row_indices[nonzero_index] = static_cast<int>(row_index + 1);
+            column_indices[nonzero_index] = static_cast<int>(column_index + 1);
+            nonzero_index++;
+         });
+      });
+      benchmark::report("copy of the sparsity pattern (virtual iterator)", time_copy_iterator);
+      benchmark::report("copy of the sparsity pattern (for_each_nonzero)", time_copy_for_each, time_copy_iterator);
+   }
+} // namespace
+
+void run_sparse_storage_traversal_benchmark() {
+   // about 10M nonzeros
+   const size_t dimension = 1000000;
+   const size_t nonzeros_per_column = 10;
+   run("COO", dimension, nonzeros_per_column);
+   run("CSC", dimension, nonzeros_per_column);
+}
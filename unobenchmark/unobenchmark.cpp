@@ -0,0 +1,18 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <iostream>
+
+void run_sparse_storage_traversal_benchmark();
+void run_sparse_kernels_benchmark();
+void run_native_LDL_benchmark();
+
+int main() {
+   std::cout << "Sparse storage traversal\n";
+   run_sparse_storage_traversal_benchmark();
+   std::cout << "\nSparse kernels\n";
+   run_sparse_kernels_benchmark();
+   std::cout << "\nNative LDL^T solver\n";
+   run_native_LDL_benchmark();
+   return 0;
+}
@@ -0,0 +1,171 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ExampleQP.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "solvers/ActiveSetQP/ActiveSetQPSolver.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+static Options active_set_options() {
+   Options options = DefaultOptions::load();
+   options["linear_solver"] = "native_LDL";
+   return options;
+}
+
+static void check_example_solution(const Direction& direction) {
+   const double tolerance = 1e-10;
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 1.4, tolerance);
+   EXPECT_NEAR(direction.primals[1], 1.7, tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[0], 0.8, tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[1], 0., tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[2], 0., tolerance);
+   EXPECT_NEAR(direction.subproblem_objective, -6.45, tolerance);
+}
+
+TEST(ActiveSetQPSolver, ConvexQP) {
+   Options options = active_set_options();
+   options["active_set_QP_regularization"] = "0";
+   const ExampleQP qp{};
+   ActiveSetQPSolver solver(qp.number_variables, qp.number_constraints, 6, 2, options);
+   Direction direction(qp.number_variables, qp.number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   qp.solve(solver, direction, warmstart_information);
+   check_example_solution(direction);
+}
+
+TEST(ActiveSetQPSolver, HotStart) {
+   Options options = active_set_options();
+   options["active_set_QP_regularization"] = "0";
+   ExampleQP qp{};
+   ActiveSetQPSolver solver(qp.number_variables, qp.number_constraints, 6, 2, options);
+   Direction direction(qp.number_variables, qp.number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   qp.solve(solver, direction, warmstart_information);
+   ASSERT_LT(0, solver.get_number_iterations());
+   const size_t number_factorizations = solver.get_number_factorizations();
+
+   // only the variable bounds changed: the factorization and the working set are reused
+   qp.variables_upper_bounds[1] = 10.;
+   warmstart_information.only_variable_bounds_changed();
+   qp.solve(solver, direction, warmstart_information);
+   check_example_solution(direction);
+   EXPECT_EQ(solver.get_number_iterations(), 0);
+   EXPECT_EQ(solver.get_number_factorizations(), number_factorizations);
+
+   // the new bound cuts off the previous solution
+   qp.variables_upper_bounds[1] = 1.5;
+   qp.solve(solver, direction, warmstart_information);
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 1., 1e-10);
+   EXPECT_NEAR(direction.primals[1], 1.5, 1e-10);
+   EXPECT_NEAR(direction.multipliers.upper_bounds[1], -2., 1e-10);
+   EXPECT_EQ(solver.get_number_factorizations(), number_factorizations);
+}
+
+TEST(ActiveSetQPSolver, SchurComplementRefactorization) {
+   Options options = active_set_options();
+   options["active_set_QP_regularization"] = "0";
+   options["active_set_QP_maximum_schur_size"] = "0";
+   const ExampleQP qp{};
+   ActiveSetQPSolver solver(qp.number_variables, qp.number_constraints, 6, 2, options);
+   Direction direction(qp.number_variables, qp.number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   qp.solve(solver, direction, warmstart_information);
+   check_example_solution(direction);
+   // every change of the working set triggers a factorization
+   EXPECT_EQ(solver.get_number_factorizations(), 1 + solver.get_number_iterations());
+}
+
+TEST(ActiveSetQPSolver, LowRankCorrection) {
+   Options options = active_set_options();
+   options["active_set_QP_regularization"] = "0";
+   ExampleQP qp{};
+   qp.variables_upper_bounds[0] = 1.;
+   ActiveSetQPSolver solver(qp.number_variables, qp.number_constraints, 6, 2, options);
+   // the Hessian 2I - e0 e0^T is diag(1, 2): the unconstrained minimizer is (2, 2.5)
+   LowRankCorrection<double> correction{};
+   correction.set(2, 1, {1., 0.}, {1.});
+   solver.set_hessian_correction(&correction);
+   Direction direction(qp.number_variables, qp.number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   qp.solve(solver, direction, warmstart_information);
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 1., 1e-10);
+   EXPECT_NEAR(direction.primals[1], 1.5, 1e-10);
+}
+
+TEST(ActiveSetQPSolver, InfeasibleQP) {
+   // x0 >= 1 and x0 <= 0
+   const size_t number_variables = 1;
+   const size_t number_constraints = 2;
+   const std::vector<double> variables_lower_bounds{-INF<double>};
+   const std::vector<double> variables_upper_bounds{INF<double>};
+   const std::vector<double> constraints_lower_bounds{1., -INF<double>};
+   const std::vector<double> constraints_upper_bounds{INF<double>, 0.};
+   SparseVector<double> linear_objective(number_variables);
+   linear_objective.insert(0, 1.);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian.insert(1., 0, 0);
+   constraint_jacobian.insert(1., 1, 0);
+   SymmetricMatrix<size_t, double> hessian(number_variables, 1, false, "COO");
+   hessian.insert(1., 0, 0);
+
+   ActiveSetQPSolver solver(number_variables, number_constraints, 2, 1, active_set_options());
+   Direction direction(number_variables, number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   solver.solve_QP(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+         constraints_upper_bounds, linear_objective, constraint_jacobian, hessian, Vector<double>{0.}, direction, warmstart_information);
+   EXPECT_EQ(direction.status, SubproblemStatus::INFEASIBLE);
+}
+
+TEST(ActiveSetQPSolver, DocumentationLP) {
+   // min x0 + x1 s.t. x1 <= 7, 5 <= x0 + 2x1 <= 15, 6 <= 3x0 + 2x1, 0 <= x0 <= 4, 1 <= x1
+   const size_t number_variables = 2;
+   const size_t number_constraints = 3;
+   const std::vector<double> variables_lower_bounds{0., 1.};
+   const std::vector<double> variables_upper_bounds{4., INF<double>};
+   const std::vector<double> constraints_lower_bounds{-INF<double>, 5., 6.};
+   const std::vector<double> constraints_upper_bounds{7., 15., INF<double>};
+   SparseVector<double> linear_objective(number_variables);
+   linear_objective.insert(0, 1.);
+   linear_objective.insert(1, 1.);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian.insert(1., 0, 1);
+   constraint_jacobian.insert(1., 1, 0);
+   constraint_jacobian.insert(2., 1, 1);
+   constraint_jacobian.insert(3., 2, 0);
+   constraint_jacobian.insert(2., 2, 1);
+
+   ActiveSetQPSolver solver(number_variables, number_constraints, 5, 0, active_set_options());
+   Direction direction(number_variables, number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   solver.solve_LP(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+         constraints_upper_bounds, linear_objective, constraint_jacobian, Vector<double>{0., 0.}, direction, warmstart_information);
+
+   // the proximal regularization perturbs the multipliers by O(regularization)
+   const double tolerance = 1e-6;
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 0.5, tolerance);
+   EXPECT_NEAR(direction.primals[1], 2.25, tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[0], 0., tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[1], 0.25, tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[2], 0.25, tolerance);
+   EXPECT_NEAR(direction.subproblem_objective, 2.75, tolerance);
+}
@@ -0,0 +1,274 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "solvers/BQPD/BQPDWorkspace.hpp"
+#include "symbolic/Range.hpp"
+
+using namespace uno;
+
+const size_t n = 3;
+const size_t m = 2;
+
+static BQPDWorkspace create_workspace(int kmax) {
+   return BQPDWorkspace(n, m, n, 2 * n, 4, BQPDProblemType::QP, kmax);
+}
+
+// upper triangle of [[4, 1, 0], [1, 3, 0], [0, 0, 2]] with a given scaling
+static void fill_hessian(SymmetricMatrix<size_t, double>& hessian, double factor) {
+   hessian.reset();
+   hessian.insert(4. * factor, 0, 0);
+   hessian.insert(1. * factor, 0, 1);
+   hessian.insert(3. * factor, 1, 1);
+   hessian.insert(2. * factor, 2, 2);
+}
+
+TEST(BQPDWorkspace, StatusFromIfail) {
+   ASSERT_EQ(bqpd_status_from_int(0), BQPDStatus::OPTIMAL);
+   ASSERT_EQ(bqpd_status_from_int(5), BQPDStatus::LP_INSUFFICIENT_SPACE);
+   ASSERT_EQ(bqpd_status_from_int(6), BQPDStatus::HESSIAN_INSUFFICIENT_SPACE);
+   ASSERT_EQ(bqpd_status_from_int(7), BQPDStatus::SPARSE_INSUFFICIENT_SPACE);
+   ASSERT_EQ(bqpd_status_from_int(9), BQPDStatus::UNDEFINED);
+}
+
+TEST(BQPDWorkspace, LPInsufficientSpaceDoublesMlp) {
+   BQPDWorkspace workspace = create_workspace(2);
+   const size_t size_hessian_workspace = workspace.size_hessian_workspace;
+   ASSERT_TRUE(workspace.grow(bqpd_status_from_int(5)));
+   ASSERT_EQ(workspace.mlp, 2000);
+   ASSERT_EQ(workspace.alp.size(), 2000);
+   ASSERT_EQ(workspace.lp.size(), 2000);
+   // the other workspaces are unchanged
+   ASSERT_EQ(workspace.kmax, 2);
+   ASSERT_EQ(workspace.size_hessian_workspace, size_hessian_workspace);
+}
+
+TEST(BQPDWorkspace, HessianInsufficientSpaceDoublesKmax) {
+   BQPDWorkspace workspace = create_workspace(1);
+   const size_t size_hessian_workspace = workspace.size_hessian_workspace;
+   const size_t size_hessian_sparsity_workspace = workspace.size_hessian_sparsity_workspace;
+   ASSERT_TRUE(workspace.grow(bqpd_status_from_int(6)));
+   ASSERT_EQ(workspace.kmax, 2);
+   // kmax (kmax + 9) / 2 reals and kmax integers for the reduced Hessian
+   ASSERT_EQ(workspace.size_hessian_workspace, size_hessian_workspace + 11 - 5);
+   ASSERT_EQ(workspace.size_hessian_sparsity_workspace, size_hessian_sparsity_workspace + 1);
+   ASSERT_EQ(workspace.hessian_values.size(), workspace.size_hessian_workspace);
+   ASSERT_EQ(workspace.hessian_sparsity.size(), workspace.size_hessian_sparsity_workspace);
+   ASSERT_EQ(workspace.mlp, 1000);
+}
+
+TEST(BQPDWorkspace, KmaxCappedAtNumberVariables) {
+   BQPDWorkspace workspace = create_workspace(2);
+   ASSERT_TRUE(workspace.grow(BQPDStatus::HESSIAN_INSUFFICIENT_SPACE));
+   ASSERT_EQ(workspace.kmax, 3);
+   // the reduced Hessian cannot grow any further
+   const size_t size_hessian_workspace = workspace.size_hessian_workspace;
+   ASSERT_FALSE(workspace.grow(BQPDStatus::HESSIAN_INSUFFICIENT_SPACE));
+   ASSERT_EQ(workspace.kmax, 3);
+   ASSERT_EQ(workspace.size_hessian_workspace, size_hessian_workspace);
+}
+
+TEST(BQPDWorkspace, KmaxGrowsFromZero) {
+   BQPDWorkspace workspace(n, m, n, 2 * n, 0, BQPDProblemType::LP, 0);
+   ASSERT_TRUE(workspace.grow(BQPDStatus::HESSIAN_INSUFFICIENT_SPACE));
+   ASSERT_EQ(workspace.kmax, 1);
+}
+
+TEST(BQPDWorkspace, SparseInsufficientSpaceDoublesSparseWorkspaces) {
+   BQPDWorkspace workspace = create_workspace(2);
+   SymmetricMatrix<size_t, double> hessian(n, 4, false, "COO");
+   fill_hessian(hessian, 1.);
+   workspace.save_hessian(hessian);
+   const std::vector<double> hessian_values(workspace.hessian_values.begin(), workspace.hessian_values.begin() + 4);
+   const std::vector<int> hessian_sparsity(workspace.hessian_sparsity.begin(), workspace.hessian_sparsity.begin() +
+         static_cast<long>(workspace.size_hessian_sparsity));
+   const size_t size_hessian_workspace = workspace.size_hessian_workspace;
+   const size_t size_hessian_sparsity_workspace = workspace.size_hessian_sparsity_workspace;
+
+   ASSERT_TRUE(workspace.grow(bqpd_status_from_int(7)));
+   ASSERT_EQ(workspace.mxwk0, 4000000);
+   ASSERT_EQ(workspace.mxiwk0, 1000000);
+   ASSERT_EQ(workspace.size_hessian_workspace, size_hessian_workspace + 2000000);
+   ASSERT_EQ(workspace.size_hessian_sparsity_workspace, size_hessian_sparsity_workspace + 500000);
+   ASSERT_EQ(workspace.hessian_values.size(), workspace.size_hessian_workspace);
+   ASSERT_EQ(workspace.hessian_sparsity.size(), workspace.size_hessian_sparsity_workspace);
+   // the Hessian at the beginning of the workspace is preserved
+   for (size_t index: Range(hessian_values.size())) {
+      ASSERT_EQ(workspace.hessian_values[index], hessian_values[index]);
+   }
+   for (size_t index: Range(hessian_sparsity.size())) {
+      ASSERT_EQ(workspace.hessian_sparsity[index], hessian_sparsity[index]);
+   }
+   // the pattern is still valid
+   fill_hessian(hessian, 2.);
+   workspace.save_hessian(hessian);
+   ASSERT_EQ(workspace.number_hessian_pattern_builds, 1);
+}
+
+TEST(BQPDWorkspace, OtherStatusesDoNotGrow) {
+   for (int ifail: {0, 1, 2, 3, 4, 8, 9}) {
+      BQPDWorkspace workspace = create_workspace(2);
+      ASSERT_FALSE(workspace.grow(bqpd_status_from_int(ifail)));
+      ASSERT_EQ(workspace.mlp, 1000);
+      ASSERT_EQ(workspace.kmax, 2);
+      ASSERT_EQ(workspace.mxwk0, 2000000);
+      ASSERT_EQ(workspace.mxiwk0, 500000);
+   }
+}
+
+TEST(BQPDWorkspace, HessianLocalFormat) {
+   BQPDWorkspace workspace = create_workspace(2);
+   SymmetricMatrix<size_t, double> hessian(n, 4, false, "COO");
+   fill_hessian(hessian, 1.);
+   workspace.save_hessian(hessian);
+   // header, row indices and column starts (Fortran indexing)
+   const std::vector<int> reference_sparsity{5, 1, 1, 2, 3, 1, 2, 4, 5};
+   const std::vector<double> reference_values{4., 1., 3., 2.};
+   for (size_t index: Range(reference_sparsity.size())) {
+      ASSERT_EQ(workspace.hessian_sparsity[index], reference_sparsity[index]);
+   }
+   for (size_t index: Range(reference_values.size())) {
+      ASSERT_EQ(workspace.hessian_values[index], reference_values[index]);
+   }
+}
+
+TEST(BQPDWorkspace, HessianPatternReused) {
+   BQPDWorkspace workspace = create_workspace(2);
+   SymmetricMatrix<size_t, double> hessian(n, 4, false, "COO");
+   fill_hessian(hessian, 1.);
+   workspace.save_hessian(hessian);
+   fill_hessian(hessian, 2.);
+   workspace.save_hessian(hessian);
+   ASSERT_EQ(workspace.number_hessian_pattern_builds, 1);
+   const std::vector<double> reference_values{8., 2., 6., 4.};
+   for (size_t index: Range(reference_values.size())) {
+      ASSERT_EQ(workspace.hessian_values[index], reference_values[index]);
+   }
+}
+
+TEST(BQPDWorkspace, HessianPatternInvalidated) {
+   BQPDWorkspace workspace = create_workspace(2);
+   SymmetricMatrix<size_t, double> hessian(n, 4, false, "COO");
+   fill_hessian(hessian, 1.);
+   workspace.save_hessian(hessian);
+
+   // different number of nonzeros
+   SymmetricMatrix<size_t, double> diagonal_hessian(n, 4, false, "COO");
+   diagonal_hessian.insert(4., 0, 0);
+   diagonal_hessian.insert(3., 1, 1);
+   diagonal_hessian.insert(2., 2, 2);
+   workspace.save_hessian(diagonal_hessian);
+   ASSERT_EQ(workspace.number_hessian_pattern_builds, 2);
+   ASSERT_EQ(workspace.hessian_sparsity[0], 4);
+
+   // same number of nonzeros, different row
+   SymmetricMatrix<size_t, double> other_hessian(n, 4, false, "COO");
+   other_hessian.insert(4., 0, 0);
+   other_hessian.insert(3., 1, 1);
+   other_hessian.insert(1., 1, 2);
+   workspace.save_hessian(other_hessian);
+   ASSERT_EQ(workspace.number_hessian_pattern_builds, 3);
+   // same number of nonzeros, different column
+   SymmetricMatrix<size_t, double> moved_hessian(n, 4, false, "COO");
+   moved_hessian.insert(4., 0, 0);
+   moved_hessian.insert(3., 1, 1);
+   moved_hessian.insert(1., 1, 1);
+   workspace.save_hessian(moved_hessian);
+   ASSERT_EQ(workspace.number_hessian_pattern_builds, 4);
+   const std::vector<int> reference_sparsity{4, 1, 2, 2, 1, 2, 4, 4};
+   for (size_t index: Range(reference_sparsity.size())) {
+      ASSERT_EQ(workspace.hessian_sparsity[index], reference_sparsity[index]);
+   }
+
+   // different dimension
+   SymmetricMatrix<size_t, double> smaller_hessian(n - 1, 4, false, "COO");
+   smaller_hessian.insert(4., 0, 0);
+   smaller_hessian.insert(3., 1, 1);
+   smaller_hessian.insert(1., 1, 1);
+   workspace.save_hessian(smaller_hessian);
+   ASSERT_EQ(workspace.number_hessian_pattern_builds, 5);
+   workspace.save_hessian(smaller_hessian);
+   ASSERT_EQ(workspace.number_hessian_pattern_builds, 5);
+}
+
+TEST(BQPDWorkspace, GradientLocalFormat) {
+   BQPDWorkspace workspace = create_workspace(2);
+   SparseVector<double> objective(n);
+   objective.insert(0, 1.);
+   objective.insert(2, 2.);
+   RectangularMatrix<double> jacobian(m, n);
+   jacobian.insert(3., 0, 1);
+   jacobian.insert(4., 1, 0);
+   jacobian.insert(5., 1, 2);
+
+   workspace.save_gradients(m, objective, jacobian);
+   ASSERT_EQ(workspace.number_gradient_pattern_builds, 1);
+   // column indices (Fortran indexing), then the starts of the gradients
+   const std::vector<int> reference_sparsity{6, 1, 3, 2, 1, 3, 1, 3, 4, 6};
+   const std::vector<double> reference_values{1., 2., 3., 4., 5.};
+   for (size_t index: Range(reference_sparsity.size())) {
+      ASSERT_EQ(workspace.jacobian_sparsity[index], reference_sparsity[index]);
+   }
+   for (size_t index: Range(reference_values.size())) {
+      ASSERT_EQ(workspace.jacobian[index], reference_values[index]);
+   }
+}
+
+TEST(BQPDWorkspace, GradientPatternReused) {
+   BQPDWorkspace workspace = create_workspace(2);
+   for (double factor: {1., 2.}) {
+      SparseVector<double> objective(n);
+      objective.insert(0, factor);
+      RectangularMatrix<double> jacobian(m, n);
+      jacobian.insert(3. * factor, 0, 1);
+      jacobian.insert(4. * factor, 1, 0);
+      workspace.save_gradients(m, objective, jacobian);
+   }
+   ASSERT_EQ(workspace.number_gradient_pattern_builds, 1);
+   const std::vector<double> reference_values{2., 6., 8.};
+   for (size_t index: Range(reference_values.size())) {
+      ASSERT_EQ(workspace.jacobian[index], reference_values[index]);
+   }
+}
+
+TEST(BQPDWorkspace, GradientPatternInvalidated) {
+   BQPDWorkspace workspace = create_workspace(2);
+   SparseVector<double> objective(n);
+   objective.insert(0, 1.);
+   RectangularMatrix<double> jacobian(m, n);
+   jacobian.insert(3., 0, 1);
+   jacobian.insert(4., 1, 0);
+   workspace.save_gradients(m, objective, jacobian);
+
+   // different column index
+   RectangularMatrix<double> other_jacobian(m, n);
+   other_jacobian.insert(3., 0, 2);
+   other_jacobian.insert(4., 1, 0);
+   workspace.save_gradients(m, objective, other_jacobian);
+   ASSERT_EQ(workspace.number_gradient_pattern_builds, 2);
+   ASSERT_EQ(workspace.jacobian_sparsity[2], 3);
+
+   // same number of nonzeros, moved from a constraint to another
+   RectangularMatrix<double> moved_jacobian(m, n);
+   moved_jacobian.insert(3., 0, 2);
+   moved_jacobian.insert(4., 0, 0);
+   workspace.save_gradients(m, objective, moved_jacobian);
+   ASSERT_EQ(workspace.number_gradient_pattern_builds, 3);
+   const std::vector<int> reference_sparsity{4, 1, 3, 1, 1, 2, 4, 4};
+   for (size_t index: Range(reference_sparsity.size())) {
+      ASSERT_EQ(workspace.jacobian_sparsity[index], reference_sparsity[index]);
+   }
+
+   // different objective gradient
+   SparseVector<double> other_objective(n);
+   other_objective.insert(0, 1.);
+   other_objective.insert(1, 1.);
+   workspace.save_gradients(m, other_objective, moved_jacobian);
+   ASSERT_EQ(workspace.number_gradient_pattern_builds, 4);
+   workspace.save_gradients(m, other_objective, moved_jacobian);
+   ASSERT_EQ(workspace.number_gradient_pattern_builds, 4);
+}
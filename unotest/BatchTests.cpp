@@ -0,0 +1,105 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "Batch.hpp"
+#include "DoubleWellModel.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+
+using namespace uno;
+
+static std::vector<std::string> split_lines(const std::string& text) {
+   std::vector<std::string> lines{};
+   std::istringstream stream(text);
+   std::string line;
+   while (std::getline(stream, line)) {
+      lines.push_back(line);
+   }
+   return lines;
+}
+
+TEST(Batch, ReadInstances) {
+   // the size of an existing model file is measured, with or without the .nl extension
+   const std::string model_file_name = testing::TempDir() + "batch_model.nl";
+   {
+      std::ofstream model_file(model_file_name);
+      model_file << std::string(100, 'x');
+   }
+   const std::string model_name = model_file_name.substr(0, model_file_name.size() - 3);
+   std::istringstream batch("# comment\n\n   first.nl 60\n" + model_name + "\n  # indented comment\nthird.nl 1e3 ignored\n");
+   const std::vector<BatchInstance> instances = Batch::read_instances(batch);
+   std::remove(model_file_name.c_str());
+
+   ASSERT_EQ(instances.size(), 3);
+   EXPECT_EQ(instances[0].model_name, "first.nl");
+   EXPECT_EQ(instances[0].time_limit, "60");
+   EXPECT_EQ(instances[0].file_size, 0);
+   EXPECT_EQ(instances[1].model_name, model_name);
+   EXPECT_EQ(instances[1].time_limit, "");
+   EXPECT_EQ(instances[1].file_size, 100);
+   EXPECT_EQ(instances[2].model_name, "third.nl");
+   EXPECT_EQ(instances[2].time_limit, "1e3");
+}
+
+TEST(Batch, MissingBatchFile) {
+   EXPECT_THROW(static_cast<void>(Batch::read_instances(std::string("missing_batch_file.txt"))), std::invalid_argument);
+}
+
+TEST(Batch, LargestInstancesFirst) {
+   const std::vector<BatchInstance> instances{{"a", "", 10}, {"b", "", 300}, {"c", "", 10}, {"d", "", 0}, {"e", "", 300}};
+   // ties keep the order of the batch file
+   EXPECT_EQ(Batch::schedule(instances), (std::vector<size_t>{1, 4, 0, 2, 3}));
+}
+
+TEST(Batch, CSVFields) {
+   EXPECT_EQ(Batch::csv_field("model.nl"), "\"model.nl\"");
+   EXPECT_EQ(Batch::csv_field("a \"quoted\", name"), "\"a \"\"quoted\"\", name\"");
+   // same number of fields as the header
+   const std::string header = Batch::results_header();
+   const std::string record = Batch::error_record("model.nl", "failure");
+   EXPECT_EQ(record, "\"model.nl\",\"Error: failure\",,,,,,,,,\n");
+   EXPECT_EQ(std::count(header.begin(), header.end(), ','), std::count(record.begin(), record.end(), ','));
+}
+
+// the instances are solved concurrently with their own time limits; a failing instance produces an error record
+TEST(Batch, Solve) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers_and_preset());
+   Options::set_preset(options, "ipopt");
+   const std::vector<BatchInstance> instances{{"left", "", 0}, {"failing", "", 0}, {"right", "17", 0}};
+   std::mutex time_limits_mutex;
+   std::vector<std::string> time_limits{};
+   const Batch batch(2);
+   std::ostringstream results;
+   batch.solve(instances, [&](const std::string& model_name, const Options& instance_options) {
+      {
+         std::lock_guard<std::mutex> lock(time_limits_mutex);
+         time_limits.push_back(model_name + ':' + instance_options.get_string("time_limit"));
+      }
+      if (model_name == "failing") {
+         throw std::runtime_error("invalid model");
+      }
+      return solve_double_well(instance_options, (model_name == "left") ? -1.5 : 1.5);
+   }, options, results);
+
+   std::sort(time_limits.begin(), time_limits.end());
+   EXPECT_EQ(time_limits, (std::vector<std::string>{"failing:inf", "left:inf", "right:17"}));
+   std::vector<std::string> lines = split_lines(results.str());
+   ASSERT_EQ(lines.size(), 4);
+   EXPECT_EQ(lines[0] + '\n', Batch::results_header());
+   // the records are written in the order of completion
+   std::sort(lines.begin() + 1, lines.end());
+   EXPECT_EQ(lines[1], "\"failing\",\"Error: invalid model\",,,,,,,,,");
+   const std::string converged = ",\"" + status_to_message(TerminationStatus::FEASIBLE_KKT_POINT) + "\",";
+   EXPECT_EQ(lines[2].rfind("\"left\"" + converged + "-0.30542848", 0), 0);
+   EXPECT_EQ(lines[3].rfind("\"right\"" + converged + "0.29414648", 0), 0);
+}
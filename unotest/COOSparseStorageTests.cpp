@@ -0,0 +1,54 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "linear_algebra/COOSparseStorage.hpp"
+
+using namespace uno;
+
+TEST(COOSparseStorage, ForEachNonzeroStorageOrder) {
+   COOSparseStorage<size_t, double> matrix(3, 4, false);
+   matrix.insert(1., 0, 0);
+   matrix.insert(2., 0, 2);
+   matrix.insert(3., 1, 1);
+   matrix.insert(4., 2, 2);
+
+   const std::vector<size_t> reference_rows{0, 0, 1, 2};
+   const std::vector<size_t> reference_columns{0, 2, 1, 2};
+   size_t nonzero_index = 0;
+   matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      EXPECT_EQ(row_index, reference_rows[nonzero_index]);
+      EXPECT_EQ(column_index, reference_columns[nonzero_index]);
+      EXPECT_DOUBLE_EQ(element, static_cast<double>(nonzero_index + 1));
+      nonzero_index++;
+   });
+   ASSERT_EQ(nonzero_index, matrix.number_nonzeros);
+}
+
+TEST(COOSparseStorage, ForEachNonzeroMatchesIterator) {
+   COOSparseStorage<size_t, double> matrix(3, 4, true);
+   matrix.insert(1., 0, 0);
+   matrix.insert(2., 0, 2);
+   matrix.insert(3., 1, 1);
+   matrix.insert(4., 2, 2);
+
+   std::vector<std::tuple<size_t, size_t, double>> iterated_nonzeros{};
+   for (const auto [row_index, column_index, element]: matrix) {
+      iterated_nonzeros.emplace_back(row_index, column_index, element);
+   }
+   std::vector<std::tuple<size_t, size_t, double>> traversed_nonzeros{};
+   matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      traversed_nonzeros.emplace_back(row_index, column_index, element);
+   });
+   ASSERT_EQ(iterated_nonzeros, traversed_nonzeros);
+}
+
+TEST(COOSparseStorage, RegularizationPosition) {
+   COOSparseStorage<size_t, double> matrix(3, 4, true);
+   matrix.insert(1., 0, 0);
+   matrix.set_regularization([](size_t row_index) { return 10. + static_cast<double>(row_index); });
+   for (size_t row_index: Range(3)) {
+      EXPECT_DOUBLE_EQ(matrix.data_pointer()[matrix.regularization_position(row_index)], 10. + static_cast<double>(row_index));
+   }
+}
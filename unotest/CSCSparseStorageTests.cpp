@@ -0,0 +1,61 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "linear_algebra/CSCSparseStorage.hpp"
+
+using namespace uno;
+
+TEST(CSCSparseStorage, ForEachNonzeroStorageOrder) {
+   CSCSparseStorage<size_t, double> matrix(3, 4, false);
+   matrix.insert(1., 0, 0);
+   matrix.finalize_column(0);
+   matrix.insert(2., 1, 1);
+   matrix.finalize_column(1);
+   matrix.insert(3., 0, 2);
+   matrix.insert(4., 2, 2);
+   matrix.finalize_column(2);
+
+   const std::vector<size_t> reference_rows{0, 1, 0, 2};
+   const std::vector<size_t> reference_columns{0, 1, 2, 2};
+   size_t nonzero_index = 0;
+   matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      EXPECT_EQ(row_index, reference_rows[nonzero_index]);
+      EXPECT_EQ(column_index, reference_columns[nonzero_index]);
+      EXPECT_DOUBLE_EQ(element, static_cast<double>(nonzero_index + 1));
+      nonzero_index++;
+   });
+   ASSERT_EQ(nonzero_index, matrix.number_nonzeros);
+}
+
+TEST(CSCSparseStorage, EmptyColumns) {
+   CSCSparseStorage<size_t, double> matrix(4, 2, false);
+   matrix.finalize_column(0);
+   matrix.insert(1., 1, 1);
+   matrix.finalize_column(1);
+   matrix.finalize_column(2);
+   matrix.insert(2., 3, 3);
+   matrix.finalize_column(3);
+
+   std::vector<size_t> columns{};
+   matrix.for_each_nonzero([&](size_t /*row_index*/, size_t column_index, double /*element*/) {
+      columns.emplace_back(column_index);
+   });
+   ASSERT_EQ(columns, (std::vector<size_t>{1, 3}));
+}
+
+TEST(CSCSparseStorage, RegularizationPosition) {
+   CSCSparseStorage<size_t, double> matrix(2, 2, true);
+   matrix.insert(1., 0, 0);
+   matrix.finalize_column(0);
+   matrix.insert(2., 0, 1);
+   matrix.finalize_column(1);
+   matrix.set_regularization([](size_t row_index) { return 10. + static_cast<double>(row_index); });
+   // the regularization terms are located at the end of each column
+   ASSERT_EQ(matrix.regularization_position(0), 1);
+   ASSERT_EQ(matrix.regularization_position(1), 3);
+   for (size_t row_index: Range(2)) {
+      EXPECT_DOUBLE_EQ(matrix.data_pointer()[matrix.regularization_position(row_index)], 10. + static_cast<double>(row_index));
+   }
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_DOUBLEWELLMODEL_H
+#define UNO_DOUBLEWELLMODEL_H
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "Uno.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategyFactory.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanism.hpp"
+#include "ingredients/globalization_mechanisms/GlobalizationMechanismFactory.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/Model.hpp"
+#include "model/ModelFactory.hpp"
+#include "optimization/Iterate.hpp"
+#include "optimization/Result.hpp"
+#include "symbolic/CollectionAdapter.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   // analytic test model with two local minima:
+   // min (x0^2 - 1)^2 + 0.3 x0 + (x1 - 0.5)^2
+   // s.t. x0 + x1^2 >= -3
+   //      -2 <= x0 <= 2, -2 <= x1 <= 2
+   // The local minima are x0 ~ -1.0356 (global, objective ~ -0.3054) and x0 ~ 0.9601 (objective ~ 0.2941), x1 = 0.5 (the constraint is
+   // inactive). The initial point (1, 0) lies in the basin of the local minimum.
+   // The evaluations of the objective can be slowed down to make a run lose a race.
+   class DoubleWellModel: public Model {
+   public:
+      static constexpr double global_minimum_x0{-1.0355787};
+      static constexpr double local_minimum_x0{0.9601496};
+
+      explicit DoubleWellModel(std::chrono::microseconds evaluation_delay = std::chrono::microseconds(0)):
+            Model("double_well", 2, 1, 1.),
+            evaluation_delay(evaluation_delay),
+            bounded_variables_collection(this->bounded_variables),
+            no_variables_collection(this->no_indices),
+            inequality_constraints_collection(this->inequality_constraints),
+            no_constraints_collection(this->no_indices) {
+      }
+
+      [[nodiscard]] double evaluate_objective(const Vector<double>& x) const override {
+         if (0 < this->evaluation_delay.count()) {
+            std::this_thread::sleep_for(this->evaluation_delay);
+         }
+         return (x[0] * x[0] - 1.) * (x[0] * x[0] - 1.) + 0.3 * x[0] + (x[1] - 0.5) * (x[1] - 0.5);
+      }
+
+      void evaluate_objective_gradient(const Vector<double>& x, SparseVector<double>& gradient) const override {
+         gradient.insert(0, 4. * x[0] * (x[0] * x[0] - 1.) + 0.3);
+         gradient.insert(1, 2. * (x[1] - 0.5));
+      }
+
+      void evaluate_constraints(const Vector<double>& x, std::vector<double>& constraints) const override {
+         constraints[0] = x[0] + x[1] * x[1];
+      }
+
+      void evaluate_constraint_gradient(const Vector<double>& x, size_t /*constraint_index*/, SparseVector<double>& gradient) const override {
+         gradient.insert(0, 1.);
+         gradient.insert(1, 2. * x[1]);
+      }
+
+      void evaluate_constraint_jacobian(const Vector<double>& x, RectangularMatrix<double>& constraint_jacobian) const override {
+         constraint_jacobian.insert(1., 0, 0);
+         constraint_jacobian.insert(2. * x[1], 0, 1);
+      }
+
+      // upper triangle of the Hessian of the Lagrangian sigma f(x) - lambda^T c(x)
+      void evaluate_lagrangian_hessian(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            SymmetricMatrix<size_t, double>& hessian) const override {
+         hessian.reset();
+         hessian.insert(objective_multiplier * (12. * x[0] * x[0] - 4.), 0, 0);
+         hessian.finalize_column(0);
+         hessian.insert(2. * objective_multiplier - 2. * multipliers[0], 1, 1);
+         hessian.finalize_column(1);
+      }
+
+      void evaluate_lagrangian_hessian_vector_product(const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers,
+            const Vector<double>& vector, Vector<double>& result) const override {
+         result[0] = objective_multiplier * (12. * x[0] * x[0] - 4.) * vector[0];
+         result[1] = (2. * objective_multiplier - 2. * multipliers[0]) * vector[1];
+      }
+
+      void compute_element_functions(std::vector<ElementFunction>& elements) const override {
+         elements = {{ElementFunction::OBJECTIVE, {0}}, {ElementFunction::OBJECTIVE, {1}}, {0, {1}}};
+      }
+
+      [[nodiscard]] double variable_lower_bound(size_t /*variable_index*/) const override { return -2.; }
+      [[nodiscard]] double variable_upper_bound(size_t /*variable_index*/) const override { return 2.; }
+      [[nodiscard]] BoundType get_variable_bound_type(size_t /*variable_index*/) const override { return BOUNDED_BOTH_SIDES; }
+      [[nodiscard]] const Collection<size_t>& get_lower_bounded_variables() const override { return this->bounded_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_upper_bounded_variables() const override { return this->bounded_variables_collection; }
+      [[nodiscard]] const SparseVector<size_t>& get_slacks() const override { return this->slacks; }
+      [[nodiscard]] const Collection<size_t>& get_single_lower_bounded_variables() const override { return this->no_variables_collection; }
+      [[nodiscard]] const Collection<size_t>& get_single_upper_bounded_variables() const override { return this->no_variables_collection; }
+      [[nodiscard]] const Vector<size_t>& get_fixed_variables() const override { return this->fixed_variables; }
+
+      [[nodiscard]] double constraint_lower_bound(size_t /*constraint_index*/) const override { return -3.; }
+      [[nodiscard]] double constraint_upper_bound(size_t /*constraint_index*/) const override { return INF<double>; }
+      [[nodiscard]] FunctionType get_constraint_type(size_t /*constraint_index*/) const override { return NONLINEAR; }
+      [[nodiscard]] BoundType get_constraint_bound_type(size_t /*constraint_index*/) const override { return BOUNDED_LOWER; }
+      [[nodiscard]] const Collection<size_t>& get_equality_constraints() const override { return this->no_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_inequality_constraints() const override { return this->inequality_constraints_collection; }
+      [[nodiscard]] const Collection<size_t>& get_linear_constraints() const override { return this->no_constraints_collection; }
+
+      void initial_primal_point(Vector<double>& x) const override {
+         x[0] = 1.;
+         x[1] = 0.;
+      }
+
+      void initial_dual_point(Vector<double>& multipliers) const override {
+         multipliers[0] = 0.;
+      }
+
+      void postprocess_solution(Iterate& /*iterate*/, TerminationStatus /*termination_status*/) const override { }
+
+      [[nodiscard]] size_t number_objective_gradient_nonzeros() const override { return 2; }
+      [[nodiscard]] size_t number_jacobian_nonzeros() const override { return 2; }
+      [[nodiscard]] size_t number_hessian_nonzeros() const override { return 2; }
+
+   protected:
+      const std::chrono::microseconds evaluation_delay;
+      std::vector<size_t> bounded_variables{0, 1};
+      std::vector<size_t> inequality_constraints{0};
+      std::vector<size_t> no_indices{};
+      CollectionAdapter<std::vector<size_t>&> bounded_variables_collection;
+      CollectionAdapter<std::vector<size_t>&> no_variables_collection;
+      CollectionAdapter<std::vector<size_t>&> inequality_constraints_collection;
+      CollectionAdapter<std::vector<size_t>&> no_constraints_collection;
+      SparseVector<size_t> slacks{};
+      Vector<size_t> fixed_variables{};
+   };
+
+   // solves the double-well model from (x0, 0) with a given preset
+   inline Result solve_double_well(const Options& options, double x0) {
+      const std::unique_ptr<Model> model = ModelFactory::reformulate(std::make_unique<DoubleWellModel>(), options);
+      Iterate initial_iterate(model->number_variables, model->number_constraints);
+      model->initial_primal_point(initial_iterate.primals);
+      initial_iterate.primals[0] = x0;
+      model->project_onto_variable_bounds(initial_iterate.primals);
+      model->initial_dual_point(initial_iterate.multipliers.constraints);
+      initial_iterate.feasibility_multipliers.reset();
+
+      auto constraint_relaxation_strategy = ConstraintRelaxationStrategyFactory::create(*model, options);
+      auto globalization_mechanism = GlobalizationMechanismFactory::create(*constraint_relaxation_strategy, options);
+      Uno uno(*globalization_mechanism, options);
+      return uno.solve(*model, initial_iterate, options);
+   }
+} // namespace
+
+#endif // UNO_DOUBLEWELLMODEL_H
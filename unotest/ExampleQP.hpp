@@ -0,0 +1,53 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#ifndef UNO_EXAMPLEQP_H
+#define UNO_EXAMPLEQP_H
+
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "solvers/QPSolver.hpp"
+#include "tools/Infinity.hpp"
+
+namespace uno {
+   // Nocedal & Wright, Example 16.4: min (x0 - 1)^2 + (x1 - 2.5)^2 s.t. x0 - 2x1 + 2 >= 0, -x0 - 2x1 + 6 >= 0, -x0 + 2x1 + 2 >= 0, x >= 0.
+   // Solution (1.4, 1.7) with the multipliers (0.8, 0, 0) and the objective -6.45 (without the constant term)
+   struct ExampleQP {
+      const size_t number_variables = 2;
+      const size_t number_constraints = 3;
+      std::vector<double> variables_lower_bounds{0., 0.};
+      std::vector<double> variables_upper_bounds{INF<double>, INF<double>};
+      const std::vector<double> constraints_lower_bounds{-2., -6., -2.};
+      const std::vector<double> constraints_upper_bounds{INF<double>, INF<double>, INF<double>};
+      SparseVector<double> linear_objective{2};
+      RectangularMatrix<double> constraint_jacobian{3, 2};
+      SymmetricMatrix<size_t, double> hessian{2, 2, false, "COO"};
+      const Vector<double> initial_point{0., 0.};
+
+      ExampleQP() {
+         this->linear_objective.insert(0, -2.);
+         this->linear_objective.insert(1, -5.);
+         this->constraint_jacobian.insert(1., 0, 0);
+         this->constraint_jacobian.insert(-2., 0, 1);
+         this->constraint_jacobian.insert(-1., 1, 0);
+         this->constraint_jacobian.insert(-2., 1, 1);
+         this->constraint_jacobian.insert(-1., 2, 0);
+         this->constraint_jacobian.insert(2., 2, 1);
+         this->hessian.insert(2., 0, 0);
+         this->hessian.insert(2., 1, 1);
+      }
+
+      void solve(QPSolver& solver, Direction& direction, const WarmstartInformation& warmstart_information) const {
+         solver.solve_QP(this->number_variables, this->number_constraints, this->variables_lower_bounds, this->variables_upper_bounds,
+               this->constraints_lower_bounds, this->constraints_upper_bounds, this->linear_objective, this->constraint_jacobian, this->hessian,
+               this->initial_point, direction, warmstart_information);
+      }
+   };
+} // namespace
+
+#endif // UNO_EXAMPLEQP_H
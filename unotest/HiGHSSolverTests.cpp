@@ -2,12 +2,16 @@
 // Licensed under the MIT license. See LICENSE file in the project directory for details.
 
 #include <gtest/gtest.h>
+#include <stdexcept>
 #include "optimization/Direction.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
 #include "linear_algebra/RectangularMatrix.hpp"
 #include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
 #include "optimization/WarmstartInformation.hpp"
 #include "options/Options.hpp"
 #include "solvers/HiGHS/HiGHSSolver.hpp"
+#include "symbolic/Range.hpp"
 #include "tools/Infinity.hpp"
 
 using namespace uno;
@@ -26,6 +30,8 @@ TEST(HiGHSSolver, DocumentationLP) {
    const size_t number_hessian_nonzeros = 0;
    Options options(false);
    options["print_subproblem"] = "false";
+   options["hessian_model"] = "exact";
+   options["HiGHS_maximum_dense_hessian_dimension"] = "2000";
    HiGHSSolver highs_solver(number_variables, number_constraints, number_jacobian_nonzeros, number_hessian_nonzeros, options);
 
    // create the LP
@@ -39,11 +45,11 @@ TEST(HiGHSSolver, DocumentationLP) {
    const std::vector<double> constraints_upper_bounds{7., 15., INF<double>};
 
    RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
-   constraint_jacobian[0].insert(1, 1.);
-   constraint_jacobian[1].insert(0, 1.);
-   constraint_jacobian[1].insert(1, 2.);
-   constraint_jacobian[2].insert(0, 3.);
-   constraint_jacobian[2].insert(1, 2.);
+   constraint_jacobian.insert(1., 0, 1);
+   constraint_jacobian.insert(1., 1, 0);
+   constraint_jacobian.insert(2., 1, 1);
+   constraint_jacobian.insert(3., 2, 0);
+   constraint_jacobian.insert(2., 2, 1);
 
    Direction direction(number_variables, number_constraints);
    WarmstartInformation warmstart_information{};
@@ -69,4 +75,97 @@ TEST(HiGHSSolver, DocumentationLP) {
       EXPECT_NEAR(direction.multipliers.lower_bounds[index], lower_bound_duals_reference[index], tolerance);
       EXPECT_NEAR(direction.multipliers.upper_bounds[index], upper_bound_duals_reference[index], tolerance);
    }
-}
\ No newline at end of file
+}
+
+TEST(HiGHSSolver, QPWithLowRankCorrection) {
+   // Min    f = 1/2 x^T H x - 6 x_0 - 6 x_1
+   // s.t.   x_0 + x_1 <= 10
+   // -10 <= x_0, x_1 <= 10
+   // where H = diag(4, 4) + [1 1; 1 1] (compact form: diagonal plus low-rank correction -Ψ N^{-1} Ψ^T with Ψ = (1, 1)^T, N = -1)
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   const size_t number_jacobian_nonzeros = 2;
+   const size_t number_hessian_nonzeros = 2;
+   Options options(false);
+   options["print_subproblem"] = "false";
+   options["hessian_model"] = "LBFGS";
+   options["HiGHS_maximum_dense_hessian_dimension"] = "2000";
+   HiGHSSolver highs_solver(number_variables, number_constraints, number_jacobian_nonzeros, number_hessian_nonzeros, options);
+
+   SparseVector<double> linear_objective(number_variables);
+   linear_objective.insert(0, -6.);
+   linear_objective.insert(1, -6.);
+   const std::vector<double> variables_lower_bounds{-10., -10.};
+   const std::vector<double> variables_upper_bounds{10., 10.};
+   const std::vector<double> constraints_lower_bounds{-INF<double>};
+   const std::vector<double> constraints_upper_bounds{10.};
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian.insert(1., 0, 0);
+   constraint_jacobian.insert(1., 0, 1);
+   SymmetricMatrix<size_t, double> hessian(number_variables, number_hessian_nonzeros, false, "COO");
+   hessian.insert(4., 0, 0);
+   hessian.finalize_column(0);
+   hessian.insert(4., 1, 1);
+   hessian.finalize_column(1);
+   LowRankCorrection<double> correction;
+   correction.set(number_variables, 1, {1., 1.}, {-1.});
+   highs_solver.set_hessian_correction(&correction);
+
+   Direction direction(number_variables, number_constraints);
+   WarmstartInformation warmstart_information{};
+   Vector<double> initial_point{0., 0.};
+   highs_solver.solve_QP(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+      constraints_upper_bounds, linear_objective, constraint_jacobian, hessian, initial_point, direction, warmstart_information);
+
+   // H x = (6, 6): x = (1, 1) with the correction, (1.5, 1.5) without
+   const double tolerance = 1e-6;
+   EXPECT_NEAR(direction.primals[0], 1., tolerance);
+   EXPECT_NEAR(direction.primals[1], 1., tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[0], 0., tolerance);
+}
+
+TEST(HiGHSSolver, LBFGSRejectedAboveDenseHessianDimension) {
+   // min -x_0 - x_1 - x_2 s.t. x_0 + x_1 + x_2 <= 1, 0 <= x <= 1
+   const size_t number_variables = 3;
+   const size_t number_constraints = 1;
+   const size_t number_jacobian_nonzeros = 3;
+   const size_t number_hessian_nonzeros = 3;
+   Options options(false);
+   options["print_subproblem"] = "false";
+   options["hessian_model"] = "LBFGS";
+   options["HiGHS_maximum_dense_hessian_dimension"] = "2";
+   // the limit only applies to the QPs: HiGHS can still be the LP solver
+   HiGHSSolver highs_solver(number_variables, number_constraints, number_jacobian_nonzeros, number_hessian_nonzeros, options);
+
+   SparseVector<double> linear_objective(number_variables);
+   linear_objective.insert(0, -1.);
+   linear_objective.insert(1, -1.);
+   linear_objective.insert(2, -1.);
+   const std::vector<double> variables_lower_bounds{0., 0., 0.};
+   const std::vector<double> variables_upper_bounds{1., 1., 1.};
+   const std::vector<double> constraints_lower_bounds{-INF<double>};
+   const std::vector<double> constraints_upper_bounds{1.};
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian.insert(1., 0, 0);
+   constraint_jacobian.insert(1., 0, 1);
+   constraint_jacobian.insert(1., 0, 2);
+   Direction direction(number_variables, number_constraints);
+   WarmstartInformation warmstart_information{};
+   Vector<double> initial_point{0., 0., 0.};
+   highs_solver.solve_LP(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+      constraints_upper_bounds, linear_objective, constraint_jacobian, initial_point, direction, warmstart_information);
+   EXPECT_NEAR(direction.primals[0] + direction.primals[1] + direction.primals[2], 1., 1e-6);
+
+   // the dense LBFGS correction of dimension 3 exceeds the limit
+   SymmetricMatrix<size_t, double> hessian(number_variables, number_hessian_nonzeros, false, "COO");
+   for (size_t variable_index: Range(number_variables)) {
+      hessian.insert(1., variable_index, variable_index);
+      hessian.finalize_column(variable_index);
+   }
+   LowRankCorrection<double> correction;
+   correction.set(number_variables, 1, {1., 1., 1.}, {-1.});
+   highs_solver.set_hessian_correction(&correction);
+   EXPECT_THROW(highs_solver.solve_QP(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds,
+      constraints_lower_bounds, constraints_upper_bounds, linear_objective, constraint_jacobian, hessian, initial_point, direction,
+      warmstart_information), std::invalid_argument);
+}
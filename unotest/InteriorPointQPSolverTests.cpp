@@ -0,0 +1,300 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "ExampleQP.hpp"
+#include "linear_algebra/LowRankCorrection.hpp"
+#include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/SparseVector.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "optimization/Direction.hpp"
+#include "optimization/WarmstartInformation.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "solvers/InteriorPointQP/InteriorPointQPSolver.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+static Options interior_point_options() {
+   Options options = DefaultOptions::load();
+   options["linear_solver"] = "native_LDL";
+   return options;
+}
+
+static void check_example_solution(const Direction& direction) {
+   const double tolerance = 1e-7;
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 1.4, tolerance);
+   EXPECT_NEAR(direction.primals[1], 1.7, tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[0], 0.8, tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[1], 0., tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[2], 0., tolerance);
+   EXPECT_NEAR(direction.subproblem_objective, -6.45, tolerance);
+   // approximate active set: no bound is active
+   EXPECT_TRUE(direction.active_bounds.at_lower_bound.empty());
+   EXPECT_TRUE(direction.active_bounds.at_upper_bound.empty());
+}
+
+
+// min 1/2 ||x - target||^2 s.t. sum(x) >= -1 (inactive), 0 <= x <= 1. The bounds active at the solution depend on the target
+static void solve_box_QP(InteriorPointQPSolver& solver, const std::vector<double>& target, Direction& direction) {
+   const size_t number_variables = target.size();
+   const std::vector<double> variables_lower_bounds(number_variables, 0.);
+   const std::vector<double> variables_upper_bounds(number_variables, 1.);
+   const std::vector<double> constraints_lower_bounds{-1.};
+   const std::vector<double> constraints_upper_bounds{INF<double>};
+   SparseVector<double> linear_objective(number_variables);
+   RectangularMatrix<double> constraint_jacobian(1, number_variables);
+   SymmetricMatrix<size_t, double> hessian(number_variables, number_variables, false, "COO");
+   for (size_t variable_index: Range(number_variables)) {
+      linear_objective.insert(variable_index, -target[variable_index]);
+      constraint_jacobian.insert(1., 0, variable_index);
+      hessian.insert(1., variable_index, variable_index);
+   }
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   solver.solve_QP(number_variables, 1, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds, constraints_upper_bounds,
+         linear_objective, constraint_jacobian, hessian, Vector<double>(number_variables, 0.), direction, warmstart_information);
+}
+
+// each iteration is a Mehrotra predictor-corrector step: the example converges in a few iterations from a cold start
+TEST(InteriorPointQPSolver, PredictorCorrectorConvergence) {
+   const ExampleQP qp{};
+   InteriorPointQPSolver solver(qp.number_variables, qp.number_constraints, 6, 2, interior_point_options());
+   Direction direction(qp.number_variables, qp.number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   qp.solve(solver, direction, warmstart_information);
+   check_example_solution(direction);
+   EXPECT_FALSE(solver.is_warm_started());
+   EXPECT_LE(solver.get_number_iterations(), 10);
+}
+
+// unlike an active-set method, the number of iterations hardly depends on the number of active bounds. No crossover is performed:
+// the active bounds are identified by the approximate active set
+TEST(InteriorPointQPSolver, IterationsHardlyDependOnActiveSet) {
+   const size_t number_variables = 100;
+   InteriorPointQPSolver solver(number_variables, 1, number_variables, number_variables, interior_point_options());
+   Direction direction(number_variables, 1);
+   // no active bound
+   solve_box_QP(solver, std::vector<double>(number_variables, 0.5), direction);
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_TRUE(direction.active_bounds.at_lower_bound.empty());
+   EXPECT_TRUE(direction.active_bounds.at_upper_bound.empty());
+   const size_t number_interior_iterations = solver.get_number_iterations();
+
+   // all the bounds active, alternately at the lower and the upper bound
+   std::vector<double> target(number_variables);
+   for (size_t variable_index: Range(number_variables)) {
+      target[variable_index] = (variable_index % 2 == 0) ? -1. : 2.;
+   }
+   solve_box_QP(solver, target, direction);
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   ASSERT_EQ(direction.active_bounds.at_lower_bound.size(), number_variables / 2);
+   ASSERT_EQ(direction.active_bounds.at_upper_bound.size(), number_variables / 2);
+   for (size_t index: Range(number_variables / 2)) {
+      EXPECT_EQ(direction.active_bounds.at_lower_bound[index], 2 * index);
+      EXPECT_EQ(direction.active_bounds.at_upper_bound[index], 2 * index + 1);
+      EXPECT_NEAR(direction.primals[2 * index], 0., 1e-7);
+      EXPECT_NEAR(direction.primals[2 * index + 1], 1., 1e-7);
+      EXPECT_NEAR(direction.multipliers.lower_bounds[2 * index], 1., 1e-7);
+      EXPECT_NEAR(direction.multipliers.upper_bounds[2 * index + 1], -1., 1e-7);
+   }
+   EXPECT_LE(solver.get_number_iterations(), number_interior_iterations + 5);
+}
+
+TEST(InteriorPointQPSolver, WarmStart) {
+   ExampleQP qp{};
+   InteriorPointQPSolver solver(qp.number_variables, qp.number_constraints, 6, 2, interior_point_options());
+   Direction direction(qp.number_variables, qp.number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   qp.solve(solver, direction, warmstart_information);
+   EXPECT_FALSE(solver.is_warm_started());
+   const size_t number_cold_start_iterations = solver.get_number_iterations();
+
+   // the same QP is warm started from its approximate active set
+   warmstart_information.only_variable_bounds_changed();
+   qp.solve(solver, direction, warmstart_information);
+   check_example_solution(direction);
+   EXPECT_TRUE(solver.is_warm_started());
+   EXPECT_LT(solver.get_number_iterations(), number_cold_start_iterations);
+
+   // the new bound cuts off the previous solution and becomes active
+   qp.variables_lower_bounds[0] = 1.6;
+   qp.solve(solver, direction, warmstart_information);
+   const double tolerance = 1e-7;
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 1.6, tolerance);
+   EXPECT_NEAR(direction.primals[1], 1.8, tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[0], 0.7, tolerance);
+   EXPECT_NEAR(direction.multipliers.lower_bounds[0], 0.5, tolerance);
+   ASSERT_EQ(direction.active_bounds.at_lower_bound.size(), 1);
+   EXPECT_EQ(direction.active_bounds.at_lower_bound[0], 0);
+
+   // warm starts can be disabled
+   Options options = interior_point_options();
+   options["interior_point_QP_warm_start"] = "no";
+   InteriorPointQPSolver cold_solver(qp.number_variables, qp.number_constraints, 6, 2, options);
+   qp.solve(cold_solver, direction, warmstart_information);
+   qp.solve(cold_solver, direction, warmstart_information);
+   EXPECT_FALSE(cold_solver.is_warm_started());
+}
+
+TEST(InteriorPointQPSolver, EqualityConstraintAndFixedVariable) {
+   // min 1/2 ||x||^2 s.t. x0 + x1 + x2 = 3, x2 = 0
+   const size_t number_variables = 3;
+   const size_t number_constraints = 1;
+   const std::vector<double> variables_lower_bounds{-INF<double>, -INF<double>, 0.};
+   const std::vector<double> variables_upper_bounds{INF<double>, INF<double>, 0.};
+   const std::vector<double> constraints_lower_bounds{3.};
+   const std::vector<double> constraints_upper_bounds{3.};
+   SparseVector<double> linear_objective(number_variables);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian.insert(1., 0, 0);
+   constraint_jacobian.insert(1., 0, 1);
+   constraint_jacobian.insert(1., 0, 2);
+   SymmetricMatrix<size_t, double> hessian(number_variables, 3, false, "COO");
+   hessian.insert(1., 0, 0);
+   hessian.insert(1., 1, 1);
+   hessian.insert(1., 2, 2);
+
+   InteriorPointQPSolver solver(number_variables, number_constraints, 3, 3, interior_point_options());
+   Direction direction(number_variables, number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   solver.solve_QP(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+         constraints_upper_bounds, linear_objective, constraint_jacobian, hessian, Vector<double>{0., 0., 0.}, direction, warmstart_information);
+   const double tolerance = 1e-7;
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 1.5, tolerance);
+   EXPECT_NEAR(direction.primals[1], 1.5, tolerance);
+   EXPECT_EQ(direction.primals[2], 0.);
+   EXPECT_NEAR(direction.multipliers.constraints[0], 1.5, tolerance);
+   EXPECT_NEAR(direction.multipliers.upper_bounds[2], -1.5, tolerance);
+   ASSERT_EQ(direction.active_bounds.at_upper_bound.size(), 1);
+   EXPECT_EQ(direction.active_bounds.at_upper_bound[0], 2);
+}
+
+// the low-rank correction is restricted to the free variables; its coupling with a fixed variable moves to the linear term
+TEST(InteriorPointQPSolver, LowRankCorrectionWithFixedVariable) {
+   // min 1/2 x^T (I + Ψ Ψ^T) x - 4 x0 - x1 with Ψ = (1, 0, 1) and x2 = 1
+   const size_t number_variables = 3;
+   const std::vector<double> variables_lower_bounds{-10., -10., 1.};
+   const std::vector<double> variables_upper_bounds{10., 10., 1.};
+   const std::vector<double> constraints_bounds{};
+   SparseVector<double> linear_objective(number_variables);
+   linear_objective.insert(0, -4.);
+   linear_objective.insert(1, -1.);
+   RectangularMatrix<double> constraint_jacobian(0, number_variables);
+   SymmetricMatrix<size_t, double> hessian(number_variables, 3, false, "COO");
+   hessian.insert(1., 0, 0);
+   hessian.insert(1., 1, 1);
+   hessian.insert(1., 2, 2);
+   LowRankCorrection<double> correction{};
+   correction.set(number_variables, 1, {1., 0., 1.}, {-1.});
+
+   InteriorPointQPSolver solver(number_variables, 0, 0, 3, interior_point_options());
+   solver.set_hessian_correction(&correction);
+   Direction direction(number_variables, 0);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   solver.solve_QP(number_variables, 0, variables_lower_bounds, variables_upper_bounds, constraints_bounds, constraints_bounds,
+         linear_objective, constraint_jacobian, hessian, Vector<double>{0., 0., 0.}, direction, warmstart_information);
+   // 2 x0 + x2 = 4 and x1 = 1; the multiplier of the fixed variable is (H x + g)_2 = x0 + 2 x2
+   const double tolerance = 1e-7;
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 1.5, tolerance);
+   EXPECT_NEAR(direction.primals[1], 1., tolerance);
+   EXPECT_EQ(direction.primals[2], 1.);
+   EXPECT_NEAR(direction.multipliers.lower_bounds[2], 3.5, tolerance);
+   EXPECT_NEAR(direction.subproblem_objective, 0.5 * (1.5 * 1.5 + 1. + 1. + 2.5 * 2.5) - 6. - 1., tolerance);
+}
+
+// the primal infeasibility stagnates while the multipliers diverge: the infeasibility is detected long before the maximum
+// number of iterations
+TEST(InteriorPointQPSolver, InfeasibilityDetection) {
+   // x0 >= 1 and x0 <= 0
+   const size_t number_variables = 1;
+   const size_t number_constraints = 2;
+   const std::vector<double> variables_lower_bounds{-INF<double>};
+   const std::vector<double> variables_upper_bounds{INF<double>};
+   const std::vector<double> constraints_lower_bounds{1., -INF<double>};
+   const std::vector<double> constraints_upper_bounds{INF<double>, 0.};
+   SparseVector<double> linear_objective(number_variables);
+   linear_objective.insert(0, 1.);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian.insert(1., 0, 0);
+   constraint_jacobian.insert(1., 1, 0);
+   SymmetricMatrix<size_t, double> hessian(number_variables, 1, false, "COO");
+   hessian.insert(1., 0, 0);
+
+   InteriorPointQPSolver solver(number_variables, number_constraints, 2, 1, interior_point_options());
+   Direction direction(number_variables, number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   solver.solve_QP(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+         constraints_upper_bounds, linear_objective, constraint_jacobian, hessian, Vector<double>{0.}, direction, warmstart_information);
+   EXPECT_EQ(direction.status, SubproblemStatus::INFEASIBLE);
+   EXPECT_LE(solver.get_number_iterations(), 20);
+}
+
+// the LP solution is an exact vertex although no crossover is performed: the active bound is identified by its multiplier
+TEST(InteriorPointQPSolver, LPActiveSetWithoutCrossover) {
+   // min x0 + 2x1 s.t. x0 + x1 >= 1, x >= 0
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   const std::vector<double> variables_lower_bounds{0., 0.};
+   const std::vector<double> variables_upper_bounds{INF<double>, INF<double>};
+   const std::vector<double> constraints_lower_bounds{1.};
+   const std::vector<double> constraints_upper_bounds{INF<double>};
+   SparseVector<double> linear_objective(number_variables);
+   linear_objective.insert(0, 1.);
+   linear_objective.insert(1, 2.);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian.insert(1., 0, 0);
+   constraint_jacobian.insert(1., 0, 1);
+
+   InteriorPointQPSolver solver(number_variables, number_constraints, 2, 0, interior_point_options());
+   Direction direction(number_variables, number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   solver.solve_LP(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+         constraints_upper_bounds, linear_objective, constraint_jacobian, Vector<double>{0., 0.}, direction, warmstart_information);
+
+   const double tolerance = 1e-7;
+   ASSERT_EQ(direction.status, SubproblemStatus::OPTIMAL);
+   EXPECT_NEAR(direction.primals[0], 1., tolerance);
+   EXPECT_NEAR(direction.primals[1], 0., tolerance);
+   EXPECT_NEAR(direction.multipliers.constraints[0], 1., tolerance);
+   EXPECT_NEAR(direction.multipliers.lower_bounds[0], 0., tolerance);
+   EXPECT_NEAR(direction.multipliers.lower_bounds[1], 1., tolerance);
+   EXPECT_NEAR(direction.subproblem_objective, 1., tolerance);
+   ASSERT_EQ(direction.active_bounds.at_lower_bound.size(), 1);
+   EXPECT_EQ(direction.active_bounds.at_lower_bound[0], 1);
+   EXPECT_TRUE(direction.active_bounds.at_upper_bound.empty());
+}
+
+TEST(InteriorPointQPSolver, UnboundedLP) {
+   // min -x0 s.t. x0 - x1 <= 1, x >= 0
+   const size_t number_variables = 2;
+   const size_t number_constraints = 1;
+   const std::vector<double> variables_lower_bounds{0., 0.};
+   const std::vector<double> variables_upper_bounds{INF<double>, INF<double>};
+   const std::vector<double> constraints_lower_bounds{-INF<double>};
+   const std::vector<double> constraints_upper_bounds{1.};
+   SparseVector<double> linear_objective(number_variables);
+   linear_objective.insert(0, -1.);
+   RectangularMatrix<double> constraint_jacobian(number_constraints, number_variables);
+   constraint_jacobian.insert(1., 0, 0);
+   constraint_jacobian.insert(-1., 0, 1);
+
+   InteriorPointQPSolver solver(number_variables, number_constraints, 2, 0, interior_point_options());
+   Direction direction(number_variables, number_constraints);
+   WarmstartInformation warmstart_information{};
+   warmstart_information.set_cold_start();
+   solver.solve_LP(number_variables, number_constraints, variables_lower_bounds, variables_upper_bounds, constraints_lower_bounds,
+         constraints_upper_bounds, linear_objective, constraint_jacobian, Vector<double>{0., 0.}, direction, warmstart_information);
+   EXPECT_EQ(direction.status, SubproblemStatus::UNBOUNDED_PROBLEM);
+}
@@ -0,0 +1,271 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "DoubleWellModel.hpp"
+#include "ingredients/constraint_relaxation_strategies/ConstraintRelaxationStrategy.hpp"
+#include "ingredients/hessian_models/LBFGSHessian.hpp"
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "reformulation/OptimalityProblem.hpp"
+#include "solvers/NativeLDL/NativeLDLSolver.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+const size_t number_variables = 5;
+const double tolerance = 1e-10;
+
+static double dot(const Vector<double>& x, const Vector<double>& y) {
+   double result = 0.;
+   for (size_t index: Range(x.size())) {
+      result += x[index] * y[index];
+   }
+   return result;
+}
+
+// y = A s with A symmetric positive definite
+static Vector<double> curvature_pair(const Vector<double>& s) {
+   Vector<double> y(number_variables);
+   for (size_t variable_index: Range(number_variables)) {
+      y[variable_index] = (1. + 0.25 * static_cast<double>(variable_index)) * s[variable_index];
+      if (0 < variable_index) {
+         y[variable_index] += 0.1 * s[variable_index - 1];
+      }
+      if (variable_index + 1 < number_variables) {
+         y[variable_index] += 0.1 * s[variable_index + 1];
+      }
+   }
+   return y;
+}
+
+static Vector<double> step(size_t index) {
+   Vector<double> s(number_variables);
+   for (size_t variable_index: Range(number_variables)) {
+      s[variable_index] = std::sin(static_cast<double>(3 * index + variable_index + 1));
+   }
+   return s;
+}
+
+// dense BFGS recursion B+ = B - B s s^T B / s^T B s + y y^T / s^T y, starting from δI
+static std::vector<double> dense_BFGS(const std::vector<Vector<double>>& s_history, const std::vector<Vector<double>>& y_history, double delta) {
+   const size_t n = number_variables;
+   std::vector<double> B(n * n, 0.);
+   for (size_t index: Range(n)) {
+      B[index * n + index] = delta;
+   }
+   for (size_t pair_index: Range(s_history.size())) {
+      const Vector<double>& s = s_history[pair_index];
+      const Vector<double>& y = y_history[pair_index];
+      std::vector<double> Bs(n, 0.);
+      double sBs = 0., sy = 0.;
+      for (size_t i: Range(n)) {
+         for (size_t j: Range(n)) {
+            Bs[i] += B[i * n + j] * s[j];
+         }
+         sBs += s[i] * Bs[i];
+         sy += s[i] * y[i];
+      }
+      for (size_t i: Range(n)) {
+         for (size_t j: Range(n)) {
+            B[i * n + j] += -Bs[i] * Bs[j] / sBs + y[i] * y[j] / sy;
+         }
+      }
+   }
+   return B;
+}
+
+TEST(LBFGSHessian, CompactFormMatchesRecursion) {
+   const Options options = DefaultOptions::load();
+   LBFGSHessian model(number_variables, options);
+   std::vector<Vector<double>> s_history, y_history;
+   for (size_t pair_index: Range(3)) {
+      const Vector<double> s = step(pair_index);
+      Vector<double> y = curvature_pair(s);
+      s_history.emplace_back(s);
+      y_history.emplace_back(y);
+      ASSERT_TRUE(model.update(s, y, number_variables));
+   }
+   ASSERT_EQ(model.number_pairs(), 3);
+   const std::vector<double> B = dense_BFGS(s_history, y_history, model.get_diagonal());
+
+   const Vector<double> x{1., -2., 0.5, 3., -1.};
+   Vector<double> result(number_variables);
+   model.compute_hessian_vector_product(x, result);
+   for (size_t i: Range(number_variables)) {
+      double reference = 0.;
+      for (size_t j: Range(number_variables)) {
+         reference += B[i * number_variables + j] * x[j];
+      }
+      EXPECT_NEAR(result[i], reference, tolerance);
+   }
+   // quadratic form of the diagonal plus the low-rank correction
+   double quadratic_product = 0.;
+   for (size_t i: Range(number_variables)) {
+      quadratic_product += model.get_diagonal() * x[i] * x[i];
+   }
+   quadratic_product += model.low_rank_correction()->quadratic_product(x);
+   EXPECT_NEAR(quadratic_product, dot(x, result), tolerance);
+}
+
+TEST(LBFGSHessian, Safeguards) {
+   Options options = DefaultOptions::load();
+   options["quasi_newton_memory_size"] = "2";
+   LBFGSHessian model(number_variables, options);
+   // zero step: skipped
+   Vector<double> zero_step(number_variables, 0.);
+   Vector<double> y = curvature_pair(step(0));
+   ASSERT_FALSE(model.update(zero_step, y, number_variables));
+   // negative curvature: the pair is damped and the approximation stays positive definite
+   const Vector<double> s = step(1);
+   Vector<double> negative_y = curvature_pair(s);
+   for (size_t variable_index: Range(number_variables)) {
+      negative_y[variable_index] = -negative_y[variable_index];
+   }
+   ASSERT_TRUE(model.update(s, negative_y, number_variables));
+   Vector<double> Bs(number_variables);
+   model.compute_hessian_vector_product(s, Bs);
+   EXPECT_LT(0., dot(s, Bs));
+   // limited memory
+   for (size_t pair_index: Range(2, 6)) {
+      const Vector<double> new_s = step(pair_index);
+      Vector<double> new_y = curvature_pair(new_s);
+      model.update(new_s, new_y, number_variables);
+   }
+   EXPECT_EQ(model.number_pairs(), 2);
+   EXPECT_EQ(model.low_rank_correction()->get_rank(), 4);
+}
+
+// augmented system [B J^T; J 0] where B is in compact form: the Sherman-Morrison-Woodbury solve reuses the factorization of
+// [δI J^T; J 0] and matches the solve of the explicitly assembled matrix
+TEST(LBFGSHessian, ShermanMorrisonWoodburySolve) {
+   const Options options = DefaultOptions::load();
+   LBFGSHessian model(number_variables, options);
+   for (size_t pair_index: Range(3)) {
+      const Vector<double> s = step(pair_index);
+      Vector<double> y = curvature_pair(s);
+      model.update(s, y, number_variables);
+   }
+   const size_t number_constraints = 2;
+   const size_t dimension = number_variables + number_constraints;
+   RectangularMatrix<double> jacobian(number_constraints, number_variables);
+   jacobian.insert(1., 0, 0);
+   jacobian.insert(2., 0, 3);
+   jacobian.insert(-1., 1, 1);
+   jacobian.insert(1., 1, 4);
+
+   // sparse part: δI
+   SymmetricMatrix<size_t, double> diagonal(number_variables, number_variables, false, "COO");
+   for (size_t variable_index: Range(number_variables)) {
+      diagonal.insert(model.get_diagonal(), variable_index, variable_index);
+   }
+   SymmetricIndefiniteLinearSystem<double> system("COO", dimension, number_variables + 4, true, options);
+   system.assemble_matrix(diagonal, jacobian, number_variables, number_constraints);
+   NativeLDLSolver linear_solver(dimension, dimension + number_variables + 4, options);
+   system.factorize_matrix(linear_solver);
+   for (size_t index: Range(dimension)) {
+      system.rhs[index] = static_cast<double>(index) - 2.;
+   }
+   system.solve(linear_solver, *model.low_rank_correction());
+
+   // explicit matrix: dense B
+   SymmetricMatrix<size_t, double> hessian(number_variables, number_variables * number_variables, false, "COO");
+   Vector<double> unit(number_variables), column(number_variables);
+   for (size_t j: Range(number_variables)) {
+      unit.fill(0.);
+      unit[j] = 1.;
+      model.compute_hessian_vector_product(unit, column);
+      for (size_t i: Range(j + 1)) {
+         hessian.insert(column[i], i, j);
+      }
+   }
+   SymmetricIndefiniteLinearSystem<double> reference_system("COO", dimension, number_variables * number_variables + 4, true, options);
+   reference_system.assemble_matrix(hessian, jacobian, number_variables, number_constraints);
+   NativeLDLSolver reference_solver(dimension, dimension + number_variables * number_variables + 4, options);
+   reference_system.factorize_matrix(reference_solver);
+   reference_system.rhs = system.rhs;
+   reference_system.solve(reference_solver);
+
+   for (size_t index: Range(dimension)) {
+      EXPECT_NEAR(system.solution[index], reference_system.solution[index], 1e-9);
+   }
+}
+
+static const std::vector<Vector<double>> double_well_points{{1., 0.}, {1.1, 0.2}, {0.9, 0.35}, {0.95, 0.45}};
+
+// the pairs are formed with the derivatives cached in the iterates: no additional evaluation
+TEST(LBFGSHessian, EvaluationAtIterateReusesDerivatives) {
+   const Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem problem(model);
+   LBFGSHessian hessian_model(model.number_variables, options);
+   LBFGSHessian reference_hessian_model(model.number_variables, options);
+   const Vector<double> multipliers{0.5};
+
+   Iterate::reset_evaluation_counters();
+   for (const Vector<double>& point: double_well_points) {
+      Iterate iterate(model.number_variables, model.number_constraints);
+      iterate.primals = point;
+      // the subproblem evaluates the derivatives at the current iterate
+      iterate.evaluate_objective_gradient(model);
+      iterate.evaluate_constraint_jacobian(model);
+      hessian_model.evaluate(statistics, problem, iterate, multipliers);
+   }
+   ASSERT_EQ(Iterate::number_eval_objective_gradient, double_well_points.size());
+   ASSERT_EQ(Iterate::number_eval_jacobian, double_well_points.size());
+
+   // same approximation as the model that evaluates the derivatives itself
+   for (const Vector<double>& point: double_well_points) {
+      reference_hessian_model.evaluate(statistics, problem, point, multipliers);
+   }
+   ASSERT_EQ(hessian_model.number_pairs(), reference_hessian_model.number_pairs());
+   ASSERT_LT(0, hessian_model.number_pairs());
+   EXPECT_NEAR(hessian_model.get_diagonal(), reference_hessian_model.get_diagonal(), tolerance);
+   const Vector<double> x{0.3, -0.7};
+   Vector<double> result(model.number_variables), reference_result(model.number_variables);
+   hessian_model.compute_hessian_vector_product(x, result);
+   reference_hessian_model.compute_hessian_vector_product(x, reference_result);
+   for (size_t variable_index: Range(model.number_variables)) {
+      EXPECT_NEAR(result[variable_index], reference_result[variable_index], tolerance);
+   }
+}
+
+// the second-order predicted reduction of the trust-region methods uses d^T B d, including the low-rank correction
+TEST(LBFGSHessian, PredictedObjectiveReduction) {
+   const Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem problem(model);
+   LBFGSHessian hessian_model(model.number_variables, options);
+   const Vector<double> multipliers{0.5};
+   Iterate iterate(model.number_variables, model.number_constraints);
+   for (const Vector<double>& point: double_well_points) {
+      iterate = Iterate(model.number_variables, model.number_constraints);
+      iterate.primals = point;
+      hessian_model.evaluate(statistics, problem, iterate, multipliers);
+   }
+   ASSERT_LT(0, hessian_model.number_pairs());
+
+   const Vector<double> direction{0.3, -0.2};
+   Vector<double> Bd(model.number_variables);
+   hessian_model.compute_hessian_vector_product(direction, Bd);
+   const double dBd = dot(direction, Bd);
+   // the diagonal alone gives a different curvature
+   ASSERT_GT(std::abs(hessian_model.hessian.quadratic_product(direction, direction) - dBd), 1e-6);
+
+   const double step_length = 0.5;
+   const double objective_multiplier = 2.;
+   double directional_derivative = 0.;
+   for (const auto [variable_index, derivative]: iterate.evaluations.objective_gradient) {
+      directional_derivative += derivative * direction[variable_index];
+   }
+   const auto predicted_reduction = ConstraintRelaxationStrategy::compute_predicted_objective_reduction_model(iterate, direction, step_length,
+         hessian_model);
+   EXPECT_NEAR(predicted_reduction(objective_multiplier), -step_length * objective_multiplier * directional_derivative -
+      step_length * step_length / 2. * dBd, tolerance);
+}
@@ -0,0 +1,111 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "DoubleWellModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "model/BoundRelaxedModel.hpp"
+#include "model/FixedBoundsConstraintsModel.hpp"
+#include "model/HomogeneousEqualityConstrainedModel.hpp"
+#include "model/ScaledModel.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "reformulation/l1RelaxedProblem.hpp"
+#include "reformulation/OptimalityProblem.hpp"
+#include "symbolic/Range.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-12;
+
+// product of the assembled Hessian (upper triangle) with a vector
+static Vector<double> assembled_product(const SymmetricMatrix<size_t, double>& hessian, const Vector<double>& vector) {
+   Vector<double> result(vector.size(), 0.);
+   hessian.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      result[row_index] += element * vector[column_index];
+      if (row_index != column_index) {
+         result[column_index] += element * vector[row_index];
+      }
+   });
+   return result;
+}
+
+static void check_model_product(const Model& model, const Vector<double>& x, double objective_multiplier, const Vector<double>& multipliers) {
+   SymmetricMatrix<size_t, double> hessian(model.number_variables, model.number_hessian_nonzeros(), false, "COO");
+   model.evaluate_lagrangian_hessian(x, objective_multiplier, multipliers, hessian);
+   Vector<double> vector(model.number_variables);
+   for (size_t variable_index: Range(model.number_variables)) {
+      vector[variable_index] = 1. + static_cast<double>(variable_index);
+   }
+   const Vector<double> expected_product = assembled_product(hessian, vector);
+   Vector<double> product(model.number_variables, 1e10);
+   model.evaluate_lagrangian_hessian_vector_product(x, objective_multiplier, multipliers, vector, product);
+   for (size_t variable_index: Range(model.number_variables)) {
+      EXPECT_NEAR(product[variable_index], expected_product[variable_index], tolerance);
+   }
+}
+
+static void check_problem_product(const OptimizationProblem& problem, const Vector<double>& x, const Vector<double>& multipliers) {
+   SymmetricMatrix<size_t, double> hessian(problem.number_variables, problem.number_hessian_nonzeros(), false, "COO");
+   problem.evaluate_lagrangian_hessian(x, multipliers, hessian);
+   Vector<double> vector(problem.number_variables);
+   for (size_t variable_index: Range(problem.number_variables)) {
+      vector[variable_index] = 1. + static_cast<double>(variable_index);
+   }
+   const Vector<double> expected_product = assembled_product(hessian, vector);
+   Vector<double> product(problem.number_variables, 1e10);
+   problem.evaluate_lagrangian_hessian_vector_product(x, multipliers, vector, product);
+   for (size_t variable_index: Range(problem.number_variables)) {
+      EXPECT_NEAR(product[variable_index], expected_product[variable_index], tolerance);
+   }
+}
+
+TEST(LagrangianHessianVectorProduct, DoubleWellModel) {
+   const DoubleWellModel model;
+   check_model_product(model, Vector<double>{0.7, -1.3}, 0.8, Vector<double>{0.5});
+}
+
+TEST(LagrangianHessianVectorProduct, ScaledModel) {
+   Options options = DefaultOptions::load();
+   options["scale_functions"] = "yes";
+   options["function_scaling_threshold"] = "0.1";
+   // the gradients at (1, 2) are scaled by different factors
+   Iterate initial_iterate(2, 1);
+   initial_iterate.primals[0] = 1.;
+   initial_iterate.primals[1] = 2.;
+   const ScaledModel model(std::make_unique<DoubleWellModel>(), initial_iterate, options);
+   check_model_product(model, Vector<double>{0.7, -1.3}, 0.8, Vector<double>{0.5});
+}
+
+TEST(LagrangianHessianVectorProduct, HomogeneousEqualityConstrainedModel) {
+   // the inequality constraint is reformulated with a slack
+   const HomogeneousEqualityConstrainedModel model(std::make_unique<DoubleWellModel>());
+   ASSERT_EQ(model.number_variables, 3);
+   check_model_product(model, Vector<double>{0.7, -1.3, 0.2}, 0.8, Vector<double>{0.5});
+}
+
+TEST(LagrangianHessianVectorProduct, BoundRelaxedAndFixedBoundsModels) {
+   const Options options = DefaultOptions::load();
+   const BoundRelaxedModel bound_relaxed_model(std::make_unique<DoubleWellModel>(), options);
+   check_model_product(bound_relaxed_model, Vector<double>{0.7, -1.3}, 0.8, Vector<double>{0.5});
+   const FixedBoundsConstraintsModel fixed_bounds_model(std::make_unique<DoubleWellModel>(), options);
+   check_model_product(fixed_bounds_model, Vector<double>{0.7, -1.3}, 0.8, Vector<double>{0.5});
+}
+
+TEST(LagrangianHessianVectorProduct, OptimalityProblem) {
+   const HomogeneousEqualityConstrainedModel model(std::make_unique<DoubleWellModel>());
+   const OptimalityProblem problem(model);
+   check_problem_product(problem, Vector<double>{0.7, -1.3, 0.2}, Vector<double>{0.5});
+}
+
+TEST(LagrangianHessianVectorProduct, l1RelaxedProblemWithProximalTerm) {
+   const HomogeneousEqualityConstrainedModel model(std::make_unique<DoubleWellModel>());
+   const Vector<double> proximal_center{2., 0.5, 1.};
+   l1RelaxedProblem problem(model, 0.8, 1., 0.3, proximal_center.data());
+   // the equality constraint is relaxed with two elastic variables
+   ASSERT_EQ(problem.number_variables, 5);
+   check_problem_product(problem, Vector<double>{0.7, -1.3, 0.2, 0.1, 0.4}, Vector<double>{0.5});
+}
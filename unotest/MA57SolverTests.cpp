@@ -74,3 +74,32 @@ TEST(MA57Solver, SingularMatrix) {
    // expected inertia (1, 1, 2)
    ASSERT_TRUE(solver.matrix_is_singular());
 }
+
+TEST(MA57Solver, MultipleRightHandSides) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+   // column-major block: the second right-hand side is twice the first one
+   const size_t number_rhs = 2;
+   const Vector<double> rhs{8., 45., 31., 15., 17., 16., 90., 62., 30., 34.};
+   Vector<double> result(n * number_rhs);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   MA57Solver solver(n, nnz);
+   solver.do_symbolic_factorization(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_systems(matrix, rhs, result, number_rhs);
+
+   for (size_t rhs_index: Range(number_rhs)) {
+      for (size_t index: Range(n)) {
+         EXPECT_DOUBLE_EQ(result[rhs_index * n + index], static_cast<double>(rhs_index + 1) * reference[index]);
+      }
+   }
+}
@@ -0,0 +1,155 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "solvers/MINRES/MINRESSolver.hpp"
+
+using namespace uno;
+
+static void fill_matrix_size_5(SymmetricMatrix<size_t, double>& matrix) {
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+}
+
+// KKT matrix [H J^T; J 0] with a random sparse Jacobian and a positive diagonal Hessian
+static void fill_random_KKT_matrix(SymmetricMatrix<size_t, double>& matrix, size_t number_variables, size_t number_constraints) {
+   std::mt19937 generator(42);
+   std::uniform_real_distribution<double> distribution(-1., 1.);
+   std::uniform_int_distribution<size_t> variable_distribution(0, number_variables - 1);
+   for (size_t variable_index: Range(number_variables)) {
+      matrix.insert(2. + distribution(generator), variable_index, variable_index);
+      if (0 < variable_index) {
+         matrix.insert(0.1 * distribution(generator), variable_index - 1, variable_index);
+      }
+   }
+   for (size_t constraint_index: Range(number_constraints)) {
+      matrix.insert(1. + distribution(generator), constraint_index, number_variables + constraint_index);
+      for ([[maybe_unused]] size_t term: Range(3)) {
+         matrix.insert(distribution(generator), variable_distribution(generator), number_variables + constraint_index);
+      }
+   }
+}
+
+static Options MINRES_options(const std::string& maximum_relative_tolerance) {
+   Options options = DefaultOptions::load();
+   options["MINRES_maximum_relative_tolerance"] = maximum_relative_tolerance;
+   return options;
+}
+
+static double relative_residual(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& rhs, const Vector<double>& solution) {
+   const size_t n = matrix.dimension();
+   Vector<double> residual(n);
+   for (size_t index: Range(n)) {
+      residual[index] = rhs[index];
+   }
+   matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      residual[row_index] -= element * solution[column_index];
+      if (row_index != column_index) {
+         residual[column_index] -= element * solution[row_index];
+      }
+   });
+   double residual_norm = 0., rhs_norm = 0.;
+   for (size_t index: Range(n)) {
+      residual_norm += residual[index] * residual[index];
+      rhs_norm += rhs[index] * rhs[index];
+   }
+   return std::sqrt(residual_norm / rhs_norm);
+}
+
+TEST(MINRESSolver, SystemSize5) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_matrix_size_5(matrix);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   MINRESSolver solver(n, MINRES_options("1e-12"));
+   ASSERT_FALSE(solver.provides_inertia());
+   solver.factorize(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], 1e-8);
+   }
+}
+
+TEST(MINRESSolver, LargeKKTSystem) {
+   const size_t number_variables = 300;
+   const size_t number_constraints = 100;
+   const size_t n = number_variables + number_constraints;
+   SymmetricMatrix<size_t, double> matrix(n, 2 * number_variables + 4 * number_constraints, false, "COO");
+   fill_random_KKT_matrix(matrix, number_variables, number_constraints);
+   Vector<double> rhs(n);
+   for (size_t index: Range(n)) {
+      rhs[index] = std::sin(static_cast<double>(index));
+   }
+   Vector<double> result(n);
+
+   MINRESSolver solver(n, MINRES_options("1e-10"));
+   solver.factorize(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+   EXPECT_LT(relative_residual(matrix, rhs, result), 1e-8);
+   EXPECT_LT(solver.get_number_iterations(), n);
+}
+
+TEST(MINRESSolver, AdaptiveTolerance) {
+   const size_t number_variables = 300;
+   const size_t number_constraints = 100;
+   const size_t n = number_variables + number_constraints;
+   SymmetricMatrix<size_t, double> matrix(n, 2 * number_variables + 4 * number_constraints, false, "COO");
+   fill_random_KKT_matrix(matrix, number_variables, number_constraints);
+   MINRESSolver solver(n, MINRES_options("1e-2"));
+   solver.factorize(matrix);
+
+   // the closer the rhs (KKT residual) to zero, the tighter the relative tolerance
+   Vector<double> rhs(n);
+   Vector<double> result(n);
+   std::vector<size_t> number_iterations{};
+   for (const double scaling: {1., 1e-12}) {
+      for (size_t index: Range(n)) {
+         rhs[index] = scaling * std::sin(static_cast<double>(index));
+      }
+      solver.solve_indefinite_system(matrix, rhs, result);
+      number_iterations.emplace_back(solver.get_number_iterations());
+   }
+   EXPECT_LT(number_iterations[0], number_iterations[1]);
+   EXPECT_LT(relative_residual(matrix, rhs, result), 1e-5);
+}
+
+// min (x0^2 - x1^2)/2 s.t. x0 = 1 with an inertia-free solver: the regularization relies on the curvature test
+TEST(MINRESSolver, InertiaFreeRegularization) {
+   const Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   SymmetricMatrix<size_t, double> hessian(2, 2, false, "COO");
+   hessian.insert(1., 0, 0);
+   hessian.insert(-1., 1, 1);
+   RectangularMatrix<double> jacobian(1, 2);
+   jacobian.insert(1., 0, 0);
+   SymmetricIndefiniteLinearSystem<double> system("COO", 3, 3, true, options);
+   MINRESSolver linear_solver(3, options);
+   ASSERT_TRUE(system.uses_curvature_test(linear_solver));
+
+   system.assemble_matrix(hessian, jacobian, 2, 1);
+   system.rhs[0] = 0.;
+   system.rhs[1] = -5.;
+   system.rhs[2] = 1.;
+   system.regularize_matrix(statistics, linear_solver, 2, 1, 1e-8);
+   system.solve(linear_solver);
+   // the step has positive curvature on the regularized Hessian
+   ASSERT_LT(1, system.get_number_factorizations());
+   EXPECT_NEAR(system.solution[0], 1., 1e-6);
+   EXPECT_LT(system.solution[1], 0.);
+}
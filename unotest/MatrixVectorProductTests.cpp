@@ -4,7 +4,10 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include "linear_algebra/RectangularMatrix.hpp"
+#include "linear_algebra/Vector.hpp"
 #include "symbolic/MatrixVectorProduct.hpp"
+#include "symbolic/Range.hpp"
+#include "symbolic/ScalarMultiple.hpp"
 
 using namespace uno;
 
@@ -13,10 +16,10 @@ TEST(MatrixVectorProduct, Test) {
    // (7, 11)
    const size_t dimension = 2;
    RectangularMatrix<double> matrix(dimension, dimension);
-   matrix[0].insert(0, 3.);
-   matrix[0].insert(1, 7.);
-   matrix[1].insert(0, 7.);
-   matrix[1].insert(1, 11.);
+   matrix.insert(3., 0, 0);
+   matrix.insert(7., 0, 1);
+   matrix.insert(7., 1, 0);
+   matrix.insert(11., 1, 1);
    const std::vector<double> x{-2., 3.};
    const auto result = matrix * x;
    const std::vector<double> reference_result{15., 19.};
@@ -24,3 +27,26 @@ TEST(MatrixVectorProduct, Test) {
       ASSERT_EQ(result[i], reference_result[i]);
    }
 }
+
+TEST(MatrixVectorProduct, SparseKernelMatchesGenericProduct) {
+   // the contiguous vector goes through the sparse kernel, the expression through the generic dot product
+   const size_t number_rows = 3;
+   const size_t number_columns = 9;
+   RectangularMatrix<double> matrix(number_rows, number_columns);
+   for (size_t row_index: Range(number_rows)) {
+      for (size_t column_index: Range(row_index, number_columns)) {
+         matrix.insert(static_cast<double>(row_index + 1) - 0.5 * static_cast<double>(column_index), row_index, column_index);
+      }
+   }
+   const Vector<double> x{1., -2., 3., 0.5, 0., 4., -1., 2., 0.25};
+   const auto kernel_result = matrix * x;
+   const auto generic_result = matrix * (2. * x);
+   for (size_t row_index: Range(number_rows)) {
+      double reference_result = 0.;
+      for (const auto [column_index, element]: matrix[row_index]) {
+         reference_result += element * x[column_index];
+      }
+      EXPECT_DOUBLE_EQ(kernel_result[row_index], reference_result);
+      EXPECT_DOUBLE_EQ(generic_result[row_index], 2. * reference_result);
+   }
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include "DoubleWellModel.hpp"
+#include "Multistart.hpp"
+#include "model/ModelFactory.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "tools/Infinity.hpp"
+
+using namespace uno;
+
+const std::vector<double> lower_bounds{0., -INF<double>, -1., 2.};
+const std::vector<double> upper_bounds{10., INF<double>, INF<double>, 2.};
+const Vector<double> initial_point{1., 3., 0.5, 2.};
+
+TEST(Multistart, LatinHypercubeSample) {
+   const size_t number_points = 9;
+   const std::vector<Vector<double>> points = Multistart::generate_starting_points(lower_bounds, upper_bounds, initial_point, number_points,
+         MultistartSampling::LATIN_HYPERCUBE, 1., 0);
+   ASSERT_EQ(points.size(), number_points);
+   // the first point is the initial point
+   for (size_t variable_index: Range(initial_point.size())) {
+      EXPECT_EQ(points[0][variable_index], initial_point[variable_index]);
+   }
+   // each stratum of [0, 10] contains exactly one sample of the first variable
+   std::vector<size_t> samples_per_stratum(number_points - 1, 0);
+   for (size_t point_index: Range(1, number_points)) {
+      const double x = points[point_index][0];
+      ASSERT_LE(0., x);
+      ASSERT_LE(x, 10.);
+      samples_per_stratum[std::min(number_points - 2, static_cast<size_t>(x / 10. * static_cast<double>(number_points - 1)))]++;
+   }
+   EXPECT_EQ(samples_per_stratum, std::vector<size_t>(number_points - 1, 1));
+   // the samples stay within the bounds, or within the box around the initial point when a bound is infinite
+   for (size_t point_index: Range(1, number_points)) {
+      EXPECT_LE(std::abs(points[point_index][1] - 3.), 3.);
+      EXPECT_LE(-1., points[point_index][2]);
+      EXPECT_LE(points[point_index][2], 1.5);
+      EXPECT_EQ(points[point_index][3], 2.);
+   }
+}
+
+TEST(Multistart, PerturbationSample) {
+   const size_t number_points = 20;
+   const std::vector<Vector<double>> points = Multistart::generate_starting_points(lower_bounds, upper_bounds, initial_point, number_points,
+         MultistartSampling::PERTURBATION, 2., 1);
+   for (size_t point_index: Range(1, number_points)) {
+      for (size_t variable_index: Range(initial_point.size())) {
+         const double x = points[point_index][variable_index];
+         EXPECT_LE(lower_bounds[variable_index], x);
+         EXPECT_LE(x, upper_bounds[variable_index]);
+         EXPECT_LE(std::abs(x - initial_point[variable_index]), 2. * std::max(1., std::abs(initial_point[variable_index])));
+      }
+   }
+}
+
+TEST(Multistart, SameSeedSamePoints) {
+   const std::vector<Vector<double>> points = Multistart::generate_starting_points(lower_bounds, upper_bounds, initial_point, 5,
+         MultistartSampling::LATIN_HYPERCUBE, 1., 42);
+   const std::vector<Vector<double>> other_points = Multistart::generate_starting_points(lower_bounds, upper_bounds, initial_point, 5,
+         MultistartSampling::LATIN_HYPERCUBE, 1., 42);
+   for (size_t point_index: Range(5)) {
+      for (size_t variable_index: Range(initial_point.size())) {
+         EXPECT_EQ(points[point_index][variable_index], other_points[point_index][variable_index]);
+      }
+   }
+}
+
+// the runs from the basins of the two minima of the double-well model find two distinct local solutions; the other runs are duplicates,
+// either cut off early or detected when they converge
+TEST(Multistart, DuplicateLocalSolutions) {
+   for (const std::string cutoff_iteration: {"1", "1000"}) {
+      Options options = DefaultOptions::load();
+      options.overwrite_with(DefaultOptions::determine_solvers_and_preset());
+      Options::set_preset(options, "ipopt");
+      options["logger"] = "SILENT";
+      options["multistart_points"] = "8";
+      // sequential runs: the local solutions of the previous runs are known
+      options["multistart_threads"] = "1";
+      options["multistart_cutoff_iteration"] = cutoff_iteration;
+      options["multistart_cutoff_distance"] = "1e-3";
+      Multistart multistart(options);
+      const Result result = multistart.solve([&]() {
+         return ModelFactory::reformulate(std::make_unique<DoubleWellModel>(), options);
+      }, options);
+
+      ASSERT_EQ(multistart.number_local_solutions, 2);
+      ASSERT_EQ(multistart.number_duplicate_runs, 6);
+      // the best objective is returned, although the initial point lies in the basin of the other minimum
+      ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+      EXPECT_NEAR(result.solution.primals[0], DoubleWellModel::global_minimum_x0, 1e-6);
+      EXPECT_NEAR(result.solution.primals[1], 0.5, 1e-6);
+      EXPECT_NEAR(DoubleWellModel().evaluate_objective(result.solution.primals), -0.305428483743916, 1e-10);
+   }
+}
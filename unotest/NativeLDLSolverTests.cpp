@@ -0,0 +1,274 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <random>
+#include "linear_algebra/Norm.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "solvers/NativeLDL/NativeLDLSolver.hpp"
+
+using namespace uno;
+
+static void fill_matrix_size_5(SymmetricMatrix<size_t, double>& matrix) {
+   matrix.insert(2., 0, 0);
+   matrix.insert(3., 0, 1);
+   matrix.insert(4., 1, 2);
+   matrix.insert(6., 1, 4);
+   matrix.insert(1., 2, 2);
+   matrix.insert(5., 2, 3);
+   matrix.insert(1., 4, 4);
+}
+
+// KKT matrix [H J^T; J 0] with a random sparse Jacobian and a diagonal Hessian of mixed signs
+static void fill_random_KKT_matrix(SymmetricMatrix<size_t, double>& matrix, size_t number_variables, size_t number_constraints) {
+   std::mt19937 generator(42);
+   std::uniform_real_distribution<double> distribution(-1., 1.);
+   std::uniform_int_distribution<size_t> variable_distribution(0, number_variables - 1);
+   for (size_t variable_index: Range(number_variables)) {
+      matrix.insert(distribution(generator) + (variable_index % 3 == 0 ? -2. : 2.), variable_index, variable_index);
+      if (0 < variable_index) {
+         matrix.insert(0.1 * distribution(generator), variable_index - 1, variable_index);
+      }
+   }
+   for (size_t constraint_index: Range(number_constraints)) {
+      matrix.insert(1. + distribution(generator), constraint_index, number_variables + constraint_index);
+      for ([[maybe_unused]] size_t term: Range(3)) {
+         matrix.insert(distribution(generator), variable_distribution(generator), number_variables + constraint_index);
+      }
+   }
+}
+
+static Options native_LDL_options(size_t number_threads) {
+   Options options = DefaultOptions::load();
+   options["native_LDL_threads"] = std::to_string(number_threads);
+   return options;
+}
+
+TEST(NativeLDLSolver, SystemSize5) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_matrix_size_5(matrix);
+   const Vector<double> rhs{8., 45., 31., 15., 17.};
+   Vector<double> result(n);
+   result.fill(0.);
+   const std::array<double, n> reference{1., 2., 3., 4., 5.};
+
+   NativeLDLSolver solver(n, nnz, native_LDL_options(1));
+   solver.do_symbolic_factorization(matrix);
+   solver.do_numerical_factorization(matrix);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], reference[index], 1e-12);
+   }
+}
+
+TEST(NativeLDLSolver, Inertia) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_matrix_size_5(matrix);
+
+   NativeLDLSolver solver(n, nnz, native_LDL_options(1));
+   solver.do_symbolic_factorization(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 3);
+   ASSERT_EQ(number_negative, 2);
+   ASSERT_EQ(number_zero, 0);
+   ASSERT_EQ(solver.rank(), n);
+}
+
+TEST(NativeLDLSolver, SingularMatrix) {
+   const size_t n = 4;
+   const size_t nnz = 7;
+   // comes from hs015 solved with byrd preset
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert( -0.0198, 0, 0);
+   matrix.insert(0.625075, 0, 0);
+   matrix.insert(-0.277512, 0, 1);
+   matrix.insert(-0.624975, 1, 1);
+   matrix.insert(0.625075, 1, 1);
+   matrix.insert(0., 2, 2);
+   matrix.insert(0., 3, 3);
+   NativeLDLSolver solver(n, nnz, native_LDL_options(1));
+   solver.do_symbolic_factorization(matrix);
+   solver.do_numerical_factorization(matrix);
+
+   // expected inertia (1, 1, 2)
+   ASSERT_TRUE(solver.matrix_is_singular());
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 1);
+   ASSERT_EQ(number_negative, 1);
+   ASSERT_EQ(number_zero, 2);
+}
+
+TEST(NativeLDLSolver, ForcedZeroPivotAtRoot) {
+   const size_t n = 4;
+   const size_t nnz = 3;
+   // path 3 - 0 - 1 - 2 with badly scaled entries: the 2x2 block left in the root front after the first 2x2 pivot is numerically
+   // zero and no stable pivot exists. The forced pivots are zero pivots
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   matrix.insert(-2e6, 0, 1);
+   matrix.insert(-2e-5, 0, 3);
+   matrix.insert(1e-3, 1, 2);
+   for (size_t number_threads: {1, 2}) {
+      NativeLDLSolver solver(n, nnz, native_LDL_options(number_threads));
+      solver.do_symbolic_factorization(matrix);
+      solver.do_numerical_factorization(matrix);
+      ASSERT_TRUE(solver.matrix_is_singular());
+      const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+      ASSERT_EQ(number_positive, 1);
+      ASSERT_EQ(number_negative, 1);
+      ASSERT_EQ(number_zero, 2);
+      ASSERT_EQ(solver.rank(), 2);
+   }
+}
+
+TEST(NativeLDLSolver, LargeKKTSystem) {
+   const size_t number_variables = 300;
+   const size_t number_constraints = 100;
+   const size_t n = number_variables + number_constraints;
+   const size_t nnz = 2 * number_variables - 1 + 4 * number_constraints;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_random_KKT_matrix(matrix, number_variables, number_constraints);
+   Vector<double> rhs(n);
+   for (size_t index: Range(n)) {
+      rhs[index] = std::sin(static_cast<double>(index));
+   }
+
+   for (size_t number_threads: {1, 4}) {
+      NativeLDLSolver solver(n, nnz, native_LDL_options(number_threads));
+      solver.do_symbolic_factorization(matrix);
+      solver.do_numerical_factorization(matrix);
+      Vector<double> result(n);
+      solver.solve_indefinite_system(matrix, rhs, result);
+
+      // residual r = K x - b
+      Vector<double> residual(n);
+      for (size_t index: Range(n)) {
+         residual[index] = -rhs[index];
+      }
+      matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+         residual[row_index] += element * result[column_index];
+         if (row_index != column_index) {
+            residual[column_index] += element * result[row_index];
+         }
+      });
+      EXPECT_LT(norm_inf(residual), 1e-10);
+      const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+      EXPECT_EQ(number_positive + number_negative + number_zero, n);
+      EXPECT_EQ(number_zero, 0);
+   }
+}
+
+TEST(NativeLDLSolver, ParallelRefactorizations) {
+   // the thread pool and the per-thread workspaces are reused by the numerical factorizations
+   const size_t number_variables = 300;
+   const size_t number_constraints = 100;
+   const size_t n = number_variables + number_constraints;
+   const size_t nnz = 2 * number_variables - 1 + 4 * number_constraints;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_random_KKT_matrix(matrix, number_variables, number_constraints);
+   NativeLDLSolver sequential_solver(n, nnz, native_LDL_options(1));
+   NativeLDLSolver parallel_solver(n, nnz, native_LDL_options(4));
+   sequential_solver.do_symbolic_factorization(matrix);
+   parallel_solver.do_symbolic_factorization(matrix);
+   for (size_t factorization_index: Range(5)) {
+      // perturb the values, the pattern is unchanged
+      double* values = matrix.data_pointer();
+      for (size_t position: Range(matrix.number_nonzeros())) {
+         values[position] += std::sin(static_cast<double>(position + factorization_index));
+      }
+      sequential_solver.do_numerical_factorization(matrix);
+      parallel_solver.do_numerical_factorization(matrix);
+      ASSERT_EQ(parallel_solver.get_inertia(), sequential_solver.get_inertia());
+   }
+}
+
+TEST(NativeLDLSolver, RefactorizationWithSamePattern) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_matrix_size_5(matrix);
+   NativeLDLSolver solver(n, nnz, native_LDL_options(1));
+   solver.factorize(matrix);
+
+   // same pattern, values multiplied by -1: the inertia is flipped
+   SymmetricMatrix<size_t, double> negated_matrix(n, nnz, false, "COO");
+   negated_matrix.insert(-2., 0, 0);
+   negated_matrix.insert(-3., 0, 1);
+   negated_matrix.insert(-4., 1, 2);
+   negated_matrix.insert(-6., 1, 4);
+   negated_matrix.insert(-1., 2, 2);
+   negated_matrix.insert(-5., 2, 3);
+   negated_matrix.insert(-1., 4, 4);
+   solver.factorize(negated_matrix);
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, 2);
+   ASSERT_EQ(number_negative, 3);
+   ASSERT_EQ(number_zero, 0);
+}
+
+TEST(NativeLDLSolver, RefactorizationWithMovedEntry) {
+   const size_t n = 5;
+   const size_t nnz = 7;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_matrix_size_5(matrix);
+   NativeLDLSolver solver(n, nnz, native_LDL_options(1));
+   solver.factorize(matrix);
+
+   // same dimension and number of nonzeros, but the entry (1, 4) moved to (3, 4): the symbolic factorization is redone
+   SymmetricMatrix<size_t, double> moved_matrix(n, nnz, false, "COO");
+   moved_matrix.insert(2., 0, 0);
+   moved_matrix.insert(3., 0, 1);
+   moved_matrix.insert(4., 1, 2);
+   moved_matrix.insert(6., 3, 4);
+   moved_matrix.insert(1., 2, 2);
+   moved_matrix.insert(5., 2, 3);
+   moved_matrix.insert(1., 4, 4);
+   solver.factorize(moved_matrix);
+   const Vector<double> rhs{8., 15., 31., 45., 29.};
+   Vector<double> result(n);
+   solver.solve_indefinite_system(moved_matrix, rhs, result);
+   for (size_t index: Range(n)) {
+      EXPECT_NEAR(result[index], static_cast<double>(index + 1), 1e-12);
+   }
+}
+
+TEST(NativeLDLSolver, MultipleRightHandSides) {
+   const size_t number_variables = 60;
+   const size_t number_constraints = 20;
+   const size_t n = number_variables + number_constraints;
+   const size_t nnz = 2 * number_variables - 1 + 4 * number_constraints;
+   SymmetricMatrix<size_t, double> matrix(n, nnz, false, "COO");
+   fill_random_KKT_matrix(matrix, number_variables, number_constraints);
+   NativeLDLSolver solver(n, nnz, native_LDL_options(1));
+   solver.factorize(matrix);
+
+   // column-major block of 3 right-hand sides
+   const size_t number_rhs = 3;
+   Vector<double> rhs(n * number_rhs);
+   for (size_t index: Range(n * number_rhs)) {
+      rhs[index] = std::cos(static_cast<double>(index));
+   }
+   Vector<double> result(n * number_rhs);
+   solver.solve_indefinite_systems(matrix, rhs, result, number_rhs);
+
+   // reference: one solve per right-hand side
+   Vector<double> column_rhs(n), column_result(n);
+   for (size_t rhs_index: Range(number_rhs)) {
+      for (size_t index: Range(n)) {
+         column_rhs[index] = rhs[rhs_index * n + index];
+      }
+      solver.solve_indefinite_system(matrix, column_rhs, column_result);
+      for (size_t index: Range(n)) {
+         EXPECT_NEAR(result[rhs_index * n + index], column_result[index], 1e-12);
+      }
+   }
+}
@@ -0,0 +1,223 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include "linear_algebra/Norm.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "ordering/ApproximateMinimumDegreeOrdering.hpp"
+#include "ordering/NestedDissectionOrdering.hpp"
+#include "ordering/SymmetricGraph.hpp"
+#include "solvers/NativeLDL/NativeLDLSolver.hpp"
+
+using namespace uno;
+
+// 5-point Laplacian on a grid_size x grid_size grid
+static void fill_grid_laplacian(SymmetricMatrix<size_t, double>& matrix, size_t grid_size) {
+   for (size_t i = 0; i < grid_size; i++) {
+      for (size_t j = 0; j < grid_size; j++) {
+         const size_t vertex = i * grid_size + j;
+         matrix.insert(4., vertex, vertex);
+         if (j + 1 < grid_size) {
+            matrix.insert(-1., vertex, vertex + 1);
+         }
+         if (i + 1 < grid_size) {
+            matrix.insert(-1., vertex, vertex + grid_size);
+         }
+      }
+   }
+}
+
+// arrow matrix whose dense row/column comes first
+static void fill_arrow_matrix(SymmetricMatrix<size_t, double>& matrix, size_t dimension) {
+   matrix.insert(static_cast<double>(dimension), 0, 0);
+   for (size_t index = 1; index < dimension; index++) {
+      matrix.insert(1., 0, index);
+      matrix.insert(2., index, index);
+   }
+}
+
+static bool is_permutation(const Permutation& permutation, size_t dimension) {
+   std::vector<size_t> sorted_permutation(permutation);
+   std::sort(sorted_permutation.begin(), sorted_permutation.end());
+   for (size_t index = 0; index < sorted_permutation.size(); index++) {
+      if (sorted_permutation[index] != index) {
+         return false;
+      }
+   }
+   return sorted_permutation.size() == dimension;
+}
+
+// number of off-diagonal nonzeros of the Cholesky factor of the permuted matrix (symbolic elimination)
+static size_t factor_fill(const SymmetricGraph& graph, const Permutation& permutation) {
+   const size_t n = graph.number_vertices();
+   const Permutation inverse_permutation = invert_permutation(permutation);
+   std::vector<std::set<size_t>> structures(n);
+   for (size_t vertex = 0; vertex < n; vertex++) {
+      for (size_t position = graph.neighbors_start(vertex); position < graph.neighbors_end(vertex); position++) {
+         const size_t row = inverse_permutation[graph.neighbor(position)];
+         if (inverse_permutation[vertex] < row) {
+            structures[inverse_permutation[vertex]].insert(row);
+         }
+      }
+   }
+   size_t fill = 0;
+   for (size_t column = 0; column < n; column++) {
+      fill += structures[column].size();
+      if (not structures[column].empty()) {
+         const size_t parent = *structures[column].begin();
+         for (size_t row: structures[column]) {
+            if (row != parent) {
+               structures[parent].insert(row);
+            }
+         }
+      }
+   }
+   return fill;
+}
+
+static Permutation natural_ordering(size_t dimension) {
+   Permutation permutation(dimension);
+   for (size_t index = 0; index < dimension; index++) {
+      permutation[index] = index;
+   }
+   return permutation;
+}
+
+TEST(Ordering, GraphFromMatrix) {
+   SymmetricMatrix<size_t, double> matrix(3, 5, false, "COO");
+   matrix.insert(1., 0, 0);
+   matrix.insert(1., 0, 2);
+   matrix.insert(1., 0, 2); // duplicate entry
+   matrix.insert(1., 1, 2);
+   matrix.insert(1., 2, 2);
+   const SymmetricGraph graph = SymmetricGraph::from_matrix(matrix);
+   ASSERT_EQ(graph.number_vertices(), 3);
+   ASSERT_EQ(graph.degree(0), 1);
+   ASSERT_EQ(graph.degree(1), 1);
+   ASSERT_EQ(graph.degree(2), 2);
+   ASSERT_EQ(graph.neighbor(graph.neighbors_start(2)), 0);
+   ASSERT_EQ(graph.neighbor(graph.neighbors_start(2) + 1), 1);
+}
+
+TEST(Ordering, ApproximateMinimumDegreeOnArrowMatrix) {
+   const size_t n = 50;
+   SymmetricMatrix<size_t, double> matrix(n, 2 * n, false, "COO");
+   fill_arrow_matrix(matrix, n);
+   const SymmetricGraph graph = SymmetricGraph::from_matrix(matrix);
+   const Permutation permutation = ApproximateMinimumDegreeOrdering().compute_permutation(graph);
+   ASSERT_TRUE(is_permutation(permutation, n));
+   // the dense vertex is eliminated among the last two vertices: there is no fill
+   ASSERT_TRUE(permutation[n - 1] == 0 || permutation[n - 2] == 0);
+   ASSERT_EQ(factor_fill(graph, permutation), n - 1);
+   ASSERT_EQ(factor_fill(graph, natural_ordering(n)), n * (n - 1) / 2);
+}
+
+TEST(Ordering, GridLaplacian) {
+   const size_t grid_size = 20;
+   const size_t n = grid_size * grid_size;
+   SymmetricMatrix<size_t, double> matrix(n, 3 * n, false, "COO");
+   fill_grid_laplacian(matrix, grid_size);
+   const SymmetricGraph graph = SymmetricGraph::from_matrix(matrix);
+   const size_t natural_fill = factor_fill(graph, natural_ordering(n));
+
+   const Permutation AMD_permutation = ApproximateMinimumDegreeOrdering().compute_permutation(graph);
+   ASSERT_TRUE(is_permutation(AMD_permutation, n));
+   EXPECT_LT(factor_fill(graph, AMD_permutation), natural_fill);
+
+   const Permutation ND_permutation = NestedDissectionOrdering().compute_permutation(graph);
+   ASSERT_TRUE(is_permutation(ND_permutation, n));
+   EXPECT_LT(factor_fill(graph, ND_permutation), natural_fill);
+}
+
+TEST(Ordering, DisconnectedGraph) {
+   // two disjoint grids and isolated vertices
+   const size_t grid_size = 10;
+   const size_t n = 2 * grid_size * grid_size + 5;
+   SymmetricMatrix<size_t, double> matrix(n, 6 * n, false, "COO");
+   fill_grid_laplacian(matrix, grid_size);
+   for (size_t i = 0; i < grid_size * grid_size; i++) {
+      const size_t vertex = grid_size * grid_size + i;
+      matrix.insert(4., vertex, vertex);
+      if ((i + 1) % grid_size != 0) {
+         matrix.insert(-1., vertex, vertex + 1);
+      }
+   }
+   const SymmetricGraph graph = SymmetricGraph::from_matrix(matrix);
+   ASSERT_TRUE(is_permutation(ApproximateMinimumDegreeOrdering().compute_permutation(graph), n));
+   ASSERT_TRUE(is_permutation(NestedDissectionOrdering().compute_permutation(graph), n));
+}
+
+TEST(Ordering, PermutationIsCachedPerPattern) {
+   const size_t grid_size = 5;
+   const size_t n = grid_size * grid_size;
+   SymmetricMatrix<size_t, double> matrix(n, 3 * n, false, "COO");
+   fill_grid_laplacian(matrix, grid_size);
+   const SparsityPatternFingerprint fingerprint = SparsityPatternFingerprint::compute(matrix);
+   const ApproximateMinimumDegreeOrdering ordering;
+   const auto permutation = ordering.permutation(matrix, fingerprint);
+   // same pattern: the same permutation object is returned
+   ASSERT_EQ(ordering.permutation(matrix, fingerprint), permutation);
+   ASSERT_EQ(ApproximateMinimumDegreeOrdering().permutation(matrix, fingerprint), permutation);
+   // different ordering method: different cache entry
+   ASSERT_NE(NestedDissectionOrdering().permutation(matrix, fingerprint), permutation);
+}
+
+TEST(Ordering, CachedPermutationRequiresSamePattern) {
+   const size_t dimension = 12;
+   SymmetricMatrix<size_t, double> matrix(dimension, 2 * dimension, false, "COO");
+   fill_arrow_matrix(matrix, dimension);
+   const SparsityPatternFingerprint fingerprint = SparsityPatternFingerprint::compute(matrix);
+   const ApproximateMinimumDegreeOrdering ordering;
+   const auto permutation = ordering.permutation(matrix, fingerprint);
+
+   // arrow matrix whose dense row/column comes last (same dimension and number of nonzeros). Looking it up with the fingerprint
+   // of the first matrix simulates a hash collision: the cached permutation must not be returned
+   SymmetricMatrix<size_t, double> other_matrix(dimension, 2 * dimension, false, "COO");
+   for (size_t index = 0; index + 1 < dimension; index++) {
+      other_matrix.insert(2., index, index);
+      other_matrix.insert(1., index, dimension - 1);
+   }
+   other_matrix.insert(static_cast<double>(dimension), dimension - 1, dimension - 1);
+   const auto other_permutation = ordering.permutation(other_matrix, fingerprint);
+   ASSERT_NE(other_permutation, permutation);
+   ASSERT_TRUE(is_permutation(*other_permutation, dimension));
+   // the permutation is that of the other matrix: there is no fill
+   ASSERT_EQ(factor_fill(SymmetricGraph::from_matrix(other_matrix), *other_permutation), dimension - 1);
+   // both entries are now cached under the same fingerprint
+   ASSERT_EQ(ordering.permutation(matrix, fingerprint), permutation);
+   ASSERT_EQ(ordering.permutation(other_matrix, fingerprint), other_permutation);
+}
+
+TEST(Ordering, NativeLDLWithNestedDissection) {
+   const size_t grid_size = 15;
+   const size_t n = grid_size * grid_size;
+   SymmetricMatrix<size_t, double> matrix(n, 3 * n, false, "COO");
+   fill_grid_laplacian(matrix, grid_size);
+   Vector<double> rhs(n);
+   for (size_t index = 0; index < n; index++) {
+      rhs[index] = static_cast<double>(index % 7) - 3.;
+   }
+   NativeLDLSolver solver(n, 3 * n, DefaultOptions::load());
+   solver.set_ordering(FillReducingOrderingFactory::create("nested_dissection"));
+   solver.factorize(matrix);
+   Vector<double> result(n);
+   solver.solve_indefinite_system(matrix, rhs, result);
+
+   Vector<double> residual(n);
+   for (size_t index = 0; index < n; index++) {
+      residual[index] = -rhs[index];
+   }
+   matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      residual[row_index] += element * result[column_index];
+      if (row_index != column_index) {
+         residual[column_index] += element * result[row_index];
+      }
+   });
+   EXPECT_LT(norm_inf(residual), 1e-12);
+   const auto [number_positive, number_negative, number_zero] = solver.get_inertia();
+   ASSERT_EQ(number_positive, n);
+}
@@ -0,0 +1,156 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "DoubleWellModel.hpp"
+#include "ingredients/hessian_models/PartitionedQuasiNewtonHessian.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "reformulation/l1RelaxedProblem.hpp"
+#include "reformulation/OptimalityProblem.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-10;
+
+// objective: elements {0, 1} and {1, 2} overlap (merged), {3}. Constraint 0: elements {2} and {4} (not merged)
+static std::vector<ElementFunction> element_functions() {
+   return {
+      {0, {4}},
+      {ElementFunction::OBJECTIVE, {1, 0}},
+      {ElementFunction::OBJECTIVE, {3}},
+      {0, {2}},
+      {ElementFunction::OBJECTIVE, {2, 1}}
+   };
+}
+
+TEST(PartitionedQuasiNewtonHessian, MergeOverlappingElements) {
+   const std::vector<PartitionedQuasiNewtonHessian::Element> elements = PartitionedQuasiNewtonHessian::merge_elements(element_functions(), 5);
+   ASSERT_EQ(elements.size(), 4);
+   // constraint 0 first
+   ASSERT_EQ(elements[0].constraint_index, 0);
+   ASSERT_EQ(elements[0].variables, std::vector<size_t>{4});
+   ASSERT_EQ(elements[1].constraint_index, 0);
+   ASSERT_EQ(elements[1].variables, std::vector<size_t>{2});
+   ASSERT_EQ(elements[2].constraint_index, ElementFunction::OBJECTIVE);
+   ASSERT_EQ(elements[2].variables, (std::vector<size_t>{0, 1, 2}));
+   ASSERT_EQ(elements[3].variables, std::vector<size_t>{3});
+   // identity
+   ASSERT_EQ(elements[2].matrix, (std::vector<double>{1., 0., 0., 0., 1., 0., 0., 0., 1.}));
+}
+
+// SR1 recovers the Hessian of a quadratic element after linearly independent steps
+TEST(PartitionedQuasiNewtonHessian, SR1RecoversQuadratic) {
+   const Options options = DefaultOptions::load();
+   const PartitionedQuasiNewtonHessian model(5, 0, options);
+   std::vector<PartitionedQuasiNewtonHessian::Element> elements = PartitionedQuasiNewtonHessian::merge_elements(element_functions(), 5);
+   PartitionedQuasiNewtonHessian::Element& element = elements[2];
+   // indefinite Hessian of the element
+   const std::vector<double> hessian{2., 1., 0., 1., -3., 0.5, 0., 0.5, 4.};
+   const std::vector<std::vector<double>> steps{{1., 0.5, -1.}, {0., 2., 1.}, {-1., 1., 3.}};
+   for (const std::vector<double>& s: steps) {
+      std::vector<double> y(3, 0.);
+      for (size_t column_index: Range(3)) {
+         for (size_t row_index: Range(3)) {
+            y[row_index] += hessian[column_index * 3 + row_index] * s[column_index];
+         }
+      }
+      model.update_element(element, s, y);
+   }
+   for (size_t index: Range(9)) {
+      EXPECT_NEAR(element.matrix[index], hessian[index], tolerance);
+   }
+}
+
+// damped BFGS keeps the element matrix positive definite under negative curvature
+TEST(PartitionedQuasiNewtonHessian, DampedBFGS) {
+   Options options = DefaultOptions::load();
+   options["quasi_newton_element_update"] = "BFGS";
+   const PartitionedQuasiNewtonHessian model(5, 0, options);
+   std::vector<PartitionedQuasiNewtonHessian::Element> elements = PartitionedQuasiNewtonHessian::merge_elements(element_functions(), 5);
+   PartitionedQuasiNewtonHessian::Element& element = elements[2];
+   const std::vector<double> s{1., -1., 0.5};
+   std::vector<double> y{-2., 2., -1.};
+   ASSERT_TRUE(model.update_element(element, s, y));
+   // s^T B s > 0 and B s = y (secant equation with the damped y)
+   double sBs = 0.;
+   for (size_t row_index: Range(3)) {
+      double Bs = 0.;
+      for (size_t column_index: Range(3)) {
+         Bs += element.matrix[column_index * 3 + row_index] * s[column_index];
+      }
+      EXPECT_NEAR(Bs, y[row_index], tolerance);
+      sBs += s[row_index] * Bs;
+   }
+   EXPECT_LT(0., sBs);
+   // zero step: skipped
+   std::vector<double> zero_y(3, 1.);
+   ASSERT_FALSE(model.update_element(element, std::vector<double>(3, 0.), zero_y));
+}
+
+// the l1-relaxed problem has an elastic variable beyond the pattern of the model: its column is empty
+TEST(PartitionedQuasiNewtonHessian, ProblemWithElasticVariables) {
+   const Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem optimality_problem(model);
+   const l1RelaxedProblem relaxed_problem(model, 1., 1., 0., nullptr);
+   ASSERT_EQ(relaxed_problem.number_variables, 3);
+   PartitionedQuasiNewtonHessian hessian_model(relaxed_problem.number_variables, relaxed_problem.number_hessian_nonzeros(), options);
+   const Vector<double> multipliers{0.};
+
+   hessian_model.evaluate(statistics, optimality_problem, Vector<double>{1., 0., 0.}, multipliers);
+   hessian_model.evaluate(statistics, relaxed_problem, Vector<double>{1.1, 0.2, 0.}, multipliers);
+   ASSERT_EQ(hessian_model.hessian.dimension(), 3);
+   ASSERT_EQ(hessian_model.hessian.number_nonzeros(), 2);
+   hessian_model.hessian.for_each_nonzero([&](size_t row_index, size_t column_index, double /*element*/) {
+      EXPECT_EQ(row_index, column_index);
+      EXPECT_LT(column_index, model.number_variables);
+   });
+   // back to the optimality problem
+   hessian_model.evaluate(statistics, optimality_problem, Vector<double>{1.2, 0.3, 0.}, multipliers);
+   ASSERT_EQ(hessian_model.hessian.dimension(), 2);
+   ASSERT_EQ(hessian_model.hessian.number_nonzeros(), 2);
+}
+
+// the element pairs are formed with the derivatives cached in the iterates: no additional evaluation
+TEST(PartitionedQuasiNewtonHessian, EvaluationAtIterateReusesDerivatives) {
+   const Options options = DefaultOptions::load();
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem problem(model);
+   PartitionedQuasiNewtonHessian hessian_model(model.number_variables, model.number_hessian_nonzeros(), options);
+   PartitionedQuasiNewtonHessian reference_hessian_model(model.number_variables, model.number_hessian_nonzeros(), options);
+   const std::vector<Vector<double>> points{{1., 0.}, {1.1, 0.2}, {0.9, 0.35}};
+   const Vector<double> multipliers{0.5};
+
+   Iterate::reset_evaluation_counters();
+   for (const Vector<double>& point: points) {
+      Iterate iterate(model.number_variables, model.number_constraints);
+      iterate.primals = point;
+      iterate.evaluate_objective_gradient(model);
+      iterate.evaluate_constraint_jacobian(model);
+      hessian_model.evaluate(statistics, problem, iterate, multipliers);
+   }
+   ASSERT_EQ(Iterate::number_eval_objective_gradient, points.size());
+   ASSERT_EQ(Iterate::number_eval_jacobian, points.size());
+
+   // same approximation as the model that evaluates the derivatives itself
+   for (const Vector<double>& point: points) {
+      reference_hessian_model.evaluate(statistics, problem, point, multipliers);
+   }
+   std::vector<double> values{}, reference_values{};
+   hessian_model.hessian.for_each_nonzero([&](size_t /*row_index*/, size_t /*column_index*/, double element) {
+      values.push_back(element);
+   });
+   reference_hessian_model.hessian.for_each_nonzero([&](size_t /*row_index*/, size_t /*column_index*/, double element) {
+      reference_values.push_back(element);
+   });
+   ASSERT_EQ(values.size(), reference_values.size());
+   for (size_t index: Range(values.size())) {
+      EXPECT_NEAR(values[index], reference_values[index], tolerance);
+   }
+}
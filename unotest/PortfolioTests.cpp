@@ -0,0 +1,58 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "DoubleWellModel.hpp"
+#include "Portfolio.hpp"
+#include "model/ModelFactory.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+
+using namespace uno;
+
+TEST(Portfolio, CombinationOptions) {
+   Options options = DefaultOptions::load();
+   options["tolerance"] = "1e-5";
+   // preset, then an option that overwrites the preset
+   const Options combination_options = Portfolio::combination_options("filtersqp+globalization_mechanism=LS", options);
+   EXPECT_EQ(combination_options.get_string("subproblem"), "QP");
+   EXPECT_EQ(combination_options.get_string("globalization_strategy"), "fletcher_filter_method");
+   EXPECT_EQ(combination_options.get_string("globalization_mechanism"), "LS");
+   // the runs are silent
+   EXPECT_EQ(combination_options.get_string("logger"), "SILENT");
+   // the original options are not modified
+   EXPECT_EQ(options.get_string("tolerance"), "1e-5");
+   EXPECT_EQ(options.get_string("logger"), "INFO");
+}
+
+TEST(Portfolio, InvalidCombinations) {
+   EXPECT_THROW(Portfolio(""), std::invalid_argument);
+   const Options options = DefaultOptions::load();
+   EXPECT_THROW(static_cast<void>(Portfolio::combination_options("unknown_preset", options)), std::runtime_error);
+}
+
+// two combinations race on the double-well model: the evaluations of the first one are slowed down, so that the second one wins and the
+// first one is cancelled
+TEST(Portfolio, Race) {
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers_and_preset());
+   // delay of the objective evaluations (test option read by the model generator)
+   options["double_well_evaluation_delay"] = "0";
+   const std::string slow_combination = "ipopt+double_well_evaluation_delay=50000";
+   Portfolio portfolio(slow_combination + ",ipopt");
+   const Result result = portfolio.solve([](const Options& run_options) {
+      const std::chrono::microseconds evaluation_delay(run_options.get_unsigned_int("double_well_evaluation_delay"));
+      return ModelFactory::reformulate(std::make_unique<DoubleWellModel>(evaluation_delay), run_options);
+   }, options);
+
+   EXPECT_EQ(portfolio.winning_combination, "ipopt");
+   EXPECT_EQ(portfolio.cancelled_combinations, std::vector<std::string>{slow_combination});
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   EXPECT_NEAR(result.solution.primals[0], DoubleWellModel::local_minimum_x0, 1e-6);
+   EXPECT_NEAR(result.solution.primals[1], 0.5, 1e-6);
+}
@@ -0,0 +1,151 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "linear_algebra/RectangularMatrix.hpp"
+
+using namespace uno;
+
+// [1 0 2]
+// [0 3 0]
+static void fill_matrix(RectangularMatrix<double>& matrix, double scaling) {
+   matrix.clear();
+   matrix.insert(1. * scaling, 0, 0);
+   matrix.insert(3. * scaling, 1, 1);
+   matrix.insert(2. * scaling, 0, 2);
+}
+
+static std::vector<double> row_values(const RectangularMatrix<double>& matrix, size_t row_index) {
+   std::vector<double> values;
+   for (const auto [column_index, element]: matrix[row_index]) {
+      values.emplace_back(element);
+   }
+   return values;
+}
+
+TEST(RectangularMatrix, PatternIsFixedAfterClear) {
+   RectangularMatrix<double> matrix(2, 3);
+   fill_matrix(matrix, 1.);
+   ASSERT_FALSE(matrix.has_fixed_pattern());
+   fill_matrix(matrix, 2.);
+   ASSERT_TRUE(matrix.has_fixed_pattern());
+   ASSERT_EQ(matrix.number_nonzeros(), 3);
+   const std::vector<double> reference_row0{2., 4.};
+   ASSERT_EQ(row_values(matrix, 0), reference_row0);
+   const std::vector<double> reference_row1{6.};
+   ASSERT_EQ(row_values(matrix, 1), reference_row1);
+}
+
+TEST(RectangularMatrix, ValuesAreOverwrittenInPlace) {
+   RectangularMatrix<double> matrix(2, 3);
+   fill_matrix(matrix, 1.);
+   fill_matrix(matrix, 1.);
+   const double* entries = matrix.entries_pointer();
+   fill_matrix(matrix, -1.);
+   // same pattern: no reallocation
+   ASSERT_TRUE(matrix.has_fixed_pattern());
+   ASSERT_EQ(matrix.entries_pointer(), entries);
+   ASSERT_EQ(entries[0], -1.);
+   ASSERT_EQ(entries[1], -2.);
+   ASSERT_EQ(entries[2], -3.);
+}
+
+TEST(RectangularMatrix, PatternChange) {
+   RectangularMatrix<double> matrix(2, 3);
+   fill_matrix(matrix, 1.);
+   fill_matrix(matrix, 1.);
+   // insert an entry that is not in the pattern
+   matrix.clear();
+   matrix.insert(1., 0, 0);
+   matrix.insert(5., 0, 1);
+   matrix.insert(2., 0, 2);
+   ASSERT_FALSE(matrix.has_fixed_pattern());
+   const std::vector<double> reference_row0{1., 5., 2.};
+   ASSERT_EQ(row_values(matrix, 0), reference_row0);
+   ASSERT_TRUE(matrix[1].is_empty());
+   // the new pattern becomes fixed at the next clear()
+   matrix.clear();
+   ASSERT_TRUE(matrix.has_fixed_pattern());
+   ASSERT_EQ(matrix.number_nonzeros(), 0);
+   matrix.insert(-1., 0, 0);
+   matrix.insert(-5., 0, 1);
+   matrix.insert(-2., 0, 2);
+   ASSERT_TRUE(matrix.has_fixed_pattern());
+   const std::vector<double> reference_new_row0{-1., -5., -2.};
+   ASSERT_EQ(row_values(matrix, 0), reference_new_row0);
+}
+
+TEST(RectangularMatrix, PartiallyFilledRows) {
+   RectangularMatrix<double> matrix(2, 3);
+   fill_matrix(matrix, 1.);
+   fill_matrix(matrix, 1.);
+   // only the first entry of row 0
+   matrix.clear();
+   matrix.insert(7., 0, 0);
+   ASSERT_EQ(matrix.number_nonzeros(), 1);
+   matrix.finalize_pattern();
+   ASSERT_TRUE(matrix.has_fixed_pattern());
+   const std::vector<double> reference_row0{7.};
+   ASSERT_EQ(row_values(matrix, 0), reference_row0);
+   ASSERT_TRUE(matrix[1].is_empty());
+}
+
+TEST(RectangularMatrix, ScaleRow) {
+   RectangularMatrix<double> matrix(2, 3);
+   fill_matrix(matrix, 1.);
+   matrix.scale_row(0, 10.);
+   const std::vector<double> reference_building_row0{10., 20.};
+   ASSERT_EQ(row_values(matrix, 0), reference_building_row0);
+   fill_matrix(matrix, 1.);
+   matrix.scale_row(1, -1.);
+   const std::vector<double> reference_fixed_row1{-3.};
+   ASSERT_EQ(row_values(matrix, 1), reference_fixed_row1);
+}
+
+TEST(RectangularMatrix, Assign) {
+   RectangularMatrix<double> source(2, 3);
+   fill_matrix(source, 1.);
+   // the target has an extra column filled after the assignment
+   RectangularMatrix<double> target(2, 4);
+   for (size_t evaluation_index: Range(3)) {
+      target.assign(source);
+      target.insert(-1., 1, 3);
+      ASSERT_EQ(target.has_fixed_pattern(), 0 < evaluation_index);
+   }
+   const std::vector<double> reference_row1{3., -1.};
+   ASSERT_EQ(row_values(target, 1), reference_row1);
+   ASSERT_EQ(target.number_columns(), 4);
+}
+
+TEST(RectangularMatrix, ColumnMajorView) {
+   RectangularMatrix<double> matrix(2, 3);
+   fill_matrix(matrix, 1.);
+   const auto& view = matrix.column_major_view();
+   const std::vector<size_t> reference_column_starts{0, 1, 2, 3};
+   ASSERT_EQ(view.column_starts, reference_column_starts);
+   const std::vector<size_t> reference_row_indices{0, 1, 0};
+   ASSERT_EQ(view.row_indices, reference_row_indices);
+   const std::vector<double> reference_values{1., 3., 2.};
+   for (size_t position: Range(view.positions.size())) {
+      ASSERT_EQ(matrix.entries_pointer()[view.positions[position]], reference_values[position]);
+   }
+}
+
+TEST(RectangularMatrix, OverwriteRows) {
+   RectangularMatrix<double> matrix(2, 3);
+   fill_matrix(matrix, 1.);
+   matrix.clear();
+   ASSERT_EQ(matrix.pattern_size(0), 2);
+   ASSERT_EQ(matrix.pattern_indices(0)[1], 2);
+   // rows filled out of order, the second row is filled by a regular insertion
+   double* values = matrix.overwrite_row(0, 2);
+   values[0] = -1.;
+   values[1] = -2.;
+   matrix.insert(-3., 1, 1);
+   const std::vector<double> reference_row0{-1., -2.};
+   ASSERT_EQ(row_values(matrix, 0), reference_row0);
+   const std::vector<double> reference_row1{-3.};
+   ASSERT_EQ(row_values(matrix, 1), reference_row1);
+   ASSERT_TRUE(matrix.has_fixed_pattern());
+}
@@ -0,0 +1,196 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "DoubleWellModel.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "solvers/NativeLDL/NativeLDLSolver.hpp"
+#include "tools/Logger.hpp"
+#include "tools/ThreadPool.hpp"
+
+using namespace uno;
+
+const size_t number_threads = 8;
+const size_t number_solves_per_thread = 32;
+
+// KKT matrix [H J^T; J 0]: the pattern only depends on the size, so that the solves share the cached orderings
+static void fill_KKT_matrix(SymmetricMatrix<size_t, double>& matrix, size_t number_variables, size_t number_constraints, unsigned int seed) {
+   std::mt19937 generator(seed);
+   std::uniform_real_distribution<double> distribution(-1., 1.);
+   for (size_t variable_index: Range(number_variables)) {
+      matrix.insert(3. + distribution(generator), variable_index, variable_index);
+      if (0 < variable_index) {
+         matrix.insert(0.1 * distribution(generator), variable_index - 1, variable_index);
+      }
+   }
+   for (size_t constraint_index: Range(number_constraints)) {
+      matrix.insert(1.5 + distribution(generator), constraint_index, number_variables + constraint_index);
+      matrix.insert(distribution(generator), (constraint_index + 1) % number_variables, number_variables + constraint_index);
+   }
+}
+
+// ||matrix x - rhs||_inf
+static double residual(const SymmetricMatrix<size_t, double>& matrix, const Vector<double>& x, const Vector<double>& rhs) {
+   std::vector<double> product(rhs.size(), 0.);
+   matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      product[row_index] += element * x[column_index];
+      if (row_index != column_index) {
+         product[column_index] += element * x[row_index];
+      }
+   });
+   double norm = 0.;
+   for (size_t index: Range(rhs.size())) {
+      norm = std::max(norm, std::abs(product[index] - rhs[index]));
+   }
+   return norm;
+}
+
+// many independent factorizations and solves run concurrently (build with WITH_TSAN=ON to detect data races)
+TEST(Reentrancy, ConcurrentLinearSolves) {
+   Options options = DefaultOptions::load();
+   options["native_LDL_threads"] = "1";
+   std::atomic<size_t> number_failures{0};
+   std::vector<std::thread> threads{};
+   for (size_t thread_index: Range(number_threads)) {
+      threads.emplace_back([&, thread_index]() {
+         for (size_t solve_index: Range(number_solves_per_thread)) {
+            const size_t number_variables = 10 + 5 * (solve_index % 4);
+            const size_t number_constraints = 3 + solve_index % 4;
+            const size_t dimension = number_variables + number_constraints;
+            const size_t number_nonzeros = 2 * number_variables + 2 * number_constraints;
+            SymmetricMatrix<size_t, double> matrix(dimension, number_nonzeros, false, "COO");
+            fill_KKT_matrix(matrix, number_variables, number_constraints, static_cast<unsigned int>(thread_index * number_solves_per_thread + solve_index));
+            Vector<double> rhs(dimension);
+            for (size_t index: Range(dimension)) {
+               rhs[index] = std::cos(static_cast<double>(index + thread_index));
+            }
+            Vector<double> solution(dimension);
+
+            NativeLDLSolver solver(dimension, number_nonzeros, options);
+            solver.do_symbolic_factorization(matrix);
+            solver.do_numerical_factorization(matrix);
+            solver.solve_indefinite_system(matrix, rhs, solution);
+            if (solver.matrix_is_singular() || 1e-10 < residual(matrix, solution, rhs)) {
+               number_failures++;
+            }
+         }
+      });
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   ASSERT_EQ(number_failures, 0);
+}
+
+// hundreds of complete solves run concurrently and share the same options (build with WITH_TSAN=ON to detect data races). Each
+// solve must reproduce the sequential solve from the same starting point: iterations, evaluation counters and solution
+TEST(Reentrancy, ConcurrentSolves) {
+   const std::vector<std::string> presets{"filtersqp", "ipopt"};
+   const std::vector<double> starting_points{-1.8, -0.5, 0.5, 1.8};
+   std::vector<Options> preset_options{};
+   for (const std::string& preset: presets) {
+      Options options = DefaultOptions::load();
+      options.overwrite_with(DefaultOptions::determine_solvers_and_preset());
+      Options::set_preset(options, preset);
+      options["logger"] = "SILENT";
+      preset_options.push_back(std::move(options));
+   }
+   // sequential references
+   std::vector<Result> references{};
+   for (const Options& options: preset_options) {
+      for (double x0: starting_points) {
+         references.push_back(solve_double_well(options, x0));
+         ASSERT_EQ(references.back().solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+      }
+   }
+
+   std::atomic<size_t> number_failures{0};
+   std::vector<std::thread> threads{};
+   for (size_t thread_index: Range(number_threads)) {
+      threads.emplace_back([&, thread_index]() {
+         for (size_t solve_index: Range(number_solves_per_thread)) {
+            const size_t reference_index = (thread_index + solve_index) % references.size();
+            const Options& options = preset_options[reference_index / starting_points.size()];
+            const Result result = solve_double_well(options, starting_points[reference_index % starting_points.size()]);
+            const Result& reference = references[reference_index];
+            if (result.solution.status != reference.solution.status || result.iteration != reference.iteration ||
+                  result.objective_evaluations != reference.objective_evaluations ||
+                  result.constraint_evaluations != reference.constraint_evaluations ||
+                  result.jacobian_evaluations != reference.jacobian_evaluations ||
+                  result.hessian_evaluations != reference.hessian_evaluations ||
+                  result.solution.primals[0] != reference.solution.primals[0] || result.solution.primals[1] != reference.solution.primals[1]) {
+               number_failures++;
+            }
+         }
+      });
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   ASSERT_EQ(number_failures, 0);
+   // both local minima are found
+   EXPECT_NEAR(references.front().solution.primals[0], DoubleWellModel::global_minimum_x0, 1e-6);
+   EXPECT_NEAR(references.back().solution.primals[0], DoubleWellModel::local_minimum_x0, 1e-6);
+}
+
+TEST(Reentrancy, EvaluationCountersArePerThread) {
+   std::atomic<size_t> number_failures{0};
+   std::vector<std::thread> threads{};
+   for (size_t thread_index: Range(number_threads)) {
+      threads.emplace_back([&, thread_index]() {
+         Iterate::reset_evaluation_counters();
+         for ([[maybe_unused]] size_t evaluation_index: Range(1000 * (thread_index + 1))) {
+            Iterate::number_eval_objective++;
+            Iterate::number_eval_jacobian += 2;
+         }
+         if (Iterate::number_eval_objective != 1000 * (thread_index + 1) || Iterate::number_eval_jacobian != 2000 * (thread_index + 1) ||
+               Iterate::number_eval_constraints != 0) {
+            number_failures++;
+         }
+      });
+   }
+   for (std::thread& thread: threads) {
+      thread.join();
+   }
+   ASSERT_EQ(number_failures, 0);
+}
+
+TEST(Reentrancy, LoggerLevelIsPerThread) {
+   const Level main_level = Logger::level;
+   std::atomic<size_t> number_failures{0};
+   std::thread thread([&]() {
+      Logger::set_logger("SILENT");
+      // the workers of a pool inherit the level of the calling thread
+      ThreadPool thread_pool(4);
+      thread_pool.parallel_for(100, [&](size_t /*task_index*/, size_t /*thread_index*/) {
+         if (Logger::level != SILENT) {
+            number_failures++;
+         }
+      });
+   });
+   thread.join();
+   ASSERT_EQ(number_failures, 0);
+   ASSERT_EQ(Logger::level, main_level);
+}
+
+TEST(Reentrancy, SolveRestoresLoggerLevel) {
+   const Level main_level = Logger::level;
+   Logger::level = WARNING;
+   Options options = DefaultOptions::load();
+   options.overwrite_with(DefaultOptions::determine_solvers_and_preset());
+   options["logger"] = "SILENT";
+   const Result result = solve_double_well(options, 0.5);
+   const Level level_after_solve = Logger::level;
+   Logger::level = main_level;
+   ASSERT_EQ(result.solution.status, TerminationStatus::FEASIBLE_KKT_POINT);
+   ASSERT_EQ(level_after_solve, WARNING);
+}
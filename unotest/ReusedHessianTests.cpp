@@ -0,0 +1,168 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <memory>
+#include "DoubleWellModel.hpp"
+#include "ingredients/hessian_models/ExactHessian.hpp"
+#include "ingredients/hessian_models/LBFGSHessian.hpp"
+#include "ingredients/hessian_models/ReusedHessian.hpp"
+#include "optimization/Iterate.hpp"
+#include "options/DefaultOptions.hpp"
+#include "options/Options.hpp"
+#include "reformulation/OptimalityProblem.hpp"
+#include "tools/Statistics.hpp"
+
+using namespace uno;
+
+// the reuse thresholds are disabled unless a test sets them
+static Options reuse_options() {
+   Options options = DefaultOptions::load();
+   options["hessian_reuse_maximum_age"] = "1000";
+   options["hessian_reuse_primal_threshold"] = "1e10";
+   options["hessian_reuse_multiplier_threshold"] = "1e10";
+   options["hessian_reuse_acceptance_threshold"] = "0";
+   return options;
+}
+
+static ReusedHessian create_reused_hessian(const Options& options) {
+   return ReusedHessian(std::make_unique<ExactHessian>(2, 2, options), options);
+}
+
+TEST(ReusedHessian, MaximumAge) {
+   Options options = reuse_options();
+   options["hessian_reuse_maximum_age"] = "2";
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem problem(model);
+   ReusedHessian hessian_model = create_reused_hessian(options);
+   const Vector<double> x{1., 0.};
+   const Vector<double> multipliers{0.};
+
+   hessian_model.evaluate(statistics, problem, x, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 1);
+   hessian_model.evaluate(statistics, problem, x, multipliers);
+   hessian_model.evaluate(statistics, problem, x, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 1);
+   ASSERT_EQ(hessian_model.number_reuses, 2);
+   // the Hessian is 2 evaluations old
+   hessian_model.evaluate(statistics, problem, x, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 2);
+   ASSERT_EQ(hessian_model.number_reuses, 2);
+}
+
+TEST(ReusedHessian, PrimalChange) {
+   Options options = reuse_options();
+   options["hessian_reuse_primal_threshold"] = "1e-2";
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem problem(model);
+   ReusedHessian hessian_model = create_reused_hessian(options);
+   const Vector<double> multipliers{0.};
+
+   hessian_model.evaluate(statistics, problem, Vector<double>{1., 0.}, multipliers);
+   // relative change 5e-3
+   hessian_model.evaluate(statistics, problem, Vector<double>{1.005, 0.}, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 1);
+   // relative change 5e-2 from the point of the last evaluation
+   hessian_model.evaluate(statistics, problem, Vector<double>{1.05, 0.}, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 2);
+   // the copy of the Hessian is the Hessian at the new point: 12 x0^2 - 4
+   hessian_model.hessian.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      if (row_index == 0 && column_index == 0) {
+         EXPECT_DOUBLE_EQ(element, 12. * 1.05 * 1.05 - 4.);
+      }
+   });
+}
+
+TEST(ReusedHessian, MultiplierChange) {
+   Options options = reuse_options();
+   options["hessian_reuse_multiplier_threshold"] = "1e-2";
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem problem(model);
+   ReusedHessian hessian_model = create_reused_hessian(options);
+   const Vector<double> x{1., 0.};
+
+   hessian_model.evaluate(statistics, problem, x, Vector<double>{2.});
+   // relative change 2.5e-3
+   hessian_model.evaluate(statistics, problem, x, Vector<double>{2.005});
+   ASSERT_EQ(hessian_model.evaluation_count, 1);
+   // relative change 5e-2
+   hessian_model.evaluate(statistics, problem, x, Vector<double>{2.1});
+   ASSERT_EQ(hessian_model.evaluation_count, 2);
+}
+
+TEST(ReusedHessian, AcceptanceRatio) {
+   Options options = reuse_options();
+   options["hessian_reuse_acceptance_threshold"] = "0.5";
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem problem(model);
+   ReusedHessian hessian_model = create_reused_hessian(options);
+   const Vector<double> multipliers{0.};
+   const Vector<double> direction{0.2, -0.1};
+
+   // full step: the Hessian is reused
+   hessian_model.evaluate(statistics, problem, Vector<double>{1., 0.}, multipliers);
+   hessian_model.notify_primal_direction(direction, 2);
+   hessian_model.evaluate(statistics, problem, Vector<double>{1.2, -0.1}, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 1);
+   // step length 0.25: the Hessian is refreshed
+   hessian_model.notify_primal_direction(direction, 2);
+   hessian_model.evaluate(statistics, problem, Vector<double>{1.25, -0.125}, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 2);
+   // full step after two rejected directions (e.g. trust-region reductions): ratio 1/3
+   hessian_model.notify_primal_direction(direction, 2);
+   hessian_model.notify_primal_direction(direction, 2);
+   hessian_model.notify_primal_direction(direction, 2);
+   hessian_model.evaluate(statistics, problem, Vector<double>{1.45, -0.225}, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 3);
+   // no direction was computed: the Hessian is reused
+   hessian_model.evaluate(statistics, problem, Vector<double>{1.45, -0.225}, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 3);
+}
+
+TEST(ReusedHessian, ProblemChange) {
+   const Options options = reuse_options();
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem problem(model);
+   const OptimalityProblem other_problem(model);
+   ReusedHessian hessian_model = create_reused_hessian(options);
+   const Vector<double> x{1., 0.};
+   const Vector<double> multipliers{0.};
+
+   hessian_model.evaluate(statistics, problem, x, multipliers);
+   hessian_model.evaluate(statistics, problem, x, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 1);
+   hessian_model.evaluate(statistics, other_problem, x, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 2);
+   hessian_model.evaluate(statistics, problem, x, multipliers);
+   ASSERT_EQ(hessian_model.evaluation_count, 3);
+}
+
+// the iterate is forwarded to the underlying model, which takes the derivatives cached in the iterate
+TEST(ReusedHessian, ForwardsIterate) {
+   Options options = reuse_options();
+   options["hessian_reuse_maximum_age"] = "0";
+   Statistics statistics(options);
+   const DoubleWellModel model;
+   const OptimalityProblem problem(model);
+   ReusedHessian hessian_model(std::make_unique<LBFGSHessian>(2, options), options);
+   const Vector<double> multipliers{0.};
+
+   Iterate::reset_evaluation_counters();
+   for (const Vector<double>& point: {Vector<double>{1., 0.}, Vector<double>{1.1, 0.2}, Vector<double>{0.9, 0.35}}) {
+      Iterate iterate(2, 1);
+      iterate.primals = point;
+      iterate.evaluate_objective_gradient(model);
+      iterate.evaluate_constraint_jacobian(model);
+      hessian_model.evaluate(statistics, problem, iterate, multipliers);
+   }
+   ASSERT_EQ(hessian_model.evaluation_count, 3);
+   ASSERT_EQ(Iterate::number_eval_objective_gradient, 3);
+   ASSERT_EQ(Iterate::number_eval_jacobian, 3);
+   ASSERT_NE(hessian_model.low_rank_correction(), nullptr);
+   ASSERT_LT(0, hessian_model.low_rank_correction()->get_rank());
+}
@@ -0,0 +1,112 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "linear_algebra/SparseKernels.hpp"
+#include "linear_algebra/Vector.hpp"
+#include "symbolic/MatrixVectorProduct.hpp"
+
+using namespace uno;
+
+const double tolerance = 1e-12;
+
+// [1  0 2 0 0 -1]
+// [0 -3 0 0 0  0]
+// [4  5 6 7 8  9]
+static void fill_matrix(RectangularMatrix<double>& matrix) {
+   matrix.clear();
+   matrix.insert(1., 0, 0);
+   matrix.insert(2., 0, 2);
+   matrix.insert(-1., 0, 5);
+   matrix.insert(-3., 1, 1);
+   for (size_t column_index: Range(6)) {
+      matrix.insert(static_cast<double>(column_index + 4), 2, column_index);
+   }
+}
+
+TEST(SparseKernels, MatrixVectorProduct) {
+   RectangularMatrix<double> matrix(3, 6);
+   fill_matrix(matrix);
+   const Vector<double> x{1., -2., 3., 0.5, -1., 2.};
+   Vector<double> result(3);
+   matrix_vector_product(matrix, x, result);
+   // the expression template is the reference
+   const auto reference = matrix * x;
+   for (size_t row_index: Range(3)) {
+      EXPECT_NEAR(result[row_index], reference[row_index], tolerance);
+   }
+   EXPECT_NEAR(result[0], 5., tolerance);
+   EXPECT_NEAR(result[1], 6., tolerance);
+   EXPECT_NEAR(result[2], 25.5, tolerance);
+}
+
+TEST(SparseKernels, TransposedMatrixVectorProduct) {
+   RectangularMatrix<double> matrix(3, 6);
+   fill_matrix(matrix);
+   const Vector<double> y{2., 0., -1.};
+   Vector<double> result(6, 1.);
+   transposed_matrix_vector_product(matrix, y, -1., result);
+   const std::vector<double> reference{1. - 2. + 4., 1. + 5., 1. - 4. + 6., 1. + 7., 1. + 8., 1. + 2. + 9.};
+   for (size_t column_index: Range(6)) {
+      EXPECT_NEAR(result[column_index], reference[column_index], tolerance);
+   }
+}
+
+TEST(SparseKernels, LinearizedResidualNorm) {
+   RectangularMatrix<double> matrix(3, 6);
+   fill_matrix(matrix);
+   const std::vector<double> constraints{-1., 2., 0.5};
+   const Vector<double> direction{1., -2., 3., 0.5, -1., 2.};
+   const double step_length = 0.5;
+   // violation of the constraints c(x) <= 0
+   const auto violation = [](double value, size_t /*row_index*/) {
+      return std::max(0., value);
+   };
+   // linearized constraints: {1.5, 5., 13.25}
+   EXPECT_NEAR(linearized_residual_norm(Norm::L1, constraints, step_length, matrix, direction, violation), 19.75, tolerance);
+   EXPECT_NEAR(linearized_residual_norm(Norm::L2_SQUARED, constraints, step_length, matrix, direction, violation),
+         1.5*1.5 + 5.*5. + 13.25*13.25, tolerance);
+   EXPECT_NEAR(linearized_residual_norm(Norm::L2, constraints, step_length, matrix, direction, violation),
+         std::sqrt(1.5*1.5 + 5.*5. + 13.25*13.25), tolerance);
+   EXPECT_NEAR(linearized_residual_norm(Norm::INF, constraints, step_length, matrix, direction, violation), 13.25, tolerance);
+}
+
+// enough rows to run the parallel loops (when compiled with OpenMP), and rows long enough for the vectorized dot products
+TEST(SparseKernels, LargeMatrix) {
+   const size_t number_rows = 2 * sparse_kernels_parallel_threshold;
+   const size_t number_columns = 100;
+   RectangularMatrix<double> matrix(number_rows, number_columns);
+   std::vector<std::vector<std::pair<size_t, double>>> rows(number_rows);
+   for (size_t row_index: Range(number_rows)) {
+      // between 1 and 9 entries per row
+      for (size_t term: Range(1 + row_index % 9)) {
+         const size_t column_index = (7 * row_index + 13 * term) % number_columns;
+         const double value = 1. + static_cast<double>((row_index + term) % 5) - 0.25 * static_cast<double>(term);
+         matrix.insert(value, row_index, column_index);
+         rows[row_index].emplace_back(column_index, value);
+      }
+   }
+   Vector<double> x(number_columns);
+   for (size_t column_index: Range(number_columns)) {
+      x[column_index] = std::sin(static_cast<double>(column_index));
+   }
+
+   Vector<double> result(number_rows);
+   matrix_vector_product(matrix, x, result);
+   std::vector<double> constraints(number_rows, -1.);
+   double reference_norm = 0.;
+   for (size_t row_index: Range(number_rows)) {
+      double reference = 0.;
+      for (const auto& [column_index, value]: rows[row_index]) {
+         reference += value * x[column_index];
+      }
+      EXPECT_NEAR(result[row_index], reference, tolerance);
+      reference_norm += std::abs(constraints[row_index] + 0.5 * reference);
+   }
+   const auto violation = [](double value, size_t /*row_index*/) {
+      return value;
+   };
+   EXPECT_NEAR(linearized_residual_norm(Norm::L1, constraints, 0.5, matrix, x, violation), reference_norm, tolerance * reference_norm);
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include "linear_algebra/SparsityPatternFingerprint.hpp"
+#include "linear_algebra/SymmetricMatrix.hpp"
+
+using namespace uno;
+
+static void fill_matrix(SymmetricMatrix<size_t, double>& matrix, double scaling) {
+   matrix.insert(2. * scaling, 0, 0);
+   matrix.insert(3. * scaling, 0, 1);
+   matrix.insert(4. * scaling, 1, 2);
+   matrix.insert(6. * scaling, 1, 4);
+   matrix.insert(1. * scaling, 2, 2);
+   matrix.insert(5. * scaling, 2, 3);
+   matrix.insert(1. * scaling, 4, 4);
+}
+
+TEST(SparsityPatternFingerprint, SamePatternDifferentValues) {
+   SymmetricMatrix<size_t, double> matrix1(5, 7, false, "COO");
+   fill_matrix(matrix1, 1.);
+   SymmetricMatrix<size_t, double> matrix2(5, 7, false, "COO");
+   fill_matrix(matrix2, -7.);
+   ASSERT_EQ(SparsityPatternFingerprint::compute(matrix1), SparsityPatternFingerprint::compute(matrix2));
+}
+
+TEST(SparsityPatternFingerprint, DifferentPattern) {
+   SymmetricMatrix<size_t, double> matrix1(5, 7, false, "COO");
+   fill_matrix(matrix1, 1.);
+   SymmetricMatrix<size_t, double> matrix2(5, 7, false, "COO");
+   matrix2.insert(2., 0, 0);
+   matrix2.insert(3., 0, 1);
+   matrix2.insert(4., 1, 2);
+   matrix2.insert(6., 1, 4);
+   matrix2.insert(1., 2, 2);
+   matrix2.insert(5., 2, 3);
+   matrix2.insert(1., 3, 4);
+   ASSERT_NE(SparsityPatternFingerprint::compute(matrix1), SparsityPatternFingerprint::compute(matrix2));
+}
+
+TEST(SparsityPatternFingerprint, DifferentDimension) {
+   SymmetricMatrix<size_t, double> matrix1(5, 7, false, "COO");
+   fill_matrix(matrix1, 1.);
+   SymmetricMatrix<size_t, double> matrix2(5, 7, false, "COO");
+   fill_matrix(matrix2, 1.);
+   matrix2.set_dimension(4);
+   ASSERT_NE(SparsityPatternFingerprint::compute(matrix1), SparsityPatternFingerprint::compute(matrix2));
+}
@@ -0,0 +1,179 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <tuple>
+#include <vector>
+#include "linear_algebra/SymmetricIndefiniteLinearSystem.hpp"
+#include "linear_algebra/RegularizationPredictor.hpp"
+#include "options/DefaultOptions.hpp"
+#include "solvers/NativeLDL/NativeLDLSolver.hpp"
+
+using namespace uno;
+
+const size_t number_variables = 3;
+const size_t number_constraints = 2;
+
+static void fill_hessian(SymmetricMatrix<size_t, double>& hessian, double scaling) {
+   hessian.reset();
+   hessian.insert(4. * scaling, 0, 0);
+   hessian.insert(1. * scaling, 0, 1);
+   hessian.insert(3. * scaling, 1, 1);
+   hessian.insert(2. * scaling, 2, 2);
+}
+
+static void fill_jacobian(RectangularMatrix<double>& jacobian, double scaling) {
+   jacobian.clear();
+   jacobian.insert(1. * scaling, 0, 0);
+   jacobian.insert(-1. * scaling, 0, 2);
+   jacobian.insert(5. * scaling, 1, 1);
+}
+
+TEST(SymmetricIndefiniteLinearSystem, ScatterMatchesFullAssembly) {
+   const Options options = DefaultOptions::load();
+   SymmetricMatrix<size_t, double> hessian(number_variables, 4, false, "COO");
+   RectangularMatrix<double> jacobian(number_constraints, number_variables);
+
+   // the first system is assembled twice (the second assembly only scatters the values)
+   SymmetricIndefiniteLinearSystem<double> system(options.get_string("sparse_format"), number_variables + number_constraints, 7, true, options);
+   fill_hessian(hessian, 1.);
+   fill_jacobian(jacobian, 1.);
+   system.assemble_matrix(hessian, jacobian, number_variables, number_constraints);
+   fill_hessian(hessian, -3.);
+   fill_jacobian(jacobian, 2.);
+   system.assemble_matrix(hessian, jacobian, number_variables, number_constraints);
+
+   // the reference system is assembled from scratch
+   SymmetricIndefiniteLinearSystem<double> reference_system(options.get_string("sparse_format"), number_variables + number_constraints, 7, true,
+         options);
+   reference_system.assemble_matrix(hessian, jacobian, number_variables, number_constraints);
+
+   ASSERT_EQ(system.matrix.number_nonzeros(), reference_system.matrix.number_nonzeros());
+   for (size_t nonzero_index: Range(system.matrix.number_nonzeros())) {
+      EXPECT_DOUBLE_EQ(system.matrix.data_pointer()[nonzero_index], reference_system.matrix.data_pointer()[nonzero_index]);
+   }
+}
+
+TEST(SymmetricIndefiniteLinearSystem, MovedEntriesTriggerFullAssembly) {
+   const Options options = DefaultOptions::load();
+   SymmetricMatrix<size_t, double> hessian(number_variables, 4, false, "COO");
+   RectangularMatrix<double> jacobian(number_constraints, number_variables);
+   SymmetricIndefiniteLinearSystem<double> system(options.get_string("sparse_format"), number_variables + number_constraints, 7, true, options);
+   fill_hessian(hessian, 1.);
+   fill_jacobian(jacobian, 1.);
+   system.assemble_matrix(hessian, jacobian, number_variables, number_constraints);
+
+   // same block sizes and row sizes, but the entry (0, 1) of the Hessian moves to (1, 2) and the entry (0, 0) of the
+   // Jacobian moves to (0, 1)
+   hessian.reset();
+   hessian.insert(4., 0, 0);
+   hessian.insert(1., 1, 2);
+   hessian.insert(3., 1, 1);
+   hessian.insert(2., 2, 2);
+   jacobian.clear();
+   jacobian.insert(1., 0, 1);
+   jacobian.insert(-1., 0, 2);
+   jacobian.insert(5., 1, 1);
+   system.assemble_matrix(hessian, jacobian, number_variables, number_constraints);
+
+   SymmetricIndefiniteLinearSystem<double> reference_system(options.get_string("sparse_format"), number_variables + number_constraints, 7, true,
+         options);
+   reference_system.assemble_matrix(hessian, jacobian, number_variables, number_constraints);
+
+   std::vector<std::tuple<size_t, size_t, double>> entries{};
+   system.matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      entries.emplace_back(row_index, column_index, element);
+   });
+   std::vector<std::tuple<size_t, size_t, double>> reference_entries{};
+   reference_system.matrix.for_each_nonzero([&](size_t row_index, size_t column_index, double element) {
+      reference_entries.emplace_back(row_index, column_index, element);
+   });
+   ASSERT_EQ(entries, reference_entries);
+}
+
+TEST(SymmetricIndefiniteLinearSystem, RegularizationPredictor) {
+   RegularizationPredictor<double> predictor(1e-20, 3., 0.5, 0.7);
+   ASSERT_FALSE(predictor.skip_unregularized_trial());
+   // two corrections in a row: the frequency exceeds the threshold
+   predictor.record_success(9e-4);
+   ASSERT_DOUBLE_EQ(predictor.predicted_regularization(), 3e-4);
+   ASSERT_FALSE(predictor.skip_unregularized_trial());
+   predictor.record_failure(1e-4);
+   predictor.record_success(1e-2);
+   // bisection (in log scale) between the failed and the successful regularizations
+   ASSERT_NEAR(predictor.predicted_regularization(), 1e-3, 1e-15);
+   ASSERT_TRUE(predictor.skip_unregularized_trial());
+   // iterations without correction: the frequency decreases
+   predictor.record_success(0.);
+   predictor.record_success(0.);
+   ASSERT_FALSE(predictor.skip_unregularized_trial());
+}
+
+// number of factorizations of a sequence of nonconvex systems
+static size_t count_factorizations(const std::string& regularization_strategy) {
+   Options options = DefaultOptions::load();
+   options["regularization_strategy"] = regularization_strategy;
+   Statistics statistics(options);
+   SymmetricMatrix<size_t, double> hessian(number_variables, 4, false, "COO");
+   RectangularMatrix<double> jacobian(number_constraints, number_variables);
+   const size_t dimension = number_variables + number_constraints;
+   SymmetricIndefiniteLinearSystem<double> system("COO", dimension, 7, true, options);
+   NativeLDLSolver linear_solver(dimension, 7 + dimension, options);
+   for (size_t iteration: Range(10)) {
+      // the negative curvature varies slightly across iterations
+      fill_hessian(hessian, -1. - 0.01 * static_cast<double>(iteration));
+      fill_jacobian(jacobian, 1.);
+      system.assemble_matrix(hessian, jacobian, number_variables, number_constraints);
+      system.regularize_matrix(statistics, linear_solver, number_variables, number_constraints, 1e-8);
+      const auto [number_positive, number_negative, number_zero] = linear_solver.get_inertia();
+      EXPECT_EQ(number_positive, number_variables);
+      EXPECT_EQ(number_negative, number_constraints);
+      EXPECT_EQ(number_zero, 0);
+   }
+   return system.get_number_factorizations();
+}
+
+TEST(SymmetricIndefiniteLinearSystem, PredictiveRegularizationSavesFactorizations) {
+   const size_t standard_factorizations = count_factorizations("standard");
+   const size_t predictive_factorizations = count_factorizations("predictive");
+   EXPECT_LT(predictive_factorizations, standard_factorizations);
+}
+
+// min (x0^2 - x1^2)/2 s.t. x0 = 1: the Hessian is indefinite on the null space of the Jacobian
+static size_t factorizations_nonconvex_system(const std::string& acceptance_test, double gradient_x1, Vector<double>& primal_direction) {
+   Options options = DefaultOptions::load();
+   options["regularization_acceptance_test"] = acceptance_test;
+   Statistics statistics(options);
+   SymmetricMatrix<size_t, double> hessian(2, 2, false, "COO");
+   hessian.insert(1., 0, 0);
+   hessian.insert(-1., 1, 1);
+   RectangularMatrix<double> jacobian(1, 2);
+   jacobian.insert(1., 0, 0);
+   SymmetricIndefiniteLinearSystem<double> system("COO", 3, 3, true, options);
+   NativeLDLSolver linear_solver(3, 6, options);
+   system.assemble_matrix(hessian, jacobian, 2, 1);
+   system.rhs[0] = 0.;
+   system.rhs[1] = -gradient_x1;
+   system.rhs[2] = 1.;
+   system.regularize_matrix(statistics, linear_solver, 2, 1, 1e-8);
+   system.solve(linear_solver);
+   primal_direction = Vector<double>{system.solution[0], system.solution[1]};
+   return system.get_number_factorizations();
+}
+
+TEST(SymmetricIndefiniteLinearSystem, CurvatureTestAcceptsWrongInertia) {
+   Vector<double> primal_direction(2);
+   // the step (1, 0) has positive curvature: the unregularized factorization is accepted
+   ASSERT_EQ(factorizations_nonconvex_system("curvature", 0., primal_direction), 1);
+   EXPECT_DOUBLE_EQ(primal_direction[0], 1.);
+   EXPECT_DOUBLE_EQ(primal_direction[1], 0.);
+   ASSERT_LT(1, factorizations_nonconvex_system("inertia", 0., primal_direction));
+}
+
+TEST(SymmetricIndefiniteLinearSystem, CurvatureTestRegularizesNegativeCurvature) {
+   Vector<double> primal_direction(2);
+   ASSERT_LT(1, factorizations_nonconvex_system("curvature", 5., primal_direction));
+   // the regularized Hessian is positive definite along the step
+   EXPECT_DOUBLE_EQ(primal_direction[0], 1.);
+   EXPECT_LT(primal_direction[1], 0.);
+}
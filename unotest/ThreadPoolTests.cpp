@@ -0,0 +1,53 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+#include "tools/ThreadPool.hpp"
+
+using namespace uno;
+
+TEST(ThreadPool, AllTasksAreExecuted) {
+   ThreadPool thread_pool(4);
+   ASSERT_EQ(thread_pool.size(), 4);
+   // several batches with the same pool
+   for (size_t batch_index = 0; batch_index < 10; batch_index++) {
+      std::vector<int> executions(100, 0);
+      std::atomic<bool> valid_thread_indices{true};
+      thread_pool.parallel_for(executions.size(), [&](size_t task_index, size_t thread_index) {
+         executions[task_index]++;
+         if (thread_pool.size() <= thread_index) {
+            valid_thread_indices = false;
+         }
+      });
+      ASSERT_EQ(executions, std::vector<int>(100, 1));
+      ASSERT_TRUE(valid_thread_indices);
+   }
+}
+
+TEST(ThreadPool, SequentialPool) {
+   ThreadPool thread_pool(1);
+   size_t sum = 0;
+   thread_pool.parallel_for(10, [&](size_t task_index, size_t thread_index) {
+      ASSERT_EQ(thread_index, 0);
+      sum += task_index;
+   });
+   ASSERT_EQ(sum, 45);
+}
+
+TEST(ThreadPool, ExceptionIsRethrown) {
+   ThreadPool thread_pool(3);
+   ASSERT_THROW(thread_pool.parallel_for(20, [&](size_t task_index, size_t /*thread_index*/) {
+      if (task_index == 7) {
+         throw std::runtime_error("task failed");
+      }
+   }), std::runtime_error);
+   // the pool is still usable
+   std::atomic<size_t> number_executions{0};
+   thread_pool.parallel_for(20, [&](size_t /*task_index*/, size_t /*thread_index*/) {
+      number_executions++;
+   });
+   ASSERT_EQ(number_executions, 20);
+}
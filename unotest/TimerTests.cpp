@@ -0,0 +1,26 @@
+// Copyright (c) 2018-2024 Charlie Vanaret
+// Licensed under the MIT license. See LICENSE file in the project directory for details.
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+#include "tools/Timer.hpp"
+
+using namespace uno;
+
+// the elapsed time is measured: a sleeping thread consumes no CPU time but its wall-clock time elapses
+TEST(Timer, WallClockTime) {
+   const Timer timer{};
+   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+   const double duration = timer.get_duration();
+   EXPECT_GE(duration, 0.05);
+   EXPECT_LT(duration, 10.);
+}
+
+TEST(Timer, MonotonicDuration) {
+   const Timer timer{};
+   const double first_duration = timer.get_duration();
+   const double second_duration = timer.get_duration();
+   EXPECT_LE(0., first_duration);
+   EXPECT_LE(first_duration, second_duration);
+}